@@ -425,6 +425,7 @@ LOCAL_SRC_FILES := \
   src/ndn-cpp/src/c/encoding/tlv/tlv-key-locator.c \
   src/ndn-cpp/src/c/encoding/tlv/tlv-lp-packet.c \
   src/ndn-cpp/src/c/encoding/tlv/tlv-name.c \
+  src/ndn-cpp/src/c/encoding/tlv/tlv-reverse-encoder.c \
   src/ndn-cpp/src/c/encoding/tlv/tlv-signature-info.c \
   src/ndn-cpp/src/c/encoding/tlv/tlv-structure-decoder.c \
   src/ndn-cpp/src/c/encrypt/algo/aes-algorithm_c.c \
@@ -500,6 +501,7 @@ LOCAL_SRC_FILES := \
   src/ndn-cpp/src/impl/pending-interest-table.cpp \
   src/ndn-cpp/src/impl/registered-prefix-table.cpp \
   src/ndn-cpp/src/in-memory-storage/in-memory-storage-retaining.cpp \
+  src/ndn-cpp/src/in-memory-storage/in-memory-storage-sharded.cpp \
   src/ndn-cpp/src/lite/control-parameters-lite.cpp \
   src/ndn-cpp/src/lite/control-response-lite.cpp \
   src/ndn-cpp/src/lite/data-lite.cpp \
@@ -516,6 +518,7 @@ LOCAL_SRC_FILES := \
   src/ndn-cpp/src/lite/encoding/tlv-0_2-wire-format-lite.cpp \
   src/ndn-cpp/src/lite/encrypt/encrypted-content-lite.cpp \
   src/ndn-cpp/src/lite/encrypt/algo/aes-algorithm-lite.cpp \
+  src/ndn-cpp/src/lite/encrypt/algo/aes-context-lite.cpp \
   src/ndn-cpp/src/lite/encrypt/algo/des-algorithm-lite.cpp \
   src/ndn-cpp/src/lite/encrypt/algo/encrypt-params-lite.cpp \
   src/ndn-cpp/src/lite/lp/congestion-mark-lite.cpp \
@@ -586,6 +589,7 @@ LOCAL_SRC_FILES := \
   src/ndn-cpp/src/security/v2/certificate-fetcher.cpp \
   src/ndn-cpp/src/security/v2/certificate-storage.cpp \
   src/ndn-cpp/src/security/v2/certificate-v2.cpp \
+  src/ndn-cpp/src/security/v2/public-key-cache.cpp \
   src/ndn-cpp/src/security/v2/trust-anchor-container.cpp \
   src/ndn-cpp/src/security/v2/trust-anchor-group.cpp \
   src/ndn-cpp/src/security/v2/validation-error.cpp \
@@ -597,6 +601,7 @@ LOCAL_SRC_FILES := \
   src/ndn-cpp/src/security/v2/validation-policy.cpp \
   src/ndn-cpp/src/security/v2/validation-state.cpp \
   src/ndn-cpp/src/security/v2/validator.cpp \
+  src/ndn-cpp/src/security/v2/verification-worker-pool.cpp \
   src/ndn-cpp/src/security/v2/validator-config/config-checker.cpp \
   src/ndn-cpp/src/security/v2/validator-config/config-filter.cpp \
   src/ndn-cpp/src/security/v2/validator-config/config-name-relation.cpp \
@@ -610,11 +615,17 @@ LOCAL_SRC_FILES := \
   src/ndn-cpp/src/util/boost-info-parser.cpp \
   src/ndn-cpp/src/util/command-interest-generator.cpp \
   src/ndn-cpp/src/util/config-file.cpp \
+  src/ndn-cpp/src/util/congestion-window.cpp \
   src/ndn-cpp/src/util/dynamic-uint8-vector.cpp \
+  src/ndn-cpp/src/util/event-loop.cpp \
   src/ndn-cpp/src/util/exponential-re-express.cpp \
+  src/ndn-cpp/src/util/fetch-scheduler.cpp \
   src/ndn-cpp/src/util/logging.cpp \
   src/ndn-cpp/src/util/memory-content-cache.cpp \
+  src/ndn-cpp/src/util/persistent-content-store.cpp \
+  src/ndn-cpp/src/util/rtt-estimator.cpp \
   src/ndn-cpp/src/util/segment-fetcher.cpp \
+  src/ndn-cpp/src/util/segment-publisher.cpp \
   src/ndn-cpp/src/util/sqlite3-statement.cpp \
   src/ndn-cpp/src/util/regex/ndn-regex-backref-manager.cpp \
   src/ndn-cpp/src/util/regex/ndn-regex-backref-matcher.cpp \
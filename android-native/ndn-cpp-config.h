@@ -112,21 +112,41 @@
 #define NDN_CPP_HAVE_MEMSET 1
 #endif
 
+/* Define to 1 if you have the `mmap' function. */
+#ifndef NDN_CPP_HAVE_MMAP
+#define NDN_CPP_HAVE_MMAP 1
+#endif
+
 /* 1 if have the OSX framework. */
 #ifndef NDN_CPP_HAVE_OSX_SECURITY
 #define NDN_CPP_HAVE_OSX_SECURITY 0
 #endif
 
+/* 1 if have POSIX threads (pthread.h and libpthread). */
+#ifndef NDN_CPP_HAVE_POSIX_THREADS
+#define NDN_CPP_HAVE_POSIX_THREADS 1
+#endif
+
 /* 1 if have Google Protobuf. */
 #ifndef NDN_CPP_HAVE_PROTOBUF
 #define NDN_CPP_HAVE_PROTOBUF 0
 #endif
 
+/* Define to 1 if you have the `recvmmsg' function. */
+#ifndef NDN_CPP_HAVE_RECVMMSG
+#define NDN_CPP_HAVE_RECVMMSG 1
+#endif
+
 /* Define to 1 if you have the `round' function. */
 #ifndef NDN_CPP_HAVE_ROUND
 #define NDN_CPP_HAVE_ROUND 1
 #endif
 
+/* Define to 1 if you have the `sendmmsg' function. */
+#ifndef NDN_CPP_HAVE_SENDMMSG
+#define NDN_CPP_HAVE_SENDMMSG 1
+#endif
+
 /* Have the SQLITE3 library */
 #define NDN_CPP_HAVE_SQLITE3
 
@@ -160,6 +180,11 @@
 #define NDN_CPP_HAVE_STD_SHARED_PTR 1
 #endif
 
+/* 1 if have the `std::unordered_map' class. */
+#ifndef NDN_CPP_HAVE_STD_UNORDERED_MAP
+#define NDN_CPP_HAVE_STD_UNORDERED_MAP 1
+#endif
+
 /* Define to 1 if you have the `strchr' function. */
 #ifndef NDN_CPP_HAVE_STRCHR
 #define NDN_CPP_HAVE_STRCHR 1
@@ -175,6 +200,11 @@
 #define NDN_CPP_HAVE_STRING_H 1
 #endif
 
+/* Define to 1 if you have the <sys/epoll.h> header file. */
+#ifndef NDN_CPP_HAVE_SYS_EPOLL_H
+#define NDN_CPP_HAVE_SYS_EPOLL_H 1
+#endif
+
 /* Define to 1 if you have the <sys/stat.h> header file. */
 #ifndef NDN_CPP_HAVE_SYS_STAT_H
 #define NDN_CPP_HAVE_SYS_STAT_H 1
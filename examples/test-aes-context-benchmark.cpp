@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the throughput of AES-256 encryption for payloads from 1 KB to
+ * 64 KB with the one-shot AesAlgorithmLite::encrypt256Cbc, which creates a
+ * cipher context and expands the key on each call, and with an AesContextLite
+ * in CBC, CTR and GCM mode, which expands the key once.
+ */
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <sys/time.h>
+#include <ndn-cpp/c/common.h>
+#include <ndn-cpp/lite/encrypt/algo/aes-algorithm-lite.hpp>
+#include <ndn-cpp/lite/encrypt/algo/aes-context-lite.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * Print the name, the rate of operations and the throughput in GB/s.
+ */
+static void
+printResult
+  (const string& name, size_t payloadSize, size_t nOperations, double duration)
+{
+  cout << name << " " << payloadSize << " bytes: Duration sec, Hz, GB/s: " <<
+    duration << ", " << (nOperations / duration) << ", " <<
+    (nOperations * (double)payloadSize / duration / 1e9) << endl;
+}
+
+static void
+benchmarkContext
+  (const string& name, ndn_EncryptAlgorithmType algorithmType,
+   const vector<uint8_t>& key, const vector<uint8_t>& plainData,
+   size_t nOperations)
+{
+  AesContextLite context;
+  if (context.setKey(algorithmType, &key[0], key.size()))
+    throw runtime_error("Error in setKey");
+  size_t initialVectorLength =
+    (algorithmType == ndn_EncryptAlgorithmType_AesGcm ?
+     ndn_AES_GCM_INITIAL_VECTOR_LENGTH : ndn_AES_BLOCK_LENGTH);
+  vector<uint8_t> initialVector(initialVectorLength, 0x33);
+  vector<uint8_t> encryptedData
+    (context.getEncryptedDataLength(plainData.size()));
+  size_t encryptedDataLength;
+
+  double start = getNowSeconds();
+  for (size_t i = 0; i < nOperations; ++i) {
+    if (context.encrypt
+        (&initialVector[0], initialVector.size(), 0, 0, &plainData[0],
+         plainData.size(), &encryptedData[0], encryptedDataLength))
+      throw runtime_error("Error in encrypt");
+  }
+  printResult(name, plainData.size(), nOperations, getNowSeconds() - start);
+}
+
+static void
+benchmarkAes(size_t payloadSize, size_t nOperations)
+{
+  vector<uint8_t> key(ndn_AES_256_KEY_LENGTH, 0x11);
+  vector<uint8_t> initialVector(ndn_AES_BLOCK_LENGTH, 0x22);
+  vector<uint8_t> plainData(payloadSize, 0x5a);
+  vector<uint8_t> encryptedData(payloadSize + ndn_AES_BLOCK_LENGTH);
+  size_t encryptedDataLength;
+
+  double start = getNowSeconds();
+  for (size_t i = 0; i < nOperations; ++i) {
+    if (AesAlgorithmLite::encrypt256Cbc
+        (&key[0], key.size(), &initialVector[0], initialVector.size(),
+         &plainData[0], plainData.size(), &encryptedData[0],
+         encryptedDataLength))
+      throw runtime_error("Error in encrypt256Cbc");
+  }
+  printResult
+    ("One-shot encrypt256Cbc", payloadSize, nOperations,
+     getNowSeconds() - start);
+
+  benchmarkContext
+    ("AesContextLite CBC", ndn_EncryptAlgorithmType_AesCbc, key, plainData,
+     nOperations);
+  benchmarkContext
+    ("AesContextLite CTR", ndn_EncryptAlgorithmType_AesCtr, key, plainData,
+     nOperations);
+  benchmarkContext
+    ("AesContextLite GCM", ndn_EncryptAlgorithmType_AesGcm, key, plainData,
+     nOperations);
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    benchmarkAes(1024, 500000);
+    benchmarkAes(8192, 100000);
+    benchmarkAes(65536, 10000);
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
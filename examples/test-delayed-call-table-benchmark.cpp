@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the cost of scheduling and then calling the delayed calls in
+ * a DelayedCallTable for different numbers of pending calls, such as the
+ * Interest timeouts for many outstanding Interests.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include "../src/impl/delayed-call-table.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+static int nCalls = 0;
+
+static void
+onCall()
+{
+  ++nCalls;
+}
+
+/**
+ * Schedule nEntries calls with delays spread over a few seconds (like
+ * Interest lifetimes), then advance the clock and call them all.
+ * @param nEntries The number of calls to schedule.
+ * @return The number of seconds to schedule and call all the entries.
+ */
+static double
+benchmarkCallLaterSeconds(int nEntries)
+{
+  DelayedCallTable delayedCallTable;
+  nCalls = 0;
+
+  double start = getNowSeconds();
+  for (int i = 0; i < nEntries; ++i)
+    // Spread the delays between 1000 and 5000 milliseconds.
+    delayedCallTable.callLater(i + 1, 1000 + (i * 7919) % 4000, onCall);
+
+  delayedCallTable.setNowOffsetMilliseconds_(10000);
+  delayedCallTable.callTimedOut();
+  double finish = getNowSeconds();
+
+  if (nCalls != nEntries)
+    throw runtime_error("Expected all delayed calls to be called");
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int sizes[] = { 1000, 10000, 50000, 200000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+      double duration = benchmarkCallLaterSeconds(sizes[i]);
+      cout << "Schedule and call " << sizes[i]
+           << " delayed calls: Duration sec, usec per call: " << duration
+           << ", " << (duration * 1000000.0 / sizes[i]) << endl;
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the rate of reassembling large Data packets which arrive on a
+ * stream socket in segments, either by receiving each segment into a separate
+ * buffer and copying it into the ElementReader, or by receiving the rest of a
+ * partial element directly into the ElementReader's buffer with readv.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <ndn-cpp/data.hpp>
+#include "../src/c/encoding/element-reader.h"
+#include "../src/encoding/element-listener.hpp"
+#include "../src/util/dynamic-uint8-vector.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+class CountingElementListener : public ElementListener {
+public:
+  CountingElementListener()
+  : nElements_(0)
+  {
+  }
+
+  virtual void
+  onReceivedElement(const uint8_t *element, size_t elementLength)
+  {
+    ++nElements_;
+  }
+
+  int nElements_;
+};
+
+/**
+ * Receive a stream of nElements copies of the encoding which is written to a
+ * socket pair in segments of segmentLength bytes. After writing each segment,
+ * read all available bytes as a transport's processEvents would.
+ * @param encoding The encoding of one element.
+ * @param segmentLength The number of bytes in each write.
+ * @param receiveIntoBuffer If true, receive the rest of a partial element
+ * directly into the ElementReader's buffer. If false, always receive into a
+ * separate buffer and call ndn_ElementReader_onReceivedData.
+ * @param nElements The number of elements to receive.
+ * @return The number of seconds for all elements.
+ */
+static double
+benchmarkElementReaderSeconds
+  (const Blob& encoding, size_t segmentLength, bool receiveIntoBuffer,
+   int nElements)
+{
+  vector<uint8_t> stream;
+  for (int i = 0; i < 16; ++i)
+    stream.insert(stream.end(), encoding.buf(), encoding.buf() + encoding.size());
+
+  int sockets[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+    throw runtime_error("Cannot create the socket pair");
+
+  CountingElementListener listener;
+  DynamicUInt8Vector elementBuffer(1000);
+  struct ndn_ElementReader elementReader;
+  ndn_ElementReader_initialize(&elementReader, &listener, &elementBuffer);
+  vector<uint8_t> receiveBuffer(MAX_NDN_PACKET_SIZE);
+  size_t streamOffset = 0;
+
+  double start = getNowSeconds();
+  while (listener.nElements_ < nElements) {
+    size_t nBytes = min(segmentLength, stream.size() - streamOffset);
+    if (write(sockets[0], &stream[streamOffset], nBytes) != (ssize_t)nBytes)
+      throw runtime_error("Error writing to the socket");
+    streamOffset = (streamOffset + nBytes) % stream.size();
+
+    while (nBytes > 0) {
+      uint8_t *gap = 0;
+      size_t gapLength = 0;
+      if (receiveIntoBuffer)
+        ndn_ElementReader_getReceiveBuffer(&elementReader, &gap, &gapLength);
+
+      ssize_t nReceived;
+      size_t nGapBytes = 0;
+      if (gapLength > 0) {
+        struct iovec ioVectors[2];
+        ioVectors[0].iov_base = gap;
+        ioVectors[0].iov_len = gapLength;
+        ioVectors[1].iov_base = &receiveBuffer[0];
+        ioVectors[1].iov_len = receiveBuffer.size();
+        nReceived = readv(sockets[1], ioVectors, 2);
+        if (nReceived > 0) {
+          nGapBytes = min((size_t)nReceived, gapLength);
+          if (ndn_ElementReader_onReceivedIntoBuffer(&elementReader, nGapBytes))
+            throw runtime_error("Error in onReceivedIntoBuffer");
+        }
+      }
+      else
+        nReceived = recv
+          (sockets[1], &receiveBuffer[0], receiveBuffer.size(), 0);
+      if (nReceived <= 0)
+        throw runtime_error("Error reading from the socket");
+
+      if ((size_t)nReceived > nGapBytes) {
+        if (ndn_ElementReader_onReceivedData
+            (&elementReader, &receiveBuffer[0], nReceived - nGapBytes))
+          throw runtime_error("Error in onReceivedData");
+      }
+      nBytes -= nReceived;
+    }
+  }
+  double finish = getNowSeconds();
+
+  close(sockets[0]);
+  close(sockets[1]);
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nElements = 200000;
+    size_t contentSizes[] = { 1000, 4000, 8000 };
+    // A typical TCP segment size.
+    size_t segmentLength = 1448;
+    for (size_t i = 0; i < sizeof(contentSizes) / sizeof(contentSizes[0]); ++i) {
+      Data data(Name("/ndn/benchmark/element-reader"));
+      data.setContent(Blob(vector<uint8_t>(contentSizes[i], 0x5a)));
+      Blob encoding = data.wireEncode();
+
+      for (int receiveIntoBuffer = 0; receiveIntoBuffer <= 1; ++receiveIntoBuffer) {
+        double duration = benchmarkElementReaderSeconds
+          (encoding, segmentLength, receiveIntoBuffer != 0, nElements);
+        cout << "Reassemble " << encoding.size() << "-byte elements"
+             << (receiveIntoBuffer ? " into buffer" : " with copy")
+             << ": Duration sec, Hz: " << duration << ", "
+             << (nElements / duration) << endl;
+      }
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the cost for FullPSync2017 to process an incoming sync
+ * Interest: get the peer's IBLT from the Interest name and list the difference
+ * with our own IBLT. It compares decoding the peer IBLT and allocating the
+ * difference for each Interest with reusing a decoded peer IBLT and a
+ * difference IBLT.
+ */
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_LIBZ 1.
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_LIBZ
+
+#include <iostream>
+#include <map>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/name.hpp>
+#include <ndn-cpp/lite/util/crypto-lite.hpp>
+#include "../src/sync/detail/invertible-bloom-lookup-table.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+static uint32_t
+makeHash(int i)
+{
+  string prefix = Name("/test/benchmark").appendNumber(i).toUri();
+  return CryptoLite::murmurHash3(11, prefix.data(), prefix.size());
+}
+
+/**
+ * Make our own IBLT with expectedNEntries entries and a peer IBLT which is
+ * missing one of them, then loop to process the peer's sync Interest.
+ * @param expectedNEntries The expected number of entries in the IBLT.
+ * @param nIterations The number of sync Interests to process.
+ * @param useCache If true, reuse the decoded peer IBLT and the difference
+ * IBLT as FullPSync2017 does. If false, decode and allocate for each Interest.
+ * @return The number of seconds for all iterations.
+ */
+static double
+benchmarkSyncInterestSeconds
+  (size_t expectedNEntries, int nIterations, bool useCache)
+{
+  InvertibleBloomLookupTable ownIblt(expectedNEntries);
+  InvertibleBloomLookupTable peerIblt(expectedNEntries);
+  for (size_t i = 0; i < expectedNEntries; ++i) {
+    ownIblt.insert(makeHash(i));
+    if (i > 0)
+      peerIblt.insert(makeHash(i));
+  }
+  Name::Component ibltName(peerIblt.encode());
+
+  map<string, ptr_lib::shared_ptr<InvertibleBloomLookupTable> > peerIblts;
+  InvertibleBloomLookupTable differenceIblt(expectedNEntries);
+  set<uint32_t> positive;
+  set<uint32_t> negative;
+
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i) {
+    if (useCache) {
+      uint8_t digest[ndn_SHA256_DIGEST_SIZE];
+      CryptoLite::digestSha256(ibltName.getValue(), digest);
+      string key((const char*)digest, sizeof(digest));
+      ptr_lib::shared_ptr<InvertibleBloomLookupTable>& iblt = peerIblts[key];
+      if (!iblt) {
+        iblt.reset(new InvertibleBloomLookupTable(expectedNEntries));
+        iblt->initialize(ibltName.getValue());
+      }
+
+      differenceIblt = ownIblt;
+      differenceIblt.subtract(*iblt);
+      if (!differenceIblt.peel(positive, negative))
+        throw runtime_error("Cannot list the IBLT difference");
+    }
+    else {
+      ptr_lib::shared_ptr<InvertibleBloomLookupTable> iblt
+        (new InvertibleBloomLookupTable(expectedNEntries));
+      iblt->initialize(ibltName.getValue());
+
+      if (!ownIblt.difference(*iblt)->listEntries(positive, negative))
+        throw runtime_error("Cannot list the IBLT difference");
+    }
+
+    if (positive.size() != 1 || negative.size() != 0)
+      throw runtime_error("Expected one positive entry");
+    // A sync Interest reply includes our own IBLT in the Data name.
+    ownIblt.encode();
+  }
+  double finish = getNowSeconds();
+
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 2000;
+    size_t sizes[] = { 80, 1000, 10000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+      for (int useCache = 0; useCache <= 1; ++useCache) {
+        double duration = benchmarkSyncInterestSeconds
+          (sizes[i], nIterations, useCache != 0);
+        cout << "Sync Interest with " << sizes[i] << " IBLT entries, "
+             << (useCache ? "reuse decoded IBLT" : "decode each Interest")
+             << ": Duration sec, Hz, usec per Interest: " << duration << ", "
+             << (nIterations / duration) << ", "
+             << (duration * 1000000.0 / nIterations) << endl;
+      }
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
+
+#else // NDN_CPP_HAVE_LIBZ
+
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  cout <<
+    "This program uses zlib but it is not installed. Install it and ./configure again." << endl;
+}
+
+#endif // NDN_CPP_HAVE_LIBZ
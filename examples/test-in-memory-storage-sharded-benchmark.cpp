@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the total rate of finding and inserting Data packets in an
+ * InMemoryStorageSharded from several threads at once. The storage with one
+ * shard has a single lock, which is the same as a producer which funnels every
+ * cache operation through one thread.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <pthread.h>
+#include <ndn-cpp/in-memory-storage/in-memory-storage-sharded.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+static const int N_DATA = 10000;
+
+/**
+ * A Worker holds the Interests for one thread. Each thread answers its
+ * Interests from the storage and inserts a new Data packet for every tenth
+ * Interest.
+ */
+struct Worker {
+  InMemoryStorageSharded* storage;
+  vector<Interest> interests;
+  vector<Data> newData;
+  int nFound;
+};
+
+static void*
+runWorker(void* arg)
+{
+  Worker* worker = (Worker*)arg;
+  worker->nFound = 0;
+  for (size_t i = 0; i < worker->interests.size(); ++i) {
+    if (worker->storage->find(worker->interests[i]))
+      ++worker->nFound;
+    if (i % 10 == 0)
+      worker->storage->insert(worker->newData[i / 10]);
+  }
+
+  return 0;
+}
+
+/**
+ * Fill an InMemoryStorageSharded with N_DATA packets, then start nThreads
+ * threads which each find Data packets for nIterations exact Interests.
+ * @param nShards The number of shards in the storage.
+ * @param nThreads The number of threads.
+ * @param nIterations The number of Interests per thread.
+ * @return The number of seconds for all threads to finish.
+ */
+static double
+benchmarkStorageSeconds(size_t nShards, int nThreads, int nIterations)
+{
+  InMemoryStorageSharded storage(nShards);
+  Blob content((const uint8_t*)"content", 7);
+  for (int i = 0; i < N_DATA; ++i) {
+    Data data(Name("/ndn/benchmark/producer"));
+    data.getName().appendSequenceNumber(i).appendSegment(0);
+    data.setContent(content);
+    storage.insert(data);
+  }
+
+  // Prepare the Interests and Data so that we only measure the storage.
+  vector<Worker> workers(nThreads);
+  for (int t = 0; t < nThreads; ++t) {
+    workers[t].storage = &storage;
+    for (int i = 0; i < nIterations; ++i) {
+      Name name("/ndn/benchmark/producer");
+      name.appendSequenceNumber((i * nThreads + t) % N_DATA).appendSegment(0);
+      Interest interest(name);
+      interest.setCanBePrefix(false);
+      workers[t].interests.push_back(interest);
+
+      if (i % 10 == 0) {
+        Data data(Name("/ndn/benchmark/producer"));
+        data.getName().appendSequenceNumber(N_DATA + i * nThreads + t)
+          .appendSegment(0);
+        data.setContent(content);
+        workers[t].newData.push_back(data);
+      }
+    }
+  }
+
+  vector<pthread_t> threads(nThreads);
+  double start = getNowSeconds();
+  for (int t = 0; t < nThreads; ++t)
+    pthread_create(&threads[t], 0, runWorker, &workers[t]);
+  for (int t = 0; t < nThreads; ++t)
+    pthread_join(threads[t], 0);
+  double finish = getNowSeconds();
+
+  for (int t = 0; t < nThreads; ++t) {
+    if (workers[t].nFound != nIterations)
+      throw runtime_error("Expected to find a Data packet for each Interest");
+  }
+
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 100000;
+    size_t shardCounts[] = { 1, 64 };
+    int threadCounts[] = { 1, 2, 4, 8 };
+    for (size_t i = 0; i < sizeof(shardCounts) / sizeof(shardCounts[0]); ++i) {
+      for (size_t j = 0; j < sizeof(threadCounts) / sizeof(threadCounts[0]); ++j) {
+        double duration = benchmarkStorageSeconds
+          (shardCounts[i], threadCounts[j], nIterations);
+        int nOperations = threadCounts[j] * nIterations;
+        cout << "Find with " << shardCounts[i] << " shards, "
+             << threadCounts[j] << " threads: Duration sec, Hz: " << duration
+             << ", " << (nOperations / duration) << endl;
+      }
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
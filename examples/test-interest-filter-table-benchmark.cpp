@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the rate of dispatching an incoming Interest to the matching
+ * interest filters for different numbers of registered filters.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/interest.hpp>
+#include "../src/impl/interest-filter-table.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+static void
+onInterest
+  (const ptr_lib::shared_ptr<const Name>& prefix,
+   const ptr_lib::shared_ptr<const Interest>& interest, Face& face,
+   uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filter)
+{
+}
+
+/**
+ * Fill an InterestFilterTable with nFilters prefixes, then loop to find the
+ * matching filters for Interests under each prefix.
+ * @param nFilters The number of interest filters in the table.
+ * @param useRegex If true, give every filter the regex filter "<data><>*".
+ * @param nIterations The number of Interests to dispatch.
+ * @return The number of seconds for all iterations.
+ */
+static double
+benchmarkGetMatchedFiltersSeconds(int nFilters, bool useRegex, int nIterations)
+{
+  InterestFilterTable interestFilterTable;
+  for (int i = 0; i < nFilters; ++i) {
+    Name prefix("/ndn/benchmark/producer");
+    prefix.appendSequenceNumber(i);
+    ptr_lib::shared_ptr<InterestFilter> filter(useRegex ?
+      new InterestFilter(prefix, "<data><>*") : new InterestFilter(prefix));
+    interestFilterTable.setInterestFilter(i + 1, filter, onInterest, 0);
+  }
+
+  // Prepare the Interests so that we only measure the table operations.
+  vector<ptr_lib::shared_ptr<Interest> > interests;
+  for (int i = 0; i < nFilters; ++i) {
+    Name name("/ndn/benchmark/producer");
+    name.appendSequenceNumber(i).append("data").appendSegment(0);
+    interests.push_back(ptr_lib::make_shared<Interest>(name));
+  }
+
+  vector<ptr_lib::shared_ptr<InterestFilterTable::Entry> > matchedFilters;
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i) {
+    matchedFilters.clear();
+    interestFilterTable.getMatchedFilters
+      (*interests[i % nFilters], matchedFilters);
+    if (matchedFilters.size() != 1)
+      throw runtime_error("Expected one matching interest filter");
+  }
+  double finish = getNowSeconds();
+
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 200000;
+    int sizes[] = { 10, 100, 1000, 10000 };
+    for (int useRegex = 0; useRegex <= 1; ++useRegex) {
+      for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double duration = benchmarkGetMatchedFiltersSeconds
+          (sizes[i], useRegex != 0, nIterations);
+        cout << "Dispatch Interest with " << sizes[i]
+             << (useRegex ? " regex" : " prefix")
+             << " filters: Duration sec, Hz: " << duration << ", "
+             << (nIterations / duration) << endl;
+      }
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the rate of answering Interests from a MemoryContentCache for
+ * different numbers of cached Data packets.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/util/memory-content-cache.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * BenchmarkFace extends Face to remember the OnInterestCallback from
+ * setInterestFilter and to count the packets sent by the MemoryContentCache
+ * without a connection to the forwarder.
+ */
+class BenchmarkFace : public Face {
+public:
+  BenchmarkFace()
+  : Face("localhost"), nSent_(0)
+  {
+  }
+
+  virtual uint64_t
+  setInterestFilter(const Name& prefix, const OnInterestCallback& onInterest)
+  {
+    prefix_ = ptr_lib::make_shared<Name>(prefix);
+    onInterest_ = onInterest;
+    return 1;
+  }
+
+  virtual void
+  send(const uint8_t *encoding, size_t encodingLength) { ++nSent_; }
+
+  ptr_lib::shared_ptr<Name> prefix_;
+  OnInterestCallback onInterest_;
+  int nSent_;
+};
+
+/**
+ * Fill a MemoryContentCache with nData segments of freshness-limited Data,
+ * then loop to answer an Interest for each of them.
+ * @param nData The number of Data packets in the cache.
+ * @param canBePrefix If true, the Interests omit the segment component and
+ * set CanBePrefix. Otherwise each Interest has the exact Data name.
+ * @param nIterations The number of Interests to answer.
+ * @return The number of seconds for all iterations.
+ */
+static double
+benchmarkOnInterestSeconds(int nData, bool canBePrefix, int nIterations)
+{
+  BenchmarkFace face;
+  MemoryContentCache cache(&face, 1000000.0);
+  cache.setInterestFilter(Name("/ndn/benchmark"));
+
+  Blob content((const uint8_t*)"content", 7);
+  for (int i = 0; i < nData; ++i) {
+    Data data(Name("/ndn/benchmark/producer"));
+    data.getName().appendSequenceNumber(i).appendSegment(0);
+    data.setContent(content);
+    data.getMetaInfo().setFreshnessPeriod(1000000.0);
+    cache.add(data);
+  }
+
+  // Prepare the Interests so that we only measure the cache operations.
+  vector<ptr_lib::shared_ptr<const Interest> > interests;
+  for (int i = 0; i < nData; ++i) {
+    ptr_lib::shared_ptr<Interest> interest
+      (new Interest(Name("/ndn/benchmark/producer")));
+    interest->getName().appendSequenceNumber(i);
+    if (!canBePrefix)
+      interest->getName().appendSegment(0);
+    interest->setCanBePrefix(canBePrefix);
+    interests.push_back(interest);
+  }
+
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i)
+    face.onInterest_
+      (face.prefix_, interests[i % nData], face, 1,
+       ptr_lib::shared_ptr<InterestFilter>());
+  double finish = getNowSeconds();
+
+  if (face.nSent_ != nIterations)
+    throw runtime_error("Expected a Data packet for each Interest");
+
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 100000;
+    int sizes[] = { 100, 1000, 10000, 100000 };
+    for (int canBePrefix = 0; canBePrefix <= 1; ++canBePrefix) {
+      for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        double duration = benchmarkOnInterestSeconds
+          (sizes[i], canBePrefix != 0, nIterations);
+        cout << "Answer " << (canBePrefix ? "CanBePrefix" : "exact")
+             << " Interest from " << sizes[i]
+             << " cached Data: Duration sec, Hz: " << duration << ", "
+             << (nIterations / duration) << endl;
+      }
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This counts the heap allocations and measures the rate of common Name
+ * operations on a typical name with short components, a version and a
+ * segment number. It replaces the global operator new to count the
+ * allocations.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/name.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static size_t nAllocations = 0;
+
+void*
+operator new(size_t size)
+{
+  ++nAllocations;
+  void* result = malloc(size > 0 ? size : 1);
+  if (!result)
+    throw bad_alloc();
+  return result;
+}
+
+void
+operator delete(void* pointer) throw()
+{
+  free(pointer);
+}
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * Print the allocations per iteration and the rate.
+ * @param label The label for the output.
+ * @param startAllocations The value of nAllocations before the iterations.
+ * @param start The start time in seconds.
+ * @param nIterations The number of iterations.
+ */
+static void
+printResult
+  (const string& label, size_t startAllocations, double start, int nIterations)
+{
+  double duration = getNowSeconds() - start;
+  cout << label << ": Allocations per operation " <<
+    (double)(nAllocations - startAllocations) / nIterations <<
+    ", Duration sec, Hz: " << duration << ", " << (nIterations / duration) <<
+    endl;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 1000000;
+
+    Name name("/ndn/edu/ucla/remap/video/camera1");
+    name.appendVersion(1580000000000ULL).appendSegment(42);
+    Blob encoding = name.wireEncode();
+    // Count the name sizes so that the compiler doesn't skip the operations.
+    size_t total = 0;
+
+    {
+      size_t startAllocations = nAllocations;
+      double start = getNowSeconds();
+      for (int i = 0; i < nIterations; ++i) {
+        Name decodedName;
+        decodedName.wireDecode(encoding);
+        total += decodedName.size();
+      }
+      printResult("Decode Name", startAllocations, start, nIterations);
+    }
+
+    {
+      size_t startAllocations = nAllocations;
+      double start = getNowSeconds();
+      for (int i = 0; i < nIterations; ++i) {
+        Name copy(name);
+        total += copy.size();
+      }
+      printResult("Copy Name", startAllocations, start, nIterations);
+    }
+
+    {
+      size_t startAllocations = nAllocations;
+      double start = getNowSeconds();
+      for (int i = 0; i < nIterations; ++i)
+        total += name.getPrefix(-1).size();
+      printResult("Name getPrefix(-1)", startAllocations, start, nIterations);
+    }
+
+    {
+      size_t startAllocations = nAllocations;
+      double start = getNowSeconds();
+      for (int i = 0; i < nIterations; ++i) {
+        Name segmentName(name.getPrefix(-1));
+        segmentName.appendSegment(i);
+        total += segmentName.size();
+      }
+      printResult("Name appendSegment", startAllocations, start, nIterations);
+    }
+
+    if (total == 0)
+      throw runtime_error("Unexpected total name size");
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
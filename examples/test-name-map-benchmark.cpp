@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This compares the rate of looking up a Name in a std::map and in a
+ * std::unordered_map with Name::Hash, where the map has 1M entries.
+ */
+
+#include <iostream>
+#include <map>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/name.hpp>
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+#include <unordered_map>
+#endif
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * Look up each name in the map.
+ * @param nameMap The std::map or std::unordered_map to search.
+ * @param names The names to look up, which must all be in nameMap.
+ * @return The number of seconds for all the lookups.
+ */
+template<class NameMap> static double
+benchmarkFindSeconds(const NameMap& nameMap, const vector<Name>& names)
+{
+  size_t total = 0;
+  double start = getNowSeconds();
+  for (size_t i = 0; i < names.size(); ++i) {
+    typename NameMap::const_iterator entry = nameMap.find(names[i]);
+    if (entry == nameMap.end())
+      throw runtime_error("Expected to find the name");
+    total += entry->second;
+  }
+  double duration = getNowSeconds() - start;
+
+  if (total == 0)
+    throw runtime_error("Unexpected total");
+  return duration;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    const size_t nEntries = 1000000;
+
+    // Use names like sync or certificate names with a common prefix.
+    vector<Name> names;
+    names.reserve(nEntries);
+    for (size_t i = 0; i < nEntries; ++i) {
+      Name name("/ndn/edu/ucla/remap/sync");
+      name.append("user" + to_string(i % 1000)).appendSequenceNumber(i);
+      names.push_back(name);
+    }
+
+    // Look up copies of the names so that the hash codes are not already
+    // cached. This is like looking up a name from a received packet.
+    vector<Name> lookupNames(names);
+
+    {
+      map<Name, size_t> nameMap;
+      for (size_t i = 0; i < nEntries; ++i)
+        nameMap[names[i]] = i + 1;
+
+      double duration = benchmarkFindSeconds(nameMap, lookupNames);
+      cout << "std::map find with " << nEntries <<
+        " entries: Duration sec, Hz: " << duration << ", " <<
+        (nEntries / duration) << endl;
+    }
+
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+    {
+      unordered_map<Name, size_t, Name::Hash> nameMap;
+      nameMap.reserve(nEntries);
+      for (size_t i = 0; i < nEntries; ++i)
+        nameMap[names[i]] = i + 1;
+
+      lookupNames = names;
+      double duration = benchmarkFindSeconds(nameMap, lookupNames);
+      cout << "std::unordered_map find with " << nEntries <<
+        " entries: Duration sec, Hz: " << duration << ", " <<
+        (nEntries / duration) << endl;
+
+      // Now the hash codes of lookupNames are cached.
+      duration = benchmarkFindSeconds(nameMap, lookupNames);
+      cout << "std::unordered_map find with cached hash: Duration sec, Hz: " <<
+        duration << ", " << (nEntries / duration) << endl;
+    }
+#endif
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the cost of matching an incoming Data packet in the pending
+ * interest table for different numbers of pending interests.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/data.hpp>
+#include "../src/impl/pending-interest-table.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+static void
+onData(const ptr_lib::shared_ptr<const Interest>& interest,
+       const ptr_lib::shared_ptr<Data>& data)
+{
+}
+
+static ptr_lib::shared_ptr<const Interest>
+makeInterest(int objectNumber)
+{
+  ptr_lib::shared_ptr<Interest> interest(new Interest
+    (Name("/ndn/benchmark/fetch").appendSequenceNumber(objectNumber)
+     .appendSegment(0)));
+  interest->setCanBePrefix(false);
+  return interest;
+}
+
+/**
+ * Fill a PendingInterestTable with nEntries, then loop to satisfy each entry
+ * with a matching Data packet and add the entry again so that the table size
+ * stays the same.
+ * @param nEntries The number of entries in the pending interest table.
+ * @param nIterations The number of Data packets to match.
+ * @return The number of seconds for all iterations.
+ */
+static double
+benchmarkMatchDataSeconds(int nEntries, int nIterations)
+{
+  PendingInterestTable pendingInterestTable;
+  uint64_t pendingInterestId = 0;
+  for (int i = 0; i < nEntries; ++i)
+    pendingInterestTable.add
+      (++pendingInterestId, makeInterest(i), onData, OnTimeout(),
+       OnNetworkNack());
+
+  // Prepare the Data packets so that we only measure the table operations.
+  vector<ptr_lib::shared_ptr<Data> > dataList;
+  for (int i = 0; i < nEntries; ++i)
+    dataList.push_back(ptr_lib::make_shared<Data>
+      (makeInterest(i)->getName()));
+
+  vector<ptr_lib::shared_ptr<PendingInterestTable::Entry> > entries;
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i) {
+    int objectNumber = i % nEntries;
+    entries.clear();
+    pendingInterestTable.extractEntriesForExpressedInterest
+      (*dataList[objectNumber], entries);
+    if (entries.size() != 1)
+      throw runtime_error("Expected one matching pending interest");
+
+    pendingInterestTable.add
+      (++pendingInterestId, entries[0]->getInterest(), onData, OnTimeout(),
+       OnNetworkNack());
+  }
+  double finish = getNowSeconds();
+
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 200000;
+    int sizes[] = { 10, 100, 1000, 10000, 50000 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+      double duration = benchmarkMatchDataSeconds(sizes[i], nIterations);
+      cout << "Match Data in PIT with " << sizes[i]
+           << " entries: Duration sec, Hz, usec per Data: " << duration << ", "
+           << (nIterations / duration) << ", "
+           << (duration * 1000000.0 / nIterations) << endl;
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
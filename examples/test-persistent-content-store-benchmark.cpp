@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This compares the time for a producer to restart by signing its Data packets
+ * again and adding them to a MemoryContentCache, with the time to reopen a
+ * PersistentContentStore which already has the signed Data packets. Then it
+ * measures the rate of answering Interests from each.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <stdio.h>
+#include <ndn-cpp/security/key-chain.hpp>
+#include <ndn-cpp/util/memory-content-cache.hpp>
+#include <ndn-cpp/util/persistent-content-store.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * BenchmarkFace extends Face to remember the OnInterestCallback from
+ * setInterestFilter and to count the packets sent without a connection to the
+ * forwarder.
+ */
+class BenchmarkFace : public Face {
+public:
+  BenchmarkFace()
+  : Face("localhost"), nSent_(0)
+  {
+  }
+
+  virtual uint64_t
+  setInterestFilter(const Name& prefix, const OnInterestCallback& onInterest)
+  {
+    prefix_ = ptr_lib::make_shared<Name>(prefix);
+    onInterest_ = onInterest;
+    return 1;
+  }
+
+  virtual void
+  send(const uint8_t *encoding, size_t encodingLength) { ++nSent_; }
+
+  ptr_lib::shared_ptr<Name> prefix_;
+  OnInterestCallback onInterest_;
+  int nSent_;
+};
+
+static const int N_DATA = 20000;
+static const size_t CONTENT_SIZE = 4000;
+
+static Data
+makeData(int i)
+{
+  Data data(Name("/ndn/benchmark/producer"));
+  data.getName().appendSequenceNumber(i).appendSegment(0);
+  data.setContent(Blob(vector<uint8_t>(CONTENT_SIZE, (uint8_t)i)));
+  return data;
+}
+
+/**
+ * Loop to answer an exact Interest for each Data packet.
+ * @param face The BenchmarkFace whose onInterest_ answers the Interests.
+ * @param nIterations The number of Interests to answer.
+ * @return The number of seconds for all iterations.
+ */
+static double
+benchmarkOnInterestSeconds(BenchmarkFace& face, int nIterations)
+{
+  // Prepare the Interests so that we only measure the answers.
+  vector<ptr_lib::shared_ptr<const Interest> > interests;
+  for (int i = 0; i < N_DATA; ++i) {
+    ptr_lib::shared_ptr<Interest> interest(new Interest(makeData(i).getName()));
+    interest->setCanBePrefix(false);
+    interests.push_back(interest);
+  }
+
+  face.nSent_ = 0;
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i)
+    face.onInterest_
+      (face.prefix_, interests[i % N_DATA], face, 1,
+       ptr_lib::shared_ptr<InterestFilter>());
+  double finish = getNowSeconds();
+
+  if (face.nSent_ != nIterations)
+    throw runtime_error("Expected a Data packet for each Interest");
+
+  return finish - start;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 200000;
+    string filePath = "test-persistent-content-store-benchmark.dat";
+    remove(filePath.c_str());
+    remove((filePath + ".index").c_str());
+
+    KeyChain keyChain("pib-memory:", "tpm-memory:");
+    keyChain.createIdentityV2(Name("/ndn/benchmark/producer"));
+
+    {
+      // Fill the store which we reopen below.
+      PersistentContentStore store(filePath);
+      for (int i = 0; i < N_DATA; ++i) {
+        Data data = makeData(i);
+        keyChain.sign(data);
+        store.add(data);
+      }
+    }
+
+    {
+      BenchmarkFace face;
+      MemoryContentCache cache(&face, 1000000.0);
+      double start = getNowSeconds();
+      for (int i = 0; i < N_DATA; ++i) {
+        Data data = makeData(i);
+        keyChain.sign(data);
+        cache.add(data);
+      }
+      double duration = getNowSeconds() - start;
+      cout << "Restart by signing " << N_DATA
+           << " Data into MemoryContentCache: Duration sec: " << duration << endl;
+
+      cache.setInterestFilter(Name("/ndn/benchmark"));
+      duration = benchmarkOnInterestSeconds(face, nIterations);
+      cout << "Answer exact Interest from MemoryContentCache: Duration sec, Hz: "
+           << duration << ", " << (nIterations / duration) << endl;
+    }
+
+    {
+      BenchmarkFace face;
+      double start = getNowSeconds();
+      PersistentContentStore store(filePath);
+      double duration = getNowSeconds() - start;
+      if (store.size() != N_DATA)
+        throw runtime_error("Expected to reopen all the Data packets");
+      cout << "Restart by reopening PersistentContentStore with " << N_DATA
+           << " Data: Duration sec: " << duration << endl;
+
+      store.setInterestFilter(face, Name("/ndn/benchmark"));
+      duration = benchmarkOnInterestSeconds(face, nIterations);
+      cout << "Answer exact Interest from PersistentContentStore: Duration sec, Hz: "
+           << duration << ", " << (nIterations / duration) << endl;
+    }
+
+    remove(filePath.c_str());
+    remove((filePath + ".index").c_str());
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the rate of verifying Data packets signed by the same
+ * certificate, where VerificationHelpers decodes the public key for each
+ * packet, and where a PublicKeyCache keeps the decoded key. It uses an RSA key
+ * and an EC key.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/security/key-chain.hpp>
+#include <ndn-cpp/security/verification-helpers.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * Sign nPackets Data packets with the key and verify them nIterations times,
+ * without and with a PublicKeyCache. Print the verification rates.
+ * @param label The label for the output.
+ * @param keyChain The KeyChain for signing.
+ * @param keyParams The parameters for the identity's key.
+ * @param nPackets The number of Data packets to sign.
+ * @param nIterations The number of times to verify all the packets.
+ */
+static void
+benchmarkVerify
+  (const string& label, KeyChain& keyChain, const KeyParams& keyParams,
+   size_t nPackets, int nIterations)
+{
+  ptr_lib::shared_ptr<PibIdentity> identity = keyChain.createIdentityV2
+    (Name("/ndn/benchmark").append(label), keyParams);
+  CertificateV2 certificate
+    (*identity->getDefaultKey()->getDefaultCertificate());
+
+  vector<ptr_lib::shared_ptr<Data> > packets;
+  for (size_t i = 0; i < nPackets; ++i) {
+    ptr_lib::shared_ptr<Data> data(new Data
+      (Name("/ndn/benchmark/producer").appendSegment(i)));
+    data->setContent(Blob(vector<uint8_t>(1000, (uint8_t)i)));
+    keyChain.sign(*data, SigningInfo(identity));
+    // Encode so that the benchmark only measures the verification.
+    data->wireEncode();
+    packets.push_back(data);
+  }
+
+  size_t nVerified = 0;
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i) {
+    for (size_t j = 0; j < packets.size(); ++j) {
+      if (VerificationHelpers::verifyDataSignature(*packets[j], certificate))
+        ++nVerified;
+    }
+  }
+  double duration = getNowSeconds() - start;
+  size_t nVerifies = nPackets * nIterations;
+  cout << label << " verify, decode key each time: Duration sec, Hz: " <<
+    duration << ", " << (nVerifies / duration) << endl;
+
+  PublicKeyCache publicKeyCache;
+  start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i) {
+    for (size_t j = 0; j < packets.size(); ++j) {
+      if (VerificationHelpers::verifyDataSignature
+          (*packets[j], certificate, publicKeyCache))
+        ++nVerified;
+    }
+  }
+  duration = getNowSeconds() - start;
+  cout << label << " verify, PublicKeyCache: Duration sec, Hz: " <<
+    duration << ", " << (nVerifies / duration) << endl;
+
+  if (nVerified != 2 * nVerifies)
+    throw runtime_error("Verification failed");
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    KeyChain keyChain("pib-memory:", "tpm-memory:");
+
+    benchmarkVerify("RSA", keyChain, RsaKeyParams(), 100, 200);
+    benchmarkVerify("EC", keyChain, EcKeyParams(), 100, 100);
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
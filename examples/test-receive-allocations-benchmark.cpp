@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This counts the heap allocations per packet which the Face makes to receive
+ * an Interest or Data packet, and measures the receive rate. It replaces the
+ * global operator new to count the allocations, and uses a Transport which
+ * delivers prepared packets to the Face without a socket.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <ndn-cpp/face.hpp>
+#include <ndn-cpp/sha256-with-rsa-signature.hpp>
+#include "../src/encoding/element-listener.hpp"
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+static size_t nAllocations = 0;
+
+void*
+operator new(size_t size)
+{
+  ++nAllocations;
+  void* result = malloc(size > 0 ? size : 1);
+  if (!result)
+    throw bad_alloc();
+  return result;
+}
+
+void
+operator delete(void* pointer) throw()
+{
+  free(pointer);
+}
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * A BenchmarkTransport delivers each packet in packets_ to the element
+ * listener when processEvents is called, and ignores packets which are sent.
+ */
+class BenchmarkTransport : public Transport {
+public:
+  class ConnectionInfo : public Transport::ConnectionInfo {
+  };
+
+  BenchmarkTransport()
+  : elementListener_(0)
+  {
+  }
+
+  virtual bool
+  isLocal(const Transport::ConnectionInfo& connectionInfo) { return true; }
+
+  virtual bool
+  isAsync() { return false; }
+
+  virtual void
+  connect
+    (const Transport::ConnectionInfo& connectionInfo,
+     ElementListener& elementListener, const OnConnected& onConnected)
+  {
+    elementListener_ = &elementListener;
+    if (onConnected)
+      onConnected();
+  }
+
+  virtual void
+  send(const uint8_t *data, size_t dataLength) {}
+
+  virtual void
+  processEvents()
+  {
+    for (size_t i = 0; i < packets_.size(); ++i)
+      elementListener_->onReceivedElement(packets_[i].buf(), packets_[i].size());
+  }
+
+  virtual bool
+  getIsConnected() { return elementListener_ != 0; }
+
+  vector<Blob> packets_;
+
+private:
+  ElementListener* elementListener_;
+};
+
+static void
+onInterest
+  (const ptr_lib::shared_ptr<const Name>& prefix,
+   const ptr_lib::shared_ptr<const Interest>& interest, Face& face,
+   uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filter, int* nInterests)
+{
+  ++(*nInterests);
+}
+
+static void
+onData
+  (const ptr_lib::shared_ptr<const Interest>& interest,
+   const ptr_lib::shared_ptr<Data>& data)
+{
+}
+
+/**
+ * Make the encoding of an LpPacket with an IncomingFaceId header field and the
+ * fragment.
+ */
+static Blob
+makeLpPacket(const Blob& fragment)
+{
+  // LpPacket(100), IncomingFaceId(812) with value 1, Fragment(80).
+  vector<uint8_t> value;
+  const uint8_t incomingFaceId[] = { 0xfd, 0x03, 0x2c, 0x01, 0x01 };
+  value.insert(value.end(), incomingFaceId, incomingFaceId + sizeof(incomingFaceId));
+  value.push_back(80);
+  value.push_back(0xfd);
+  value.push_back((uint8_t)(fragment.size() >> 8));
+  value.push_back((uint8_t)fragment.size());
+  value.insert(value.end(), fragment.buf(), fragment.buf() + fragment.size());
+
+  vector<uint8_t> encoding;
+  encoding.push_back(100);
+  encoding.push_back(0xfd);
+  encoding.push_back((uint8_t)(value.size() >> 8));
+  encoding.push_back((uint8_t)value.size());
+  encoding.insert(encoding.end(), value.begin(), value.end());
+  return Blob(encoding);
+}
+
+/**
+ * Receive the packets nIterations times and print the allocations per packet
+ * and the receive rate.
+ * @param label The label for the output.
+ * @param packets The packets to receive.
+ * @param nIterations The number of times to receive all the packets.
+ */
+static void
+benchmarkReceive(const string& label, const vector<Blob>& packets, int nIterations)
+{
+  ptr_lib::shared_ptr<BenchmarkTransport> transport(new BenchmarkTransport());
+  Face face(transport, ptr_lib::make_shared<BenchmarkTransport::ConnectionInfo>());
+  int nInterests = 0;
+  face.setInterestFilter
+    (Name("/ndn/benchmark"), bind(&onInterest, _1, _2, _3, _4, _5, &nInterests));
+  // Express an Interest so that the Face connects to the transport. Its name
+  // doesn't match the received Data packets.
+  Interest connectInterest(Name("/connect"));
+  connectInterest.setCanBePrefix(false);
+  face.expressInterest(connectInterest, &onData);
+  transport->packets_ = packets;
+
+  // Receive once so that the Face has its initial allocations.
+  face.processEvents();
+
+  size_t startAllocations = nAllocations;
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i)
+    face.processEvents();
+  double finish = getNowSeconds();
+  size_t nPackets = packets.size() * nIterations;
+  double duration = finish - start;
+
+  cout << label << ": Allocations per packet " <<
+    (double)(nAllocations - startAllocations) / nPackets <<
+    ", Duration sec, Hz: " << duration << ", " << (nPackets / duration) << endl;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nIterations = 20000;
+    const size_t nPackets = 10;
+
+    vector<Blob> interests;
+    vector<Blob> data;
+    vector<Blob> lpData;
+    uint8_t signatureBits[256] = {0};
+    for (size_t i = 0; i < nPackets; ++i) {
+      Interest interest(Name("/ndn/benchmark/producer"));
+      interest.getName().appendSequenceNumber(i).appendSegment(0);
+      interest.setCanBePrefix(false);
+      interest.setInterestLifetimeMilliseconds(4000);
+      interests.push_back(interest.wireEncode());
+
+      Data packet(interest.getName());
+      packet.setContent(Blob(vector<uint8_t>(1000, (uint8_t)i)));
+      packet.getMetaInfo().setFreshnessPeriod(10000);
+      Sha256WithRsaSignature* signature =
+        (Sha256WithRsaSignature*)packet.getSignature();
+      signature->getKeyLocator().setType(ndn_KeyLocatorType_KEYNAME);
+      signature->getKeyLocator().setKeyName
+        (Name("/ndn/benchmark/producer/KEY/1234"));
+      signature->setSignature(Blob(signatureBits, sizeof(signatureBits)));
+      data.push_back(packet.wireEncode());
+      lpData.push_back(makeLpPacket(packet.wireEncode()));
+    }
+
+    benchmarkReceive("Receive Interest", interests, nIterations);
+    benchmarkReceive("Receive Data", data, nIterations);
+    benchmarkReceive("Receive Data in LpPacket", lpData, nIterations);
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the throughput of SegmentFetcher over a simulated link to an
+ * in-process producer. The link has a fixed round-trip time and a bottleneck
+ * which serves one segment at a time with a bounded queue. Interests which
+ * overflow the queue are dropped, and Data which waited in the queue longer
+ * than a threshold gets a CongestionMark, like a forwarder with active queue
+ * management. This compares a window of one segment (one segment per RTT), a
+ * fixed window, and the AIMD window with and without congestion marks.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <unistd.h>
+#include <sys/time.h>
+#include <ndn-cpp/util/segment-fetcher.hpp>
+#include <ndn-cpp/lite/lp/lp-packet-lite.hpp>
+#include <ndn-cpp/lite/encoding/tlv-0_2-wire-format-lite.hpp>
+#include "../src/lp/lp-packet.hpp"
+#include "../src/impl/delayed-call-table.hpp"
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+static double
+getNowMilliseconds() { return getNowSeconds() * 1000.0; }
+
+static const uint8_t CONGESTION_MARK_LP_PACKET[] = {
+  0x64, 0x05, // LpPacket
+    0xfd, 0x03, 0x40, 0x01, 0x01 // CongestionMark = 1
+};
+
+/**
+ * LinkFace extends Face to answer Interests from the segments of one object
+ * after the delay of a simulated link, as described above.
+ */
+class LinkFace : public Face
+{
+public:
+  /**
+   * Create a LinkFace with the segments of the object.
+   * @param prefix The name prefix of the object.
+   * @param nSegments The number of segments.
+   * @param segmentSize The content size of each segment.
+   * @param rtt The round-trip time of the link in milliseconds.
+   * @param serviceTime The time for the bottleneck to send one segment in
+   * milliseconds.
+   * @param queueLimit The number of segments which can wait in the queue
+   * before an Interest is dropped.
+   * @param markQueueLimit The number of segments in the queue after which
+   * Data gets a CongestionMark. If this is 0, don't mark.
+   */
+  LinkFace
+    (const Name& prefix, int nSegments, size_t segmentSize, double rtt,
+     double serviceTime, int queueLimit, int markQueueLimit)
+  : Face("localhost"), nDropped_(0), nMarked_(0), rtt_(rtt),
+    serviceTime_(serviceTime), queueLimit_(queueLimit),
+    markQueueLimit_(markQueueLimit), nextServiceTime_(0),
+    lastPendingInterestId_(0), lastCallLaterId_(0)
+  {
+    Name versionedName(prefix);
+    versionedName.appendVersion(1);
+    vector<uint8_t> content(segmentSize, 0x5a);
+    for (int i = 0; i < nSegments; ++i) {
+      ptr_lib::shared_ptr<Data> data(new Data(Name(versionedName).appendSegment(i)));
+      data->setContent(content);
+      data->getMetaInfo().setFinalBlockId(Name::Component::fromSegment(nSegments - 1));
+      segments_.push_back(data);
+    }
+
+    struct ndn_LpPacketHeaderField headerFields[5];
+    LpPacketLite lpPacketLite
+      (headerFields, sizeof(headerFields) / sizeof(headerFields[0]));
+    Tlv0_2WireFormatLite::decodeLpPacket
+      (lpPacketLite, CONGESTION_MARK_LP_PACKET, sizeof(CONGESTION_MARK_LP_PACKET));
+    congestionMarkLpPacket_.reset(new LpPacket());
+    congestionMarkLpPacket_->set(lpPacketLite);
+  }
+
+  virtual uint64_t
+  expressInterest
+    (const Interest& interest, const OnData& onData,
+     const OnTimeout& onTimeout, const OnNetworkNack& onNetworkNack,
+     WireFormat& wireFormat = *WireFormat::getDefaultWireFormat())
+  {
+    uint64_t pendingInterestId = ++lastPendingInterestId_;
+    PendingInterest& entry = pendingInterests_[pendingInterestId];
+    entry.interest.reset(new Interest(interest));
+    entry.onData = onData;
+    entry.onTimeout = onTimeout;
+
+    double now = getNowMilliseconds();
+    double arrivalTime = now + rtt_ / 2;
+    double startTime = max(arrivalTime, nextServiceTime_);
+    int queueLength = (int)((startTime - arrivalTime) / serviceTime_);
+    entry.isMarked = false;
+    if (queueLength >= queueLimit_) {
+      // Drop the Interest so that it times out.
+      entry.isDropped = true;
+      entry.eventTime = now + interest.getInterestLifetimeMilliseconds();
+      ++nDropped_;
+    }
+    else {
+      entry.isDropped = false;
+      nextServiceTime_ = startTime + serviceTime_;
+      entry.eventTime = nextServiceTime_ + rtt_ / 2;
+      if (markQueueLimit_ > 0 && queueLength >= markQueueLimit_) {
+        entry.isMarked = true;
+        ++nMarked_;
+      }
+    }
+
+    return pendingInterestId;
+  }
+
+  virtual void
+  removePendingInterest(uint64_t pendingInterestId)
+  {
+    pendingInterests_.erase(pendingInterestId);
+  }
+
+  virtual uint64_t
+  callLater(Milliseconds delayMilliseconds, const Face::Callback& callback)
+  {
+    uint64_t callLaterId = ++lastCallLaterId_;
+    delayedCallTable_.callLater(callLaterId, delayMilliseconds, callback);
+    return callLaterId;
+  }
+
+  virtual void
+  cancelCallLater(uint64_t callLaterId)
+  {
+    delayedCallTable_.cancelCallLater(callLaterId);
+  }
+
+  virtual void
+  processEvents()
+  {
+    delayedCallTable_.callTimedOut();
+
+    double now = getNowMilliseconds();
+    vector<uint64_t> dueIds;
+    for (map<uint64_t, PendingInterest>::iterator entry = pendingInterests_.begin();
+         entry != pendingInterests_.end(); ++entry) {
+      if (entry->second.eventTime <= now)
+        dueIds.push_back(entry->first);
+    }
+
+    for (size_t i = 0; i < dueIds.size(); ++i) {
+      map<uint64_t, PendingInterest>::iterator entry =
+        pendingInterests_.find(dueIds[i]);
+      if (entry == pendingInterests_.end())
+        continue;
+      PendingInterest pendingInterest = entry->second;
+      pendingInterests_.erase(entry);
+
+      if (pendingInterest.isDropped) {
+        pendingInterest.onTimeout(pendingInterest.interest);
+        continue;
+      }
+
+      const Name& name = pendingInterest.interest->getName();
+      // The discovery Interest gets segment 0.
+      uint64_t segment = name.get(-1).isSegment() ? name.get(-1).toSegment() : 0;
+      if (segment >= segments_.size())
+        // No such segment. Let the fetcher time out.
+        continue;
+
+      ptr_lib::shared_ptr<Data> data = segments_[segment];
+      if (pendingInterest.isMarked) {
+        data.reset(new Data(*data));
+        data->setLpPacket(congestionMarkLpPacket_);
+      }
+      pendingInterest.onData(pendingInterest.interest, data);
+    }
+  }
+
+  int nDropped_;
+  int nMarked_;
+
+private:
+  class PendingInterest {
+  public:
+    ptr_lib::shared_ptr<Interest> interest;
+    OnData onData;
+    OnTimeout onTimeout;
+    bool isDropped;
+    bool isMarked;
+    // The time to call onData, or onTimeout if isDropped.
+    double eventTime;
+  };
+
+  double rtt_;
+  double serviceTime_;
+  int queueLimit_;
+  int markQueueLimit_;
+  double nextServiceTime_;
+  vector<ptr_lib::shared_ptr<Data> > segments_;
+  ptr_lib::shared_ptr<LpPacket> congestionMarkLpPacket_;
+  map<uint64_t, PendingInterest> pendingInterests_;
+  DelayedCallTable delayedCallTable_;
+  uint64_t lastPendingInterestId_;
+  uint64_t lastCallLaterId_;
+};
+
+static void
+onComplete(const Blob& content, bool* isDone, size_t* contentSize)
+{
+  *isDone = true;
+  *contentSize = content.size();
+}
+
+static void
+onError
+  (SegmentFetcher::ErrorCode errorCode, const string& message, bool* isDone)
+{
+  cout << "Error " << errorCode << ": " << message << endl;
+  *isDone = true;
+}
+
+static void
+benchmarkSegmentFetcher
+  (const char* label, const SegmentFetcher::Options& options, int nSegments,
+   size_t segmentSize, int markQueueLimit)
+{
+  const double rtt = 10;
+  const double serviceTime = 0.25;
+  const int queueLimit = 64;
+  Name prefix("/benchmark/object");
+  LinkFace face
+    (prefix, nSegments, segmentSize, rtt, serviceTime, queueLimit,
+     markQueueLimit);
+
+  bool isDone = false;
+  size_t contentSize = 0;
+  Interest interest(prefix);
+  interest.setInterestLifetimeMilliseconds(1000);
+
+  double start = getNowSeconds();
+  SegmentFetcher::fetch
+    (face, interest, SegmentFetcher::DontVerifySegment,
+     bind(&onComplete, _1, &isDone, &contentSize),
+     bind(&onError, _1, _2, &isDone), options);
+  while (!isDone) {
+    face.processEvents();
+    usleep(50);
+  }
+  double duration = getNowSeconds() - start;
+
+  cout << label << ": " << nSegments << " segments of " << segmentSize <<
+    " bytes, RTT " << rtt << " ms, link " <<
+    (segmentSize / serviceTime / 1000.0) << " MB/s" << endl;
+  cout << "  Duration sec, segments/sec, MB/s: " << duration << ", " <<
+    (nSegments / duration) << ", " << (contentSize / duration / 1e6) <<
+    ", dropped " << face.nDropped_ << ", marked " << face.nMarked_ << endl;
+}
+
+int
+main(int argc, char** argv)
+{
+  const size_t segmentSize = 8000;
+
+  benchmarkSegmentFetcher
+    ("Window of 1",
+     SegmentFetcher::Options().setUseConstantCwnd(true).setInitCwnd(1),
+     200, segmentSize, 0);
+  benchmarkSegmentFetcher
+    ("Constant window of 16",
+     SegmentFetcher::Options().setUseConstantCwnd(true).setInitCwnd(16),
+     4000, segmentSize, 0);
+  benchmarkSegmentFetcher
+    ("AIMD with drops", SegmentFetcher::Options(), 4000, segmentSize, 0);
+  benchmarkSegmentFetcher
+    ("AIMD with congestion marks", SegmentFetcher::Options(), 4000,
+     segmentSize, 16);
+
+  return 0;
+}
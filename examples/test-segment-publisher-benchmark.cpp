@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the rate of making segments of a 4 MB object with
+ * SegmentPublisher, signing each segment on the calling thread and with
+ * worker threads, and signing one manifest. The speedup of the worker threads
+ * depends on the number of processors.
+ */
+
+#include <iostream>
+#include <unistd.h>
+#include <ndn-cpp/util/segment-publisher.hpp>
+
+using namespace std;
+using namespace ndn;
+
+/**
+ * Publish the content and print the segments per second.
+ * @param label The label to print.
+ * @param keyChain The KeyChain for signing.
+ * @param signingInfo The SigningInfo for the identity.
+ * @param options The SegmentPublisher options.
+ * @param content The content to publish.
+ */
+static void
+benchmarkPublish
+  (const string& label, KeyChain& keyChain, const SigningInfo& signingInfo,
+   const SegmentPublisher::Options& options, const Blob& content)
+{
+  SegmentPublisher publisher(keyChain, signingInfo, options);
+  vector<ptr_lib::shared_ptr<Data> > segments;
+  publisher.publish(Name("/ndn/benchmark/object"), content, segments);
+
+  cout << label << ": Segments, segments/s, MB/s: " <<
+    publisher.getNSegmentsPublished() << ", " <<
+    publisher.getSegmentsPerSecond() << ", " <<
+    publisher.getSegmentsPerSecond() * options.getSegmentSize() / 1e6 << endl;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    KeyChain keyChain("pib-memory:", "tpm-memory:");
+    Blob content(vector<uint8_t>(4 * 1000 * 1000, 0x55));
+    cout << "Online processors: " << sysconf(_SC_NPROCESSORS_ONLN) << endl;
+
+    const char* keyTypes[] = { "RSA", "EC" };
+    for (size_t i = 0; i < 2; ++i) {
+      string keyType(keyTypes[i]);
+      ptr_lib::shared_ptr<PibIdentity> identity;
+      if (keyType == "RSA")
+        identity = keyChain.createIdentityV2
+          (Name("/ndn/benchmark/rsa"), RsaKeyParams());
+      else
+        identity = keyChain.createIdentityV2
+          (Name("/ndn/benchmark/ec"), EcKeyParams());
+      SigningInfo signingInfo(identity);
+
+      benchmarkPublish
+        (keyType + " sign each segment, calling thread", keyChain, signingInfo,
+         SegmentPublisher::Options().setNThreads(1), content);
+      benchmarkPublish
+        (keyType + " sign each segment, 2 threads", keyChain, signingInfo,
+         SegmentPublisher::Options().setNThreads(2), content);
+      benchmarkPublish
+        (keyType + " sign each segment, 4 threads", keyChain, signingInfo,
+         SegmentPublisher::Options().setNThreads(4), content);
+      benchmarkPublish
+        (keyType + " sign manifest", keyChain, signingInfo,
+         SegmentPublisher::Options().setSigningMode
+           (SegmentPublisher::SIGN_MANIFEST), content);
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the throughput of CryptoLite::digestSha256,
+ * CryptoLite::digestSha256Multiple and CryptoLite::computeHmacWithSha256 for
+ * buffers the size of a small Interest, a typical Data packet and a large
+ * Data packet.
+ */
+
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+#include <ndn-cpp/c/common.h>
+#include <ndn-cpp/lite/util/crypto-lite.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+/**
+ * Print the name, the rate of operations and the throughput in GB/s.
+ */
+static void
+printResult
+  (const char* name, size_t bufferSize, size_t nOperations, double duration)
+{
+  cout << name << " " << bufferSize << " bytes: Duration sec, Hz, GB/s: " <<
+    duration << ", " << (nOperations / duration) << ", " <<
+    (nOperations * (double)bufferSize / duration / 1e9) << endl;
+}
+
+static void
+benchmarkSha256(size_t bufferSize, size_t nOperations)
+{
+  vector<uint8_t> buffer(bufferSize, 0x5a);
+  uint8_t digest[ndn_SHA256_DIGEST_SIZE];
+
+  double start = getNowSeconds();
+  for (size_t i = 0; i < nOperations; ++i)
+    CryptoLite::digestSha256(&buffer[0], buffer.size(), digest);
+  printResult("digestSha256", bufferSize, nOperations, getNowSeconds() - start);
+
+  // Hash the same total number of buffers in batches of nBatch.
+  const size_t nBatch = 64;
+  vector<vector<uint8_t> > buffers(nBatch, buffer);
+  vector<const uint8_t*> dataList;
+  vector<size_t> dataLengthList(nBatch, bufferSize);
+  for (size_t i = 0; i < nBatch; ++i)
+    dataList.push_back(&buffers[i][0]);
+  vector<uint8_t> digests(nBatch * ndn_SHA256_DIGEST_SIZE);
+
+  size_t nBatches = nOperations / nBatch;
+  start = getNowSeconds();
+  for (size_t i = 0; i < nBatches; ++i)
+    CryptoLite::digestSha256Multiple
+      (&dataList[0], &dataLengthList[0], nBatch, &digests[0]);
+  printResult
+    ("digestSha256Multiple", bufferSize, nBatches * nBatch,
+     getNowSeconds() - start);
+
+#if NDN_CPP_HAVE_LIBCRYPTO
+  vector<uint8_t> key(32, 0x0b);
+  start = getNowSeconds();
+  for (size_t i = 0; i < nOperations; ++i)
+    CryptoLite::computeHmacWithSha256
+      (&key[0], key.size(), &buffer[0], buffer.size(), digest);
+  printResult
+    ("computeHmacWithSha256", bufferSize, nOperations, getNowSeconds() - start);
+#endif
+}
+
+int
+main(int argc, char** argv)
+{
+  benchmarkSha256(64, 2000000);
+  benchmarkSha256(1024, 500000);
+  benchmarkSha256(8192, 100000);
+  return 0;
+}
@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the packets per second which a UdpTransport can send and
+ * receive over the loopback interface, with and without batched I/O
+ * (recvmmsg/sendmmsg).
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <stdexcept>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <ndn-cpp/interest.hpp>
+#include <ndn-cpp/transport/udp-transport.hpp>
+#include "../src/encoding/element-listener.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+class CountingElementListener : public ElementListener {
+public:
+  CountingElementListener()
+  : nElements_(0)
+  {}
+
+  virtual void
+  onReceivedElement(const uint8_t *element, size_t elementLength)
+  {
+    ++nElements_;
+  }
+
+  int nElements_;
+};
+
+/**
+ * Bind a UDP socket on the loopback interface as the peer of the transport.
+ * @param port Set port to the bound port.
+ * @return The socket descriptor.
+ */
+static int
+bindPeerSocket(unsigned short& port)
+{
+  int peerSocket = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(peerSocket, (struct sockaddr *)&address, sizeof(address)) < 0)
+    throw runtime_error("Cannot bind the peer socket");
+  socklen_t addressLength = sizeof(address);
+  getsockname(peerSocket, (struct sockaddr *)&address, &addressLength);
+  port = ntohs(address.sin_port);
+  return peerSocket;
+}
+
+// Send in bursts which fit in the socket receive buffer.
+static const int BURST_SIZE = 32;
+
+/**
+ * Send nPackets Interests through a UdpTransport to a peer socket, in bursts
+ * of BURST_SIZE. The peer receives each burst before the next.
+ * @param useBatchedIo The UdpTransport constructor option.
+ * @param nPackets The number of packets to send.
+ * @return The number of seconds to send all the packets.
+ */
+static double
+benchmarkSendSeconds(bool useBatchedIo, int nPackets)
+{
+  unsigned short port;
+  int peerSocket = bindPeerSocket(port);
+  CountingElementListener listener;
+  UdpTransport transport(useBatchedIo);
+  transport.connect
+    (UdpTransport::ConnectionInfo("127.0.0.1", port), listener,
+     Transport::OnConnected());
+
+  Blob encoding = Interest(Name("/ndn/benchmark/udp/interest")).wireEncode();
+  uint8_t buffer[MAX_NDN_PACKET_SIZE];
+
+  double start = getNowSeconds();
+  for (int i = 0; i < nPackets; i += BURST_SIZE) {
+    for (int j = 0; j < BURST_SIZE; ++j)
+      transport.send(encoding.buf(), encoding.size());
+    // processEvents would call flush.
+    transport.flush();
+
+    for (int j = 0; j < BURST_SIZE; ++j)
+      recv(peerSocket, buffer, sizeof(buffer), 0);
+  }
+  double finish = getNowSeconds();
+
+  transport.close();
+  close(peerSocket);
+  return finish - start;
+}
+
+/**
+ * Send nPackets Interests from a peer socket to a UdpTransport, in bursts of
+ * BURST_SIZE, and call processEvents to receive each burst.
+ * @param useBatchedIo The UdpTransport constructor option.
+ * @param nPackets The number of packets to receive.
+ * @return The number of seconds for the transport to receive all the packets.
+ */
+static double
+benchmarkReceiveSeconds(bool useBatchedIo, int nPackets)
+{
+  unsigned short port;
+  int peerSocket = bindPeerSocket(port);
+  CountingElementListener listener;
+  UdpTransport transport(useBatchedIo);
+  transport.connect
+    (UdpTransport::ConnectionInfo("127.0.0.1", port), listener,
+     Transport::OnConnected());
+
+  // Get the transport's address so that the peer can send to it.
+  struct sockaddr_in transportAddress;
+  socklen_t addressLength = sizeof(transportAddress);
+  getsockname
+    (transport.getSocketDescriptor(), (struct sockaddr *)&transportAddress,
+     &addressLength);
+
+  Blob encoding = Interest(Name("/ndn/benchmark/udp/interest")).wireEncode();
+
+  double duration = 0;
+  for (int i = 0; i < nPackets; i += BURST_SIZE) {
+    for (int j = 0; j < BURST_SIZE; ++j)
+      sendto(peerSocket, encoding.buf(), encoding.size(), 0,
+             (struct sockaddr *)&transportAddress, addressLength);
+
+    // Only measure the time for the transport to receive.
+    double start = getNowSeconds();
+    int expectedCount = i + BURST_SIZE;
+    while (listener.nElements_ < expectedCount)
+      transport.processEvents();
+    duration += getNowSeconds() - start;
+  }
+
+  transport.close();
+  close(peerSocket);
+  return duration;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    int nPackets = 320000;
+    for (int useBatchedIo = 0; useBatchedIo <= 1; ++useBatchedIo) {
+      const char* mode = useBatchedIo ? "batched" : "unbatched";
+
+      double duration = benchmarkSendSeconds(useBatchedIo != 0, nPackets);
+      cout << "UDP send " << mode << ": Duration sec, packets/sec: "
+           << duration << ", " << (nPackets / duration) << endl;
+
+      duration = benchmarkReceiveSeconds(useBatchedIo != 0, nPackets);
+      cout << "UDP receive " << mode << ": Duration sec, packets/sec: "
+           << duration << ", " << (nPackets / duration) << endl;
+    }
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
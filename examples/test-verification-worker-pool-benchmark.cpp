@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+/**
+ * This measures the rate of verifying Data packets signed by the same RSA
+ * certificate on the calling thread, and with a VerificationWorkerPool with
+ * different numbers of worker threads. The speedup depends on the number of
+ * processors.
+ */
+
+#include <iostream>
+#include <sys/time.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <ndn-cpp/security/key-chain.hpp>
+#include <ndn-cpp/security/v2/verification-worker-pool.hpp>
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+static double
+getNowSeconds()
+{
+  struct timeval t;
+  gettimeofday(&t, 0);
+  return t.tv_sec + t.tv_usec / 1000000.0;
+}
+
+#if NDN_CPP_HAVE_POSIX_THREADS
+static void
+onVerified(const vector<bool>& results, size_t* nVerified, size_t* nFinished)
+{
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i])
+      ++(*nVerified);
+  }
+  ++(*nFinished);
+}
+
+/**
+ * Verify the items with a VerificationWorkerPool, where each call to verify()
+ * has one item like a Validator, and print the verification rate.
+ * @param nThreads The number of worker threads.
+ * @param items The items to verify.
+ * @param nIterations The number of times to verify all the items.
+ */
+static void
+benchmarkWorkerPool
+  (size_t nThreads, const vector<VerificationWorkerPool::Item>& items,
+   int nIterations)
+{
+  VerificationWorkerPool workerPool(nThreads);
+  PublicKeyCache publicKeyCache;
+  vector<ptr_lib::shared_ptr<const vector<VerificationWorkerPool::Item> > >
+    requests;
+  for (size_t i = 0; i < items.size(); ++i)
+    requests.push_back(ptr_lib::make_shared<vector<VerificationWorkerPool::Item> >
+      (1, items[i]));
+
+  size_t nVerified = 0;
+  size_t nFinished = 0;
+  size_t nRequests = requests.size() * nIterations;
+  double start = getNowSeconds();
+  for (int i = 0; i < nIterations; ++i) {
+    for (size_t j = 0; j < requests.size(); ++j)
+      workerPool.verify
+        (requests[j], publicKeyCache,
+         bind(&onVerified, _1, &nVerified, &nFinished));
+  }
+  while (nFinished < nRequests) {
+    workerPool.processEvents();
+    usleep(100);
+  }
+  double duration = getNowSeconds() - start;
+
+  if (nVerified != nRequests)
+    throw runtime_error("Verification failed");
+  cout << "VerificationWorkerPool with " << nThreads <<
+    " threads: Duration sec, Hz: " << duration << ", " <<
+    (nRequests / duration) << endl;
+}
+#endif
+
+int
+main(int argc, char** argv)
+{
+  try {
+    KeyChain keyChain("pib-memory:", "tpm-memory:");
+    ptr_lib::shared_ptr<PibIdentity> identity = keyChain.createIdentityV2
+      (Name("/ndn/benchmark"), RsaKeyParams());
+    ptr_lib::shared_ptr<CertificateV2> certificate =
+      identity->getDefaultKey()->getDefaultCertificate();
+
+    const size_t nPackets = 100;
+    const int nIterations = 100;
+    vector<VerificationWorkerPool::Item> items;
+    for (size_t i = 0; i < nPackets; ++i) {
+      Data data(Name("/ndn/benchmark/producer").appendSegment(i));
+      data.setContent(Blob(vector<uint8_t>(1000, (uint8_t)i)));
+      keyChain.sign(data, SigningInfo(identity));
+      items.push_back(VerificationWorkerPool::Item
+        (data.wireEncode(), data.getSignature()->getSignature(),
+         certificate->getKeyName(), certificate->getPublicKey()));
+    }
+
+    {
+      PublicKeyCache publicKeyCache;
+      size_t nVerified = 0;
+      double start = getNowSeconds();
+      for (int i = 0; i < nIterations; ++i) {
+        for (size_t j = 0; j < items.size(); ++j) {
+          const VerificationWorkerPool::Item& item = items[j];
+          if (publicKeyCache.verifySignature
+              (item.encoding_.signedBuf(), item.encoding_.signedSize(),
+               item.signature_.buf(), item.signature_.size(), item.keyName_,
+               item.publicKeyDer_))
+            ++nVerified;
+        }
+      }
+      double duration = getNowSeconds() - start;
+
+      if (nVerified != nPackets * nIterations)
+        throw runtime_error("Verification failed");
+      cout << "Calling thread: Duration sec, Hz: " << duration << ", " <<
+        (nPackets * nIterations / duration) << endl;
+    }
+
+#if NDN_CPP_HAVE_POSIX_THREADS
+    cout << "Online processors: " << sysconf(_SC_NPROCESSORS_ONLN) << endl;
+    benchmarkWorkerPool(1, items, nIterations);
+    benchmarkWorkerPool(2, items, nIterations);
+    benchmarkWorkerPool(4, items, nIterations);
+#endif
+  } catch (std::exception& e) {
+    cout << "exception: " << e.what() << endl;
+  }
+  return 0;
+}
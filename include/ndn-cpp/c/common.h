@@ -90,6 +90,17 @@ static const size_t ndn_AES_128_KEY_LENGTH = 16;
  */
 static const size_t ndn_AES_256_KEY_LENGTH = 32;
 
+/**
+ * The recommended initial vector size in bytes for AES in GCM mode.
+ */
+static const size_t ndn_AES_GCM_INITIAL_VECTOR_LENGTH = 12;
+
+/**
+ * The size in bytes of the authentication tag which AES in GCM mode appends to
+ * the encrypted data.
+ */
+static const size_t ndn_AES_GCM_TAG_LENGTH = 16;
+
 /**
  * The key size in bytes for the DES EDE3 algorithm. We define this separately
  * so that we don't have to include the openssl header everywhere.
@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_AES_CONTEXT_TYPES_H
+#define NDN_AES_CONTEXT_TYPES_H
+
+#include "encrypt-params-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct evp_cipher_ctx_st;
+
+/**
+ * A struct ndn_AesContext holds an AES key which is already expanded in
+ * OpenSSL cipher contexts, so that encrypting or decrypting many packets with
+ * the same key only needs to set the initial vector.
+ */
+struct ndn_AesContext {
+  ndn_EncryptAlgorithmType algorithmType;
+  struct evp_cipher_ctx_st *encryptContext;
+  struct evp_cipher_ctx_st *decryptContext;
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
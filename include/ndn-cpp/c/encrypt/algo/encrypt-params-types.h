@@ -33,7 +33,10 @@ typedef enum {
   ndn_EncryptAlgorithmType_AesEcb = 0,
   ndn_EncryptAlgorithmType_AesCbc = 1,
   ndn_EncryptAlgorithmType_RsaPkcs = 2,
-  ndn_EncryptAlgorithmType_RsaOaep = 3
+  ndn_EncryptAlgorithmType_RsaOaep = 3,
+  // These are not in the NAC specification.
+  ndn_EncryptAlgorithmType_AesGcm = 4,
+  ndn_EncryptAlgorithmType_AesCtr = 5
 } ndn_EncryptAlgorithmType;
 
 /**
@@ -25,6 +25,7 @@
 
 #include "../security/key-chain.hpp"
 #include "../security/v2/validator.hpp"
+#include "../lite/encrypt/algo/aes-context-lite.hpp"
 #include "encrypted-content.hpp"
 #include "encrypt-error.hpp"
 
@@ -61,7 +62,10 @@ public:
   shutdown() { impl_->shutdown(); }
 
   /**
-   * Asynchronously decrypt the encryptedContent.
+   * Asynchronously decrypt the encryptedContent. For AES-GCM, this checks
+   * the authentication tag with an empty Data name as from
+   * EncryptorV2::encrypt(plainData), so to decrypt the content of a Data
+   * packet use decrypt(data, ...).
    * @param encryptedContent The EncryptedContent to decrypt, which must have
    * a KeyLocator with a KEYNAME and and initial vector. This does not copy
    * the EncryptedContent object. If you may change it later, then pass in a
@@ -84,7 +88,36 @@ public:
      const DecryptSuccessCallback& onSuccess,
      const EncryptError::OnError& onError)
   {
-    impl_->decrypt(encryptedContent, onSuccess, onError);
+    impl_->decrypt(encryptedContent, Name(), onSuccess, onError);
+  }
+
+  /**
+   * Asynchronously decrypt the EncryptedContent v2 in the content of the Data
+   * packet. For AES-GCM, this checks that the authentication tag covers the
+   * Data name and the EncryptedContent header as from
+   * EncryptorV2::encrypt(plainData, data). This does not check the Data
+   * signature, so the application should validate the Data first.
+   * @param data The Data packet whose content is the EncryptedContent to
+   * decrypt, which must have a KeyLocator with a KEYNAME and and initial
+   * vector.
+   * @param onSuccess On successful decryption, this calls
+   * onSuccess(plainData) where plainData is the decrypted Blob.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param onError On failure, this calls onError(errorCode, message)
+   * where errorCode is from EncryptError::ErrorCode, and message is an error
+   * string.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   */
+  void
+  decrypt
+    (const Data& data, const DecryptSuccessCallback& onSuccess,
+     const EncryptError::OnError& onError)
+  {
+    impl_->decrypt(data, onSuccess, onError);
   }
 
   class ContentKey {
@@ -93,13 +126,14 @@ public:
     public:
       PendingDecrypt
         (const ptr_lib::shared_ptr<EncryptedContent>& encryptedContentIn,
-         const DecryptSuccessCallback& onSuccessIn,
+         const Name& dataNameIn, const DecryptSuccessCallback& onSuccessIn,
          const EncryptError::OnError& onErrorIn)
-      : encryptedContent(encryptedContentIn), onSuccess(onSuccessIn),
-        onError(onErrorIn)
+      : encryptedContent(encryptedContentIn), dataName(dataNameIn),
+        onSuccess(onSuccessIn), onError(onErrorIn)
       {}
 
       ptr_lib::shared_ptr<EncryptedContent> encryptedContent;
+      Name dataName;
       DecryptSuccessCallback onSuccess;
       EncryptError::OnError onError;
     };
@@ -110,6 +144,8 @@ public:
 
     bool isRetrieved;
     Blob bits;
+    // The expanded bits for the algorithm of the last decrypted content.
+    AesContextLite context;
     uint64_t pendingInterest;
     std::vector<ptr_lib::shared_ptr<PendingDecrypt> > pendingDecrypts;
   };
@@ -131,7 +167,12 @@ private:
   void
   decrypt
     (const ptr_lib::shared_ptr<EncryptedContent>& encryptedContent,
-     const DecryptSuccessCallback& onSuccess,
+     const Name& dataName, const DecryptSuccessCallback& onSuccess,
+     const EncryptError::OnError& onError);
+
+  void
+  decrypt
+    (const Data& data, const DecryptSuccessCallback& onSuccess,
      const EncryptError::OnError& onError);
 
   private:
@@ -160,8 +201,8 @@ private:
 
     static void
     doDecrypt
-      (const EncryptedContent& content, const Blob& ckBits,
-       const DecryptSuccessCallback& onSuccess,
+      (const EncryptedContent& content, const Name& dataName,
+       ContentKey& contentKey, const DecryptSuccessCallback& onSuccess,
        const EncryptError::OnError& onError);
 
     /**
@@ -194,7 +194,10 @@ public:
 
   /**
    * Encode this to an EncryptedContent v2 (used in Name-based Access Control
-   * v2) wire encoding.
+   * v2) wire encoding. NAC v2 assumes AES-CBC, so this only encodes the
+   * algorithm type if it is specified and is not
+   * ndn_EncryptAlgorithmType_AesCbc (for example AES-GCM). This extension is
+   * not in the NAC specification.
    * @param wireFormat (optional) A WireFormat object used to encode this
    * EncryptedContent. If omitted, use WireFormat::getDefaultWireFormat().
    * @return The encoded byte array.
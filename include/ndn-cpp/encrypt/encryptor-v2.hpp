@@ -26,6 +26,7 @@
 #include "../security/key-chain.hpp"
 #include "../security/v2/validator.hpp"
 #include "../in-memory-storage/in-memory-storage-retaining.hpp"
+#include "../lite/encrypt/algo/aes-context-lite.hpp"
 #include "encrypted-content.hpp"
 #include "encrypt-error.hpp"
 
@@ -81,7 +82,10 @@ public:
 
   /**
    * Encrypt the plainData using the existing Content Key (CK) and return a new
-   * EncryptedContent.
+   * EncryptedContent. In AES-GCM mode, the authentication tag covers the
+   * EncryptedContent header with an empty Data name, so DecryptorV2 must
+   * decrypt it with decrypt(encryptedContent, ...). To bind the content to
+   * the name of a Data packet, use encrypt(plainData, data).
    * @param plainData The data to encrypt.
    * @param plainDataLength The length of plainData.
    * @return The new EncryptedContent.
@@ -94,7 +98,7 @@ public:
 
   /**
    * Encrypt the plainData using the existing Content Key (CK) and return a new
-   * EncryptedContent.
+   * EncryptedContent. See encrypt(plainData, plainDataLength) for AES-GCM.
    * @param plainData The data to encrypt.
    * @return The new EncryptedContent.
    */
@@ -104,6 +108,70 @@ public:
     return encrypt(plainData.buf(), plainData.size());
   }
 
+  /**
+   * Encrypt the plainData using the existing Content Key (CK) and set the
+   * content of the Data packet to the EncryptedContent v2 TLV encoding. This
+   * is the same as data.setContent(encrypt(plainData)->wireEncodeV2()), but it
+   * encrypts directly into the buffer of the encoding, so it doesn't allocate
+   * and copy a separate payload. In AES-GCM mode, the authentication tag
+   * covers the Data name and the EncryptedContent header, so the name must
+   * already be set and DecryptorV2 must decrypt it with decrypt(data, ...).
+   * @param plainData The data to encrypt.
+   * @param plainDataLength The length of plainData.
+   * @param data The Data packet whose content is set.
+   */
+  void
+  encrypt(const uint8_t* plainData, size_t plainDataLength, Data& data)
+  {
+    impl_->encrypt(plainData, plainDataLength, data);
+  }
+
+  /**
+   * Encrypt the plainData using the existing Content Key (CK) and set the
+   * content of the Data packet to the EncryptedContent v2 TLV encoding. This
+   * is the same as data.setContent(encrypt(plainData)->wireEncodeV2()), but it
+   * encrypts directly into the buffer of the encoding, so it doesn't allocate
+   * and copy a separate payload. See encrypt(plainData, plainDataLength, data)
+   * for AES-GCM.
+   * @param plainData The data to encrypt.
+   * @param data The Data packet whose content is set.
+   */
+  void
+  encrypt(const Blob& plainData, Data& data)
+  {
+    encrypt(plainData.buf(), plainData.size(), data);
+  }
+
+  /**
+   * Set the algorithm type used to encrypt the content. The default is
+   * ndn_EncryptAlgorithmType_AesCbc as in the NAC specification. If this is
+   * ndn_EncryptAlgorithmType_AesGcm, the EncryptedContent has the AES-GCM
+   * authentication tag at the end of the payload and has the algorithm type,
+   * which is not in the NAC specification. The tag also covers the Data name
+   * and the EncryptedContent header (see getAesGcmAdditionalData), and
+   * DecryptorV2 checks it, so that a corrupted payload or content moved to
+   * another Data name fails to decrypt. The tag does not identify the
+   * producer, since every consumer which can decrypt also holds the CK and
+   * can make a valid tag, so the producer must still sign the Data packet.
+   * Since the initial vector is random, the application should call
+   * regenerateCk() well before encrypting 2^32 packets with one CK.
+   * @param algorithmType The algorithm type, either
+   * ndn_EncryptAlgorithmType_AesCbc or ndn_EncryptAlgorithmType_AesGcm.
+   * @throws runtime_error for an unsupported algorithm type.
+   */
+  void
+  setAlgorithmType(ndn_EncryptAlgorithmType algorithmType)
+  {
+    impl_->setAlgorithmType(algorithmType);
+  }
+
+  /**
+   * Get the algorithm type used to encrypt the content.
+   * @return The algorithm type.
+   */
+  ndn_EncryptAlgorithmType
+  getAlgorithmType() const { return impl_->getAlgorithmType(); }
+
   /**
    * Create a new Content Key (CK) and publish the corresponding CK Data packet.
    * This uses the onError given to the constructor to report errors.
@@ -118,6 +186,26 @@ public:
   size_t
   size() { return impl_->size(); }
 
+  /**
+   * Get the additional data which the AES-GCM authentication tag covers
+   * besides the payload. This is the TLV encoding of dataName followed by the
+   * fields of the EncryptedContent v2 encoding after the EncryptedPayload,
+   * which are the InitialVector, the CK name and the EncryptionAlgorithm.
+   * @param dataName The name of the Data packet with the encrypted content,
+   * or an empty Name if the EncryptedContent is not in a Data packet.
+   * @param encryptedContentEncoding A pointer to the EncryptedContent v2 TLV
+   * encoding. Only the type and length of the EncryptedPayload are read, so
+   * its value may be empty or not yet encrypted.
+   * @param encryptedContentEncodingLength The length of
+   * encryptedContentEncoding.
+   * @return The additional data.
+   * @throws runtime_error for an error decoding encryptedContentEncoding.
+   */
+  static Blob
+  getAesGcmAdditionalData
+    (const Name& dataName, const uint8_t* encryptedContentEncoding,
+     size_t encryptedContentEncodingLength);
+
   static const Name::Component&
   getNAME_COMPONENT_ENCRYPTED_BY() { return getValues().NAME_COMPONENT_ENCRYPTED_BY; }
 
@@ -197,6 +285,7 @@ private:
        const SigningInfo& ckDataSigningInfo, const EncryptError::OnError& onError,
        Validator* validator, KeyChain* keyChain, Face* face)
     : accessPrefix_(accessPrefix), ckPrefix_(ckPrefix),
+      algorithmType_(ndn_EncryptAlgorithmType_AesCbc),
       ckDataSigningInfo_(ckDataSigningInfo), isKekRetrievalInProgress_(false),
       onError_(onError), keyChain_(keyChain), face_(face),
       kekPendingInterestId_(0)
@@ -215,6 +304,15 @@ private:
     ptr_lib::shared_ptr<EncryptedContent>
     encrypt(const uint8_t* plainData, size_t plainDataLength);
 
+    void
+    encrypt(const uint8_t* plainData, size_t plainDataLength, Data& data);
+
+    void
+    setAlgorithmType(ndn_EncryptAlgorithmType algorithmType);
+
+    ndn_EncryptAlgorithmType
+    getAlgorithmType() const { return algorithmType_; }
+
     /**
      * Create a new Content Key (CK) and publish the corresponding CK Data
      * packet. This uses the onError given to the constructor to report errors.
@@ -233,6 +331,20 @@ private:
     void
     retryFetchingKek();
 
+    /**
+     * Set ckContext_ to the key in ckBits_ for algorithmType_.
+     */
+    void
+    setCkContext();
+
+    /**
+     * Fill the initialVector with random bytes for algorithmType_.
+     * @param initialVector The buffer of size AES_IV_SIZE for the result.
+     * @return The length of the initial vector.
+     */
+    size_t
+    generateInitialVector(uint8_t* initialVector);
+
     /**
      * Create an Interest for <access-prefix>/KEK to retrieve the
      * <access-prefix>/KEK/<key-id> KEK Data packet, and set kekData_.
@@ -263,6 +375,12 @@ private:
     Name ckPrefix_;
     Name ckName_;
     uint8_t ckBits_[AES_KEY_SIZE];
+    // ckContext_ has the expanded ckBits_ so that it is not expanded for each
+    // encrypt.
+    AesContextLite ckContext_;
+    // The TLV encoding of ckName_ for encrypting into a Data packet.
+    Blob ckNameEncoding_;
+    ndn_EncryptAlgorithmType algorithmType_;
     SigningInfo ckDataSigningInfo_;
 
     bool isKekRetrievalInProgress_;
@@ -79,6 +79,7 @@ typedef func_lib::function<void
 
 class Node;
 class KeyChain;
+class EventLoop;
 
 /**
  * The Face class provides the main methods for NDN communication.
@@ -657,6 +658,38 @@ public:
   virtual void
   processEvents();
 
+  /**
+   * Repeatedly call processEvents, blocking while there is nothing to do,
+   * until stop() is called from a callback. Instead of polling, this waits
+   * until the transport has data to receive or until the next timeout (such as
+   * an Interest timeout) is due. This also returns if the face is not connected
+   * and there are no timeouts, since then no callback can be called. To run
+   * multiple faces in one loop, see EventLoop. (This is not needed for
+   * ThreadsafeFace which uses the io_service.)
+   * @throws This may throw an exception for reading data or in a callback for
+   * processing the data.
+   */
+  void
+  run();
+
+  /**
+   * Repeatedly call processEvents, blocking while there is nothing to do,
+   * until the duration has passed or stop() is called from a callback. See
+   * run() for details.
+   * @param durationMilliseconds The number of milliseconds to run.
+   * @throws This may throw an exception for reading data or in a callback for
+   * processing the data.
+   */
+  void
+  runFor(Milliseconds durationMilliseconds);
+
+  /**
+   * Make run() or runFor() return after the current callback. This should be
+   * called from a callback in the thread which is running this Face.
+   */
+  void
+  stop();
+
   /**
    * Check if the face is local based on the current connection through the
    * Transport; some Transport may cause network I/O (e.g. an IP host name lookup).
@@ -693,10 +726,22 @@ public:
    * calls Node::callLater, but a subclass can override.
    * @param delayMilliseconds The delay in milliseconds.
    * @param callback This calls callback.callback() after the delay.
+   * @return The call ID which can be used with cancelCallLater.
    */
-  virtual void
+  virtual uint64_t
   callLater(Milliseconds delayMilliseconds, const Callback& callback);
 
+  /**
+   * Cancel the call from callLater with the callLaterId so that its callback
+   * is not called. If there is no such call (for example, if it was already
+   * called), do nothing. This default implementation just calls
+   * Node::cancelCallLater, but a subclass which overrides callLater should
+   * also override this.
+   * @param callLaterId The ID returned from callLater.
+   */
+  virtual void
+  cancelCallLater(uint64_t callLaterId);
+
 protected:
   /**
    * If the forwarder's Unix socket file path exists, then return the file path.
@@ -732,6 +777,9 @@ protected:
   Name commandCertificateName_;
 
 private:
+  // EventLoop uses node_ to get the transport socket and the next timeout.
+  friend class EventLoop;
+
   // Disable the copy constructor and assignment operator.
   Face(const Face& other);
   Face& operator=(const Face& other);
@@ -741,6 +789,15 @@ private:
 
   static ptr_lib::shared_ptr<Transport::ConnectionInfo>
   getDefaultConnectionInfo();
+
+  /**
+   * Get eventLoop_, creating it for this face if needed.
+   */
+  EventLoop&
+  getEventLoop();
+
+  // The EventLoop for run() and runFor(), created when first needed.
+  ptr_lib::shared_ptr<EventLoop> eventLoop_;
 };
 
 }
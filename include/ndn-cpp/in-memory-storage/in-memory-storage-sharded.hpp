@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_IN_MEMORY_STORAGE_SHARDED_HPP
+#define NDN_IN_MEMORY_STORAGE_SHARDED_HPP
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_POSIX_THREADS.
+#include "../ndn-cpp-config.h"
+#if NDN_CPP_HAVE_POSIX_THREADS
+
+#include "../interest.hpp"
+#include "../data.hpp"
+
+namespace ndn {
+
+/**
+ * InMemoryStorageSharded is like InMemoryStorageRetaining, but it is safe to
+ * call its methods from multiple threads at the same time, for example from
+ * the worker threads of a producer which uses ThreadsafeFace. The Data packets
+ * are divided among shards by the hash of the Data name, where each shard has
+ * its own read-write lock. Threads which insert or find Data packets with
+ * different names usually use different shards and don't wait for each other,
+ * and threads which only find Data packets in the same shard share its read
+ * lock. No eviction policy is employed. Entries are only removed by explicit
+ * application control. This class is only defined if the library is built
+ * with POSIX threads (NDN_CPP_HAVE_POSIX_THREADS).
+ */
+class InMemoryStorageSharded {
+public:
+  /**
+   * Create an InMemoryStorageSharded with the given number of shards.
+   * @param nShards (optional) The number of shards. A larger number reduces
+   * the chance that two threads use the same shard. If omitted, use 64.
+   */
+  InMemoryStorageSharded(size_t nShards = 64);
+
+  ~InMemoryStorageSharded();
+
+  /**
+   * Insert a Data packet. If a Data packet with the same name, including the
+   * implicit digest, already exists, replace it.
+   * @param data The packet to insert, which is copied.
+   */
+  void
+  insert(const Data& data);
+
+  /**
+   * Find the best match Data for a Name, which is the first Data packet in
+   * the canonical order whose name has the given name as a prefix.
+   * @param name The Name of the Data packet to find.
+   * @return The best match if any, otherwise null. Other threads may use the
+   * same returned object, so you must not modify it. If you need to modify it
+   * then you must make a copy. Its wire encoding is already cached, so you can
+   * call Face::putData with it.
+   */
+  ptr_lib::shared_ptr<Data>
+  find(const Name& name);
+
+  /**
+   * Find the best match Data for an Interest. If the Interest has CanBePrefix
+   * false, this only checks the shard for the Interest name. Otherwise, this
+   * is the same as find(interest.getName()) which checks all the shards. Note
+   * that other Interest selectors such as MustBeFresh are not checked.
+   * @param interest The Interest with the Name of the Data packet to find.
+   * @return The best match if any, otherwise null. Other threads may use the
+   * same returned object, so you must not modify it. If you need to modify it
+   * then you must make a copy. Its wire encoding is already cached, so you can
+   * call Face::putData with it.
+   */
+  ptr_lib::shared_ptr<Data>
+  find(const Interest& interest);
+
+  /**
+   * Remove matching entries by prefix.
+   * @param prefix The prefix Name of the entries to remove.
+   */
+  void
+  remove(const Name& prefix);
+
+  /**
+   * Get the number of packets stored in the in-memory storage.
+   * @return The number of packets.
+   */
+  size_t
+  size();
+
+  /**
+   * Get the number of shards given to the constructor.
+   * @return The number of shards.
+   */
+  size_t
+  getNShards() const { return shards_.size(); }
+
+private:
+  class Shard;
+
+  /**
+   * Get the shard for Data packets whose name is the first nComponents of the
+   * name. This computes the hash from the components instead of calling
+   * Name::hash() which caches the hash code in the (possibly shared) Name.
+   * @param name The name.
+   * @param nComponents The number of components to use, which is less than
+   * name.size() if the name has the implicit digest.
+   * @return The shard.
+   */
+  Shard&
+  getShard(const Name& name, size_t nComponents);
+
+  // Don't allow copying since each shard has a lock.
+  InMemoryStorageSharded(const InMemoryStorageSharded& other);
+  InMemoryStorageSharded& operator=(const InMemoryStorageSharded& other);
+
+  std::vector<Shard*> shards_;
+};
+
+}
+
+#endif // NDN_CPP_HAVE_POSIX_THREADS
+
+#endif
@@ -168,6 +168,9 @@ public:
   getRegexFilter() const { return regexFilter_; }
 
 private:
+  // InterestFilterTable uses regexFilterPattern_ to keep a compiled matcher.
+  friend class InterestFilterTable;
+
   /**
    * If regexFilter doesn't already have them, add ^ to the beginning and $ to
    * the end since these are required by NdnRegexTopMatcher.
@@ -107,6 +107,28 @@ public:
      size_t* signedPortionEndOffset, DynamicUInt8ArrayLite& output,
      size_t* encodingLength);
 
+  /**
+   * Encode interest as NDN-TLV in a single pass, writing the encoding at the
+   * back of the output array. This produces the same encoding as
+   * encodeInterest but does not need a pass to compute the nested lengths.
+   * @param interest The interest object to encode.
+   * @param signedPortionBeginOffset Return the offset in the encoding of the
+   * beginning of the signed portion. See encodeInterest.
+   * @param signedPortionEndOffset Return the offset in the encoding of the end
+   * of the signed portion. See encodeInterest.
+   * @param output A DynamicUInt8ArrayLite object which receives the encoded
+   * output as the final encodingLength bytes of its array. If the output's
+   * reallocFunction is null, its array must be large enough to receive the
+   * entire encoding.
+   * @param encodingLength Set encodingLength to the length of the encoded output.
+   * @return 0 for success, else an error code.
+   */
+  static ndn_Error
+  reverseEncodeInterest
+    (const InterestLite& interest, size_t* signedPortionBeginOffset,
+     size_t* signedPortionEndOffset, DynamicUInt8ArrayLite& output,
+     size_t* encodingLength);
+
   /**
    * Decode input as an interest in NDN-TLV and set the fields of the interest
    * object.
@@ -149,6 +171,30 @@ public:
      size_t* signedPortionEndOffset, DynamicUInt8ArrayLite& output,
      size_t* encodingLength);
 
+  /**
+   * Encode the data packet as NDN-TLV in a single pass, writing the encoding
+   * at the back of the output array. This produces the same encoding as
+   * encodeData but does not need a pass to compute the nested lengths.
+   * @param data The data object to encode.
+   * @param signedPortionBeginOffset Return the offset in the encoding of the
+   * beginning of the signed portion. If you are not encoding in order to sign,
+   * you can ignore this returned value.
+   * @param signedPortionEndOffset Return the offset in the encoding of the end of
+   * the signed portion. If you are not encoding in order to sign, you can ignore
+   * this returned value.
+   * @param output A DynamicUInt8ArrayLite object which receives the encoded
+   * output as the final encodingLength bytes of its array. If the output's
+   * reallocFunction is null, its array must be large enough to receive the
+   * entire encoding.
+   * @param encodingLength Set encodingLength to the length of the encoded output.
+   * @return 0 for success, else an error code.
+   */
+  static ndn_Error
+  reverseEncodeData
+    (const DataLite& data, size_t* signedPortionBeginOffset,
+     size_t* signedPortionEndOffset, DynamicUInt8ArrayLite& output,
+     size_t* encodingLength);
+
   /**
    * Decode input as a data packet in NDN-TLV and set the fields in the data object.
    * @param data The data object whose fields are updated.
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_AES_CONTEXT_LITE_HPP
+#define NDN_AES_CONTEXT_LITE_HPP
+
+#include "../../util/blob-lite.hpp"
+#include "../../../c/errors.h"
+#include "../../../c/encrypt/algo/aes-context-types.h"
+
+namespace ndn {
+
+/**
+ * An AesContextLite holds an AES key which is expanded once for a cipher mode
+ * so that it can encrypt or decrypt many packets without the cost of creating
+ * a cipher context and expanding the key for each one. The modes are ECB, CBC,
+ * CTR and GCM, with a 128-bit or 256-bit key. An AesContextLite is not
+ * thread-safe since encrypt and decrypt change the cipher context.
+ * @note This class is an experimental feature. The API may change.
+ */
+class AesContextLite : private ndn_AesContext {
+public:
+  /**
+   * Create an AesContextLite with no key. You must call setKey before
+   * encrypting or decrypting.
+   */
+  AesContextLite();
+
+  /**
+   * Finalize the AesContextLite, freeing the cipher contexts if needed.
+   */
+  ~AesContextLite();
+
+  /**
+   * Expand the key for the algorithm, replacing the previous key if needed.
+   * @param algorithmType The cipher mode, which must be
+   * ndn_EncryptAlgorithmType_AesEcb, ndn_EncryptAlgorithmType_AesCbc,
+   * ndn_EncryptAlgorithmType_AesCtr or ndn_EncryptAlgorithmType_AesGcm.
+   * @param key A pointer to the key byte array.
+   * @param keyLength The length of key, which must be ndn_AES_128_KEY_LENGTH
+   * or ndn_AES_256_KEY_LENGTH.
+   * @return 0 for success, else NDN_ERROR_Incorrect_key_size for incorrect
+   * keyLength, NDN_ERROR_Unsupported_algorithm_type for an unsupported
+   * algorithmType, or NDN_ERROR_Error_in_encrypt_operation if the contexts
+   * can't be created.
+   */
+  ndn_Error
+  setKey
+    (ndn_EncryptAlgorithmType algorithmType, const uint8_t* key,
+     size_t keyLength);
+
+  /**
+   * Expand the key for the algorithm, replacing the previous key if needed.
+   * @param algorithmType The cipher mode, which must be
+   * ndn_EncryptAlgorithmType_AesEcb, ndn_EncryptAlgorithmType_AesCbc,
+   * ndn_EncryptAlgorithmType_AesCtr or ndn_EncryptAlgorithmType_AesGcm.
+   * @param key The key byte array, whose size must be ndn_AES_128_KEY_LENGTH
+   * or ndn_AES_256_KEY_LENGTH.
+   * @return 0 for success, else NDN_ERROR_Incorrect_key_size for incorrect
+   * key.size(), NDN_ERROR_Unsupported_algorithm_type for an unsupported
+   * algorithmType, or NDN_ERROR_Error_in_encrypt_operation if the contexts
+   * can't be created.
+   */
+  ndn_Error
+  setKey(ndn_EncryptAlgorithmType algorithmType, const BlobLite& key)
+  {
+    return setKey(algorithmType, key.buf(), key.size());
+  }
+
+  /**
+   * Check if setKey has succeeded.
+   * @return True if this has a key.
+   */
+  bool
+  hasKey() const { return encryptContext != 0; }
+
+  /**
+   * Get the algorithm type given to setKey.
+   * @return The algorithm type, or -1 if there is no key.
+   */
+  ndn_EncryptAlgorithmType
+  getAlgorithmType() const { return algorithmType; }
+
+  /**
+   * Get the exact number of bytes that encrypt will write for the plain data
+   * length, including the padding for ECB and CBC mode and the authentication
+   * tag for GCM mode.
+   * @param plainDataLength The length of the plain data.
+   * @return The length of the encrypted data.
+   */
+  size_t
+  getEncryptedDataLength(size_t plainDataLength) const;
+
+  /**
+   * Encrypt plainData with the key and algorithm given to setKey. In GCM mode,
+   * this appends the authentication tag to the encrypted data. The tag covers
+   * the encrypted data and additionalData, so that decrypt must be given the
+   * same additionalData.
+   * @param initialVector A pointer to the initial vector byte array. This is
+   * ignored for ECB mode.
+   * @param initialVectorLength The length of initialVector. It is an error if
+   * this is not ndn_AES_GCM_INITIAL_VECTOR_LENGTH for GCM mode or
+   * ndn_AES_BLOCK_LENGTH for CBC and CTR mode.
+   * @param additionalData A pointer to the additional data which GCM mode
+   * authenticates but doesn't encrypt. This may be 0 if additionalDataLength
+   * is 0.
+   * @param additionalDataLength The length of additionalData. It is an error
+   * if this is not 0 for modes other than GCM.
+   * @param plainData A pointer to the input byte array to encrypt.
+   * @param plainDataLength The length of plainData.
+   * @param encryptedData A pointer to the encrypted output buffer. The caller
+   * must provide a buffer of at least getEncryptedDataLength(plainDataLength)
+   * bytes. For CTR mode this may be the same as plainData to encrypt in place.
+   * @param encryptedDataLength This sets encryptedDataLength to the number of
+   * bytes placed in the encryptedData buffer.
+   * @return 0 for success, else NDN_ERROR_Incorrect_initial_vector_size for
+   * incorrect initialVectorLength or NDN_ERROR_Error_in_encrypt_operation if
+   * the key is not set or the encryption fails.
+   */
+  ndn_Error
+  encrypt
+    (const uint8_t* initialVector, size_t initialVectorLength,
+     const uint8_t* additionalData, size_t additionalDataLength,
+     const uint8_t* plainData, size_t plainDataLength, uint8_t* encryptedData,
+     size_t& encryptedDataLength);
+
+  /**
+   * Decrypt encryptedData with the key and algorithm given to setKey. In GCM
+   * mode, this checks the authentication tag at the end of encryptedData
+   * against the encrypted data and additionalData.
+   * @param initialVector A pointer to the initial vector byte array. This is
+   * ignored for ECB mode.
+   * @param initialVectorLength The length of initialVector. It is an error if
+   * this is not ndn_AES_GCM_INITIAL_VECTOR_LENGTH for GCM mode or
+   * ndn_AES_BLOCK_LENGTH for CBC and CTR mode.
+   * @param additionalData A pointer to the additional data which GCM mode
+   * authenticates but doesn't encrypt. This may be 0 if additionalDataLength
+   * is 0.
+   * @param additionalDataLength The length of additionalData. It is an error
+   * if this is not 0 for modes other than GCM.
+   * @param encryptedData A pointer to the input byte array to decrypt.
+   * @param encryptedDataLength The length of encryptedData.
+   * @param plainData A pointer to the decrypted output buffer. The caller
+   * must provide a large enough buffer, which should be at least
+   * encryptedDataLength bytes.
+   * @param plainDataLength This sets plainDataLength to the number of bytes
+   * placed in the plainData buffer.
+   * @return 0 for success, else NDN_ERROR_Incorrect_initial_vector_size for
+   * incorrect initialVectorLength or NDN_ERROR_Error_in_decrypt_operation if
+   * the key is not set, the padding is wrong or the GCM authentication tag
+   * doesn't verify.
+   */
+  ndn_Error
+  decrypt
+    (const uint8_t* initialVector, size_t initialVectorLength,
+     const uint8_t* additionalData, size_t additionalDataLength,
+     const uint8_t* encryptedData, size_t encryptedDataLength,
+     uint8_t* plainData, size_t& plainDataLength);
+
+  /**
+   * Decrypt encryptedData with the key and algorithm given to setKey. In GCM
+   * mode, this checks the authentication tag at the end of encryptedData
+   * against the encrypted data and additionalData.
+   * @param initialVector The initial vector byte array. This is ignored for
+   * ECB mode.
+   * @param additionalData The additional data which GCM mode authenticates.
+   * This must be empty for modes other than GCM.
+   * @param encryptedData The input byte array to decrypt.
+   * @param plainData A pointer to the decrypted output buffer. The caller
+   * must provide a large enough buffer, which should be at least
+   * encryptedData.size() bytes.
+   * @param plainDataLength This sets plainDataLength to the number of bytes
+   * placed in the plainData buffer.
+   * @return 0 for success, else NDN_ERROR_Incorrect_initial_vector_size for
+   * incorrect initialVector.size() or NDN_ERROR_Error_in_decrypt_operation if
+   * the key is not set, the padding is wrong or the GCM authentication tag
+   * doesn't verify.
+   */
+  ndn_Error
+  decrypt
+    (const BlobLite& initialVector, const BlobLite& additionalData,
+     const BlobLite& encryptedData, uint8_t* plainData, size_t& plainDataLength)
+  {
+    return decrypt
+      (initialVector.buf(), initialVector.size(), additionalData.buf(),
+       additionalData.size(), encryptedData.buf(), encryptedData.size(),
+       plainData, plainDataLength);
+  }
+
+private:
+  // Don't allow copying since we don't reference count the cipher contexts.
+  AesContextLite(const AesContextLite& other);
+  AesContextLite& operator=(const AesContextLite& other);
+};
+
+}
+
+#endif
@@ -54,6 +54,22 @@ public:
     digestSha256(data.buf(), data.size(), digest);
   }
 
+  /**
+   * Compute the sha-256 digest of each buffer in a list, such as the encodings
+   * of many packets. This has the same result as calling digestSha256 for
+   * each buffer.
+   * @param dataList An array of nData pointers to the input byte arrays.
+   * @param dataLengthList An array of nData lengths of the input byte arrays.
+   * @param nData The number of input byte arrays.
+   * @param digests A pointer to a buffer of size
+   * nData * ndn_SHA256_DIGEST_SIZE to receive the digests, in the same order
+   * as dataList.
+   */
+  static void
+  digestSha256Multiple
+    (const uint8_t* const* dataList, const size_t* dataLengthList, size_t nData,
+     uint8_t *digests);
+
   /**
    * Fill the buffer with random bytes.
    * @param buffer Write the random bytes to this buffer.
@@ -44,13 +44,22 @@ public:
    */
   class Component {
   public:
+    /**
+     * A component value which is not larger than this is copied into the
+     * Component itself instead of a separately allocated Blob. This covers
+     * segment, version, timestamp and sequence number components and most
+     * short generic components, so that decoding or copying a Name doesn't
+     * allocate memory for them.
+     */
+    static const size_t MAX_INLINE_VALUE_SIZE = 16;
+
     /**
      * Create a new GENERIC Name::Component with a zero-length value.
      */
     Component()
     : type_(ndn_NameComponentType_GENERIC),
       otherTypeCode_(-1),
-      value_((const uint8_t*)0, 0)
+      inlineValueSize_(NO_INLINE_VALUE)
     {
     }
 
@@ -72,8 +81,13 @@ public:
       (const std::vector<uint8_t>& value,
        ndn_NameComponentType type = ndn_NameComponentType_GENERIC,
        int otherTypeCode = -1)
-    : value_(value)
     {
+      if (value.size() <= MAX_INLINE_VALUE_SIZE)
+        setInlineValue(value.size() > 0 ? &value[0] : 0, value.size());
+      else {
+        inlineValueSize_ = NO_INLINE_VALUE;
+        value_ = Blob(value);
+      }
       setType(type, otherTypeCode);
     }
 
@@ -96,8 +110,8 @@ public:
       (const uint8_t *value, size_t valueLength,
        ndn_NameComponentType type = ndn_NameComponentType_GENERIC,
        int otherTypeCode = -1)
-    : value_(value, valueLength)
     {
+      setValue(value, valueLength);
       setType(type, otherTypeCode);
     }
 
@@ -120,8 +134,8 @@ public:
       (const char* value,
        ndn_NameComponentType type = ndn_NameComponentType_GENERIC,
        int otherTypeCode = -1)
-    : value_((const uint8_t*)value, ::strlen(value))
     {
+      setValue((const uint8_t*)value, ::strlen(value));
       setType(type, otherTypeCode);
     }
 
@@ -144,8 +158,8 @@ public:
       (const std::string& value,
        ndn_NameComponentType type = ndn_NameComponentType_GENERIC,
        int otherTypeCode = -1)
-    : value_((const uint8_t*)&value[0], value.size())
     {
+      setValue((const uint8_t*)value.c_str(), value.size());
       setType(type, otherTypeCode);
     }
 
@@ -168,11 +182,46 @@ public:
       (const Blob &value,
        ndn_NameComponentType type = ndn_NameComponentType_GENERIC,
        int otherTypeCode = -1)
-    : value_(value)
+    : inlineValueSize_(NO_INLINE_VALUE), value_(value)
     {
       setType(type, otherTypeCode);
     }
 
+    /**
+     * Create a new Name::Component, copying the other component. If the value
+     * is stored in place, this copies the bytes but not the Blob made by
+     * getValue(), so that this doesn't read the Blob while another thread may
+     * be making it.
+     * @param component The Name::Component to copy.
+     */
+    Component(const Component& component)
+    : type_(component.type_),
+      otherTypeCode_(component.otherTypeCode_),
+      inlineValueSize_(component.inlineValueSize_)
+    {
+      if (inlineValueSize_ != NO_INLINE_VALUE)
+        memcpy(inlineValue_, component.inlineValue_, inlineValueSize_);
+      else
+        value_ = component.value_;
+    }
+
+    Component&
+    operator=(const Component& component)
+    {
+      if (&component == this)
+        return *this;
+
+      type_ = component.type_;
+      otherTypeCode_ = component.otherTypeCode_;
+      if (component.inlineValueSize_ != NO_INLINE_VALUE)
+        setInlineValue(component.inlineValue_, component.inlineValueSize_);
+      else {
+        inlineValueSize_ = NO_INLINE_VALUE;
+        value_ = component.value_;
+      }
+      return *this;
+    }
+
     /**
      * Create a new Name::Component, copying bytes from the
      * NameLite::Component value and using its type.
@@ -180,9 +229,9 @@ public:
      */
     Component(const NameLite::Component &componentLite)
     : type_(componentLite.getType()),
-      otherTypeCode_(componentLite.getOtherTypeCode()),
-      value_(componentLite.getValue())
+      otherTypeCode_(componentLite.getOtherTypeCode())
     {
+      setValue(componentLite.getValue().buf(), componentLite.getValue().size());
     }
 
     /**
@@ -195,11 +244,18 @@ public:
     get(NameLite::Component& componentLite) const;
 
     /**
-     * Get the component value.
+     * Get the component value. If the value is stored in place (see
+     * MAX_INLINE_VALUE_SIZE), the first call makes the Blob. It is safe for
+     * multiple threads to call this on the same const Component.
      * @return The component value.
      */
     const Blob&
-    getValue() const { return value_; }
+    getValue() const
+    {
+      if (inlineValueSize_ != NO_INLINE_VALUE)
+        return getInlineValueBlob();
+      return value_;
+    }
 
     /**
      * Get the name component type.
@@ -246,7 +302,7 @@ public:
     bool
     isSegment() const
     {
-      return value_.size() >= 1 && value_.buf()[0] == 0x00 &&
+      return getValueSize() >= 1 && getValueBuf()[0] == 0x00 &&
              type_ == ndn_NameComponentType_GENERIC;
     }
 
@@ -259,7 +315,7 @@ public:
     bool
     isSegmentOffset() const
     {
-      return value_.size() >= 1 && value_.buf()[0] == 0xFB &&
+      return getValueSize() >= 1 && getValueBuf()[0] == 0xFB &&
              type_ == ndn_NameComponentType_GENERIC;
     }
 
@@ -272,7 +328,7 @@ public:
     bool
     isVersion() const
     {
-      return value_.size() >= 1 && value_.buf()[0] == 0xFD &&
+      return getValueSize() >= 1 && getValueBuf()[0] == 0xFD &&
              type_ == ndn_NameComponentType_GENERIC;
     }
 
@@ -285,7 +341,7 @@ public:
     bool
     isTimestamp() const
     {
-      return value_.size() >= 1 && value_.buf()[0] == 0xFC &&
+      return getValueSize() >= 1 && getValueBuf()[0] == 0xFC &&
              type_ == ndn_NameComponentType_GENERIC;
     }
 
@@ -298,7 +354,7 @@ public:
     bool
     isSequenceNumber() const
     {
-      return value_.size() >= 1 && value_.buf()[0] == 0xFE &&
+      return getValueSize() >= 1 && getValueBuf()[0] == 0xFE &&
              type_ == ndn_NameComponentType_GENERIC;
     }
 
@@ -678,11 +734,11 @@ public:
     equals(const Component& other) const
     {
       if (type_ == ndn_NameComponentType_OTHER_CODE)
-        return  value_.equals(other.value_) &&
+        return  valueEquals(other) &&
           other.type_ == ndn_NameComponentType_OTHER_CODE &&
           otherTypeCode_ == other.otherTypeCode_;
       else
-        return value_.equals(other.value_) && type_ == other.type_;
+        return valueEquals(other) && type_ == other.type_;
     }
 
     /**
@@ -694,7 +750,7 @@ public:
     {
       return 37 *
         (type_ == ndn_NameComponentType_OTHER_CODE ? otherTypeCode_ : type_) +
-        value_.hash();
+        (isValueNull() ? 0 : BlobLite::hash(getValueBuf(), getValueSize()));
     }
 
     /**
@@ -770,6 +826,67 @@ public:
     void
     setType(ndn_NameComponentType type, int otherTypeCode);
 
+    friend class Name;
+
+    /**
+     * Get a pointer to the value bytes, either in place or in value_.
+     * @return The pointer, or 0 if the value is null.
+     */
+    const uint8_t*
+    getValueBuf() const
+    {
+      return inlineValueSize_ != NO_INLINE_VALUE ? inlineValue_ : value_.buf();
+    }
+
+    size_t
+    getValueSize() const
+    {
+      return inlineValueSize_ != NO_INLINE_VALUE ? inlineValueSize_ : value_.size();
+    }
+
+    bool
+    isValueNull() const
+    {
+      return inlineValueSize_ == NO_INLINE_VALUE && value_.isNull();
+    }
+
+    /**
+     * Get value_ for a value stored in place, making the Blob if needed. This
+     * uses the atomic shared_ptr functions so that if two threads make the
+     * Blob at the same time, only one is kept and value_ is never changed after
+     * it is set.
+     * @return value_.
+     */
+    const Blob&
+    getInlineValueBlob() const;
+
+    /**
+     * Check if the value bytes equal the value bytes of the other component,
+     * where a null value only equals a null value.
+     */
+    bool
+    valueEquals(const Component& other) const;
+
+    /**
+     * Copy the value in place if it is not null and is not larger than
+     * MAX_INLINE_VALUE_SIZE. Otherwise, copy it to a new Blob in value_.
+     * @param value The value bytes, or 0 for a null value.
+     * @param valueLength The length of value.
+     */
+    void
+    setValue(const uint8_t* value, size_t valueLength);
+
+    /**
+     * Copy the value in place, clearing value_.
+     * @param value The value bytes, which can be 0 if valueLength is 0.
+     * @param valueLength The length of value, which must not be larger than
+     * MAX_INLINE_VALUE_SIZE.
+     */
+    void
+    setInlineValue(const uint8_t* value, size_t valueLength);
+
+    static const uint8_t NO_INLINE_VALUE = 0xff;
+
     /**
      * FINAL_SEGMENT_PREFIX has the bytes of the component prefix used by toFinalSegment, etc.
      */
@@ -778,7 +895,12 @@ public:
 
     ndn_NameComponentType type_;
     int otherTypeCode_;
-    Blob value_;
+    // If the value is stored in place, this is its size and value_ is only
+    // made by getInlineValueBlob(). Otherwise, this is NO_INLINE_VALUE and value_ has the
+    // value.
+    uint8_t inlineValueSize_;
+    uint8_t inlineValue_[MAX_INLINE_VALUE_SIZE];
+    mutable Blob value_;
   };
 
   /**
@@ -936,6 +1058,12 @@ public:
   append(const Component &value)
   {
     components_.push_back(value);
+    if (hashCodeChangeCount_ == changeCount_ && hashCode_ != 0) {
+      // Update the cached hash code the same way that hash() computes it, so
+      // that appending to a hashed name doesn't hash all the components again.
+      hashCode_ = 37 * hashCode_ + value.hash();
+      ++hashCodeChangeCount_;
+    }
     ++changeCount_;
     return *this;
   }
@@ -1586,12 +1714,25 @@ public:
   }
 
   /**
-   * Get the hash code of this Name.
+   * Get the hash code of this Name. This caches the hash code until the Name
+   * is changed, and append() updates a cached hash code for the new component.
    * @return The hash code.
    */
   size_t
   hash() const;
 
+  /**
+   * Name::Hash is a hash function object to use a Name as the key of an
+   * unordered container, for example
+   * std::unordered_map<Name, int, Name::Hash>. It calls Name::hash() so that a
+   * key's hash code is only computed once.
+   */
+  class Hash {
+  public:
+    size_t
+    operator()(const Name& name) const { return name.hash(); }
+  };
+
   const Component&
   operator [] (int i) const
   {
@@ -1714,6 +1855,16 @@ private:
   void
   checkAppendOtherTypeCode(int otherTypeCode);
 
+  /**
+   * Write the value to result, escaping characters according to the NDN URI
+   * Scheme, as in toEscapedString.
+   * @param value The value bytes, which can be 0 if valueLength is 0.
+   * @param valueLength The length of value.
+   * @param result The string stream to write to.
+   */
+  static void
+  escape(const uint8_t* value, size_t valueLength, std::ostringstream& result);
+
   std::vector<Component> components_;
   uint64_t changeCount_;
   size_t hashCode_;
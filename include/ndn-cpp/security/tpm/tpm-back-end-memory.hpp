@@ -25,6 +25,9 @@
 
 #include <map>
 #include "tpm-back-end.hpp"
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+#include <unordered_map>
+#endif
 
 namespace ndn {
 
@@ -120,7 +123,13 @@ private:
   TpmBackEndMemory(const TpmBackEndMemory& other);
   TpmBackEndMemory& operator=(const TpmBackEndMemory& other);
 
-  std::map<Name, ptr_lib::shared_ptr<TpmPrivateKey>> keys_;
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+  typedef std::unordered_map
+    <Name, ptr_lib::shared_ptr<TpmPrivateKey>, Name::Hash> PrivateKeyMap;
+#else
+  typedef std::map<Name, ptr_lib::shared_ptr<TpmPrivateKey>> PrivateKeyMap;
+#endif
+  PrivateKeyMap keys_;
 };
 
 }
@@ -26,6 +26,9 @@
 #include <stdexcept>
 #include <map>
 #include "../../name.hpp"
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+#include <unordered_map>
+#endif
 #include "../key-params.hpp"
 
 namespace ndn {
@@ -241,7 +244,13 @@ private:
   std::string scheme_;
   std::string location_;
 
-  std::map<Name, ptr_lib::shared_ptr<TpmKeyHandle>> keys_;
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+  typedef std::unordered_map
+    <Name, ptr_lib::shared_ptr<TpmKeyHandle>, Name::Hash> KeyHandleMap;
+#else
+  typedef std::map<Name, ptr_lib::shared_ptr<TpmKeyHandle>> KeyHandleMap;
+#endif
+  KeyHandleMap keys_;
 
   ptr_lib::shared_ptr<TpmBackEnd> backEnd_;
 };
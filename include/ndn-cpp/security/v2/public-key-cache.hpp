@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_PUBLIC_KEY_CACHE_HPP
+#define NDN_PUBLIC_KEY_CACHE_HPP
+
+#include "../../name.hpp"
+#include "../security-common.hpp"
+
+namespace ndn {
+
+/**
+ * A PublicKeyCache holds decoded public keys for signature verification so
+ * that verifying many packets signed by the same key only decodes the
+ * DER-encoded key once. An entry is found by the key name and the SHA-256
+ * digest of the key DER, so a certificate which is fetched again (for example
+ * from a CertificateCacheV2) uses the same decoded key, while a certificate
+ * with the same key name but a different key never matches an old entry. When
+ * the cache is full, it removes the least recently used entry. If the library
+ * is built with POSIX threads (NDN_CPP_HAVE_POSIX_THREADS), it is safe to call
+ * the methods of a PublicKeyCache from multiple threads at the same time.
+ * Otherwise, the cache has no lock and must only be used from one thread.
+ */
+class PublicKeyCache {
+public:
+  /**
+   * Create a PublicKeyCache.
+   * @param maxEntries (optional) The maximum number of decoded keys to keep.
+   * If omitted, use 100.
+   */
+  PublicKeyCache(size_t maxEntries = 100);
+
+  ~PublicKeyCache();
+
+  /**
+   * Verify the buffer against the signature using the public key, decoding
+   * the public key and adding it to the cache if it is not already cached.
+   * @param buffer A pointer to the input buffer to verify.
+   * @param bufferLength The length of the buffer.
+   * @param signature A pointer to the signature bytes.
+   * @param signatureLength The length of the signature.
+   * @param keyName The name of the public key, such as the key name of a
+   * CertificateV2.
+   * @param publicKeyDer The DER-encoded public key.
+   * @param digestAlgorithm (optional) The digest algorithm. If omitted, use
+   * SHA256.
+   * @return True if verification succeeds, false if verification fails or for
+   * an error decoding the public key.
+   * @throws invalid_argument for an invalid public key type or digestAlgorithm.
+   */
+  bool
+  verifySignature
+    (const uint8_t* buffer, size_t bufferLength, const uint8_t* signature,
+     size_t signatureLength, const Name& keyName, const Blob& publicKeyDer,
+     DigestAlgorithm digestAlgorithm = DIGEST_ALGORITHM_SHA256);
+
+  /**
+   * Remove all the decoded keys, for example after a key is revoked. This does
+   * not reset the hit and miss counts.
+   */
+  void
+  clear();
+
+  /**
+   * Get the number of decoded keys in the cache.
+   * @return The number of keys.
+   */
+  size_t
+  size();
+
+  /**
+   * Get the maximum number of decoded keys given to the constructor.
+   * @return The maximum number of keys.
+   */
+  size_t
+  getMaxEntries() const { return maxEntries_; }
+
+  /**
+   * Get the number of calls to verifySignature which found the decoded key in
+   * the cache.
+   * @return The number of hits.
+   */
+  size_t
+  getNHits();
+
+  /**
+   * Get the number of calls to verifySignature which had to decode the key.
+   * @return The number of misses.
+   */
+  size_t
+  getNMisses();
+
+private:
+  class Impl;
+
+  // Don't allow copying since the Impl has a lock.
+  PublicKeyCache(const PublicKeyCache& other);
+  PublicKeyCache& operator=(const PublicKeyCache& other);
+
+  size_t maxEntries_;
+  Impl* impl_;
+};
+
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <set>
 #include "validation-error.hpp"
 #include "certificate-v2.hpp"
+#include "public-key-cache.hpp"
 #include "../../interest.hpp"
 
 namespace ndn {
@@ -168,9 +169,13 @@ private:
    * Verify the signature of the original packet. This is only called by the
    * Validator class.
    * @param trustedCertificate The certificate that signs the original packet.
+   * @param publicKeyCache The Validator's PublicKeyCache for the decoded
+   * public key of trustedCertificate.
    */
   virtual void
-  verifyOriginalPacket(const CertificateV2& trustedCertificate) = 0;
+  verifyOriginalPacket
+    (const CertificateV2& trustedCertificate,
+     PublicKeyCache& publicKeyCache) = 0;
 
   /**
    * Call the success callback of the original packet without signature
@@ -179,6 +184,38 @@ private:
   virtual void
   bypassValidation() = 0;
 
+  /**
+   * Get the encoding and the signature bits of the original packet, so that a
+   * worker thread can verify the signature without using the packet. This is
+   * only called by the Validator class.
+   * @param encoding Set this to the encoding of the original packet with the
+   * signed portion.
+   * @param signature Set this to the signature bits.
+   * @return True for success, or false if the packet can't be encoded or its
+   * signature can't be decoded.
+   */
+  virtual bool
+  getOriginalPacketSignature(SignedBlob& encoding, Blob& signature) = 0;
+
+  /**
+   * Finish the validation of the original packet after verifying its
+   * signature, by calling the success callback or fail(). This is only called
+   * by the Validator class.
+   * @param verified True if the signature of the original packet verifies.
+   */
+  virtual void
+  onOriginalPacketVerified(bool verified) = 0;
+
+  /**
+   * Call fail() with the INVALID_SIGNATURE error code for the certificate in
+   * the certificate chain, and remove it and the certificates after it from
+   * the chain. This is only called by the Validator class.
+   * @param index The index in the certificate chain of the certificate whose
+   * signature is invalid.
+   */
+  void
+  failCertificateSignature(size_t index);
+
   /**
    * Verify signatures of certificates in the certificate chain. On return, the
    * certificate chain contains a list of certificates successfully verified by
@@ -186,6 +223,10 @@ private:
    * When the certificate chain cannot be verified, this method will call
    * fail() with the INVALID_SIGNATURE error code and the appropriate message.
    * This is only called by the Validator class.
+   * @param trustedCertificate The trusted certificate which signs the first
+   * certificate in the chain.
+   * @param publicKeyCache The Validator's PublicKeyCache for the decoded
+   * public keys of the certificates.
    * @return The certificate to validate the original data packet, either the
    * last entry in the certificate chain or trustedCertificate if the
    * certificate chain is empty. However, return null if the signature of at
@@ -194,7 +235,8 @@ private:
    */
   ptr_lib::shared_ptr<CertificateV2>
   verifyCertificateChain
-    (const ptr_lib::shared_ptr<CertificateV2>& trustedCertificate);
+    (const ptr_lib::shared_ptr<CertificateV2>& trustedCertificate,
+     PublicKeyCache& publicKeyCache);
 
   // Disable the copy constructor and assignment operator.
   ValidationState(const ValidationState& other);
@@ -242,11 +284,18 @@ public:
 
 private:
   virtual void
-  verifyOriginalPacket(const CertificateV2& trustedCertificate);
+  verifyOriginalPacket
+    (const CertificateV2& trustedCertificate, PublicKeyCache& publicKeyCache);
 
   virtual void
   bypassValidation();
 
+  virtual bool
+  getOriginalPacketSignature(SignedBlob& encoding, Blob& signature);
+
+  virtual void
+  onOriginalPacketVerified(bool verified);
+
   Data data_;
   DataValidationSuccessCallback successCallback_;
   DataValidationFailureCallback failureCallback_;
@@ -295,11 +344,18 @@ public:
 
 private:
   virtual void
-  verifyOriginalPacket(const CertificateV2& trustedCertificate);
+  verifyOriginalPacket
+    (const CertificateV2& trustedCertificate, PublicKeyCache& publicKeyCache);
 
   virtual void
   bypassValidation();
 
+  virtual bool
+  getOriginalPacketSignature(SignedBlob& encoding, Blob& signature);
+
+  virtual void
+  onOriginalPacketVerified(bool verified);
+
   Interest interest_;
   std::vector<InterestValidationSuccessCallback> successCallbacks_;
   InterestValidationFailureCallback failureCallback_;
@@ -25,6 +25,7 @@
 
 #include "certificate-fetcher-offline.hpp"
 #include "validation-policy.hpp"
+#include "verification-worker-pool.hpp"
 
 namespace ndn {
 
@@ -94,6 +95,43 @@ public:
   size_t
   getMaxDepth() const { return maxDepth_; }
 
+  /**
+   * Get the PublicKeyCache which keeps the decoded public keys of the
+   * certificates which verify packets, including the certificates in the
+   * verified certificate cache, so that each key is only decoded once.
+   * @return The PublicKeyCache.
+   */
+  PublicKeyCache&
+  getPublicKeyCache() { return publicKeyCache_; }
+
+#if NDN_CPP_HAVE_POSIX_THREADS
+  /**
+   * Set the VerificationWorkerPool which verifies signatures for this
+   * Validator, instead of verifying them on the thread which calls validate.
+   * The pool calls the validation success and failure callbacks from its
+   * processEvents(), which the application should call on the same thread as
+   * Face::processEvents(). The Validator (and the pool) must remain valid
+   * until all validations are finished. This is only defined if the library
+   * is built with POSIX threads (NDN_CPP_HAVE_POSIX_THREADS).
+   * @param workerPool The VerificationWorkerPool, which can be shared by
+   * multiple Validator objects. If null, then verify signatures on the thread
+   * which calls validate (the default).
+   */
+  void
+  setVerificationWorkerPool
+    (const ptr_lib::shared_ptr<VerificationWorkerPool>& workerPool)
+  {
+    workerPool_ = workerPool;
+  }
+
+  /**
+   * Get the VerificationWorkerPool given to setVerificationWorkerPool.
+   * @return The VerificationWorkerPool, or null if not set.
+   */
+  const ptr_lib::shared_ptr<VerificationWorkerPool>&
+  getVerificationWorkerPool() { return workerPool_; }
+#endif
+
   /**
    * Asynchronously validate the Data packet.
    * @param data The Data packet to validate, which is copied.
@@ -107,6 +145,25 @@ public:
     (const Data& data, const DataValidationSuccessCallback& successCallback,
      const DataValidationFailureCallback& failureCallback);
 
+  /**
+   * Asynchronously validate the Data packets, which are usually segments
+   * signed with the same certificate chain. This first validates the first
+   * packet, which fetches and verifies the certificate chain. Then it
+   * validates the rest of the packets, which use the verified certificates
+   * and don't need to fetch them again. If setVerificationWorkerPool is used,
+   * then the worker threads verify the rest of the packets at the same time.
+   * @param dataList The Data packets to validate. Each is copied.
+   * @param successCallback On validation success of each Data packet, this
+   * calls successCallback(data).
+   * @param failureCallback On validation failure of each Data packet, this
+   * calls failureCallback(data, error) where error is a ValidationError.
+   */
+  void
+  validate
+    (const std::vector<ptr_lib::shared_ptr<Data> >& dataList,
+     const DataValidationSuccessCallback& successCallback,
+     const DataValidationFailureCallback& failureCallback);
+
   /**
    * Asynchronously validate the Interest.
    * @param interest The Interest to validate, which is copied.
@@ -142,6 +199,65 @@ private:
     (const ptr_lib::shared_ptr<CertificateRequest>& certificateRequest,
      const ptr_lib::shared_ptr<ValidationState>& state);
 
+#if NDN_CPP_HAVE_POSIX_THREADS
+  /**
+   * Use workerPool_ to verify the certificate chain and the original packet in
+   * the state. Then call onWorkerPoolVerified.
+   * @param trustedCertificate The trusted certificate which signs the first
+   * certificate in the chain.
+   * @param state The current validation state.
+   */
+  void
+  verifyWithWorkerPool
+    (const ptr_lib::shared_ptr<CertificateV2>& trustedCertificate,
+     const ptr_lib::shared_ptr<ValidationState>& state);
+
+  /**
+   * Finish the validation with the results from workerPool_. This is called
+   * from the VerificationWorkerPool processEvents().
+   * @param results The results for each certificate in the certificate chain
+   * of the state, followed by the result for the original packet.
+   * @param state The current validation state.
+   */
+  void
+  onWorkerPoolVerified
+    (const std::vector<bool>& results,
+     const ptr_lib::shared_ptr<ValidationState>& state);
+#endif
+
+  /**
+   * Validate each Data packet in dataList. This is called by the batch
+   * validate after the first Data packet is validated, so dataList has the
+   * rest of the packets.
+   */
+  void
+  validateRest
+    (const ptr_lib::shared_ptr<std::vector<ptr_lib::shared_ptr<Data> > >& dataList,
+     const DataValidationSuccessCallback& successCallback,
+     const DataValidationFailureCallback& failureCallback);
+
+  /**
+   * This is the success callback for the first Data packet of the batch
+   * validate.
+   */
+  void
+  onFirstDataValidated
+    (const Data& data,
+     const ptr_lib::shared_ptr<std::vector<ptr_lib::shared_ptr<Data> > >& dataList,
+     const DataValidationSuccessCallback& successCallback,
+     const DataValidationFailureCallback& failureCallback);
+
+  /**
+   * This is the failure callback for the first Data packet of the batch
+   * validate.
+   */
+  void
+  onFirstDataFailed
+    (const Data& data, const ValidationError& error,
+     const ptr_lib::shared_ptr<std::vector<ptr_lib::shared_ptr<Data> > >& dataList,
+     const DataValidationSuccessCallback& successCallback,
+     const DataValidationFailureCallback& failureCallback);
+
   /**
    * This is the continuation for validateCertificate.
    */
@@ -181,6 +297,10 @@ private:
   ptr_lib::shared_ptr<ValidationPolicy> policy_;
   ptr_lib::shared_ptr<CertificateFetcher> certificateFetcher_;
   size_t maxDepth_;
+  PublicKeyCache publicKeyCache_;
+#if NDN_CPP_HAVE_POSIX_THREADS
+  ptr_lib::shared_ptr<VerificationWorkerPool> workerPool_;
+#endif
 };
 
 }
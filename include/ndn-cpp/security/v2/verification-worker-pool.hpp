@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_VERIFICATION_WORKER_POOL_HPP
+#define NDN_VERIFICATION_WORKER_POOL_HPP
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_POSIX_THREADS.
+#include "../../ndn-cpp-config.h"
+#if NDN_CPP_HAVE_POSIX_THREADS
+
+#include <vector>
+#include "../../util/signed-blob.hpp"
+#include "public-key-cache.hpp"
+
+namespace ndn {
+
+/**
+ * A VerificationWorkerPool has worker threads which verify signatures so that
+ * the thread which calls verify() doesn't wait for the RSA or ECDSA
+ * operations. Each call to verify() has a list of signatures, which different
+ * workers can verify at the same time. When all the signatures of a call are
+ * verified, processEvents() calls its onVerified callback. The application
+ * should call processEvents() on the same thread as Face::processEvents() (or
+ * in the same io_service as a ThreadsafeFace) so that the callbacks happen on
+ * the Face's thread. To use a VerificationWorkerPool with a Validator, see
+ * Validator::setVerificationWorkerPool. This class is only defined if the
+ * library is built with POSIX threads (NDN_CPP_HAVE_POSIX_THREADS).
+ */
+class VerificationWorkerPool {
+public:
+  /**
+   * A VerificationWorkerPool::Item holds the values to verify one signature.
+   * The values are copied from the packet and certificate before calling
+   * verify() so that the worker thread doesn't use the packet objects.
+   */
+  class Item {
+  public:
+    /**
+     * Create an Item.
+     * @param encoding The packet encoding with the signed portion.
+     * @param signature The signature bits.
+     * @param keyName The name of the public key, such as the key name of a
+     * CertificateV2.
+     * @param publicKeyDer The DER-encoded public key.
+     */
+    Item
+      (const SignedBlob& encoding, const Blob& signature, const Name& keyName,
+       const Blob& publicKeyDer)
+    : encoding_(encoding), signature_(signature), keyName_(keyName),
+      publicKeyDer_(publicKeyDer)
+    {
+    }
+
+    SignedBlob encoding_;
+    Blob signature_;
+    Name keyName_;
+    Blob publicKeyDer_;
+  };
+
+  /**
+   * OnVerified is called by processEvents() with one result for each Item
+   * given to verify(), where the result is true if the signature verifies.
+   */
+  typedef func_lib::function<void
+    (const std::vector<bool>& results)> OnVerified;
+
+  /**
+   * Create a VerificationWorkerPool and start its worker threads.
+   * @param nThreads (optional) The number of worker threads. If omitted or 0,
+   * use the number of online processors.
+   */
+  VerificationWorkerPool(size_t nThreads = 0);
+
+  /**
+   * Stop and join the worker threads. This does not call the onVerified
+   * callback of a call to verify() which is not finished.
+   */
+  ~VerificationWorkerPool();
+
+  /**
+   * Add the items to the queue for the worker threads to verify, and return
+   * immediately. It is safe to call this from any thread.
+   * @param items The items to verify. This keeps a pointer to the vector
+   * until the items are verified, so the caller must not modify it.
+   * @param publicKeyCache The PublicKeyCache for the decoded public keys. This
+   * keeps a pointer to the PublicKeyCache until the items are verified, so it
+   * must remain valid.
+   * @param onVerified When all the items are verified, processEvents() calls
+   * onVerified(results).
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   */
+  void
+  verify
+    (const ptr_lib::shared_ptr<const std::vector<Item> >& items,
+     PublicKeyCache& publicKeyCache, const OnVerified& onVerified);
+
+  /**
+   * Call the onVerified callback of each call to verify() whose items are all
+   * verified. Call this on the thread where the callbacks should happen, such
+   * as the thread which calls Face::processEvents().
+   */
+  void
+  processEvents();
+
+  /**
+   * Get the number of worker threads.
+   * @return The number of worker threads.
+   */
+  size_t
+  getNThreads() const { return nThreads_; }
+
+private:
+  class Impl;
+
+  // Don't allow copying since the Impl has the threads.
+  VerificationWorkerPool(const VerificationWorkerPool& other);
+  VerificationWorkerPool& operator=(const VerificationWorkerPool& other);
+
+  size_t nThreads_;
+  Impl* impl_;
+};
+
+}
+
+#endif // NDN_CPP_HAVE_POSIX_THREADS
+
+#endif
@@ -26,6 +26,7 @@
 #include "../interest.hpp"
 #include "certificate/public-key.hpp"
 #include "v2/certificate-v2.hpp"
+#include "v2/public-key-cache.hpp"
 
 namespace ndn {
 
@@ -181,6 +182,28 @@ public:
       (data, certificate.getPublicKey(), digestAlgorithm, wireFormat);
   }
 
+  /**
+   * Verify the Data packet using the public key in the certificate, where the
+   * decoded public key is kept in the publicKeyCache. This does not check the
+   * type of public key or digest algorithm against the type of SignatureInfo
+   * in the Data packet such as Sha256WithRsaSignature.
+   * @param data The Data packet to verify.
+   * @param certificate The certificate containing the public key.
+   * @param publicKeyCache The PublicKeyCache for the decoded public key.
+   * @param digestAlgorithm (optional) The digest algorithm. If omitted, use SHA256.
+   * @param wireFormat (optional) A WireFormat object used to encode the Data
+   * packet. If omitted, use WireFormat getDefaultWireFormat().
+   * @return True if verification succeeds, false if verification fails or for
+   * an error decoding the public key.
+   * @throws invalid_argument for an invalid public key type or digestAlgorithm.
+   */
+  static bool
+  verifyDataSignature
+    (const Data& data, const CertificateV2& certificate,
+     PublicKeyCache& publicKeyCache,
+     DigestAlgorithm digestAlgorithm = DIGEST_ALGORITHM_SHA256,
+     WireFormat& wireFormat = *WireFormat::getDefaultWireFormat());
+
   /**
    * Verify the Interest packet using the public key, where the last two name
    * components are the SignatureInfo and signature bytes. This does not check
@@ -249,6 +272,29 @@ public:
       (interest, certificate.getPublicKey(), digestAlgorithm, wireFormat);
   }
 
+  /**
+   * Verify the Interest packet using the public key in the certificate, where
+   * the last two name components are the SignatureInfo and signature bytes,
+   * and the decoded public key is kept in the publicKeyCache. This does not
+   * check the type of public key or digest algorithm against the type of
+   * SignatureInfo such as Sha256WithRsaSignature.
+   * @param interest The Interest packet to verify.
+   * @param certificate The certificate containing the public key.
+   * @param publicKeyCache The PublicKeyCache for the decoded public key.
+   * @param digestAlgorithm (optional) The digest algorithm. If omitted, use SHA256.
+   * @param wireFormat (optional) A WireFormat object used to decode the
+   * Interest packet. If omitted, use WireFormat getDefaultWireFormat().
+   * @return True if verification succeeds, false if verification fails or
+   * cannot decode the Interest or public key.
+   * @throws invalid_argument for an invalid public key type or digestAlgorithm.
+   */
+  static bool
+  verifyInterestSignature
+    (const Interest& interest, const CertificateV2& certificate,
+     PublicKeyCache& publicKeyCache,
+     DigestAlgorithm digestAlgorithm = DIGEST_ALGORITHM_SHA256,
+     WireFormat& wireFormat = *WireFormat::getDefaultWireFormat());
+
   /////////////////////////////////////////////////////////////
 
   /**
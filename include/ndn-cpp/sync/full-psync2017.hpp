@@ -23,6 +23,7 @@
 #ifndef NDN_FULL_PSYNC2017_HPP
 #define NDN_FULL_PSYNC2017_HPP
 
+#include <deque>
 #include "../face.hpp"
 #include "../util/segment-fetcher.hpp"
 #include "../security/key-chain.hpp"
@@ -200,6 +201,27 @@ private:
     static void
     onError(SegmentFetcher::ErrorCode errorCode, const std::string& message);
 
+    /**
+     * Get the decoded IBLT for the IBLT name component of a sync Interest. If
+     * a peer IBLT with the same SHA-256 digest of the component value was
+     * decoded recently, then return it from peerIblts_ instead of decompressing
+     * it again. (Peers in a converged sync group send the same IBLT.) The
+     * returned IBLT is shared and must not be modified.
+     * @param ibltName The IBLT name component from the sync Interest.
+     * @return The decoded IBLT.
+     * @throws runtime_error if the IBLT cannot be decoded.
+     */
+    ptr_lib::shared_ptr<InvertibleBloomLookupTable>
+    getPeerIblt(const Name::Component& ibltName);
+
+    /**
+     * Set differenceIblt_ to iblt_ minus the other IBLT, reusing its storage.
+     * @param other The other IBLT.
+     * @return differenceIblt_, which is changed by the next call.
+     */
+    InvertibleBloomLookupTable&
+    computeDifference(const InvertibleBloomLookupTable& other);
+
     /**
      * Send the sync Data. Check if the data will satisfy our own pending 
      * Interest. If it does, then remove it and then renew the sync interest.
@@ -266,6 +288,14 @@ private:
     CanAddReceivedName canAddReceivedName_;
     Name outstandingInterestName_;
     uint64_t registeredPrefix_;
+    // The key is the SHA-256 digest of the IBLT name component value.
+    std::map<std::string, ptr_lib::shared_ptr<InvertibleBloomLookupTable> >
+      peerIblts_;
+    // The keys of peerIblts_ in the order they were added, to remove the oldest.
+    std::deque<std::string> peerIbltKeys_;
+    ptr_lib::shared_ptr<InvertibleBloomLookupTable> differenceIblt_;
+
+    static const size_t MAX_PEER_IBLTS = 32;
   };
 
   ptr_lib::shared_ptr<Impl> impl_;
@@ -25,6 +25,9 @@
 
 #include <map>
 #include "../name.hpp"
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+#include <unordered_map>
+#endif
 
 namespace ndn {
 
@@ -79,7 +82,12 @@ protected:
   // nameToHash_ and hashToName_ are just for looking up the hash more quickly
   // (instead of calculating it again).
   // The key is the Name. The value is the hash.
-  std::map<Name, uint32_t> nameToHash_;
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+  typedef std::unordered_map<Name, uint32_t, Name::Hash> NameToHash;
+#else
+  typedef std::map<Name, uint32_t> NameToHash;
+#endif
+  NameToHash nameToHash_;
   // The key is the hash. The value is the Name.
   std::map<uint32_t, Name> hashToName_;
 
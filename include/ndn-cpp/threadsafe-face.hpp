@@ -26,6 +26,7 @@
 #include "ndn-cpp-config.h"
 #ifdef NDN_CPP_HAVE_BOOST_ASIO
 
+#include <map>
 #include <boost/asio.hpp>
 #include <boost/move/unique_ptr.hpp>
 #include "face.hpp"
@@ -248,11 +249,44 @@ public:
    * though this is public, it is not part of the public API of Face.
    * @param delayMilliseconds The delay in milliseconds.
    * @param callback This calls callback.callback() after the delay.
+   * @return The call ID which can be used with cancelCallLater.
    */
-  virtual void
+  virtual uint64_t
   callLater(Milliseconds delayMilliseconds, const Callback& callback);
 
+  /**
+   * Override to cancel the timer for the call from callLater with the
+   * callLaterId, using the ioService given to the constructor.
+   * @param callLaterId The ID returned from callLater.
+   */
+  virtual void
+  cancelCallLater(uint64_t callLaterId);
+
 private:
+  /**
+   * Do the work of callLater in the ioService thread to start the timer and
+   * add it to timers_.
+   */
+  void
+  callLaterHelper
+    (uint64_t callLaterId, Milliseconds delayMilliseconds,
+     const Callback& callback);
+
+  /**
+   * Do the work of cancelCallLater in the ioService thread.
+   */
+  void
+  cancelCallLaterHelper(uint64_t callLaterId);
+
+  /**
+   * After the delay, async_wait calls this to remove the timer from timers_
+   * and call the original caller's callback, unless the call was cancelled.
+   */
+  void
+  onTimerExpired
+    (const boost::system::error_code& errorCode, uint64_t callLaterId,
+     const Callback& callback);
+
   static ptr_lib::shared_ptr<Transport>
   getDefaultTransport(boost::asio::io_service& ioService);
 
@@ -262,6 +296,9 @@ private:
   // This is only used if the io_service is not supplied to the constructor.
   boost::movelib::unique_ptr<boost::asio::io_service> internalIoService_;
   boost::asio::io_service& ioService_;
+  // The pending timers from callLater, by callLaterId. This is only accessed
+  // in the ioService thread.
+  std::map<uint64_t, ptr_lib::shared_ptr<boost::asio::deadline_timer> > timers_;
 };
 
 }
@@ -106,9 +106,29 @@ public:
   virtual void
   processEvents() = 0;
 
+  /**
+   * Send any data which send() queued instead of sending immediately. This is
+   * called by Face.processEvents after processing received data and timeouts,
+   * so that data sent by the callbacks goes out in one batch. This base class
+   * implementation does nothing, but your derived class can override.
+   */
+  virtual void
+  flush();
+
   virtual bool
   getIsConnected();
 
+  /**
+   * Get the socket descriptor which an event loop can wait on for data to
+   * receive before calling processEvents(). This base class implementation
+   * returns -1, but a derived class with a socket can override.
+   * @return The socket descriptor, or -1 if this transport is not connected or
+   * does not have a socket descriptor to wait on (for example, an async
+   * transport which receives with its own io_service).
+   */
+  virtual int
+  getSocketDescriptor();
+
   /**
    * Close the connection.  This base class implementation does nothing, but
    * your derived class can override.
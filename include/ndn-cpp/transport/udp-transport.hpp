@@ -76,7 +76,17 @@ public:
     unsigned short port_;
   };
 
-  UdpTransport();
+  /**
+   * Create a UdpTransport.
+   * @param useBatchedIo (optional) If true, processEvents receives multiple
+   * datagrams per system call with recvmmsg (where available) into
+   * preallocated buffers, and send queues each datagram until flush() (which
+   * Face.processEvents calls) sends them all with one call to sendmmsg. Data
+   * sent outside of processEvents callbacks is held until the next call to
+   * processEvents. If omitted, false to receive and send each datagram with a
+   * separate system call.
+   */
+  UdpTransport(bool useBatchedIo = false);
 
   /**
    * Determine whether this transport connecting according to connectionInfo is
@@ -109,7 +119,8 @@ public:
           ElementListener& elementListener, const OnConnected& onConnected);
 
   /**
-   * Send data to the host
+   * Send data to the host. If useBatchedIo was given to the constructor, this
+   * copies the data to a queue to be sent by flush().
    * @param data A pointer to the buffer of data to send.
    * @param dataLength The number of bytes in data.
    */
@@ -128,9 +139,23 @@ public:
   virtual void
   processEvents();
 
+  /**
+   * If useBatchedIo was given to the constructor, send the datagrams queued by
+   * send() with one call to sendmmsg where available. Otherwise do nothing.
+   */
+  virtual void
+  flush();
+
   virtual bool
   getIsConnected();
 
+  /**
+   * Override to get the descriptor of the connected socket.
+   * @return The socket descriptor, or -1 if not connected.
+   */
+  virtual int
+  getSocketDescriptor();
+
   /**
    * Close the connection to the host.
    */
@@ -138,9 +163,25 @@ public:
   close();
 
 private:
+  /**
+   * The number of preallocated buffers for receiving, and for queueing sent
+   * datagrams, when useBatchedIo is true.
+   */
+  static const size_t MAX_BATCHED_DATAGRAMS = 32;
+
   ptr_lib::shared_ptr<struct ndn_UdpTransport> transport_;
   ptr_lib::shared_ptr<DynamicUInt8Vector> elementBuffer_;
   bool isConnected_;
+  bool useBatchedIo_;
+  // The following are only allocated if useBatchedIo_. Each buffer is a slice
+  // of MAX_NDN_PACKET_SIZE bytes in receiveBuffer_ or sendBuffer_.
+  std::vector<uint8_t> receiveBuffer_;
+  std::vector<uint8_t*> receiveDatagrams_;
+  std::vector<size_t> receiveDatagramLengths_;
+  std::vector<uint8_t> sendBuffer_;
+  std::vector<uint8_t*> sendDatagrams_;
+  std::vector<size_t> sendDatagramLengths_;
+  size_t nQueuedDatagrams_;
 };
 
 }
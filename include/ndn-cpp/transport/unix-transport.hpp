@@ -123,6 +123,13 @@ public:
   virtual bool
   getIsConnected();
 
+  /**
+   * Override to get the descriptor of the connected socket.
+   * @return The socket descriptor, or -1 if not connected.
+   */
+  virtual int
+  getSocketDescriptor();
+
   /**
    * Close the connection to the host.
    */
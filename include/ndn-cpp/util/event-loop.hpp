@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_EVENT_LOOP_HPP
+#define NDN_EVENT_LOOP_HPP
+
+#include <vector>
+#include <map>
+#include "../face.hpp"
+
+namespace ndn {
+
+/**
+ * An EventLoop calls processEvents for one or more Face objects, blocking
+ * between calls until a Face's socket has data to receive or until the next
+ * call from callLater (such as an Interest timeout) is due. This replaces an
+ * application loop which calls processEvents and sleeps. On Linux this waits
+ * with epoll_wait, otherwise with poll. Face.run() uses an EventLoop for a
+ * single Face. The EventLoop must be run in the same thread which calls
+ * expressInterest, etc. on the faces. (ThreadsafeFace uses its own
+ * io_service instead.)
+ */
+class EventLoop {
+public:
+  EventLoop();
+
+  ~EventLoop();
+
+  /**
+   * Add the face so that run() and runFor() call its processEvents. The face
+   * must remain valid until it is removed or this EventLoop is destroyed. If
+   * the face was already added, do nothing.
+   * @param face The Face to add.
+   */
+  void
+  addFace(Face& face);
+
+  /**
+   * Remove the face which was given to addFace. If the face was not added, do
+   * nothing.
+   * @param face The Face to remove.
+   */
+  void
+  removeFace(Face& face);
+
+  /**
+   * Repeatedly call processEvents for the faces, blocking while there is
+   * nothing to do, until stop() is called from a callback. This also returns
+   * if no face is connected and there are no calls from callLater, since then
+   * no callback can be called.
+   * @throws This may throw an exception for reading data or in a callback for
+   * processing the data.
+   */
+  void
+  run() { runFor(-1); }
+
+  /**
+   * Repeatedly call processEvents for the faces, blocking while there is
+   * nothing to do, until the duration has passed or stop() is called from a
+   * callback.
+   * @param durationMilliseconds The number of milliseconds to run. If this is
+   * negative, run until stop() is called, as in run().
+   * @throws This may throw an exception for reading data or in a callback for
+   * processing the data.
+   */
+  void
+  runFor(Milliseconds durationMilliseconds);
+
+  /**
+   * Make run() or runFor() return after the current callback. This should be
+   * called from a callback in the thread which is running this EventLoop.
+   */
+  void
+  stop() { isStopped_ = true; }
+
+private:
+  /**
+   * Get the milliseconds until the earliest delayed call of all the faces.
+   * @return The milliseconds until the next call, 0 if a call is due, or -1 if
+   * there are no calls.
+   */
+  Milliseconds
+  getMillisecondsUntilNextCall();
+
+  /**
+   * Update the socket descriptors to wait on from the faces' transports, since
+   * a transport may connect or close in a callback.
+   * @return The number of faces with a socket descriptor.
+   */
+  size_t
+  updateSocketDescriptors();
+
+  /**
+   * Block until a socket has data to receive or until the timeout.
+   * @param timeoutMilliseconds The maximum milliseconds to wait, or -1 to wait
+   * until a socket has data.
+   */
+  void
+  waitForEvents(Milliseconds timeoutMilliseconds);
+
+  /**
+   * The maximum number of events to get from one call to epoll_wait. If more
+   * sockets are ready, the next call gets them.
+   */
+  static const int MAX_EVENTS = 64;
+
+  std::vector<Face*> faces_;
+  // The socket descriptor which was last found for each face in faces_.
+  std::map<Face*, int> socketDescriptors_;
+  // The epoll instance, or -1 if not using epoll.
+  int epollDescriptor_;
+  bool isStopped_;
+
+  // Disable the copy constructor and assignment operator.
+  EventLoop(const EventLoop& other);
+  EventLoop& operator=(const EventLoop& other);
+};
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_FETCH_SCHEDULER_HPP
+#define NDN_FETCH_SCHEDULER_HPP
+
+#include "segment-fetcher.hpp"
+
+namespace ndn {
+
+/**
+ * A FetchScheduler fetches many segmented objects in parallel over one Face.
+ * Each object is fetched by a SegmentFetcher with the same version discovery,
+ * retransmission and verification as SegmentFetcher::fetch, but all the
+ * fetchers share one congestion window and RTT estimator, so that the objects
+ * together adapt to the network like a single retrieval instead of competing
+ * with each other. When the window has room, the scheduler sends the next
+ * Interest for the object which has the fewest Interests in flight relative to
+ * its priority, so that objects with the same priority share the window
+ * equally and an object with priority 2 gets twice the share of an object
+ * with priority 1. An object which finishes or fails frees its share for the
+ * others.
+ */
+class FetchScheduler {
+public:
+  /**
+   * Create a FetchScheduler to fetch objects over the Face.
+   * @param face This calls face.expressInterest to fetch the segments. The
+   * Face must remain valid while fetching.
+   * @param options The Options for the shared congestion window and for each
+   * object's retransmissions and reorder buffer. The OnProgress callback is
+   * called for each object. If omitted, use the default Options().
+   */
+  FetchScheduler
+    (Face& face,
+     const SegmentFetcher::Options& options = SegmentFetcher::Options());
+
+  /**
+   * Start fetching the segments of the object with the baseInterest name, as
+   * in SegmentFetcher::fetch, using the shared window.
+   * @param baseInterest An Interest for the initial segment of the requested
+   * data, where baseInterest.getName() has the name prefix. See
+   * SegmentFetcher::fetch.
+   * @param validatorKeyChain If this is not null, use its verifyData to verify
+   * each segment. If null, do not verify.
+   * @param onComplete When all segments are received, call
+   * onComplete(content) where content is the concatenation of the content of
+   * all the segments.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param onError Call onError(errorCode, message) for timeout or an error
+   * processing segments.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param priority (optional) The weight of this object's share of the
+   * window relative to the other objects. If omitted, use 1.
+   */
+  void
+  fetch
+    (const Interest& baseInterest, KeyChain* validatorKeyChain,
+     const SegmentFetcher::OnComplete& onComplete,
+     const SegmentFetcher::OnError& onError, double priority = 1.0);
+
+  /**
+   * Start fetching the segments of the object with the baseInterest name, as
+   * in SegmentFetcher::fetchStream, using the shared window.
+   * @param baseInterest An Interest for the initial segment of the requested
+   * data. See SegmentFetcher::fetch.
+   * @param validatorKeyChain If this is not null, use its verifyData to verify
+   * each segment. If null, do not verify.
+   * @param onSegment Call onSegment(segmentNumber, content) for each segment
+   * in order.
+   * @param onComplete When all segments are delivered, call
+   * onComplete(nBytes).
+   * @param onError Call onError(errorCode, message) for timeout or an error
+   * processing segments.
+   * @param priority (optional) The weight of this object's share of the
+   * window relative to the other objects. If omitted, use 1.
+   */
+  void
+  fetchStream
+    (const Interest& baseInterest, KeyChain* validatorKeyChain,
+     const SegmentFetcher::OnSegment& onSegment,
+     const SegmentFetcher::OnStreamComplete& onComplete,
+     const SegmentFetcher::OnError& onError, double priority = 1.0);
+
+  /**
+   * Get the number of objects which are still being fetched.
+   * @return The number of objects.
+   */
+  size_t
+  getNObjectsInProgress() const;
+
+  /**
+   * Get the current size of the shared congestion window.
+   * @return The number of Interests allowed in flight.
+   */
+  double
+  getCwnd() const;
+
+private:
+  Face& face_;
+  SegmentFetcher::Options options_;
+  ptr_lib::shared_ptr<CongestionWindow> window_;
+};
+
+}
+
+#endif
@@ -23,15 +23,20 @@
 #define NDN_MEMORY_CONTENT_CACHE_HPP
 
 #include <map>
-#include <deque>
+#include <list>
 #include "../face.hpp"
 
 namespace ndn {
 
+template<class T> class NameTrie;
+
 /**
  * A MemoryContentCache holds a set of Data packets and answers an Interest to
  * return the correct Data packet. The cache is periodically cleaned up to
  * remove each stale Data packet based on its FreshnessPeriod (if it has one).
+ * The Data packets are indexed by name so that answering an Interest only
+ * searches the Data packets under the Interest name. You can limit the size
+ * of the cache with setMaxEntries() and setMaxBytes().
  * @note This class is an experimental feature.  See the API docs for more detail at
  * http://named-data.net/doc/ndn-ccl-api/memory-content-cache.html .
  */
@@ -310,10 +315,12 @@ public:
 
   /**
    * Add the Data packet to the cache so that it is available to use to
-   * answer interests. If data.getMetaInfo().getFreshnessPeriod() is not
+   * answer interests. This replaces a Data packet in the cache with the same
+   * name, and calls the OnContentRemoved callback with the replaced content. If data.getMetaInfo().getFreshnessPeriod() is not
    * negative, set the staleness time to now plus the maximum of
    * data.getMetaInfo().getFreshnessPeriod() and minimumCacheLifetime, which is
-   * checked during cleanup to remove stale content.
+   * checked during cleanup to remove stale content. If the cache exceeds
+   * getMaxEntries() or getMaxBytes(), remove the least recently used content.
    * This also checks if cleanupIntervalMilliseconds
    * milliseconds have passed and removes stale content from the cache. After
    * removing stale content, remove timed-out pending interests from
@@ -400,7 +407,9 @@ public:
 
   /**
    * Set the OnContentRemoved callback to call when stale content is removed
-   * from the cache during cleanup. Note: Because onContentRemoved is called
+   * from the cache during cleanup, content is removed to stay within
+   * getMaxEntries() or getMaxBytes(), or add() replaces content with the same
+   * name. Note: Because onContentRemoved is called
    * while processing incoming Interests, it should return quickly to allow the
    * Interest to be processed quickly.
    * @param onContentRemoved This calls onContentRemoved(contentList) where
@@ -435,6 +444,82 @@ public:
     impl_->setMinimumCacheLifetime(minimumCacheLifetime);
   }
 
+  /**
+   * Get the maximum number of Data packets in the cache.
+   * @return The maximum number of Data packets, or 0 for no limit.
+   */
+  size_t
+  getMaxEntries() { return impl_->getMaxEntries(); }
+
+  /**
+   * Set the maximum number of Data packets in the cache. When add(data) would
+   * exceed the limit, remove the least recently used Data packet (the one
+   * least recently added or used to answer an Interest). If the cache already
+   * has more Data packets, remove the least recently used now.
+   * @param maxEntries The maximum number of Data packets, or 0 for no limit
+   * (the default).
+   */
+  void
+  setMaxEntries(size_t maxEntries) { impl_->setMaxEntries(maxEntries); }
+
+  /**
+   * Get the maximum total size of the encoded Data packets in the cache.
+   * @return The maximum number of bytes, or 0 for no limit.
+   */
+  size_t
+  getMaxBytes() { return impl_->getMaxBytes(); }
+
+  /**
+   * Set the maximum total size of the encoded Data packets in the cache. When
+   * add(data) would exceed the limit, remove the least recently used Data
+   * packets. A Data packet whose encoding is larger than maxBytes is not
+   * added to the cache. If the cache is already larger, remove the least
+   * recently used Data packets now.
+   * @param maxBytes The maximum number of bytes, or 0 for no limit (the
+   * default).
+   */
+  void
+  setMaxBytes(size_t maxBytes) { impl_->setMaxBytes(maxBytes); }
+
+  /**
+   * Get the number of Data packets in the cache.
+   * @return The number of Data packets.
+   */
+  size_t
+  getNEntries() { return impl_->getNEntries(); }
+
+  /**
+   * Get the total size of the encoded Data packets in the cache.
+   * @return The number of bytes.
+   */
+  size_t
+  getNBytes() { return impl_->getNBytes(); }
+
+  /**
+   * Get the number of Interests which were answered with a Data packet from
+   * the cache.
+   * @return The number of hits.
+   */
+  uint64_t
+  getNHits() { return impl_->getNHits(); }
+
+  /**
+   * Get the number of Interests for which no Data packet was found in the
+   * cache.
+   * @return The number of misses.
+   */
+  uint64_t
+  getNMisses() { return impl_->getNMisses(); }
+
+  /**
+   * Get the number of Data packets which were removed to stay within
+   * getMaxEntries() and getMaxBytes(). This does not count stale content
+   * removed during cleanup.
+   * @return The number of evictions.
+   */
+  uint64_t
+  getNEvictions() { return impl_->getNEvictions(); }
+
 private:
   /**
    * MemoryContentCache::Impl does the work of MemoryContentCache. It is a
@@ -510,6 +595,33 @@ private:
       minimumCacheLifetime_ = minimumCacheLifetime;
     }
 
+    size_t
+    getMaxEntries() { return maxEntries_; }
+
+    void
+    setMaxEntries(size_t maxEntries);
+
+    size_t
+    getMaxBytes() { return maxBytes_; }
+
+    void
+    setMaxBytes(size_t maxBytes);
+
+    size_t
+    getNEntries() { return nEntries_; }
+
+    size_t
+    getNBytes() { return nBytes_; }
+
+    uint64_t
+    getNHits() { return nHits_; }
+
+    uint64_t
+    getNMisses() { return nMisses_; }
+
+    uint64_t
+    getNEvictions() { return nEvictions_; }
+
     /**
      * This is the OnInterestCallback which is called when the library receives
      * an interest whose name has the prefix given to registerPrefix. First
@@ -527,88 +639,63 @@ private:
        const ptr_lib::shared_ptr<const InterestFilter>& filter);
 
   private:
-    /**
-     * StaleTimeContent extends Content to include the cacheRemovalTimeMilliseconds_
-     * for when this entry should be cleaned up from the cache.
-     */
-    class StaleTimeContent : public Content {
-    public:
-      /**
-       * Create a new StaleTimeContent to hold data's name and wire encoding
-       * as well as the cacheRemovalTimeMilliseconds_ which is now plus the
-       * maximum of data.getMetaInfo().getFreshnessPeriod() and the
-       * minimumCacheLifetime.
-       * @param data The Data packet whose name and wire encoding are copied.
-       * @param nowMilliseconds The current time in milliseconds from
-       * ndn_getNowMilliseconds.
-       * @param minimumCacheLifetime The minimum cache lifetime in milliseconds.
-       */
-      StaleTimeContent
-        (const Data& data, MillisecondsSince1970 nowMilliseconds,
-         Milliseconds minimumCacheLifetime);
-
-      /**
-       * Check if this content is stale and should be removed from the cache,
-       * according to the content freshness period and the minimumCacheLifetime.
-       * @param nowMilliseconds The current time in milliseconds from
-       * ndn_getNowMilliseconds.
-       * @return True if this content should be removed, otherwise false.
-       */
-      bool
-      isPastRemovalTime(MillisecondsSince1970 nowMilliseconds) const
-      {
-        return cacheRemovalTimeMilliseconds_ <= nowMilliseconds;
-      }
-
-      /**
-       * Check if the content is still fresh according to its freshness period
-       * (independent of when to remove from the cache).
-       * @param nowMilliseconds The current time in milliseconds from
-       * ndn_getNowMilliseconds.
-       * @return True if the content is still fresh, otherwise false.
-       */
-      bool
-      isFresh(MillisecondsSince1970 nowMilliseconds) const
-      {
-        return freshnessExpiryTimeMilliseconds_ > nowMilliseconds;
-      }
-
-      /**
-       * Compare shared_ptrs to Content based only on cacheRemovalTimeMilliseconds_.
-       */
-      class Compare {
-      public:
-        bool
-        operator()
-          (const ptr_lib::shared_ptr<const StaleTimeContent>& x,
-           const ptr_lib::shared_ptr<const StaleTimeContent>& y) const
-        {
-          return x->cacheRemovalTimeMilliseconds_ < y->cacheRemovalTimeMilliseconds_;
-        }
-      };
-
-    private:
-      MillisecondsSince1970 cacheRemovalTimeMilliseconds_; /**< The time when the content
-        becomes stale and should be removed from the cache in milliseconds
-        according to ndn_getNowMilliseconds */
-      MillisecondsSince1970 freshnessExpiryTimeMilliseconds_; /**< The time when
-        the freshness period of the content expires (independent of when to
-        remove from the cache) in milliseconds according to ndn_getNowMilliseconds */
-    };
+    class Entry;
+    class MatchVisitor;
+    typedef NameTrie<ptr_lib::shared_ptr<Entry> > ContentTrie;
+    typedef std::list<Entry*> EntryList;
+    typedef std::multimap<MillisecondsSince1970, Entry*> RemovalTimeMap;
 
     /**
      * Check if now is greater than nextCleanupTime_ and, if so, remove stale
-     * content from staleTimeCache_ and reset nextCleanupTime_ based on
-     * cleanupIntervalMilliseconds_. Since add(Data) does a sorted insert into
-     * staleTimeCache_, the check for stale data is quick and does not require
-     * searching the entire staleTimeCache_. If onContentRemoved_ is defined,
-     * this calls onContentRemoved_(content) for the removed content.
+     * content from the cache and reset nextCleanupTime_ based on
+     * cleanupIntervalMilliseconds_. Since removalTimes_ is sorted by the
+     * cache removal time, the check for stale data only visits the entries
+     * which are removed. If onContentRemoved_ is defined, this calls
+     * onContentRemoved_(content) for the removed content.
      * @param nowMilliseconds The current time in milliseconds from
      * ndn_getNowMilliseconds.
      */
     void
     doCleanup(MillisecondsSince1970 nowMilliseconds);
 
+    /**
+     * Find the best entry in the cache for the interest, searching only the
+     * entries under the interest name in contentTrie_ and using the
+     * ChildSelector (if specified) to choose among matching entries.
+     * @param interest The Interest to match.
+     * @param nowMilliseconds The current time in milliseconds from
+     * ndn_getNowMilliseconds, used to check MustBeFresh.
+     * @return The matching entry, or null if not found.
+     */
+    Entry*
+    findEntry(const Interest& interest, MillisecondsSince1970 nowMilliseconds);
+
+    /**
+     * Remove the entry from contentTrie_, entriesByUse_ and removalTimes_ and
+     * update the counts. After this returns, the caller must not use the entry
+     * pointer.
+     * @param entry The entry to remove.
+     * @return The entry's content, for example to give to onContentRemoved_.
+     */
+    ptr_lib::shared_ptr<const Content>
+    removeEntry(Entry* entry);
+
+    /**
+     * Remove the least recently used entries until the cache is within
+     * maxEntries_ and maxBytes_, and add the removed content to contentList.
+     * @param contentList If onContentRemoved_ is defined, add the removed
+     * content to this list, creating the list if it is null.
+     */
+    void
+    evictToLimits(ptr_lib::shared_ptr<ContentList>& contentList);
+
+    /**
+     * Call onContentRemoved_(contentList), logging any exception.
+     * @param contentList The list of removed content.
+     */
+    void
+    callOnContentRemoved(const ptr_lib::shared_ptr<ContentList>& contentList);
+
     /**
      * This is a private method to return for setting storePendingInterestCallback_.
      * We need a separate method because the arguments are different from the main
@@ -630,10 +717,19 @@ private:
     std::map<std::string, OnInterestCallback> onDataNotFoundForPrefix_; /**< The map key is the prefix.toUri() */
     std::vector<uint64_t> interestFilterIdList_;
     std::vector<uint64_t> registeredPrefixIdList_;
-    std::vector<ptr_lib::shared_ptr<const Content> > noStaleTimeCache_;
-    // Use a deque so we can efficiently remove from the front.
-    std::deque<ptr_lib::shared_ptr<const StaleTimeContent> > staleTimeCache_;
-    StaleTimeContent::Compare contentCompare_;
+    // Each trie node holds the entries whose content has the node's name.
+    ptr_lib::shared_ptr<ContentTrie> contentTrie_;
+    // The most recently used entry is first.
+    EntryList entriesByUse_;
+    // Only the entries with a FreshnessPeriod, sorted by cache removal time.
+    RemovalTimeMap removalTimes_;
+    size_t nEntries_;
+    size_t nBytes_;
+    size_t maxEntries_;
+    size_t maxBytes_;
+    uint64_t nHits_;
+    uint64_t nMisses_;
+    uint64_t nEvictions_;
     Name::Component emptyComponent_;
     std::vector<ptr_lib::shared_ptr<const PendingInterest> > pendingInterestTable_;
     OnInterestCallback storePendingInterestCallback_;
@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_PERSISTENT_CONTENT_STORE_HPP
+#define NDN_PERSISTENT_CONTENT_STORE_HPP
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_MMAP.
+#include "../ndn-cpp-config.h"
+#if NDN_CPP_HAVE_MMAP
+
+#include <map>
+#include <string>
+#include "../face.hpp"
+#include "../lite/util/blob-lite.hpp"
+
+namespace ndn {
+
+/**
+ * A PersistentContentStore keeps the wire encoding of already-signed Data
+ * packets in a file and answers an Interest by sending the encoding directly
+ * from a memory mapping of the file. The Data file is append-only and only
+ * holds the concatenated Data encodings. A separate index file (the Data file
+ * path plus ".index") holds the name, offset and length of each Data packet so
+ * that opening an existing store only reads the index, not the Data packets.
+ * The operating system pages in a Data packet when it is sent, so the store
+ * can be larger than the available memory.
+ *
+ * If the process stops while adding a Data packet, the constructor removes an
+ * incomplete Data packet at the end of the Data file and adds index entries
+ * for complete Data packets which are missing from the index file.
+ *
+ * Adding a Data packet with the same name as an existing one replaces it in
+ * the index, but the old encoding remains in the Data file.
+ */
+class PersistentContentStore {
+public:
+  /**
+   * Open the Data file and index file, creating them if they don't exist, and
+   * read the index.
+   * @param filePath The path of the Data file. The index file path is filePath
+   * plus ".index".
+   * @throws runtime_error If the files can't be opened or mapped.
+   */
+  PersistentContentStore(const std::string& filePath);
+
+  ~PersistentContentStore();
+
+  /**
+   * Append the wire encoding of the Data packet to the Data file and add its
+   * name to the index. You should sign the Data packet before adding it. This
+   * invalidates the BlobLite from a previous call to find.
+   * @param data The Data packet to add. This calls data.wireEncode(), which
+   * uses the cached encoding if the Data packet was signed.
+   * @throws runtime_error If the files can't be written.
+   */
+  void
+  add(const Data& data);
+
+  /**
+   * Find the encoding of the first Data packet in the canonical order which
+   * matches the Interest. If the last component of the Interest name is an
+   * implicit digest, this checks the digest of the Data packet. This doesn't
+   * check MustBeFresh since the Data packet comes from the producer and a
+   * downstream cache counts the FreshnessPeriod from when it receives it.
+   * @param interest The Interest to match.
+   * @return A BlobLite with a pointer into the memory mapping of the Data file,
+   * or an isNull() BlobLite if not found. The BlobLite is only valid until the
+   * next call to add.
+   */
+  BlobLite
+  find(const Interest& interest) const;
+
+  /**
+   * Call setInterestFilter on the Face so that this store answers Interests
+   * for the prefix by sending the Data encoding from the memory mapping.
+   * This object must remain valid while the Face can call the callback.
+   * @param face The Face on which to call setInterestFilter.
+   * @param prefix The Name prefix for the Interest filter.
+   * @param onDataNotFound (optional) If a Data packet for an Interest is not
+   * found in the store, call onDataNotFound(prefix, interest, face,
+   * interestFilterId, filter). If omitted or an empty OnInterestCallback(),
+   * don't answer the Interest.
+   * @return The interest filter ID from Face::setInterestFilter.
+   */
+  uint64_t
+  setInterestFilter
+    (Face& face, const Name& prefix,
+     const OnInterestCallback& onDataNotFound = OnInterestCallback());
+
+  /**
+   * Get the number of names in the index.
+   * @return The number of names.
+   */
+  size_t
+  size() const { return records_.size(); }
+
+  /**
+   * Get the size of the Data file, including the encodings of Data packets
+   * which were replaced.
+   * @return The number of bytes in the Data file.
+   */
+  uint64_t
+  getNBytes() const { return dataFileSize_; }
+
+private:
+  /**
+   * A Record has the offset and length of a Data encoding in the Data file.
+   */
+  class Record {
+  public:
+    Record(uint64_t offset = 0, size_t length = 0)
+    : offset_(offset), length_(length)
+    {
+    }
+
+    uint64_t offset_;
+    size_t length_;
+  };
+
+  typedef std::map<Name, Record> RecordMap;
+
+  /**
+   * Read the index file and add its entries to records_. Then add index
+   * entries for complete Data packets after the last indexed one, and
+   * truncate an incomplete Data packet at the end of the Data file.
+   */
+  void
+  readIndex();
+
+  /**
+   * Write an index entry for the Data packet to the index file.
+   * @param nameEncoding The wire encoding of the Data name.
+   * @param record The offset and length of the Data encoding.
+   */
+  void
+  writeIndexEntry(const BlobLite& nameEncoding, const Record& record);
+
+  /**
+   * Make sure that the memory mapping of the Data file covers dataFileSize_,
+   * remapping it if needed.
+   */
+  void
+  mapDataFile();
+
+  /**
+   * Unmap the Data file and close the files.
+   */
+  void
+  close();
+
+  /**
+   * Get the Data encoding for the record from the memory mapping.
+   */
+  BlobLite
+  getEncoding(const Record& record) const
+  {
+    return BlobLite(mapping_ + record.offset_, record.length_);
+  }
+
+  void
+  onInterest
+    (const ptr_lib::shared_ptr<const Name>& prefix,
+     const ptr_lib::shared_ptr<const Interest>& interest, Face& face,
+     uint64_t interestFilterId,
+     const ptr_lib::shared_ptr<const InterestFilter>& filter,
+     const OnInterestCallback& onDataNotFound);
+
+  // Don't allow copying since we own the file descriptors and the mapping.
+  PersistentContentStore(const PersistentContentStore& other);
+  PersistentContentStore& operator=(const PersistentContentStore& other);
+
+  std::string dataFilePath_;
+  std::string indexFilePath_;
+  int dataFile_;
+  int indexFile_;
+  uint64_t dataFileSize_;
+  uint64_t indexFileSize_;
+  const uint8_t* mapping_;
+  size_t mappingLength_;
+  RecordMap records_;
+};
+
+}
+
+#endif // NDN_CPP_HAVE_MMAP
+
+#endif
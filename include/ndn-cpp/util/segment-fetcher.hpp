@@ -23,11 +23,17 @@
 #ifndef NDN_SEGMENT_FETCHER_HPP
 #define NDN_SEGMENT_FETCHER_HPP
 
+#include <map>
+#include <deque>
+#include <limits>
 #include "../face.hpp"
 #include "../security/key-chain.hpp"
 
 namespace ndn {
 
+class CongestionWindow;
+class FetchScheduler;
+
 /**
  * SegmentFetcher is a utility class to the fetch latest version of segmented data.
  *
@@ -52,22 +58,47 @@ namespace ndn {
  *
  *    >> Interest: /<prefix>/<version>/<segment=0>
  *
- * 5. Keep sending Interests for the next segment while the retrieved Data does
- *    not have a FinalBlockId or the FinalBlockId != Data.getName().get(-1).
+ * 5. Keep a window of Interests for the following segments outstanding
+ *    until the segment number in the FinalBlockId of a received Data packet
+ *    has been fetched.
  *
  *    >> Interest: /<prefix>/<version>/<segment=(N+1))>
+ *    >> Interest: /<prefix>/<version>/<segment=(N+2))>
+ *    >> ...
  *
  * 6. Call the OnComplete callback with a blob that concatenates the content
  *    from all the segmented objects.
  *
+ * Segments which arrive out of order wait in a reorder buffer until the
+ * segments before them arrive, and are then delivered in order. Instead of
+ * concatenating the content, fetchStream delivers each segment to an
+ * OnSegment callback and fetchToFile writes each segment to a file descriptor
+ * at its offset, so that a large object does not need to be held in memory.
+ * The reorder buffer is bounded by Options.getMaxReorderSegments(), which
+ * limits how far ahead of the next segment to deliver Interests are sent.
+ * Options.setOnProgress can give the progress and throughput.
+ *
+ * The window size is controlled with additive-increase/multiplicative-decrease
+ * (AIMD), starting in slow start. The window is decreased (at most once per
+ * round trip) when a segment times out, when a Data packet has a
+ * CongestionMark, or when a network Nack with reason Congestion is received.
+ * The retransmission timeout (RTO) for each segment follows RFC 6298, and a
+ * segment whose Interest times out is retransmitted. See Options to configure
+ * the window, or to keep it constant. To fetch many objects over one shared
+ * window, see FetchScheduler.
+ *
  * If an error occurs during the fetching process, the OnError callback is called
  * with a proper error code.  The following errors are possible:
  *
- * - `INTEREST_TIMEOUT`: if any of the Interests times out
+ * - `INTEREST_TIMEOUT`: if no Data packet is received within
+ *   Options.getMaxTimeout() while Interests are timing out
  * - `DATA_HAS_NO_SEGMENT`: if any of the retrieved Data packets don't have a segment
  *   as the last component of the name (not counting the implicit digest)
  * - `SEGMENT_VERIFICATION_FAILED`: if any retrieved segment fails
  *   the user-provided VerifySegment callback or KeyChain verifyData.
+ * - `NACK_ERROR`: if a network Nack is received with a reason other than
+ *   Congestion or Duplicate.
+ * - `IO_ERROR`: if fetchToFile cannot write to the file descriptor.
  *
  * In order to validate individual segments, a KeyChain needs to be supplied.
  * If verifyData fails, the fetching process is aborted with
@@ -89,13 +120,372 @@ public:
   enum ErrorCode {
     INTEREST_TIMEOUT = 1,
     DATA_HAS_NO_SEGMENT = 2,
-    SEGMENT_VERIFICATION_FAILED = 3
+    SEGMENT_VERIFICATION_FAILED = 3,
+    NACK_ERROR = 4,
+    IO_ERROR = 5
+  };
+
+  /**
+   * An OnProgress callback is called as segments are delivered.
+   * @param nSegmentsDelivered The number of segments delivered so far.
+   * @param nSegments The total number of segments, or -1 if the FinalBlockId
+   * is not known yet.
+   * @param nBytesDelivered The number of content bytes delivered so far.
+   * @param bytesPerSecond The average throughput since fetching started.
+   */
+  typedef func_lib::function<void
+    (uint64_t nSegmentsDelivered, int64_t nSegments, uint64_t nBytesDelivered,
+     double bytesPerSecond)> OnProgress;
+
+  /**
+   * An Options object holds the settings for the congestion window and
+   * retransmission timer of a SegmentFetcher. The set methods return a
+   * reference to this object so that calls can be chained.
+   */
+  class Options {
+  public:
+    /**
+     * Create an Options with the default values: a window which starts at 1
+     * and adapts with AIMD, and a 60 second maximum time without receiving a
+     * Data packet.
+     */
+    Options()
+    : useConstantCwnd_(false), initCwnd_(1.0),
+      initSsthresh_(std::numeric_limits<double>::max()), aiStep_(1.0),
+      mdCoef_(0.5), resetCwndToInit_(false), ignoreCongestionMarks_(false),
+      maxTimeout_(60000.0), initialRto_(1000.0), minRto_(200.0),
+      maxRto_(60000.0), rtoCheckInterval_(10.0), maxReorderSegments_(1024),
+      progressInterval_(1000.0)
+    {
+    }
+
+    /**
+     * Check if the congestion window is kept at getInitCwnd().
+     * @return True if the window is constant.
+     */
+    bool
+    getUseConstantCwnd() const { return useConstantCwnd_; }
+
+    /**
+     * Get the initial size of the congestion window.
+     * @return The initial window in segments.
+     */
+    double
+    getInitCwnd() const { return initCwnd_; }
+
+    /**
+     * Get the initial slow start threshold.
+     * @return The initial threshold in segments.
+     */
+    double
+    getInitSsthresh() const { return initSsthresh_; }
+
+    /**
+     * Get the additive increase step, which is added to the window for each
+     * segment in slow start, and spread over a window of segments in
+     * congestion avoidance.
+     * @return The step in segments.
+     */
+    double
+    getAiStep() const { return aiStep_; }
+
+    /**
+     * Get the multiplicative decrease coefficient for the window.
+     * @return The coefficient.
+     */
+    double
+    getMdCoef() const { return mdCoef_; }
+
+    /**
+     * Check if the window is reset to getInitCwnd() on a decrease, instead of
+     * to the new slow start threshold.
+     * @return True to reset to the initial window.
+     */
+    bool
+    getResetCwndToInit() const { return resetCwndToInit_; }
+
+    /**
+     * Check if the CongestionMark of received Data packets is ignored.
+     * @return True to ignore congestion marks.
+     */
+    bool
+    getIgnoreCongestionMarks() const { return ignoreCongestionMarks_; }
+
+    /**
+     * Get the maximum time to keep retransmitting without receiving a Data
+     * packet before failing with INTEREST_TIMEOUT.
+     * @return The maximum time in milliseconds.
+     */
+    Milliseconds
+    getMaxTimeout() const { return maxTimeout_; }
+
+    /**
+     * Get the retransmission timeout before the first RTT measurement.
+     * @return The initial RTO in milliseconds.
+     */
+    Milliseconds
+    getInitialRto() const { return initialRto_; }
+
+    /**
+     * Get the lower bound of the retransmission timeout.
+     * @return The minimum RTO in milliseconds.
+     */
+    Milliseconds
+    getMinRto() const { return minRto_; }
+
+    /**
+     * Get the upper bound of the retransmission timeout.
+     * @return The maximum RTO in milliseconds.
+     */
+    Milliseconds
+    getMaxRto() const { return maxRto_; }
+
+    /**
+     * Get the interval between checks for segments whose RTO has expired.
+     * @return The interval in milliseconds.
+     */
+    Milliseconds
+    getRtoCheckInterval() const { return rtoCheckInterval_; }
+
+    /**
+     * Get the maximum number of segments after the next segment to deliver
+     * which can be requested, and so held in the reorder buffer.
+     * @return The maximum number of segments.
+     */
+    size_t
+    getMaxReorderSegments() const { return maxReorderSegments_; }
+
+    /**
+     * Get the OnProgress callback.
+     * @return The callback, or an empty OnProgress() if not set.
+     */
+    const OnProgress&
+    getOnProgress() const { return onProgress_; }
+
+    /**
+     * Get the minimum interval between calls to the OnProgress callback.
+     * @return The interval in milliseconds.
+     */
+    Milliseconds
+    getProgressInterval() const { return progressInterval_; }
+
+    /**
+     * Set whether to keep the congestion window at getInitCwnd(), for example
+     * to fetch with a fixed window of Interests.
+     * @param useConstantCwnd True to keep the window constant.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setUseConstantCwnd(bool useConstantCwnd)
+    {
+      useConstantCwnd_ = useConstantCwnd;
+      return *this;
+    }
+
+    /**
+     * Set the initial size of the congestion window.
+     * @param initCwnd The initial window in segments. This must be at least 1.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setInitCwnd(double initCwnd)
+    {
+      initCwnd_ = initCwnd;
+      return *this;
+    }
+
+    /**
+     * Set the initial slow start threshold.
+     * @param initSsthresh The initial threshold in segments.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setInitSsthresh(double initSsthresh)
+    {
+      initSsthresh_ = initSsthresh;
+      return *this;
+    }
+
+    /**
+     * Set the additive increase step.
+     * @param aiStep The step in segments.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setAiStep(double aiStep)
+    {
+      aiStep_ = aiStep;
+      return *this;
+    }
+
+    /**
+     * Set the multiplicative decrease coefficient.
+     * @param mdCoef The coefficient, between 0 and 1.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setMdCoef(double mdCoef)
+    {
+      mdCoef_ = mdCoef;
+      return *this;
+    }
+
+    /**
+     * Set whether the window is reset to getInitCwnd() on a decrease.
+     * @param resetCwndToInit True to reset to the initial window.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setResetCwndToInit(bool resetCwndToInit)
+    {
+      resetCwndToInit_ = resetCwndToInit;
+      return *this;
+    }
+
+    /**
+     * Set whether to ignore the CongestionMark of received Data packets.
+     * @param ignoreCongestionMarks True to ignore congestion marks.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setIgnoreCongestionMarks(bool ignoreCongestionMarks)
+    {
+      ignoreCongestionMarks_ = ignoreCongestionMarks;
+      return *this;
+    }
+
+    /**
+     * Set the maximum time to keep retransmitting without receiving a Data
+     * packet. Use 0 to fail on the first timeout.
+     * @param maxTimeout The maximum time in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setMaxTimeout(Milliseconds maxTimeout)
+    {
+      maxTimeout_ = maxTimeout;
+      return *this;
+    }
+
+    /**
+     * Set the retransmission timeout before the first RTT measurement.
+     * @param initialRto The initial RTO in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setInitialRto(Milliseconds initialRto)
+    {
+      initialRto_ = initialRto;
+      return *this;
+    }
+
+    /**
+     * Set the lower bound of the retransmission timeout.
+     * @param minRto The minimum RTO in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setMinRto(Milliseconds minRto)
+    {
+      minRto_ = minRto;
+      return *this;
+    }
+
+    /**
+     * Set the upper bound of the retransmission timeout.
+     * @param maxRto The maximum RTO in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setMaxRto(Milliseconds maxRto)
+    {
+      maxRto_ = maxRto;
+      return *this;
+    }
+
+    /**
+     * Set the interval between checks for segments whose RTO has expired.
+     * @param rtoCheckInterval The interval in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setRtoCheckInterval(Milliseconds rtoCheckInterval)
+    {
+      rtoCheckInterval_ = rtoCheckInterval;
+      return *this;
+    }
+
+    /**
+     * Set the maximum number of segments after the next segment to deliver
+     * which can be requested. This bounds the memory for segments which arrive
+     * out of order, but a small value can keep the window from growing while
+     * a lost segment is retransmitted.
+     * @param maxReorderSegments The maximum number of segments. This must be
+     * at least 1.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setMaxReorderSegments(size_t maxReorderSegments)
+    {
+      maxReorderSegments_ = maxReorderSegments;
+      return *this;
+    }
+
+    /**
+     * Set the callback for progress and throughput. It is called at most once
+     * per getProgressInterval() and after the last segment is delivered.
+     * NOTE: The library will log any exceptions thrown by this callback, but
+     * for better error handling the callback should catch and properly handle
+     * any exceptions.
+     * @param onProgress The callback, or an empty OnProgress() for none.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setOnProgress(const OnProgress& onProgress)
+    {
+      onProgress_ = onProgress;
+      return *this;
+    }
+
+    /**
+     * Set the minimum interval between calls to the OnProgress callback.
+     * @param progressInterval The interval in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setProgressInterval(Milliseconds progressInterval)
+    {
+      progressInterval_ = progressInterval;
+      return *this;
+    }
+
+  private:
+    bool useConstantCwnd_;
+    double initCwnd_;
+    double initSsthresh_;
+    double aiStep_;
+    double mdCoef_;
+    bool resetCwndToInit_;
+    bool ignoreCongestionMarks_;
+    Milliseconds maxTimeout_;
+    Milliseconds initialRto_;
+    Milliseconds minRto_;
+    Milliseconds maxRto_;
+    Milliseconds rtoCheckInterval_;
+    size_t maxReorderSegments_;
+    OnProgress onProgress_;
+    Milliseconds progressInterval_;
   };
 
   typedef func_lib::function<bool(const ptr_lib::shared_ptr<Data>& data)> VerifySegment;
 
   typedef func_lib::function<void(const Blob& content)> OnComplete;
 
+  typedef func_lib::function<void
+    (uint64_t segmentNumber, const Blob& content)> OnSegment;
+
+  typedef func_lib::function<void(uint64_t nBytes)> OnStreamComplete;
+
   typedef func_lib::function<void
     (ErrorCode errorCode, const std::string& message)> OnError;
 
@@ -133,11 +523,14 @@ public:
    * NOTE: The library will log any exceptions thrown by this callback, but for
    * better error handling the callback should catch and properly handle any
    * exceptions.
+   * @param options (optional) The Options for the congestion window and
+   * retransmission. If omitted, use the default Options().
    */
   static void
   fetch
     (Face& face, const Interest &baseInterest, const VerifySegment& verifySegment,
-     const OnComplete& onComplete, const OnError& onError);
+     const OnComplete& onComplete, const OnError& onError,
+     const Options& options = Options());
 
   /**
    * Initiate segment fetching. For more details, see the documentation for
@@ -165,49 +558,270 @@ public:
    * NOTE: The library will log any exceptions thrown by this callback, but for
    * better error handling the callback should catch and properly handle any
    * exceptions.
+   * @param options (optional) The Options for the congestion window and
+   * retransmission. If omitted, use the default Options().
    */
   static void
   fetch
     (Face& face, const Interest &baseInterest, KeyChain* validatorKeyChain,
-     const OnComplete& onComplete, const OnError& onError);
+     const OnComplete& onComplete, const OnError& onError,
+     const Options& options = Options());
+
+  /**
+   * Initiate segment fetching like fetch, but deliver each segment in order
+   * to onSegment as soon as it and the segments before it are received,
+   * instead of concatenating the content. For more details, see the
+   * documentation for the class.
+   * @param face This calls face.expressInterest to fetch more segments.
+   * @param baseInterest An Interest for the initial segment of the requested
+   * data. See fetch for details.
+   * @param validatorKeyChain When a Data packet is received this calls
+   * validatorKeyChain->verifyData(data). See fetch for details. If
+   * validatorKeyChain is null, this does not validate the data packet.
+   * @param onSegment Call onSegment(segmentNumber, content) for each segment
+   * in order, starting from segment 0.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param onComplete After the last segment is delivered, call
+   * onComplete(nBytes) where nBytes is the total content size.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param onError Call onError(errorCode, message) for timeout or an error
+   * processing segments. Segments already given to onSegment are not
+   * delivered again.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param options (optional) The Options for the congestion window,
+   * retransmission and reorder buffer. If omitted, use the default Options().
+   */
+  static void
+  fetchStream
+    (Face& face, const Interest &baseInterest, KeyChain* validatorKeyChain,
+     const OnSegment& onSegment, const OnStreamComplete& onComplete,
+     const OnError& onError, const Options& options = Options());
+
+  /**
+   * Initiate segment fetching like fetchStream, but write the content of each
+   * segment to the file descriptor with pwrite at its offset in the object,
+   * starting at fileOffset. This does not change the file position. For more
+   * details, see the documentation for the class.
+   * @param face This calls face.expressInterest to fetch more segments.
+   * @param baseInterest An Interest for the initial segment of the requested
+   * data. See fetch for details.
+   * @param validatorKeyChain When a Data packet is received this calls
+   * validatorKeyChain->verifyData(data). See fetch for details. If
+   * validatorKeyChain is null, this does not validate the data packet.
+   * @param fd The file descriptor open for writing. This does not close it.
+   * @param fileOffset The offset in the file for the start of the content.
+   * @param onComplete After the last segment is written, call
+   * onComplete(nBytes) where nBytes is the total content size.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param onError Call onError(errorCode, message) for timeout or an error
+   * processing segments, or with IO_ERROR if a write fails.
+   * NOTE: The library will log any exceptions thrown by this callback, but for
+   * better error handling the callback should catch and properly handle any
+   * exceptions.
+   * @param options (optional) The Options for the congestion window,
+   * retransmission and reorder buffer. If omitted, use the default Options().
+   */
+  static void
+  fetchToFile
+    (Face& face, const Interest &baseInterest, KeyChain* validatorKeyChain,
+     int fd, uint64_t fileOffset, const OnStreamComplete& onComplete,
+     const OnError& onError, const Options& options = Options());
 
 private:
+  friend class CongestionWindow;
+  friend class FetchScheduler;
+
+  enum SegmentState {
+    // The Interest for the segment was sent once and is pending.
+    FIRST_INTEREST,
+    // The Interest timed out and the segment waits in retransmitQueue_.
+    IN_RETRANSMIT_QUEUE,
+    // The Interest for the segment was retransmitted and is pending.
+    RETRANSMITTED
+  };
+
+  class PendingSegment {
+  public:
+    SegmentState state;
+    MillisecondsSince1970 sendTime;
+    Milliseconds rto;
+    uint64_t pendingInterestId;
+    // The sequence number from CongestionWindow::onInterestSent.
+    uint64_t sendSequence;
+  };
+
   /**
    * Create a new SegmentFetcher to use the Face. See the static fetch method
    * for details. If validatorKeyChain is not null, use it and ignore
-   * verifySegment. After creating the SegmentFetcher, call fetchFirstSegment.
+   * verifySegment. After creating the SegmentFetcher, call start.
+   * @param window The CongestionWindow shared with other fetchers, or null to
+   * create one from the options for this fetcher.
+   * @param priority The share of the window relative to the other fetchers.
    */
   SegmentFetcher
     (Face& face, KeyChain* validatorKeyChain, const VerifySegment& verifySegment,
-     const OnComplete& onComplete, const OnError& onError)
-  : face_(face), validatorKeyChain_(validatorKeyChain), verifySegment_(verifySegment),
-    onComplete_(onComplete), onError_(onError)
-  {
-  }
+     const OnComplete& onComplete, const OnError& onError,
+     const Options& options, const Interest& baseInterest,
+     const ptr_lib::shared_ptr<CongestionWindow>& window =
+       ptr_lib::shared_ptr<CongestionWindow>(),
+     double priority = 1.0);
+
+  /**
+   * Add this to the window and let the window schedule the discovery
+   * Interest.
+   */
+  void
+  start();
 
+  /**
+   * Check if this can send an Interest for version discovery, for a segment
+   * in the retransmit queue or for a new segment.
+   * @return True if sendNextInterest will send an Interest.
+   */
+  bool
+  hasInterestToSend();
+
+  /**
+   * Send the next Interest as described in hasInterestToSend. The window
+   * calls this when it has room.
+   */
   void
-  fetchFirstSegment(const Interest& baseInterest);
+  sendNextInterest();
 
   void
-  fetchNextSegment
-    (const Interest& originalInterest, const Name& dataName, uint64_t segment);
+  sendDiscoveryInterest();
 
+  /**
+   * Let the window send the discovery Interest again.
+   */
   void
-  onSegmentReceived
-    (const ptr_lib::shared_ptr<const Interest>& originalInterest,
+  retryDiscoveryInterest();
+
+  /**
+   * Count an Interest sent by this fetcher through window_.
+   * @return The sequence number from CongestionWindow::onInterestSent.
+   */
+  uint64_t
+  onInterestSent();
+
+  /**
+   * Count an Interest of this fetcher which is no longer in flight.
+   */
+  void
+  onInterestDone();
+
+  void
+  onDiscoveryData
+    (const ptr_lib::shared_ptr<const Interest>& interest,
      const ptr_lib::shared_ptr<Data>& data);
 
   void
-  onVerified
-    (const ptr_lib::shared_ptr<Data>& data,
-     const ptr_lib::shared_ptr<const Interest>& originalInterest);
+  onDiscoveryTimeout(const ptr_lib::shared_ptr<const Interest>& interest);
+
+  void
+  sendSegmentInterest(uint64_t segment, bool isRetransmission);
+
+  void
+  onSegmentData
+    (const ptr_lib::shared_ptr<const Interest>& interest,
+     const ptr_lib::shared_ptr<Data>& data, uint64_t segment);
+
+  void
+  onSegmentTimeout
+    (const ptr_lib::shared_ptr<const Interest>& interest, uint64_t segment);
+
+  /**
+   * Handle a network Nack.
+   * @param segment The segment number, or -1 for the discovery Interest.
+   */
+  void
+  onNetworkNack
+    (const ptr_lib::shared_ptr<const Interest>& interest,
+     const ptr_lib::shared_ptr<NetworkNack>& networkNack, int64_t segment);
+
+  /**
+   * Call verifySegment_ or validatorKeyChain_, and then onVerified.
+   */
+  void
+  verify(const ptr_lib::shared_ptr<Data>& data, bool isDiscovery);
+
+  void
+  onVerified(const ptr_lib::shared_ptr<Data>& data, bool isDiscovery);
 
   void
   onValidationFailed
     (const ptr_lib::shared_ptr<Data>& data, const std::string& reason);
 
+  /**
+   * Periodically retransmit the segments whose RTO has expired.
+   */
+  void
+  checkRto();
+
+  /**
+   * Mark the pending segment as timed out and add it to retransmitQueue_.
+   */
+  void
+  enqueueForRetransmission(std::map<uint64_t, PendingSegment>::iterator entry);
+
+  /**
+   * If the maximum time without receiving a Data packet is exceeded, call
+   * onError with INTEREST_TIMEOUT and stop.
+   * @param name The Interest name for the error message.
+   * @return True if fetching is stopped.
+   */
+  bool
+  checkMaxTimeout(const Name& name);
+
+  /**
+   * Remove the pending Interests and received content for segments after
+   * finalSegmentNumber_.
+   */
+  void
+  cancelSegmentsAfterFinal();
+
+  /**
+   * Deliver the segments at the front of the reorder buffer which are next
+   * in order.
+   */
+  void
+  deliverSegments();
+
+  /**
+   * Deliver the content of the next segment to contentParts_, onSegment_ or
+   * fd_.
+   * @return False if fetching was stopped with an error.
+   */
+  bool
+  deliverSegment(uint64_t segment, const Blob& content);
+
   void
-  onTimeout(const ptr_lib::shared_ptr<const Interest>& interest);
+  reportProgress();
+
+  /**
+   * Stop and call onComplete_ with the concatenated contentParts_, or
+   * onStreamComplete_.
+   */
+  void
+  finish();
+
+  /**
+   * Remove all pending Interests and the RTO check so that no more callbacks
+   * are processed.
+   */
+  void
+  stop();
+
+  void
+  reportError(ErrorCode errorCode, const std::string& message);
 
   /**
    * Check if the last component in the name is a segment number.
@@ -220,12 +834,46 @@ private:
     return name.size() >= 1 && name.get(-1).isSegment();
   }
 
-  std::vector<Blob> contentParts_;
   Face& face_;
   KeyChain* validatorKeyChain_;
   VerifySegment verifySegment_;
   OnComplete onComplete_;
+  OnSegment onSegment_;
+  OnStreamComplete onStreamComplete_;
+  // -1 if not writing to a file.
+  int fd_;
+  uint64_t fileOffset_;
   OnError onError_;
+  Options options_;
+  Interest baseInterest_;
+  ptr_lib::shared_ptr<CongestionWindow> window_;
+  double priority_;
+  Name versionedDataName_;
+  bool isStopped_;
+  // The number of Interests in flight through window_, including discovery.
+  int nInterestsInFlight_;
+  uint64_t nextSegmentNumber_;
+  // -1 until a FinalBlockId is received.
+  int64_t finalSegmentNumber_;
+  // True until the discovery Interest is sent, or to send it again.
+  bool needDiscoveryInterest_;
+  bool isDiscoveryPending_;
+  bool isVersionDiscovered_;
+  MillisecondsSince1970 discoverySendTime_;
+  bool isDiscoveryRetransmitted_;
+  uint64_t discoveryInterestId_;
+  MillisecondsSince1970 timeLastSegmentReceived_;
+  uint64_t rtoCheckCallId_;
+  std::map<uint64_t, PendingSegment> pendingSegments_;
+  std::deque<uint64_t> retransmitQueue_;
+  // The reorder buffer of segments received after nextSegmentToDeliver_.
+  std::map<uint64_t, Blob> receivedSegments_;
+  uint64_t nextSegmentToDeliver_;
+  uint64_t nBytesDelivered_;
+  // The delivered content for fetch.
+  std::vector<Blob> contentParts_;
+  MillisecondsSince1970 startTime_;
+  MillisecondsSince1970 lastProgressTime_;
 };
 
 }
@@ -0,0 +1,309 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_SEGMENT_PUBLISHER_HPP
+#define NDN_SEGMENT_PUBLISHER_HPP
+
+#include <vector>
+#include "../security/key-chain.hpp"
+#include "memory-content-cache.hpp"
+
+namespace ndn {
+
+/**
+ * SegmentPublisher is a utility class to slice a buffer or a file into signed
+ * segment Data packets named /<prefix>/<version>/<segment>, which
+ * SegmentFetcher can fetch. The segments are created all at once so that they
+ * can be put in a content store, ready to serve.
+ *
+ * Signing is the slow part. There are two signing modes:
+ * - SIGN_EACH_SEGMENT signs each segment with the SigningInfo. The first
+ *   segment is signed on the calling thread, and the rest are signed by
+ *   Options.getNThreads() worker threads at the same time. (This requires a
+ *   security v2 KeyChain and pthreads. Otherwise all are signed on the calling
+ *   thread.)
+ * - SIGN_MANIFEST signs each segment with a DigestSha256Signature and makes
+ *   one manifest Data packet whose content is the implicit SHA-256 digest of
+ *   each segment, in order. Only the manifest is signed with the SigningInfo.
+ *   A consumer verifies the manifest once, then uses verifyWithManifest for
+ *   each segment.
+ */
+class SegmentPublisher {
+public:
+  enum SigningMode {
+    SIGN_EACH_SEGMENT = 0,
+    SIGN_MANIFEST = 1
+  };
+
+  /**
+   * SegmentPublisher::Options holds the settings for slicing and signing. The
+   * set methods return a reference to this object so that they can be chained.
+   */
+  class Options {
+  public:
+    Options()
+    : segmentSize_(DEFAULT_SEGMENT_SIZE), nThreads_(0),
+      signingMode_(SIGN_EACH_SEGMENT), freshnessPeriod_(-1)
+    {
+    }
+
+    /**
+     * Get the maximum number of content bytes in each segment.
+     * @return The segment size.
+     */
+    size_t
+    getSegmentSize() const { return segmentSize_; }
+
+    /**
+     * Set the maximum number of content bytes in each segment. The default is
+     * DEFAULT_SEGMENT_SIZE, which leaves room in MAX_NDN_PACKET_SIZE for the
+     * name and an RSA signature.
+     * @param segmentSize The segment size.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setSegmentSize(size_t segmentSize)
+    {
+      segmentSize_ = segmentSize;
+      return *this;
+    }
+
+    /**
+     * Get the number of threads which sign segments in SIGN_EACH_SEGMENT mode.
+     * @return The number of threads, or 0 to use the number of online
+     * processors.
+     */
+    size_t
+    getNThreads() const { return nThreads_; }
+
+    /**
+     * Set the number of threads which sign segments in SIGN_EACH_SEGMENT mode.
+     * The default is 0, which uses the number of online processors. Use 1 to
+     * sign all segments on the calling thread. If the library is not built
+     * with POSIX threads (NDN_CPP_HAVE_POSIX_THREADS), then 0 signs on the
+     * calling thread and the SegmentPublisher constructor throws an exception
+     * for a value greater than 1.
+     * @param nThreads The number of threads.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setNThreads(size_t nThreads)
+    {
+      nThreads_ = nThreads;
+      return *this;
+    }
+
+    /**
+     * Get the signing mode.
+     * @return The SigningMode.
+     */
+    SigningMode
+    getSigningMode() const { return signingMode_; }
+
+    /**
+     * Set the signing mode. The default is SIGN_EACH_SEGMENT.
+     * @param signingMode The SigningMode.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setSigningMode(SigningMode signingMode)
+    {
+      signingMode_ = signingMode;
+      return *this;
+    }
+
+    /**
+     * Get the freshness period of the segments and manifest.
+     * @return The freshness period in milliseconds, or -1 to not set it.
+     */
+    Milliseconds
+    getFreshnessPeriod() const { return freshnessPeriod_; }
+
+    /**
+     * Set the freshness period of the segments and manifest. The default is
+     * -1, which does not set the freshness period.
+     * @param freshnessPeriod The freshness period in milliseconds.
+     * @return This Options so that you can chain calls to update values.
+     */
+    Options&
+    setFreshnessPeriod(Milliseconds freshnessPeriod)
+    {
+      freshnessPeriod_ = freshnessPeriod;
+      return *this;
+    }
+
+  private:
+    size_t segmentSize_;
+    size_t nThreads_;
+    SigningMode signingMode_;
+    Milliseconds freshnessPeriod_;
+  };
+
+  /**
+   * Create a SegmentPublisher.
+   * @param keyChain The KeyChain for signing. This keeps a reference to the
+   * KeyChain, so it must remain valid. While publish is signing with worker
+   * threads, the KeyChain must not be used by another thread.
+   * @param signingInfo (optional) The SigningInfo for signing the segments, or
+   * the manifest in SIGN_MANIFEST mode. If omitted, use the default
+   * SigningInfo().
+   * @param options (optional) The Options. If omitted, use Options().
+   * @throws runtime_error if options.getNThreads() is greater than 1 but the
+   * library is not built with POSIX threads.
+   */
+  SegmentPublisher
+    (KeyChain& keyChain, const SigningInfo& signingInfo = SigningInfo(),
+     const Options& options = Options());
+
+  /**
+   * Slice the content into signed segment Data packets.
+   * @param prefix The name prefix of the object.
+   * @param content The content bytes.
+   * @param contentLength The number of content bytes. If this is 0, make one
+   * segment with empty content.
+   * @param version The version number to append to the prefix.
+   * @param segments Append the segment Data packets to this vector, in order
+   * of segment number. This does not clear the vector first.
+   * @return The versioned name /<prefix>/<version>.
+   * @throws KeyChain::Error if signing fails.
+   */
+  Name
+  publish
+    (const Name& prefix, const uint8_t* content, size_t contentLength,
+     uint64_t version, std::vector<ptr_lib::shared_ptr<Data> >& segments);
+
+  /**
+   * Slice the content into signed segment Data packets, using the current
+   * time in milliseconds as the version.
+   * @param prefix The name prefix of the object.
+   * @param content The content to slice.
+   * @param segments Append the segment Data packets to this vector, in order
+   * of segment number. This does not clear the vector first.
+   * @return The versioned name /<prefix>/<version>.
+   * @throws KeyChain::Error if signing fails.
+   */
+  Name
+  publish
+    (const Name& prefix, const Blob& content,
+     std::vector<ptr_lib::shared_ptr<Data> >& segments);
+
+  /**
+   * Slice the content into signed segment Data packets, using the current
+   * time in milliseconds as the version, and add them to the content cache
+   * where they are ready to answer Interests. In SIGN_MANIFEST mode, this
+   * does not add the manifest (see getManifest).
+   * @param prefix The name prefix of the object.
+   * @param content The content to slice.
+   * @param contentCache The MemoryContentCache to add the segments to.
+   * @return The versioned name /<prefix>/<version>.
+   * @throws KeyChain::Error if signing fails.
+   */
+  Name
+  publish
+    (const Name& prefix, const Blob& content, MemoryContentCache& contentCache);
+
+  /**
+   * Read the file and slice its content into signed segment Data packets,
+   * using the current time in milliseconds as the version.
+   * @param prefix The name prefix of the object.
+   * @param filePath The path of the file to read.
+   * @param segments Append the segment Data packets to this vector, in order
+   * of segment number. This does not clear the vector first.
+   * @return The versioned name /<prefix>/<version>.
+   * @throws std::runtime_error if the file cannot be read.
+   * @throws KeyChain::Error if signing fails.
+   */
+  Name
+  publishFile
+    (const Name& prefix, const std::string& filePath,
+     std::vector<ptr_lib::shared_ptr<Data> >& segments);
+
+  /**
+   * Get the manifest from the last call to publish in SIGN_MANIFEST mode. Its
+   * name is /<prefix>/<version>/_manifest. The application should serve it
+   * separately from the segments, for example from a different content
+   * cache, so that it doesn't answer the version discovery Interest of a
+   * SegmentFetcher.
+   * @return The signed manifest Data packet, or null if not in SIGN_MANIFEST
+   * mode.
+   */
+  const ptr_lib::shared_ptr<Data>&
+  getManifest() const { return manifest_; }
+
+  /**
+   * Check that the segment is listed in the manifest, by comparing its
+   * implicit SHA-256 digest with the manifest entry for its segment number.
+   * The caller should already have verified the manifest signature. To use
+   * this with SegmentFetcher, bind the manifest to make a VerifySegment.
+   * @param manifest The manifest from SIGN_MANIFEST mode.
+   * @param segment The segment Data packet.
+   * @return True if the segment matches the manifest, otherwise false.
+   */
+  static bool
+  verifyWithManifest
+    (const ptr_lib::shared_ptr<Data>& manifest,
+     const ptr_lib::shared_ptr<Data>& segment);
+
+  /**
+   * Get the number of segments made by the last call to publish.
+   * @return The number of segments.
+   */
+  size_t
+  getNSegmentsPublished() const { return nSegmentsPublished_; }
+
+  /**
+   * Get the rate of making and signing segments in the last call to publish.
+   * @return The number of segments per second.
+   */
+  double
+  getSegmentsPerSecond() const { return segmentsPerSecond_; }
+
+  static const size_t DEFAULT_SEGMENT_SIZE = 8000;
+
+private:
+  /**
+   * Sign segments[begin] and the segments after it with signingInfo_, using
+   * worker threads if possible.
+   */
+  void
+  signSegments
+    (std::vector<ptr_lib::shared_ptr<Data> >& segments, size_t begin);
+
+  /**
+   * Sign segments[begin] and the segments after it with a
+   * DigestSha256Signature, and make and sign manifest_.
+   */
+  void
+  signWithManifest
+    (std::vector<ptr_lib::shared_ptr<Data> >& segments, size_t begin,
+     const Name& versionedName);
+
+  KeyChain& keyChain_;
+  SigningInfo signingInfo_;
+  Options options_;
+  ptr_lib::shared_ptr<Data> manifest_;
+  size_t nSegmentsPublished_;
+  double segmentsPerSecond_;
+};
+
+}
+
+#endif
@@ -21,6 +21,44 @@
 #include "tlv/tlv.h"
 #include "element-reader.h"
 
+/**
+ * If the TLV structure decoder has read the type and length of the partial
+ * element, then ensure that partialData can hold the entire element. This way
+ * the rest of the element is received without reallocating partialData, and
+ * ndn_ElementReader_getReceiveBuffer can return the remaining gap.
+ * @param self A pointer to the ndn_ElementReader struct.
+ * @return 0 for success, else an error code.
+ */
+static ndn_Error
+reservePartialData(struct ndn_ElementReader *self)
+{
+  size_t elementLength;
+  ndn_Error error;
+
+  if (self->tlvStructureDecoder.state != ndn_TlvStructureDecoder_READ_VALUE_BYTES)
+    // We don't know the element length yet.
+    return NDN_ERROR_success;
+
+  elementLength =
+    self->partialDataLength + self->tlvStructureDecoder.nBytesToRead;
+  if (elementLength > MAX_NDN_PACKET_SIZE) {
+    // Reset to read a new element on the next call.
+    self->usePartialData = 0;
+    ndn_TlvStructureDecoder_initialize(&self->tlvStructureDecoder);
+
+    return NDN_ERROR_ElementReader_The_incoming_packet_exceeds_the_maximum_limit_getMaxNdnPacketSize;
+  }
+
+  if ((error = ndn_DynamicUInt8Array_ensureLength
+       (self->partialData, elementLength))) {
+    // Set gotPartialDataError so we won't call onReceivedElement with invalid data.
+    self->gotPartialDataError = 1;
+    return error;
+  }
+
+  return NDN_ERROR_success;
+}
+
 ndn_Error ndn_ElementReader_onReceivedData
   (struct ndn_ElementReader *self, const uint8_t *data, size_t dataLength)
 {
@@ -122,9 +160,68 @@ ndn_Error ndn_ElementReader_onReceivedData
           return error;
         }
         self->partialDataLength += dataLength;
+
+        return reservePartialData(self);
       }
 
       return NDN_ERROR_success;
     }
   }
 }
+
+void
+ndn_ElementReader_getReceiveBuffer
+  (struct ndn_ElementReader *self, uint8_t **buffer, size_t *bufferLength)
+{
+  if (self->usePartialData && !self->gotPartialDataError &&
+      self->tlvStructureDecoder.state == ndn_TlvStructureDecoder_READ_VALUE_BYTES &&
+      self->partialData->length >=
+        self->partialDataLength + self->tlvStructureDecoder.nBytesToRead) {
+    *buffer = self->partialData->array + self->partialDataLength;
+    *bufferLength = self->tlvStructureDecoder.nBytesToRead;
+  }
+  else {
+    *buffer = 0;
+    *bufferLength = 0;
+  }
+}
+
+ndn_Error
+ndn_ElementReader_onReceivedIntoBuffer
+  (struct ndn_ElementReader *self, size_t nBytes)
+{
+  uint8_t *buffer;
+  size_t bufferLength;
+  const uint8_t *element;
+  size_t elementLength;
+
+  if (nBytes == 0)
+    return NDN_ERROR_success;
+
+  ndn_ElementReader_getReceiveBuffer(self, &buffer, &bufferLength);
+  if (nBytes > bufferLength)
+    return NDN_ERROR_ElementReader_received_more_bytes_than_the_receive_buffer_length;
+
+  // The bytes are already in place, so just update the TLV structure decoder
+  // which is reading the value bytes.
+  self->partialDataLength += nBytes;
+  self->tlvStructureDecoder.nBytesToRead -= nBytes;
+  if (self->tlvStructureDecoder.nBytesToRead > 0)
+    // Wait for more data.
+    return NDN_ERROR_success;
+
+  if (!self->elementListener)
+    return NDN_ERROR_ElementReader_ElementListener_is_not_specified;
+
+  element = self->partialData->array;
+  elementLength = self->partialDataLength;
+  // Reset to read a new object. Do this before calling onReceivedElement in
+  // case it throws an exception.
+  self->usePartialData = 0;
+  ndn_TlvStructureDecoder_initialize(&self->tlvStructureDecoder);
+
+  (*self->elementListener->onReceivedElement)
+    (self->elementListener, element, elementLength);
+
+  return NDN_ERROR_success;
+}
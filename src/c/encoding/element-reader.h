@@ -79,6 +79,34 @@ static __inline void ndn_ElementReader_reset
 ndn_Error ndn_ElementReader_onReceivedData
   (struct ndn_ElementReader *self, const uint8_t *data, size_t dataLength);
 
+/**
+ * If the ElementReader has read the type and length of a partial element, get
+ * the gap in its buffer for the rest of the element. The caller can receive
+ * directly into this gap (for example with readv) and then call
+ * ndn_ElementReader_onReceivedIntoBuffer, which avoids copying the bytes again
+ * in ndn_ElementReader_onReceivedData.
+ * @param self pointer to the ndn_ElementReader struct
+ * @param buffer Set buffer to the start of the gap, or 0 if there is no gap.
+ * @param bufferLength Set bufferLength to the number of bytes needed to finish
+ * the partial element, or 0 if there is no gap.
+ */
+void
+ndn_ElementReader_getReceiveBuffer
+  (struct ndn_ElementReader *self, uint8_t **buffer, size_t *bufferLength);
+
+/**
+ * Process nBytes which the caller wrote at the start of the buffer from
+ * ndn_ElementReader_getReceiveBuffer. If this finishes the element, call
+ * (*elementListener->onReceivedElement)(element, elementLength).
+ * @param self pointer to the ndn_ElementReader struct
+ * @param nBytes The number of bytes written into the buffer.
+ * @return 0 for success, else an error code including if nBytes is greater
+ * than the bufferLength from ndn_ElementReader_getReceiveBuffer.
+ */
+ndn_Error
+ndn_ElementReader_onReceivedIntoBuffer
+  (struct ndn_ElementReader *self, size_t nBytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,7 @@ extern "C" {
 #endif
 
 struct ndn_Interest;
+struct ndn_Data;
 struct ndn_DynamicUInt8Array;
 
 /**
@@ -54,6 +55,28 @@ ndn_Tlv0_3WireFormat_encodeInterest
    size_t *signedPortionEndOffset, struct ndn_DynamicUInt8Array *output,
    size_t *encodingLength);
 
+/**
+ * Encode interest as NDN-TLV format v0.3 in a single pass, writing the
+ * encoding at the back of the output array. This produces the same encoding as
+ * ndn_Tlv0_3WireFormat_encodeInterest.
+ * @param interest A pointer to the interest struct to encode.
+ * @param signedPortionBeginOffset Return the offset in the encoding of the
+ * beginning of the signed portion. See ndn_Tlv0_3WireFormat_encodeInterest.
+ * @param signedPortionEndOffset Return the offset in the encoding of the end
+ * of the signed portion. See ndn_Tlv0_3WireFormat_encodeInterest.
+ * @param output A pointer to a ndn_DynamicUInt8Array struct which receives the
+ * encoded output as its final encodingLength bytes. If the output->realloc
+ * function pointer is null, its array must be large enough to receive the
+ * entire encoding.
+ * @param encodingLength Set encodingLength to the length of the encoded output.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_Tlv0_3WireFormat_reverseEncodeInterest
+  (const struct ndn_Interest *interest, size_t *signedPortionBeginOffset,
+   size_t *signedPortionEndOffset, struct ndn_DynamicUInt8Array *output,
+   size_t *encodingLength);
+
 /**
  * Decode input as an interest in NDN-TLV format v0.3 and set the
  * fields of the interest struct.
@@ -75,6 +98,30 @@ ndn_Tlv0_3WireFormat_decodeInterest
   (struct ndn_Interest *interest, const uint8_t *input, size_t inputLength,
    size_t *signedPortionBeginOffset, size_t *signedPortionEndOffset);
 
+/**
+ * Encode data as NDN-TLV in a single pass, writing the encoding at the back of
+ * the output array. This produces the same encoding as
+ * ndn_Tlv0_2WireFormat_encodeData.
+ * @param data A pointer to the data struct to encode.
+ * @param signedPortionBeginOffset Return the offset in the encoding of the
+ * beginning of the signed portion.
+ * If you are not encoding in order to sign, you can ignore this returned value.
+ * @param signedPortionEndOffset Return the offset in the encoding of the end of
+ * the signed portion.
+ * If you are not encoding in order to sign, you can ignore this returned value.
+ * @param output A pointer to a ndn_DynamicUInt8Array struct which receives the
+ * encoded output as its final encodingLength bytes. If the output->realloc
+ * function pointer is null, its array must be large enough to receive the
+ * entire encoding.
+ * @param encodingLength Set encodingLength to the length of the encoded output.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_Tlv0_3WireFormat_reverseEncodeData
+  (const struct ndn_Data *data, size_t *signedPortionBeginOffset,
+   size_t *signedPortionEndOffset, struct ndn_DynamicUInt8Array *output,
+   size_t *encodingLength);
+
 #ifdef __cplusplus
 }
 #endif
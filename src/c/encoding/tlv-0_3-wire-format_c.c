@@ -19,6 +19,7 @@
  */
 
 #include "tlv/tlv-interest.h"
+#include "tlv/tlv-data.h"
 #include "tlv-0_3-wire-format.h"
 
 ndn_Error
@@ -37,6 +38,29 @@ ndn_Tlv0_3WireFormat_encodeInterest
   return error;
 }
 
+ndn_Error
+ndn_Tlv0_3WireFormat_reverseEncodeInterest
+  (const struct ndn_Interest *interest, size_t *signedPortionBeginOffset,
+   size_t *signedPortionEndOffset, struct ndn_DynamicUInt8Array *output,
+   size_t *encodingLength)
+{
+  ndn_Error error;
+  struct ndn_TlvReverseEncoder encoder;
+  size_t signedPortionBeginLength, signedPortionEndLength;
+
+  ndn_TlvReverseEncoder_initialize(&encoder, output);
+  if ((error = ndn_reverseEncodeTlvInterestV0_3
+       (interest, &signedPortionBeginLength, &signedPortionEndLength,
+        &encoder)))
+    return error;
+
+  // Convert the lengths from the back to offsets from the front.
+  *encodingLength = encoder.length;
+  *signedPortionBeginOffset = encoder.length - signedPortionBeginLength;
+  *signedPortionEndOffset = encoder.length - signedPortionEndLength;
+  return NDN_ERROR_success;
+}
+
 ndn_Error
 ndn_Tlv0_3WireFormat_decodeInterest
   (struct ndn_Interest *interest, const uint8_t *input, size_t inputLength,
@@ -48,3 +72,25 @@ ndn_Tlv0_3WireFormat_decodeInterest
   return ndn_decodeTlvInterest
     (interest, signedPortionBeginOffset, signedPortionEndOffset, &decoder);
 }
+
+ndn_Error
+ndn_Tlv0_3WireFormat_reverseEncodeData
+  (const struct ndn_Data *data, size_t *signedPortionBeginOffset,
+   size_t *signedPortionEndOffset, struct ndn_DynamicUInt8Array *output,
+   size_t *encodingLength)
+{
+  ndn_Error error;
+  struct ndn_TlvReverseEncoder encoder;
+  size_t signedPortionBeginLength, signedPortionEndLength;
+
+  ndn_TlvReverseEncoder_initialize(&encoder, output);
+  if ((error = ndn_reverseEncodeTlvData
+       (data, &signedPortionBeginLength, &signedPortionEndLength, &encoder)))
+    return error;
+
+  // Convert the lengths from the back to offsets from the front.
+  *encodingLength = encoder.length;
+  *signedPortionBeginOffset = encoder.length - signedPortionBeginLength;
+  *signedPortionEndOffset = encoder.length - signedPortionEndLength;
+  return NDN_ERROR_success;
+}
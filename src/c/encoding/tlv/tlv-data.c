@@ -130,6 +130,91 @@ ndn_encodeTlvData
   return ndn_TlvEncoder_writeNestedTlv(encoder, ndn_Tlv_Data, encodeDataValue, &dataValueContext, 0);
 }
 
+/**
+ * Prepend the MetaInfo TLV to the reverse encoder.
+ * @param metaInfo A pointer to the ndn_MetaInfo struct to encode.
+ * @param encoder the ndn_TlvReverseEncoder which receives the encoding.
+ * @return 0 for success, else an error code.
+ */
+static ndn_Error
+reverseEncodeMetaInfo
+  (const struct ndn_MetaInfo *metaInfo, struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  ndn_Error error;
+
+  if (metaInfo->finalBlockId.value.value &&
+      metaInfo->finalBlockId.value.length > 0) {
+    // The FinalBlockId has an inner NameComponent.
+    size_t finalBlockIdSaveLength = encoder->length;
+    if ((error = ndn_reverseEncodeTlvNameComponent
+         (&metaInfo->finalBlockId, encoder)))
+      return error;
+    if ((error = ndn_TlvReverseEncoder_prependNestedTlvHeader
+         (encoder, ndn_Tlv_FinalBlockId, finalBlockIdSaveLength)))
+      return error;
+  }
+  if ((error = ndn_TlvReverseEncoder_prependOptionalNonNegativeIntegerTlvFromDouble
+      (encoder, ndn_Tlv_FreshnessPeriod, metaInfo->freshnessPeriod)))
+    return error;
+
+  if (!((int)metaInfo->type < 0 || metaInfo->type == ndn_ContentType_BLOB)) {
+    // Not the default, so we need to encode the type.
+    if (metaInfo->type == ndn_ContentType_LINK ||
+        metaInfo->type == ndn_ContentType_KEY ||
+        metaInfo->type == ndn_ContentType_NACK) {
+      // The ContentType enum is set up with the correct integer for each NDN-TLV ContentType.
+      if ((error = ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv
+          (encoder, ndn_Tlv_ContentType, metaInfo->type)))
+        return error;
+    }
+    else if (metaInfo->type == ndn_ContentType_OTHER_CODE) {
+      if ((error = ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv
+          (encoder, ndn_Tlv_ContentType, metaInfo->otherTypeCode)))
+        return error;
+    }
+    else
+      // We don't expect this to happen.
+      return NDN_ERROR_unrecognized_ndn_ContentType;
+  }
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader
+    (encoder, ndn_Tlv_MetaInfo, saveLength);
+}
+
+ndn_Error
+ndn_reverseEncodeTlvData
+  (const struct ndn_Data *data, size_t *signedPortionBeginLength,
+   size_t *signedPortionEndLength, struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  ndn_Error error;
+  size_t dummyBeginLength, dummyEndLength;
+
+  // Prepend the fields in the reverse order of encodeDataValue.
+  if ((error = ndn_TlvReverseEncoder_prependBlobTlv
+       (encoder, ndn_Tlv_SignatureValue, &data->signature.signature)))
+    return error;
+
+  *signedPortionEndLength = encoder->length;
+
+  if ((error = ndn_reverseEncodeTlvSignatureInfo(&data->signature, encoder)))
+    return error;
+  if ((error = ndn_TlvReverseEncoder_prependBlobTlv
+       (encoder, ndn_Tlv_Content, &data->content)))
+    return error;
+  if ((error = reverseEncodeMetaInfo(&data->metaInfo, encoder)))
+    return error;
+  if ((error = ndn_reverseEncodeTlvName
+       (&data->name, &dummyBeginLength, &dummyEndLength, encoder)))
+    return error;
+
+  *signedPortionBeginLength = encoder->length;
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader
+    (encoder, ndn_Tlv_Data, saveLength);
+}
+
 static ndn_Error
 decodeMetaInfo(struct ndn_MetaInfo *metaInfo, struct ndn_TlvDecoder *decoder)
 {
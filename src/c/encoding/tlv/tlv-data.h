@@ -23,6 +23,7 @@
 
 #include "../../data.h"
 #include "tlv-encoder.h"
+#include "tlv-reverse-encoder.h"
 #include "tlv-decoder.h"
 
 #ifdef  __cplusplus
@@ -44,6 +45,27 @@ ndn_encodeTlvData
   (const struct ndn_Data *data, size_t *signedPortionBeginOffset,
    size_t *signedPortionEndOffset, struct ndn_TlvEncoder *encoder);
 
+/**
+ * Encode the data packet as NDN-TLV in a single pass by prepending it to the
+ * reverse encoder. This produces the same encoding as ndn_encodeTlvData.
+ * @param data Pointer to the data object to encode.
+ * @param signedPortionBeginLength Return the encoder length at the beginning
+ * of the signed portion, which is the number of bytes from the beginning of
+ * the signed portion to the end of the final encoding.
+ * If you are not encoding in order to sign, you can ignore this returned value.
+ * @param signedPortionEndLength Return the encoder length at the end of the
+ * signed portion, which is the number of bytes from the end of the signed
+ * portion to the end of the final encoding.
+ * If you are not encoding in order to sign, you can ignore this returned value.
+ * @param encoder Pointer to the ndn_TlvReverseEncoder struct which receives
+ * the encoding.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_reverseEncodeTlvData
+  (const struct ndn_Data *data, size_t *signedPortionBeginLength,
+   size_t *signedPortionEndLength, struct ndn_TlvReverseEncoder *encoder);
+
 /**
  * Decode the data packet as NDN-TLV and set the fields in the data object.
  * @param data Pointer to the data object whose fields are updated.
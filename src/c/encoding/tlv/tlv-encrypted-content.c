@@ -134,6 +134,14 @@ encodeEncryptedContentV2Value(const void *context, struct ndn_TlvEncoder *encode
           &dummyEndOffset, encoder)))
       return error;
   }
+  // NAC v2 assumes AES-CBC, so only encode other algorithm types such as
+  // AES-GCM. This is not in the NAC specification.
+  if (encryptedContent->algorithmType != ndn_EncryptAlgorithmType_AesCbc) {
+    if ((error = ndn_TlvEncoder_writeOptionalNonNegativeIntegerTlv
+         (encoder, ndn_Tlv_Encrypt_EncryptionAlgorithm,
+          (int)encryptedContent->algorithmType)))
+      return error;
+  }
 
   return NDN_ERROR_success;
 }
@@ -156,6 +164,7 @@ ndn_decodeTlvEncryptedContentV2
   size_t endOffset;
   int gotExpectedType;
   size_t dummyBeginOffset, dummyEndOffset;
+  int algorithmType;
 
   if ((error = ndn_TlvDecoder_readNestedTlvsStart
        (decoder, ndn_Tlv_Encrypt_EncryptedContent, &endOffset)))
@@ -186,6 +195,12 @@ ndn_decodeTlvEncryptedContentV2
     encryptedContent->keyLocator.type = ndn_KeyLocatorType_KEYNAME;
   }
 
+  if ((error = ndn_TlvDecoder_readOptionalNonNegativeIntegerTlv
+       (decoder, ndn_Tlv_Encrypt_EncryptionAlgorithm, endOffset,
+        &algorithmType)))
+    return error;
+  encryptedContent->algorithmType = (ndn_EncryptAlgorithmType)algorithmType;
+
   if ((error = ndn_TlvDecoder_finishNestedTlvs(decoder, endOffset)))
     return error;
 
@@ -98,6 +98,44 @@ encodeSelectorsValue(const void *context, struct ndn_TlvEncoder *encoder)
   return NDN_ERROR_success;
 }
 
+/**
+ * Get the 4-byte Nonce to encode. If the interest nonce is missing or shorter
+ * than 4 bytes, use random bytes. If it is longer, truncate to 4 bytes.
+ * @param interest A pointer to the Interest object.
+ * @param nonceBuffer A 4-byte buffer for the random nonce, if needed.
+ * @param nonceBlob Set nonceBlob to the 4-byte nonce, which may point to
+ * nonceBuffer.
+ * @return 0 for success, else an error code.
+ */
+static ndn_Error
+getNonceToEncode
+  (const struct ndn_Interest *interest, uint8_t nonceBuffer[4],
+   struct ndn_Blob *nonceBlob)
+{
+  ndn_Error error;
+
+  nonceBlob->length = 4;
+  if (interest->nonce.length == 0) {
+    // Generate a random nonce.
+    if ((error = ndn_generateRandomBytes(nonceBuffer, 4)))
+      return error;
+    nonceBlob->value = nonceBuffer;
+  }
+  else if (interest->nonce.length < 4) {
+    // TLV encoding requires 4 bytes, so pad out to 4 using random bytes.
+    ndn_memcpy(nonceBuffer, interest->nonce.value, interest->nonce.length);
+    if ((error = ndn_generateRandomBytes
+         (nonceBuffer + interest->nonce.length, 4 - interest->nonce.length)))
+      return error;
+    nonceBlob->value = nonceBuffer;
+  }
+  else
+    // TLV encoding requires 4 bytes, so truncate to 4.
+    nonceBlob->value = interest->nonce.value;
+
+  return NDN_ERROR_success;
+}
+
 /* An InterestValueContext is for passing the context to encodeInterestValue so
  *   that we can include signedPortionBeginOffset and signedPortionEndOffset.
  */
@@ -132,26 +170,8 @@ encodeInterestValueV02(const void *context, struct ndn_TlvEncoder *encoder)
   if ((error = ndn_TlvEncoder_writeNestedTlv(encoder, ndn_Tlv_Selectors, encodeSelectorsValue, interest, 1)))
     return error;
 
-  // Encode the Nonce as 4 bytes.
-  nonceBlob.length = sizeof(nonceBuffer);
-  if (interest->nonce.length == 0) {
-    // Generate a random nonce.
-    if ((error = ndn_generateRandomBytes(nonceBuffer, sizeof(nonceBuffer))))
-      return error;
-    nonceBlob.value = nonceBuffer;
-  }
-  else if (interest->nonce.length < 4) {
-    // TLV encoding requires 4 bytes, so pad out to 4 using random bytes.
-    ndn_memcpy(nonceBuffer, interest->nonce.value, interest->nonce.length);
-    if ((error = ndn_generateRandomBytes
-         (nonceBuffer + interest->nonce.length,
-          sizeof(nonceBuffer) - interest->nonce.length)))
-      return error;
-    nonceBlob.value = nonceBuffer;
-  }
-  else
-    // TLV encoding requires 4 bytes, so truncate to 4.
-    nonceBlob.value = interest->nonce.value;
+  if ((error = getNonceToEncode(interest, nonceBuffer, &nonceBlob)))
+    return error;
   if ((error = ndn_TlvEncoder_writeBlobTlv(encoder, ndn_Tlv_Nonce, &nonceBlob)))
     return error;
 
@@ -228,26 +248,8 @@ encodeInterestValueV03(const void *context, struct ndn_TlvEncoder *encoder)
       return error;
   }
 
-  // Encode the Nonce as 4 bytes.
-  nonceBlob.length = sizeof(nonceBuffer);
-  if (interest->nonce.length == 0) {
-    // Generate a random nonce.
-    if ((error = ndn_generateRandomBytes(nonceBuffer, sizeof(nonceBuffer))))
-      return error;
-    nonceBlob.value = nonceBuffer;
-  }
-  else if (interest->nonce.length < 4) {
-    // TLV encoding requires 4 bytes, so pad out to 4 using random bytes.
-    ndn_memcpy(nonceBuffer, interest->nonce.value, interest->nonce.length);
-    if ((error = ndn_generateRandomBytes
-         (nonceBuffer + interest->nonce.length,
-          sizeof(nonceBuffer) - interest->nonce.length)))
-      return error;
-    nonceBlob.value = nonceBuffer;
-  }
-  else
-    // TLV encoding requires 4 bytes, so truncate to 4.
-    nonceBlob.value = interest->nonce.value;
+  if ((error = getNonceToEncode(interest, nonceBuffer, &nonceBlob)))
+    return error;
   if ((error = ndn_TlvEncoder_writeBlobTlv(encoder, ndn_Tlv_Nonce, &nonceBlob)))
     return error;
 
@@ -292,6 +294,58 @@ ndn_encodeTlvInterestV0_3
     (encoder, ndn_Tlv_Interest, encodeInterestValueV03, &interestValueContext, 0);
 }
 
+ndn_Error
+ndn_reverseEncodeTlvInterestV0_3
+  (const struct ndn_Interest *interest, size_t *signedPortionBeginLength,
+   size_t *signedPortionEndLength, struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  ndn_Error error;
+  uint8_t nonceBuffer[4];
+  struct ndn_Blob nonceBlob;
+
+  // Prepend the fields in the reverse order of encodeInterestValueV03.
+  if ((error = ndn_TlvReverseEncoder_prependOptionalBlobTlv
+       (encoder, ndn_Tlv_ApplicationParameters, &interest->applicationParameters)))
+    return error;
+  if ((error = ndn_TlvReverseEncoder_prependOptionalNonNegativeIntegerTlvFromDouble
+      (encoder, ndn_Tlv_InterestLifetime, interest->interestLifetimeMilliseconds)))
+    return error;
+
+  if ((error = getNonceToEncode(interest, nonceBuffer, &nonceBlob)))
+    return error;
+  if ((error = ndn_TlvReverseEncoder_prependBlobTlv
+       (encoder, ndn_Tlv_Nonce, &nonceBlob)))
+    return error;
+
+  if (interest->forwardingHintWireEncoding.value &&
+      interest->forwardingHintWireEncoding.length > 0) {
+    // Add the encoded sequence of delegations as is.
+    if ((error = ndn_TlvReverseEncoder_prependBlobTlv
+         (encoder, ndn_Tlv_ForwardingHint, &interest->forwardingHintWireEncoding)))
+      return error;
+  }
+
+  if (interest->mustBeFresh) {
+    if ((error = ndn_TlvReverseEncoder_prependTypeAndLength
+         (encoder, ndn_Tlv_MustBeFresh, 0)))
+      return error;
+  }
+  if (ndn_Interest_getCanBePrefix(interest)) {
+    if ((error = ndn_TlvReverseEncoder_prependTypeAndLength
+         (encoder, ndn_Tlv_CanBePrefix, 0)))
+      return error;
+  }
+
+  if ((error = ndn_reverseEncodeTlvName
+       (&interest->name, signedPortionBeginLength, signedPortionEndLength,
+        encoder)))
+    return error;
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader
+    (encoder, ndn_Tlv_Interest, saveLength);
+}
+
 static ndn_Error
 decodeExclude(struct ndn_Exclude *exclude, struct ndn_TlvDecoder *decoder)
 {
@@ -411,6 +465,7 @@ ndn_decodeTlvInterest
    size_t *signedPortionEndOffset, struct ndn_TlvDecoder *decoder)
 {
   ndn_Error errorV03;
+  ndn_Error errorV02;
   size_t saveOffset;
 
   saveOffset = decoder->offset;
@@ -422,10 +477,16 @@ ndn_decodeTlvInterest
 
   // Failed to decode as format v0.3. Restore offset and try to decode as v0.2.
   ndn_TlvDecoder_seek(decoder, saveOffset);
-  if (ndn_decodeTlvInterestV02
-      (interest, signedPortionBeginOffset, signedPortionEndOffset, decoder)
-      == NDN_ERROR_success)
+  errorV02 = ndn_decodeTlvInterestV02
+    (interest, signedPortionBeginOffset, signedPortionEndOffset, decoder);
+  if (errorV02 == NDN_ERROR_success)
     return NDN_ERROR_success;
+  if (errorV02 ==
+        NDN_ERROR_attempt_to_add_a_component_past_the_maximum_number_of_components_allowed_in_the_name ||
+      errorV02 ==
+        NDN_ERROR_cannot_add_an_entry_past_the_maximum_number_of_entries_allowed_in_the_exclude)
+    // The v0.2 Interest is valid but the caller must provide larger arrays.
+    return errorV02;
 
   // Ignore the exception decoding as format v0.2 and throw the exception
   // from trying to decode as format as format v0.3.
@@ -23,6 +23,7 @@
 
 #include "../../interest.h"
 #include "tlv-encoder.h"
+#include "tlv-reverse-encoder.h"
 #include "tlv-decoder.h"
 
 #ifdef  __cplusplus
@@ -63,6 +64,28 @@ ndn_encodeTlvInterestV0_3
   (const struct ndn_Interest *interest, size_t *signedPortionBeginOffset,
    size_t *signedPortionEndOffset, struct ndn_TlvEncoder *encoder);
 
+/**
+ * Encode the Interest packet strictly as NDN-TLV format v0.3 in a single pass
+ * by prepending it to the reverse encoder. This produces the same encoding as
+ * ndn_encodeTlvInterestV0_3.
+ * @param interest A pointer to the Interest object to encode.
+ * @param signedPortionBeginLength Return the encoder length at the beginning
+ * of the signed portion, which is the number of bytes from the beginning of
+ * the signed portion to the end of the final encoding. If you are not encoding
+ * in order to sign, you can ignore this returned value.
+ * @param signedPortionEndLength Return the encoder length at the end of the
+ * signed portion, which is the number of bytes from the end of the signed
+ * portion to the end of the final encoding. If you are not encoding in order
+ * to sign, you can ignore this returned value.
+ * @param encoder Pointer to the ndn_TlvReverseEncoder struct which receives
+ * the encoding.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_reverseEncodeTlvInterestV0_3
+  (const struct ndn_Interest *interest, size_t *signedPortionBeginLength,
+   size_t *signedPortionEndLength, struct ndn_TlvReverseEncoder *encoder);
+
 /**
  * Decode the Interest packet as NDN-TLV format v0.3, or if this fails then as
  * format v0.2. Set the fields in the data object.
@@ -46,6 +46,33 @@ ndn_encodeTlvKeyLocatorValue(const void *context, struct ndn_TlvEncoder *encoder
   return NDN_ERROR_success;
 }
 
+ndn_Error
+ndn_reverseEncodeTlvKeyLocator
+  (unsigned int type, const struct ndn_KeyLocator *keyLocator,
+   struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  ndn_Error error;
+
+  if ((int)keyLocator->type >= 0) {
+    if (keyLocator->type == ndn_KeyLocatorType_KEYNAME) {
+      size_t dummyBeginLength, dummyEndLength;
+      if ((error = ndn_reverseEncodeTlvName
+           (&keyLocator->keyName, &dummyBeginLength, &dummyEndLength, encoder)))
+        return error;
+    }
+    else if (keyLocator->type == ndn_KeyLocatorType_KEY_LOCATOR_DIGEST && keyLocator->keyData.length > 0) {
+      if ((error = ndn_TlvReverseEncoder_prependBlobTlv
+           (encoder, ndn_Tlv_KeyLocatorDigest, &keyLocator->keyData)))
+        return error;
+    }
+    else
+      return NDN_ERROR_unrecognized_ndn_KeyLocatorType;
+  }
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader(encoder, type, saveLength);
+}
+
 ndn_Error
 ndn_decodeTlvKeyLocator
   (unsigned int expectedType, struct ndn_KeyLocator *keyLocator,
@@ -23,6 +23,7 @@
 
 #include "../../key-locator.h"
 #include "tlv-encoder.h"
+#include "tlv-reverse-encoder.h"
 #include "tlv-decoder.h"
 
 #ifdef  __cplusplus
@@ -38,6 +39,20 @@ extern "C" {
 ndn_Error
 ndn_encodeTlvKeyLocatorValue(const void *context, struct ndn_TlvEncoder *encoder);
 
+/**
+ * Encode the KeyLocator as NDN-TLV by prepending it to the reverse encoder.
+ * This prepends the TLV with the given type even if the value is empty.
+ * @param type The type code of the TLV, e.g. ndn_Tlv_KeyLocator.
+ * @param keyLocator A pointer to the ndn_KeyLocator struct to encode.
+ * @param encoder A pointer to the ndn_TlvReverseEncoder struct which receives
+ * the encoding.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_reverseEncodeTlvKeyLocator
+  (unsigned int type, const struct ndn_KeyLocator *keyLocator,
+   struct ndn_TlvReverseEncoder *encoder);
+
 /**
  * Expect the next element to be a TLV KeyLocator and decode into the ndn_KeyLocator struct.
  * @param expectedType The expected type code of the TLV, e.g. ndn_Tlv_KeyLocator
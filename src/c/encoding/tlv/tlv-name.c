@@ -20,24 +20,54 @@
 
 #include "tlv-name.h"
 
-ndn_Error
-ndn_encodeTlvNameComponent
-  (const struct ndn_NameComponent *component, struct ndn_TlvEncoder *encoder)
+/**
+ * Get the TLV type code of the name component.
+ * @param component A pointer to the name component.
+ * @param type Set type to the TLV type code.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+getNameComponentTlvType
+  (const struct ndn_NameComponent *component, unsigned int *type)
 {
-  unsigned int type;
   if (component->type == ndn_NameComponentType_OTHER_CODE) {
     if (component->otherTypeCode < 0)
       return NDN_ERROR_Name_component_otherTypeCode_must_be_non_negative;
 
-    type = (unsigned int)component->otherTypeCode;
+    *type = (unsigned int)component->otherTypeCode;
   }
   else
     // The enum values are the same as the TLV type codes.
-    type = (unsigned int)component->type;
+    *type = (unsigned int)component->type;
+
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_encodeTlvNameComponent
+  (const struct ndn_NameComponent *component, struct ndn_TlvEncoder *encoder)
+{
+  ndn_Error error;
+  unsigned int type;
+  if ((error = getNameComponentTlvType(component, &type)))
+    return error;
 
   return ndn_TlvEncoder_writeBlobTlv(encoder, type, &component->value);
 }
 
+ndn_Error
+ndn_reverseEncodeTlvNameComponent
+  (const struct ndn_NameComponent *component,
+   struct ndn_TlvReverseEncoder *encoder)
+{
+  ndn_Error error;
+  unsigned int type;
+  if ((error = getNameComponentTlvType(component, &type)))
+    return error;
+
+  return ndn_TlvReverseEncoder_prependBlobTlv(encoder, type, &component->value);
+}
+
 ndn_Error
 ndn_decodeTlvNameComponent
   (struct ndn_NameComponent *component, struct ndn_TlvDecoder *decoder)
@@ -113,6 +143,37 @@ ndn_encodeTlvName
   return NDN_ERROR_success;
 }
 
+ndn_Error
+ndn_reverseEncodeTlvName
+  (const struct ndn_Name *name, size_t *signedPortionBeginLength,
+   size_t *signedPortionEndLength, struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  size_t i;
+  ndn_Error error;
+
+  // The final component is prepended first.
+  i = name->nComponents;
+  while (i > 0) {
+    --i;
+    if ((error = ndn_reverseEncodeTlvNameComponent
+         (&name->components[i], encoder)))
+      return error;
+
+    if (i == name->nComponents - 1)
+      // We just prepended the final component.
+      *signedPortionEndLength = encoder->length;
+  }
+
+  *signedPortionBeginLength = encoder->length;
+  if (name->nComponents == 0)
+    // There is no "final component", so set signedPortionEndLength arbitrarily.
+    *signedPortionEndLength = *signedPortionBeginLength;
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader
+    (encoder, ndn_Tlv_Name, saveLength);
+}
+
 ndn_Error
 ndn_decodeTlvName
   (struct ndn_Name *name, size_t *signedPortionBeginOffset,
@@ -23,6 +23,7 @@
 
 #include "../../name.h"
 #include "tlv-encoder.h"
+#include "tlv-reverse-encoder.h"
 #include "tlv-decoder.h"
 
 #ifdef  __cplusplus
@@ -41,6 +42,19 @@ ndn_Error
 ndn_encodeTlvNameComponent
   (const struct ndn_NameComponent *component, struct ndn_TlvEncoder *encoder);
 
+/**
+ * Encode the name component as NDN-TLV by prepending it to the reverse
+ * encoder. See ndn_encodeTlvNameComponent.
+ * @param component A pointer to the name component to encode.
+ * @param encoder A pointer to the ndn_TlvReverseEncoder struct which receives
+ * the encoding.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_reverseEncodeTlvNameComponent
+  (const struct ndn_NameComponent *component,
+   struct ndn_TlvReverseEncoder *encoder);
+
 /**
  * Decode the next element as a TLV NameComponent into the ndn_NameComponent
  * struct. This handles different component types such as
@@ -75,6 +89,28 @@ ndn_encodeTlvName
   (const struct ndn_Name *name, size_t *signedPortionBeginOffset,
    size_t *signedPortionEndOffset, struct ndn_TlvEncoder *encoder);
 
+/**
+ * Encode the name as NDN-TLV by prepending it to the reverse encoder. This
+ * produces the same encoding as ndn_encodeTlvName.
+ * @param name A pointer to the name object to encode.
+ * @param signedPortionBeginLength Return the encoder length at the beginning
+ * of the signed portion, which is the number of bytes from the beginning of
+ * the signed portion to the end of the final encoding. See ndn_encodeTlvName
+ * for the signed portion.
+ * If you are not encoding in order to sign, you can ignore this returned value.
+ * @param signedPortionEndLength Return the encoder length at the end of the
+ * signed portion, which is the number of bytes from the end of the signed
+ * portion to the end of the final encoding.
+ * If you are not encoding in order to sign, you can ignore this returned value.
+ * @param encoder A pointer to the ndn_TlvReverseEncoder struct which receives
+ * the encoding.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_reverseEncodeTlvName
+  (const struct ndn_Name *name, size_t *signedPortionBeginLength,
+   size_t *signedPortionEndLength, struct ndn_TlvReverseEncoder *encoder);
+
 /**
  * Expect the next element to be a TLV Name and decode into the ndn_Name struct.
  * @param name A pointer to the ndn_Name struct.
@@ -0,0 +1,128 @@
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "../../util/ndn_memory.h"
+#include "tlv-reverse-encoder.h"
+
+/**
+ * Make room for nBytes more at the back of the output, shifting the existing
+ * encoding to the back if the output is reallocated, and add nBytes to
+ * self->length.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param nBytes The number of bytes to prepend.
+ * @param position Set position to the location in the output to write the
+ * nBytes.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+prependSpace
+  (struct ndn_TlvReverseEncoder *self, size_t nBytes, uint8_t **position)
+{
+  ndn_Error error;
+  if ((error = ndn_DynamicUInt8Array_ensureLengthFromBack
+       (self->output, self->length + nBytes)))
+    return error;
+
+  self->length += nBytes;
+  *position = ndn_TlvReverseEncoder_getEncoding(self);
+  return NDN_ERROR_success;
+}
+
+/**
+ * Write the lower nBytes of value in big endian order.
+ * @param position The location in the output to write.
+ * @param value The value to write.
+ * @param nBytes The number of bytes to write.
+ */
+static __inline void
+writeBigEndian(uint8_t *position, uint64_t value, size_t nBytes)
+{
+  uint8_t *p = position + nBytes;
+  while (p != position) {
+    *(--p) = (uint8_t)(value & 0xff);
+    value >>= 8;
+  }
+}
+
+ndn_Error
+ndn_TlvReverseEncoder_prependVarNumber
+  (struct ndn_TlvReverseEncoder *self, uint64_t varNumber)
+{
+  ndn_Error error;
+  uint8_t *p;
+
+  if (varNumber < 253) {
+    if ((error = prependSpace(self, 1, &p)))
+      return error;
+    *p = (uint8_t)varNumber;
+  }
+  else if (varNumber <= 0xffff) {
+    if ((error = prependSpace(self, 3, &p)))
+      return error;
+    *p = 253;
+    writeBigEndian(p + 1, varNumber, 2);
+  }
+  else if (varNumber <= 0xffffffff) {
+    if ((error = prependSpace(self, 5, &p)))
+      return error;
+    *p = 254;
+    writeBigEndian(p + 1, varNumber, 4);
+  }
+  else {
+    if ((error = prependSpace(self, 9, &p)))
+      return error;
+    *p = 255;
+    writeBigEndian(p + 1, varNumber, 8);
+  }
+
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_TlvReverseEncoder_prependNonNegativeInteger
+  (struct ndn_TlvReverseEncoder *self, uint64_t value)
+{
+  ndn_Error error;
+  uint8_t *p;
+  size_t nBytes = ndn_TlvEncoder_sizeOfNonNegativeInteger(value);
+
+  if ((error = prependSpace(self, nBytes, &p)))
+    return error;
+  writeBigEndian(p, value, nBytes);
+
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_TlvReverseEncoder_prependArray
+  (struct ndn_TlvReverseEncoder *self, const uint8_t *array, size_t arrayLength)
+{
+  ndn_Error error;
+  uint8_t *p;
+
+  if (arrayLength == 0)
+    return NDN_ERROR_success;
+
+  if ((error = prependSpace(self, arrayLength, &p)))
+    return error;
+  ndn_memcpy(p, array, arrayLength);
+
+  return NDN_ERROR_success;
+}
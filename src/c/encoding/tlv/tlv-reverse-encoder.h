@@ -0,0 +1,224 @@
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_TLV_REVERSE_ENCODER_H
+#define NDN_TLV_REVERSE_ENCODER_H
+
+#include <math.h>
+#include <ndn-cpp/c/errors.h>
+#include "../../util/dynamic-uint8-array.h"
+#include "../../util/blob.h"
+#include "tlv-encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An ndn_TlvReverseEncoder struct is used to encode TLV in a single pass by
+ * prepending each element to the back of the output array, starting with the
+ * last element. When the value of a nested TLV is finished, its length is
+ * known so that the type and length can be prepended without first making a
+ * pass to compute the length as ndn_TlvEncoder_writeNestedTlv does. The
+ * encoding is the final self->length bytes of output->array. You should
+ * initialize it with ndn_TlvReverseEncoder_initialize.
+ */
+struct ndn_TlvReverseEncoder {
+  struct ndn_DynamicUInt8Array *output; /**< A pointer to a ndn_DynamicUInt8Array which receives the encoded output. */
+  size_t length;                        /**< The number of bytes written so far at the back of output.array. */
+};
+
+/**
+ * Initialize an ndn_TlvReverseEncoder struct to encode at the back of output.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param output A pointer to a ndn_DynamicUInt8Array struct which receives the
+ * encoded output. The struct must remain valid during the entire life of this
+ * ndn_TlvReverseEncoder. If the output->realloc function pointer is null, its
+ * array must be large enough to receive the entire encoding.
+ */
+static __inline void
+ndn_TlvReverseEncoder_initialize
+  (struct ndn_TlvReverseEncoder *self, struct ndn_DynamicUInt8Array *output)
+{
+  self->output = output;
+  self->length = 0;
+}
+
+/**
+ * Get a pointer to the beginning of the encoding so far, which is the final
+ * self->length bytes of output->array.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @return A pointer to the beginning of the encoding.
+ */
+static __inline uint8_t *
+ndn_TlvReverseEncoder_getEncoding(struct ndn_TlvReverseEncoder *self)
+{
+  return self->output->array + (self->output->length - self->length);
+}
+
+/**
+ * Encode varNumber as a VAR-NUMBER in NDN-TLV and prepend it to the output.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param varNumber The number to encode.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_TlvReverseEncoder_prependVarNumber
+  (struct ndn_TlvReverseEncoder *self, uint64_t varNumber);
+
+/**
+ * Prepend the type and length to the output. Since the encoding is written
+ * back to front, call this after prepending the value.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param type the type of the TLV.
+ * @param length The length of the TLV.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_TlvReverseEncoder_prependTypeAndLength
+  (struct ndn_TlvReverseEncoder *self, unsigned int type, size_t length)
+{
+  ndn_Error error;
+  if ((error = ndn_TlvReverseEncoder_prependVarNumber(self, (uint64_t)length)))
+    return error;
+  return ndn_TlvReverseEncoder_prependVarNumber(self, (uint64_t)type);
+}
+
+/**
+ * Prepend the type and the length of the value which was prepended since the
+ * encoder had valueEndLength bytes. This finishes a nested TLV.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param type the type of the TLV.
+ * @param valueEndLength The value of self->length before prepending the value.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_TlvReverseEncoder_prependNestedTlvHeader
+  (struct ndn_TlvReverseEncoder *self, unsigned int type, size_t valueEndLength)
+{
+  return ndn_TlvReverseEncoder_prependTypeAndLength
+    (self, type, self->length - valueEndLength);
+}
+
+/**
+ * Encode value as a non-negative integer in NDN-TLV and prepend it to the
+ * output. This does not write a type or length for the value.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param value The integer to encode.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_TlvReverseEncoder_prependNonNegativeInteger
+  (struct ndn_TlvReverseEncoder *self, uint64_t value);
+
+/**
+ * Prepend the array to the output. Note that this does not encode a type and
+ * length; for that see prependBlobTlv.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param array The array to copy.
+ * @param arrayLength The length of the array.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_TlvReverseEncoder_prependArray
+  (struct ndn_TlvReverseEncoder *self, const uint8_t *array, size_t arrayLength);
+
+/**
+ * Prepend the type, then the length of the blob then the blob value to the
+ * output.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param type the type of the TLV.
+ * @param value A Blob with the array of bytes for the value.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_TlvReverseEncoder_prependBlobTlv
+  (struct ndn_TlvReverseEncoder *self, unsigned int type,
+   const struct ndn_Blob *value)
+{
+  ndn_Error error;
+  if ((error = ndn_TlvReverseEncoder_prependArray
+       (self, value->value, value->length)))
+    return error;
+  return ndn_TlvReverseEncoder_prependTypeAndLength(self, type, value->length);
+}
+
+/**
+ * If value or valueLen is 0 then do nothing, otherwise call
+ * ndn_TlvReverseEncoder_prependBlobTlv.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param type the type of the TLV.
+ * @param value A Blob with the array of bytes for the value.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_TlvReverseEncoder_prependOptionalBlobTlv
+  (struct ndn_TlvReverseEncoder *self, unsigned int type,
+   const struct ndn_Blob *value)
+{
+  if (value->value && value->length > 0)
+    return ndn_TlvReverseEncoder_prependBlobTlv(self, type, value);
+  else
+    return NDN_ERROR_success;
+}
+
+/**
+ * Prepend the type, then the length of the encoded value then encode value as
+ * a non-negative integer.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param type the type of the TLV.
+ * @param value The integer to encode.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv
+  (struct ndn_TlvReverseEncoder *self, unsigned int type, uint64_t value)
+{
+  ndn_Error error;
+  size_t saveLength = self->length;
+  if ((error = ndn_TlvReverseEncoder_prependNonNegativeInteger(self, value)))
+    return error;
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader(self, type, saveLength);
+}
+
+/**
+ * If value is negative then do nothing, otherwise round value to uint64_t and
+ * call ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv.
+ * @param self A pointer to the ndn_TlvReverseEncoder struct.
+ * @param type the type of the TLV.
+ * @param value Negative for none, otherwise use (uint64_t)round(value).
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_TlvReverseEncoder_prependOptionalNonNegativeIntegerTlvFromDouble
+  (struct ndn_TlvReverseEncoder *self, unsigned int type, double value)
+{
+  if (value >= 0.0)
+    return ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv
+      (self, type, (uint64_t)round(value));
+  else
+    return NDN_ERROR_success;
+}
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
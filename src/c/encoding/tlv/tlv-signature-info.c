@@ -114,6 +114,73 @@ encodeDigestSha256Value(const void *context, struct ndn_TlvEncoder *encoder)
   return NDN_ERROR_success;
 }
 
+/**
+ * Prepend the ValidityPeriod TLV to the reverse encoder.
+ * @param validityPeriod A pointer to the ndn_ValidityPeriod struct to encode.
+ * @param encoder A pointer to the ndn_TlvReverseEncoder struct.
+ * @return 0 for success, else an error code.
+ */
+static ndn_Error
+reverseEncodeValidityPeriod
+  (const struct ndn_ValidityPeriod *validityPeriod,
+   struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  ndn_Error error;
+  struct ndn_Blob isoStringBlob;
+  char isoString[23];
+
+  // Prepend notAfter first.
+  if ((error = ndn_toIsoString(validityPeriod->notAfter, 0, isoString)))
+    return error;
+  ndn_Blob_initialize
+    (&isoStringBlob, (const uint8_t *)isoString, strlen(isoString));
+  if ((error = ndn_TlvReverseEncoder_prependOptionalBlobTlv
+       (encoder, ndn_Tlv_ValidityPeriod_NotAfter, &isoStringBlob)))
+    return error;
+
+  if ((error = ndn_toIsoString(validityPeriod->notBefore, 0, isoString)))
+    return error;
+  ndn_Blob_initialize
+    (&isoStringBlob, (const uint8_t *)isoString, strlen(isoString));
+  if ((error = ndn_TlvReverseEncoder_prependOptionalBlobTlv
+       (encoder, ndn_Tlv_ValidityPeriod_NotBefore, &isoStringBlob)))
+    return error;
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader
+    (encoder, ndn_Tlv_ValidityPeriod_ValidityPeriod, saveLength);
+}
+
+/**
+ * Do a test decoding of the Generic signature encoding to sanity check that it
+ * is a valid TLV SignatureInfo.
+ * @param encoding A pointer to the signatureInfoEncoding.
+ * @return 0 for success, else
+ * NDN_ERROR_The_Generic_signature_encoding_is_not_a_valid_NDN_TLV_SignatureInfo.
+ */
+static ndn_Error
+checkGenericSignatureInfoEncoding(const struct ndn_Blob *encoding)
+{
+  ndn_Error error;
+  size_t endOffset;
+  uint64_t signatureType;
+
+  struct ndn_TlvDecoder decoder;
+  ndn_TlvDecoder_initialize(&decoder, encoding->value, encoding->length);
+  error = ndn_TlvDecoder_readNestedTlvsStart
+    (&decoder, ndn_Tlv_SignatureInfo, &endOffset);
+  if (!error)
+    error = ndn_TlvDecoder_readNonNegativeIntegerTlv
+      (&decoder, ndn_Tlv_SignatureType, &signatureType);
+  if (!error)
+    // Skip unrecognized TLVs, even if they have a critical type code.
+    error = ndn_TlvDecoder_finishNestedTlvsSkipCritical(&decoder, endOffset);
+  if (error)
+    return NDN_ERROR_The_Generic_signature_encoding_is_not_a_valid_NDN_TLV_SignatureInfo;
+
+  return NDN_ERROR_success;
+}
+
 static ndn_Error
 decodeValidityPeriod
   (struct ndn_ValidityPeriod *validityPeriod, struct ndn_TlvDecoder *decoder)
@@ -167,22 +234,9 @@ ndn_encodeTlvSignatureInfo
     // Handle a Generic signature separately since it has the entire encoding.
     const struct ndn_Blob *encoding = &signatureInfo->signatureInfoEncoding;
     ndn_Error error;
-    size_t endOffset;
-    uint64_t signatureType;
-
-    // Do a test decoding to sanity check that it is valid TLV.
-    struct ndn_TlvDecoder decoder;
-    ndn_TlvDecoder_initialize(&decoder, encoding->value, encoding->length);
-    error = ndn_TlvDecoder_readNestedTlvsStart
-      (&decoder, ndn_Tlv_SignatureInfo, &endOffset);
-    if (!error)
-      error = ndn_TlvDecoder_readNonNegativeIntegerTlv
-        (&decoder, ndn_Tlv_SignatureType, &signatureType);
-    if (!error)
-      // Skip unrecognized TLVs, even if they have a critical type code.
-      error = ndn_TlvDecoder_finishNestedTlvsSkipCritical(&decoder, endOffset);
-    if (error)
-      return NDN_ERROR_The_Generic_signature_encoding_is_not_a_valid_NDN_TLV_SignatureInfo;
+
+    if ((error = checkGenericSignatureInfoEncoding(encoding)))
+      return error;
 
     return ndn_TlvEncoder_writeArray(encoder, encoding->value, encoding->length);
   }
@@ -201,6 +255,54 @@ ndn_encodeTlvSignatureInfo
     return NDN_ERROR_encodeSignatureInfo_unrecognized_SignatureType;
 }
 
+ndn_Error
+ndn_reverseEncodeTlvSignatureInfo
+  (const struct ndn_Signature *signatureInfo,
+   struct ndn_TlvReverseEncoder *encoder)
+{
+  size_t saveLength = encoder->length;
+  ndn_Error error;
+
+  if (signatureInfo->type == ndn_SignatureType_Generic) {
+    // Handle a Generic signature separately since it has the entire encoding.
+    const struct ndn_Blob *encoding = &signatureInfo->signatureInfoEncoding;
+
+    if ((error = checkGenericSignatureInfoEncoding(encoding)))
+      return error;
+
+    return ndn_TlvReverseEncoder_prependArray
+      (encoder, encoding->value, encoding->length);
+  }
+
+  if (signatureInfo->type == ndn_SignatureType_Sha256WithRsaSignature ||
+      signatureInfo->type == ndn_SignatureType_Sha256WithEcdsaSignature ||
+      signatureInfo->type == ndn_SignatureType_HmacWithSha256Signature) {
+    if (ndn_ValidityPeriod_hasPeriod(&signatureInfo->validityPeriod)) {
+      if ((error = reverseEncodeValidityPeriod
+           (&signatureInfo->validityPeriod, encoder)))
+        return error;
+    }
+    if ((error = ndn_reverseEncodeTlvKeyLocator
+         (ndn_Tlv_KeyLocator, &signatureInfo->keyLocator, encoder)))
+      return error;
+    // Use signature->type as the TLV type, assuming that the ndn_SignatureType
+    // enum has the same values as the TLV signature types.
+    if ((error = ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv
+         (encoder, ndn_Tlv_SignatureType, signatureInfo->type)))
+      return error;
+  }
+  else if (signatureInfo->type == ndn_SignatureType_DigestSha256Signature) {
+    if ((error = ndn_TlvReverseEncoder_prependNonNegativeIntegerTlv
+         (encoder, ndn_Tlv_SignatureType, ndn_Tlv_SignatureType_DigestSha256)))
+      return error;
+  }
+  else
+    return NDN_ERROR_encodeSignatureInfo_unrecognized_SignatureType;
+
+  return ndn_TlvReverseEncoder_prependNestedTlvHeader
+    (encoder, ndn_Tlv_SignatureInfo, saveLength);
+}
+
 ndn_Error
 ndn_decodeTlvSignatureInfo
   (struct ndn_Signature *signatureInfo, struct ndn_TlvDecoder *decoder)
@@ -23,6 +23,7 @@
 
 #include "../../data.h"
 #include "tlv-encoder.h"
+#include "tlv-reverse-encoder.h"
 #include "tlv-decoder.h"
 
 #ifdef __cplusplus
@@ -40,6 +41,20 @@ ndn_Error
 ndn_encodeTlvSignatureInfo
   (const struct ndn_Signature *signatureInfo, struct ndn_TlvEncoder *encoder);
 
+/**
+ * Encode signatureInfo as an NDN-TLV SignatureInfo by prepending it to the
+ * reverse encoder. This produces the same encoding as
+ * ndn_encodeTlvSignatureInfo.
+ * @param signatureInfo A pointer to the ndn_Signature struct to encode.
+ * @param encoder A pointer to the ndn_TlvReverseEncoder struct which receives
+ * the encoding.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_reverseEncodeTlvSignatureInfo
+  (const struct ndn_Signature *signatureInfo,
+   struct ndn_TlvReverseEncoder *encoder);
+
 /**
  * Decode as an NDN-TLV SignatureInfo and set the fields in signatureInfo.
  * @param signatureInfo A pointer to the ndn_Signature struct to receive the
@@ -23,6 +23,7 @@
 
 #include <ndn-cpp/c/common.h>
 #include <ndn-cpp/c/errors.h>
+#include <ndn-cpp/c/encrypt/algo/aes-context-types.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -178,6 +179,143 @@ ndn_AesAlgorithm_encrypt128Ecb
   (const uint8_t *key, size_t keyLength, const uint8_t *plainData,
    size_t plainDataLength, uint8_t *encryptedData, size_t *encryptedDataLength);
 
+/**
+ * Initialize the ndn_AesContext struct with no key. You must call
+ * ndn_AesContext_setKey before encrypting or decrypting.
+ * @param self A pointer to the ndn_AesContext struct.
+ */
+static __inline void
+ndn_AesContext_initialize(struct ndn_AesContext *self)
+{
+  self->algorithmType = (ndn_EncryptAlgorithmType)-1;
+  self->encryptContext = 0;
+  self->decryptContext = 0;
+}
+
+/**
+ * Finalize the ndn_AesContext struct, freeing the cipher contexts if needed.
+ * @param self A pointer to the ndn_AesContext struct.
+ */
+void
+ndn_AesContext_finalize(struct ndn_AesContext *self);
+
+/**
+ * Expand the key for the algorithm in new cipher contexts, freeing the
+ * previous contexts if needed. You must call ndn_AesContext_finalize to free
+ * them.
+ * @param self A pointer to the ndn_AesContext struct.
+ * @param algorithmType The cipher mode, which must be
+ * ndn_EncryptAlgorithmType_AesEcb, ndn_EncryptAlgorithmType_AesCbc,
+ * ndn_EncryptAlgorithmType_AesCtr or ndn_EncryptAlgorithmType_AesGcm.
+ * @param key A pointer to the key byte array.
+ * @param keyLength The length of key, which must be ndn_AES_128_KEY_LENGTH or
+ * ndn_AES_256_KEY_LENGTH.
+ * @return 0 for success, else NDN_ERROR_Incorrect_key_size for incorrect
+ * keyLength, NDN_ERROR_Unsupported_algorithm_type for an unsupported
+ * algorithmType, or NDN_ERROR_Error_in_encrypt_operation if the contexts can't
+ * be created.
+ */
+ndn_Error
+ndn_AesContext_setKey
+  (struct ndn_AesContext *self, ndn_EncryptAlgorithmType algorithmType,
+   const uint8_t *key, size_t keyLength);
+
+/**
+ * Get the exact number of bytes that ndn_AesContext_encrypt will write for
+ * the plain data length, including the padding for ECB and CBC mode and the
+ * authentication tag for GCM mode.
+ * @param self A pointer to the ndn_AesContext struct.
+ * @param plainDataLength The length of the plain data.
+ * @return The length of the encrypted data.
+ */
+static __inline size_t
+ndn_AesContext_getEncryptedDataLength
+  (const struct ndn_AesContext *self, size_t plainDataLength)
+{
+  if (self->algorithmType == ndn_EncryptAlgorithmType_AesEcb ||
+      self->algorithmType == ndn_EncryptAlgorithmType_AesCbc)
+    return (plainDataLength / ndn_AES_BLOCK_LENGTH + 1) * ndn_AES_BLOCK_LENGTH;
+  else if (self->algorithmType == ndn_EncryptAlgorithmType_AesGcm)
+    return plainDataLength + ndn_AES_GCM_TAG_LENGTH;
+  else
+    return plainDataLength;
+}
+
+/**
+ * Encrypt plainData with the key and algorithm given to ndn_AesContext_setKey.
+ * This only sets the initial vector in the cipher context, so it doesn't
+ * expand the key again. In GCM mode, this appends the authentication tag to
+ * the encrypted data. The tag covers the encrypted data and additionalData,
+ * so that the decryptor must supply the same additionalData. Because this
+ * changes the cipher context, different threads must not use the same
+ * ndn_AesContext at the same time.
+ * @param self A pointer to the ndn_AesContext struct.
+ * @param initialVector A pointer to the initial vector byte array. This is
+ * ignored for ECB mode.
+ * @param initialVectorLength The length of initialVector. It is an error if
+ * this is not ndn_AES_GCM_INITIAL_VECTOR_LENGTH for GCM mode or
+ * ndn_AES_BLOCK_LENGTH for CBC and CTR mode.
+ * @param additionalData A pointer to the additional data which GCM mode
+ * authenticates but doesn't encrypt. This may be 0 if additionalDataLength
+ * is 0.
+ * @param additionalDataLength The length of additionalData. It is an error if
+ * this is not 0 for modes other than GCM.
+ * @param plainData A pointer to the input byte array to encrypt.
+ * @param plainDataLength The length of plainData.
+ * @param encryptedData A pointer to the encrypted output buffer. The caller
+ * must provide a buffer of at least
+ * ndn_AesContext_getEncryptedDataLength(self, plainDataLength) bytes. For CTR
+ * mode this may be the same as plainData to encrypt in place.
+ * @param encryptedDataLength This sets encryptedDataLength to the number of
+ * bytes placed in the encryptedData buffer.
+ * @return 0 for success, else NDN_ERROR_Incorrect_initial_vector_size for
+ * incorrect initialVectorLength or NDN_ERROR_Error_in_encrypt_operation if
+ * the key is not set or the encryption fails.
+ */
+ndn_Error
+ndn_AesContext_encrypt
+  (struct ndn_AesContext *self, const uint8_t *initialVector,
+   size_t initialVectorLength, const uint8_t *additionalData,
+   size_t additionalDataLength, const uint8_t *plainData,
+   size_t plainDataLength, uint8_t *encryptedData, size_t *encryptedDataLength);
+
+/**
+ * Decrypt encryptedData with the key and algorithm given to
+ * ndn_AesContext_setKey. This only sets the initial vector in the cipher
+ * context, so it doesn't expand the key again. In GCM mode, this checks the
+ * authentication tag at the end of encryptedData against the encrypted data
+ * and additionalData. Because this changes the cipher context, different
+ * threads must not use the same ndn_AesContext at the same time.
+ * @param self A pointer to the ndn_AesContext struct.
+ * @param initialVector A pointer to the initial vector byte array. This is
+ * ignored for ECB mode.
+ * @param initialVectorLength The length of initialVector. It is an error if
+ * this is not ndn_AES_GCM_INITIAL_VECTOR_LENGTH for GCM mode or
+ * ndn_AES_BLOCK_LENGTH for CBC and CTR mode.
+ * @param additionalData A pointer to the additional data which GCM mode
+ * authenticates but doesn't encrypt. This may be 0 if additionalDataLength
+ * is 0.
+ * @param additionalDataLength The length of additionalData. It is an error if
+ * this is not 0 for modes other than GCM.
+ * @param encryptedData A pointer to the input byte array to decrypt.
+ * @param encryptedDataLength The length of encryptedData.
+ * @param plainData A pointer to the decrypted output buffer. The caller
+ * must provide a large enough buffer, which should be at least
+ * encryptedDataLength bytes.
+ * @param plainDataLength This sets plainDataLength to the number of bytes
+ * placed in the plainData buffer.
+ * @return 0 for success, else NDN_ERROR_Incorrect_initial_vector_size for
+ * incorrect initialVectorLength or NDN_ERROR_Error_in_decrypt_operation if
+ * the key is not set, the padding is wrong or the GCM authentication tag
+ * doesn't verify.
+ */
+ndn_Error
+ndn_AesContext_decrypt
+  (struct ndn_AesContext *self, const uint8_t *initialVector,
+   size_t initialVectorLength, const uint8_t *additionalData,
+   size_t additionalDataLength, const uint8_t *encryptedData,
+   size_t encryptedDataLength, uint8_t *plainData, size_t *plainDataLength);
+
 #ifdef __cplusplus
 }
 #endif
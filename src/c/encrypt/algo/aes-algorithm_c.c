@@ -219,4 +219,199 @@ ndn_AesAlgorithm_encrypt128Ecb
   return NDN_ERROR_success;
 }
 
+/**
+ * Get the OpenSSL cipher for the algorithm type and key length.
+ * @return The cipher, or 0 if not supported.
+ */
+static const EVP_CIPHER *
+getAesCipher(ndn_EncryptAlgorithmType algorithmType, size_t keyLength)
+{
+  int is256 = (keyLength == ndn_AES_256_KEY_LENGTH);
+
+  if (algorithmType == ndn_EncryptAlgorithmType_AesEcb)
+    return is256 ? EVP_aes_256_ecb() : EVP_aes_128_ecb();
+  else if (algorithmType == ndn_EncryptAlgorithmType_AesCbc)
+    return is256 ? EVP_aes_256_cbc() : EVP_aes_128_cbc();
+  else if (algorithmType == ndn_EncryptAlgorithmType_AesCtr)
+    return is256 ? EVP_aes_256_ctr() : EVP_aes_128_ctr();
+  else if (algorithmType == ndn_EncryptAlgorithmType_AesGcm)
+    return is256 ? EVP_aes_256_gcm() : EVP_aes_128_gcm();
+  else
+    return 0;
+}
+
+/**
+ * Check the initial vector length for the algorithm type in the context.
+ * @return 0 for success, else NDN_ERROR_Incorrect_initial_vector_size.
+ */
+static ndn_Error
+checkInitialVectorLength
+  (const struct ndn_AesContext *self, size_t initialVectorLength)
+{
+  if (self->algorithmType == ndn_EncryptAlgorithmType_AesEcb)
+    return NDN_ERROR_success;
+  else if (self->algorithmType == ndn_EncryptAlgorithmType_AesGcm) {
+    if (initialVectorLength != ndn_AES_GCM_INITIAL_VECTOR_LENGTH)
+      return NDN_ERROR_Incorrect_initial_vector_size;
+  }
+  else {
+    if (initialVectorLength != ndn_AES_BLOCK_LENGTH)
+      return NDN_ERROR_Incorrect_initial_vector_size;
+  }
+
+  return NDN_ERROR_success;
+}
+
+void
+ndn_AesContext_finalize(struct ndn_AesContext *self)
+{
+  if (self->encryptContext) {
+    EVP_CIPHER_CTX_free(self->encryptContext);
+    self->encryptContext = 0;
+  }
+  if (self->decryptContext) {
+    EVP_CIPHER_CTX_free(self->decryptContext);
+    self->decryptContext = 0;
+  }
+  self->algorithmType = (ndn_EncryptAlgorithmType)-1;
+}
+
+ndn_Error
+ndn_AesContext_setKey
+  (struct ndn_AesContext *self, ndn_EncryptAlgorithmType algorithmType,
+   const uint8_t *key, size_t keyLength)
+{
+  const EVP_CIPHER *cipher;
+
+  if (keyLength != ndn_AES_128_KEY_LENGTH && keyLength != ndn_AES_256_KEY_LENGTH)
+    return NDN_ERROR_Incorrect_key_size;
+  cipher = getAesCipher(algorithmType, keyLength);
+  if (!cipher)
+    return NDN_ERROR_Unsupported_algorithm_type;
+
+  ndn_AesContext_finalize(self);
+  self->encryptContext = EVP_CIPHER_CTX_new();
+  self->decryptContext = EVP_CIPHER_CTX_new();
+  // Expand the key now. Each call to encrypt or decrypt only sets the IV.
+  if (!self->encryptContext || !self->decryptContext ||
+      !EVP_EncryptInit_ex
+        (self->encryptContext, cipher, 0, (const unsigned char*)key, 0) ||
+      !EVP_DecryptInit_ex
+        (self->decryptContext, cipher, 0, (const unsigned char*)key, 0)) {
+    ndn_AesContext_finalize(self);
+    return NDN_ERROR_Error_in_encrypt_operation;
+  }
+
+  self->algorithmType = algorithmType;
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_AesContext_encrypt
+  (struct ndn_AesContext *self, const uint8_t *initialVector,
+   size_t initialVectorLength, const uint8_t *additionalData,
+   size_t additionalDataLength, const uint8_t *plainData,
+   size_t plainDataLength, uint8_t *encryptedData, size_t *encryptedDataLength)
+{
+  int outLength1, outLength2;
+  ndn_Error error;
+
+  if (!self->encryptContext)
+    return NDN_ERROR_Error_in_encrypt_operation;
+  if ((error = checkInitialVectorLength(self, initialVectorLength)))
+    return error;
+  if (additionalDataLength > 0 &&
+      self->algorithmType != ndn_EncryptAlgorithmType_AesGcm)
+    return NDN_ERROR_Error_in_encrypt_operation;
+
+  // Passing a null cipher and key keeps the expanded key.
+  if (!EVP_EncryptInit_ex
+        (self->encryptContext, 0, 0, 0,
+         self->algorithmType == ndn_EncryptAlgorithmType_AesEcb ?
+           0 : (const unsigned char*)initialVector))
+    return NDN_ERROR_Error_in_encrypt_operation;
+
+  // A null output buffer gives the additional data to GCM to authenticate.
+  if (additionalDataLength > 0 &&
+      !EVP_EncryptUpdate
+        (self->encryptContext, 0, &outLength1,
+         (const unsigned char*)additionalData, (int)additionalDataLength))
+    return NDN_ERROR_Error_in_encrypt_operation;
+
+  if (!EVP_EncryptUpdate
+        (self->encryptContext, (unsigned char*)encryptedData, &outLength1,
+         (const unsigned char*)plainData, (int)plainDataLength) ||
+      !EVP_EncryptFinal_ex
+        (self->encryptContext, (unsigned char*)encryptedData + outLength1,
+         &outLength2))
+    return NDN_ERROR_Error_in_encrypt_operation;
+  *encryptedDataLength = outLength1 + outLength2;
+
+  if (self->algorithmType == ndn_EncryptAlgorithmType_AesGcm) {
+    if (!EVP_CIPHER_CTX_ctrl
+        (self->encryptContext, EVP_CTRL_GCM_GET_TAG, ndn_AES_GCM_TAG_LENGTH,
+         encryptedData + *encryptedDataLength))
+      return NDN_ERROR_Error_in_encrypt_operation;
+    *encryptedDataLength += ndn_AES_GCM_TAG_LENGTH;
+  }
+
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_AesContext_decrypt
+  (struct ndn_AesContext *self, const uint8_t *initialVector,
+   size_t initialVectorLength, const uint8_t *additionalData,
+   size_t additionalDataLength, const uint8_t *encryptedData,
+   size_t encryptedDataLength, uint8_t *plainData, size_t *plainDataLength)
+{
+  int outLength1, outLength2;
+  ndn_Error error;
+
+  if (!self->decryptContext)
+    return NDN_ERROR_Error_in_decrypt_operation;
+  if ((error = checkInitialVectorLength(self, initialVectorLength)))
+    return error;
+  if (additionalDataLength > 0 &&
+      self->algorithmType != ndn_EncryptAlgorithmType_AesGcm)
+    return NDN_ERROR_Error_in_decrypt_operation;
+
+  if (!EVP_DecryptInit_ex
+      (self->decryptContext, 0, 0, 0,
+       self->algorithmType == ndn_EncryptAlgorithmType_AesEcb ?
+         0 : (const unsigned char*)initialVector))
+    return NDN_ERROR_Error_in_decrypt_operation;
+
+  if (self->algorithmType == ndn_EncryptAlgorithmType_AesGcm) {
+    // Remove the authentication tag and give it to the context to check.
+    if (encryptedDataLength < ndn_AES_GCM_TAG_LENGTH)
+      return NDN_ERROR_Error_in_decrypt_operation;
+    encryptedDataLength -= ndn_AES_GCM_TAG_LENGTH;
+    if (!EVP_CIPHER_CTX_ctrl
+        (self->decryptContext, EVP_CTRL_GCM_SET_TAG, ndn_AES_GCM_TAG_LENGTH,
+         (void *)(encryptedData + encryptedDataLength)))
+      return NDN_ERROR_Error_in_decrypt_operation;
+
+    // A null output buffer gives the additional data to GCM to authenticate.
+    if (additionalDataLength > 0 &&
+        !EVP_DecryptUpdate
+          (self->decryptContext, 0, &outLength1,
+           (const unsigned char*)additionalData, (int)additionalDataLength))
+      return NDN_ERROR_Error_in_decrypt_operation;
+  }
+
+  // For GCM, EVP_DecryptFinal_ex fails if the authentication tag is wrong,
+  // including when the additional data doesn't match.
+  if (!EVP_DecryptUpdate
+        (self->decryptContext, (unsigned char*)plainData, &outLength1,
+         (const unsigned char*)encryptedData, (int)encryptedDataLength) ||
+      !EVP_DecryptFinal_ex
+        (self->decryptContext, (unsigned char*)plainData + outLength1,
+         &outLength2))
+    return NDN_ERROR_Error_in_decrypt_operation;
+  *plainDataLength = outLength1 + outLength2;
+
+  return NDN_ERROR_success;
+}
+
 #endif // NDN_CPP_HAVE_LIBCRYPTO
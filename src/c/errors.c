@@ -146,6 +146,8 @@ ndn_getErrorString(int error)
     return      "Unrecognized critical TLV type code";
   case NDN_ERROR_Name_component_otherTypeCode_must_be_non_negative:
     return      "Name component otherTypeCode must be non-negative";
+  case NDN_ERROR_ElementReader_received_more_bytes_than_the_receive_buffer_length:
+    return      "ElementReader received more bytes than the receive buffer length";
   default:
     return "unrecognized ndn_Error code";
   }
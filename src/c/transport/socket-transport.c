@@ -18,6 +18,11 @@
  * A copy of the GNU Lesser General Public License is in the file COPYING.
  */
 
+// recvmmsg and sendmmsg are GNU extensions.
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 // Only compile if we have Unix socket support.
 #include <ndn-cpp/ndn-cpp-config.h>
 #if NDN_CPP_HAVE_UNISTD_H
@@ -30,6 +35,7 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
 #include <poll.h>
 #include "../util/ndn_memory.h"
@@ -185,17 +191,48 @@ ndn_SocketTransport_processEvents
     int receiveIsReady;
     ndn_Error error;
     size_t nBytes;
+    uint8_t *gap;
+    size_t gapLength;
     if ((error = ndn_SocketTransport_receiveIsReady
          (self, &receiveIsReady)))
       return error;
     if (!receiveIsReady)
       return NDN_ERROR_success;
 
-    if ((error = ndn_SocketTransport_receive
-         (self, buffer, bufferLength, &nBytes)))
-      return error;
-    if (nBytes == 0)
-      return NDN_ERROR_success;
+    ndn_ElementReader_getReceiveBuffer(&self->elementReader, &gap, &gapLength);
+    if (gapLength > 0) {
+      // The element reader already knows the length of the partial element.
+      // Receive the rest of it directly into its buffer and any following
+      // bytes into the given buffer.
+      struct iovec ioVectors[2];
+      ssize_t nReceived;
+      size_t nGapBytes;
+
+      ioVectors[0].iov_base = gap;
+      ioVectors[0].iov_len = gapLength;
+      ioVectors[1].iov_base = buffer;
+      ioVectors[1].iov_len = bufferLength;
+      if ((nReceived = readv(self->socketDescriptor, ioVectors, 2)) == -1)
+        return NDN_ERROR_SocketTransport_error_in_recv;
+      if (nReceived == 0)
+        return NDN_ERROR_success;
+
+      nBytes = (size_t)nReceived;
+      nGapBytes = nBytes < gapLength ? nBytes : gapLength;
+      if ((error = ndn_ElementReader_onReceivedIntoBuffer
+           (&self->elementReader, nGapBytes)))
+        return error;
+      nBytes -= nGapBytes;
+      if (nBytes == 0)
+        continue;
+    }
+    else {
+      if ((error = ndn_SocketTransport_receive
+           (self, buffer, bufferLength, &nBytes)))
+        return error;
+      if (nBytes == 0)
+        return NDN_ERROR_success;
+    }
 
     if ((error = ndn_ElementReader_onReceivedData
          (&self->elementReader, buffer, nBytes)))
@@ -203,6 +240,144 @@ ndn_SocketTransport_processEvents
   }
 }
 
+ndn_Error
+ndn_SocketTransport_receiveDatagrams
+  (struct ndn_SocketTransport *self, uint8_t **buffers, size_t bufferLength,
+   size_t nBuffers, size_t *datagramLengths, size_t *nDatagrams)
+{
+  *nDatagrams = 0;
+  if (self->socketDescriptor < 0)
+    // The socket is not open.  Just silently return.
+    return NDN_ERROR_success;
+  if (nBuffers > NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS)
+    nBuffers = NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS;
+
+#if NDN_CPP_HAVE_RECVMMSG
+  {
+    struct mmsghdr messages[NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS];
+    struct iovec ioVectors[NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS];
+    size_t i;
+    int nMessages;
+
+    ndn_memset((uint8_t *)messages, 0, sizeof(messages[0]) * nBuffers);
+    for (i = 0; i < nBuffers; ++i) {
+      ioVectors[i].iov_base = buffers[i];
+      ioVectors[i].iov_len = bufferLength;
+      messages[i].msg_hdr.msg_iov = &ioVectors[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    nMessages = recvmmsg
+      (self->socketDescriptor, messages, nBuffers, MSG_DONTWAIT, NULL);
+    if (nMessages < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        // No data is ready.
+        return NDN_ERROR_success;
+      return NDN_ERROR_SocketTransport_error_in_recv;
+    }
+
+    for (i = 0; i < (size_t)nMessages; ++i)
+      datagramLengths[i] = messages[i].msg_len;
+    *nDatagrams = (size_t)nMessages;
+  }
+#else
+  // Receive one datagram at a time while data is ready.
+  while (*nDatagrams < nBuffers) {
+    int receiveIsReady;
+    ndn_Error error;
+    if ((error = ndn_SocketTransport_receiveIsReady(self, &receiveIsReady)))
+      return error;
+    if (!receiveIsReady)
+      break;
+
+    if ((error = ndn_SocketTransport_receive
+         (self, buffers[*nDatagrams], bufferLength,
+          &datagramLengths[*nDatagrams])))
+      return error;
+    ++(*nDatagrams);
+  }
+#endif
+
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_SocketTransport_sendDatagrams
+  (struct ndn_SocketTransport *self, uint8_t **datagrams,
+   const size_t *datagramLengths, size_t nDatagrams)
+{
+  if (self->socketDescriptor < 0)
+    return NDN_ERROR_SocketTransport_socket_is_not_open;
+
+#if NDN_CPP_HAVE_SENDMMSG
+  {
+    struct mmsghdr messages[NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS];
+    struct iovec ioVectors[NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS];
+
+    while (nDatagrams > 0) {
+      size_t nToSend = nDatagrams < NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS ?
+        nDatagrams : NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS;
+      size_t i;
+      int nSent;
+
+      ndn_memset((uint8_t *)messages, 0, sizeof(messages[0]) * nToSend);
+      for (i = 0; i < nToSend; ++i) {
+        ioVectors[i].iov_base = datagrams[i];
+        ioVectors[i].iov_len = datagramLengths[i];
+        messages[i].msg_hdr.msg_iov = &ioVectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+      }
+
+      if ((nSent = sendmmsg(self->socketDescriptor, messages, nToSend, 0)) <= 0)
+        return NDN_ERROR_SocketTransport_error_in_send;
+
+      // sendmmsg may send fewer than requested, so send the rest.
+      datagrams += nSent;
+      datagramLengths += nSent;
+      nDatagrams -= (size_t)nSent;
+    }
+  }
+#else
+  {
+    size_t i;
+    for (i = 0; i < nDatagrams; ++i) {
+      ndn_Error error;
+      if ((error = ndn_SocketTransport_send
+           (self, datagrams[i], datagramLengths[i])))
+        return error;
+    }
+  }
+#endif
+
+  return NDN_ERROR_success;
+}
+
+ndn_Error
+ndn_SocketTransport_processDatagrams
+  (struct ndn_SocketTransport *self, uint8_t **buffers, size_t bufferLength,
+   size_t nBuffers, size_t *datagramLengths)
+{
+  // Loop until there is no more data in the receive buffer.
+  while (1) {
+    ndn_Error error;
+    size_t nDatagrams;
+    size_t i;
+    if ((error = ndn_SocketTransport_receiveDatagrams
+         (self, buffers, bufferLength, nBuffers, datagramLengths, &nDatagrams)))
+      return error;
+
+    for (i = 0; i < nDatagrams; ++i) {
+      if ((error = ndn_ElementReader_onReceivedData
+           (&self->elementReader, buffers[i], datagramLengths[i])))
+        return error;
+    }
+
+    if (nDatagrams < nBuffers)
+      // We received everything which was ready.
+      return NDN_ERROR_success;
+  }
+}
+
 ndn_Error ndn_SocketTransport_close(struct ndn_SocketTransport *self)
 {
   if (self->socketDescriptor < 0)
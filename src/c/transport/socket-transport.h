@@ -30,6 +30,13 @@
 extern "C" {
 #endif
 
+/**
+ * The maximum number of datagrams for one call to
+ * ndn_SocketTransport_receiveDatagrams or one system call in
+ * ndn_SocketTransport_sendDatagrams.
+ */
+#define NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS 64
+
 typedef enum {
   SOCKET_TCP,
   SOCKET_UDP,
@@ -120,6 +127,62 @@ ndn_Error
 ndn_SocketTransport_processEvents
   (struct ndn_SocketTransport *self, uint8_t *buffer, size_t bufferLength);
 
+/**
+ * Receive the datagrams which are ready on the socket, up to nBuffers, with one
+ * call to recvmmsg if available, else by calling recv for each datagram. This
+ * does not block, and returns immediately if no data is ready. If the socket is
+ * not open, this sets nDatagrams to 0 and returns success.
+ * @param self A pointer to the ndn_SocketTransport struct.
+ * @param buffers An array of nBuffers pointers to buffers to receive the
+ * datagrams, each of size bufferLength.
+ * @param bufferLength The size of each buffer.
+ * @param nBuffers The number of buffers. This uses at most
+ * NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS.
+ * @param datagramLengths An array of size nBuffers which this sets to the
+ * length of the datagram received into the buffer at the same index.
+ * @param nDatagrams This sets nDatagrams to the number of datagrams received.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_SocketTransport_receiveDatagrams
+  (struct ndn_SocketTransport *self, uint8_t **buffers, size_t bufferLength,
+   size_t nBuffers, size_t *datagramLengths, size_t *nDatagrams);
+
+/**
+ * Send each of the datagrams to the connected socket, with one call to
+ * sendmmsg for up to NDN_SOCKET_TRANSPORT_MAX_DATAGRAMS if available, else by
+ * calling send for each datagram.
+ * @param self A pointer to the ndn_SocketTransport struct.
+ * @param datagrams An array of nDatagrams pointers to the datagrams to send.
+ * @param datagramLengths An array of the nDatagrams lengths of the datagrams.
+ * @param nDatagrams The number of datagrams to send.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_SocketTransport_sendDatagrams
+  (struct ndn_SocketTransport *self, uint8_t **datagrams,
+   const size_t *datagramLengths, size_t nDatagrams);
+
+/**
+ * Process any datagrams to receive, using ndn_SocketTransport_receiveDatagrams
+ * to receive multiple datagrams at once. For each element received, call
+ * (*elementListener->onReceivedElement)(element, elementLength) for the
+ * elementListener in the elementReader given to connect(). This is
+ * non-blocking and will return immediately if there is no data to receive.
+ * @param self A pointer to the ndn_SocketTransport struct.
+ * @param buffers An array of nBuffers pointers to buffers for receiving
+ * datagrams, each of size bufferLength. These are only for temporary use.
+ * @param bufferLength The size of each buffer, which should be
+ * MAX_NDN_PACKET_SIZE so that a datagram is not truncated.
+ * @param nBuffers The number of buffers.
+ * @param datagramLengths An array of size nBuffers for temporary use.
+ * @return 0 for success, else an error code.
+ */
+ndn_Error
+ndn_SocketTransport_processDatagrams
+  (struct ndn_SocketTransport *self, uint8_t **buffers, size_t bufferLength,
+   size_t nBuffers, size_t *datagramLengths);
+
 /**
  * Close the socket.
  * @param self A pointer to the ndn_SocketTransport struct.
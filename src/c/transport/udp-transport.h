@@ -105,6 +105,43 @@ ndn_UdpTransport_processEvents
   return ndn_SocketTransport_processEvents(&self->base, buffer, bufferLength);
 }
 
+/**
+ * Process any datagrams to receive, receiving multiple datagrams with one call
+ * to recvmmsg if available. See ndn_SocketTransport_processDatagrams.
+ * @param self A pointer to the ndn_UdpTransport struct.
+ * @param buffers An array of nBuffers pointers to buffers for receiving
+ * datagrams, each of size bufferLength.
+ * @param bufferLength The size of each buffer.
+ * @param nBuffers The number of buffers.
+ * @param datagramLengths An array of size nBuffers for temporary use.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error
+ndn_UdpTransport_processDatagrams
+  (struct ndn_UdpTransport *self, uint8_t **buffers, size_t bufferLength,
+   size_t nBuffers, size_t *datagramLengths)
+{
+  return ndn_SocketTransport_processDatagrams
+    (&self->base, buffers, bufferLength, nBuffers, datagramLengths);
+}
+
+/**
+ * Send the datagrams with one call to sendmmsg if available. See
+ * ndn_SocketTransport_sendDatagrams.
+ * @param self A pointer to the ndn_UdpTransport struct.
+ * @param datagrams An array of nDatagrams pointers to the datagrams to send.
+ * @param datagramLengths An array of the nDatagrams lengths of the datagrams.
+ * @param nDatagrams The number of datagrams to send.
+ * @return 0 for success, else an error code.
+ */
+static __inline ndn_Error ndn_UdpTransport_sendDatagrams
+  (struct ndn_UdpTransport *self, uint8_t **datagrams,
+   const size_t *datagramLengths, size_t nDatagrams)
+{
+  return ndn_SocketTransport_sendDatagrams
+    (&self->base, datagrams, datagramLengths, nDatagrams);
+}
+
 /**
  * Close the socket.
  * @param self A pointer to the ndn_UdpTransport struct.
@@ -20,6 +20,7 @@
  */
 
 #include <stdexcept>
+#include <typeinfo>
 #include <ndn-cpp/common.hpp>
 #include <ndn-cpp/digest-sha256-signature.hpp>
 #include <ndn-cpp/sha256-with-ecdsa-signature.hpp>
@@ -36,6 +37,19 @@ using namespace std;
 
 namespace ndn {
 
+/**
+ * Make sure that signature has a Signature object of type T. If it already
+ * has one, keep it so that decoding into a reused Data object doesn't
+ * allocate a new Signature.
+ * @param signature The signature to check and set.
+ */
+template<class T> static void
+ensureSignatureType(SharedPointerChangeCounter<Signature>& signature)
+{
+  if (!signature.get() || typeid(*signature.get()) != typeid(T))
+    signature.set(ptr_lib::shared_ptr<Signature>(new T()));
+}
+
 Data::Data()
 : signature_(new Sha256WithRsaSignature()),
   changeCount_(0),
@@ -146,15 +160,15 @@ void
 Data::set(const DataLite& dataLite)
 {
   if (dataLite.getSignature().getType() == ndn_SignatureType_Sha256WithRsaSignature)
-    signature_.set(ptr_lib::shared_ptr<Signature>(new Sha256WithRsaSignature()));
+    ensureSignatureType<Sha256WithRsaSignature>(signature_);
   else if (dataLite.getSignature().getType() == ndn_SignatureType_Sha256WithEcdsaSignature)
-    signature_.set(ptr_lib::shared_ptr<Signature>(new Sha256WithEcdsaSignature()));
+    ensureSignatureType<Sha256WithEcdsaSignature>(signature_);
   else if (dataLite.getSignature().getType() == ndn_SignatureType_HmacWithSha256Signature)
-    signature_.set(ptr_lib::shared_ptr<Signature>(new HmacWithSha256Signature()));
+    ensureSignatureType<HmacWithSha256Signature>(signature_);
   else if (dataLite.getSignature().getType() == ndn_SignatureType_DigestSha256Signature)
-    signature_.set(ptr_lib::shared_ptr<Signature>(new DigestSha256Signature()));
+    ensureSignatureType<DigestSha256Signature>(signature_);
   else if (dataLite.getSignature().getType() == ndn_SignatureType_Generic)
-    signature_.set(ptr_lib::shared_ptr<Signature>(new GenericSignature()));
+    ensureSignatureType<GenericSignature>(signature_);
   else
     // We don't expect this to happen.
     throw runtime_error("dataLite.getSignature().getType() has an unrecognized value");
@@ -185,10 +199,16 @@ Data::wireEncode(WireFormat& wireFormat) const
   Blob encoding = wireFormat.encodeData(*this, &signedPortionBeginOffset, &signedPortionEndOffset);
   SignedBlob wireEncoding = SignedBlob(encoding, signedPortionBeginOffset, signedPortionEndOffset);
 
-  if (&wireFormat == WireFormat::getDefaultWireFormat())
+  if (&wireFormat == WireFormat::getDefaultWireFormat()) {
+    if (defaultFullName_->size() > 0)
+      // The full name is for a previous encoding, such as before re-signing.
+      // (We don't modify the Name since getFullName may have returned it.)
+      const_cast<Data*>(this)->defaultFullName_.reset(new Name());
+
     // This is the default wire encoding.
     const_cast<Data*>(this)->setDefaultWireEncoding
       (wireEncoding, WireFormat::getDefaultWireFormat());
+  }
 
   return wireEncoding;
 }
@@ -198,6 +218,10 @@ Data::wireDecode(const Blob& input, WireFormat& wireFormat)
 {
   size_t signedPortionBeginOffset, signedPortionEndOffset;
   wireFormat.decodeData(*this, input.buf(), input.size(), &signedPortionBeginOffset, &signedPortionEndOffset);
+  if (defaultFullName_->size() > 0)
+    // The full name is for a previously decoded packet. (We don't modify the
+    // Name since getFullName may have returned it.)
+    defaultFullName_.reset(new Name());
 
   if (&wireFormat == WireFormat::getDefaultWireFormat())
     // This is the default wire encoding.
@@ -23,12 +23,18 @@
 #include <ndn-cpp/interest.hpp>
 #include <ndn-cpp/lite/encoding/tlv-0_2-wire-format-lite.hpp>
 #include "tlv-encoder.hpp"
+#include "../util/scratch-array.hpp"
 #include <ndn-cpp/encoding/tlv-0_2-wire-format.hpp>
 
 using namespace std;
 
 namespace ndn {
 
+// Most names fit in the ScratchArray without using the heap.
+typedef ScratchArray<struct ndn_NameComponent, 32> NameComponentArray;
+typedef ScratchArray<struct ndn_NameComponent, 16> KeyNameComponentArray;
+typedef ScratchArray<struct ndn_ExcludeEntry, 8> ExcludeEntryArray;
+
 static bool didCanBePrefixWarning_ = false;
 
 Blob
@@ -42,13 +48,13 @@ Tlv0_2WireFormat::encodeInterest
     didCanBePrefixWarning_ = true;
   }
 
-  struct ndn_NameComponent nameComponents[100];
-  struct ndn_ExcludeEntry excludeEntries[100];
-  struct ndn_NameComponent keyNameComponents[100];
+  NameComponentArray nameComponents(interest.getName().size());
+  ExcludeEntryArray excludeEntries(interest.getExclude().size());
+  KeyNameComponentArray keyNameComponents
+    (interest.getKeyLocator().getKeyName().size());
   InterestLite interestLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
-     excludeEntries, sizeof(excludeEntries) / sizeof(excludeEntries[0]),
-     keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+    (nameComponents.get(), nameComponents.size(), excludeEntries.get(),
+     excludeEntries.size(), keyNameComponents.get(), keyNameComponents.size());
   Blob blob1, blob2;
   interest.get(interestLite, *this, blob1, blob2);
 
@@ -68,29 +74,38 @@ Tlv0_2WireFormat::decodeInterest
   (Interest& interest, const uint8_t *input, size_t inputLength,
    size_t *signedPortionBeginOffset, size_t *signedPortionEndOffset)
 {
-  struct ndn_NameComponent nameComponents[100];
-  struct ndn_ExcludeEntry excludeEntries[100];
-  struct ndn_NameComponent keyNameComponents[100];
-  InterestLite interestLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
-     excludeEntries, sizeof(excludeEntries) / sizeof(excludeEntries[0]),
-     keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+  NameComponentArray nameComponents;
+  ExcludeEntryArray excludeEntries;
+  KeyNameComponentArray keyNameComponents;
+  while (true) {
+    InterestLite interestLite
+      (nameComponents.get(), nameComponents.size(), excludeEntries.get(),
+       excludeEntries.size(), keyNameComponents.get(), keyNameComponents.size());
 
-  ndn_Error error;
-  if ((error = Tlv0_2WireFormatLite::decodeInterest
-       (interestLite, input, inputLength, signedPortionBeginOffset,
-        signedPortionEndOffset)))
-    throw runtime_error(ndn_getErrorString(error));
+    ndn_Error error = Tlv0_2WireFormatLite::decodeInterest
+      (interestLite, input, inputLength, signedPortionBeginOffset,
+       signedPortionEndOffset);
+    if (isScratchArrayFullError(error)) {
+      // This is a long name or exclude. Make room and decode again.
+      nameComponents.grow();
+      excludeEntries.grow();
+      keyNameComponents.grow();
+      continue;
+    }
+    if (error)
+      throw runtime_error(ndn_getErrorString(error));
 
-  if (interestLite.getForwardingHintWireEncoding().buf()) {
-    // Throw any decoding exceptions now before calling set.
-    DelegationSet delegationSet;
-    decodeDelegationSet
-      (delegationSet, interestLite.getForwardingHintWireEncoding().buf(),
-       interestLite.getForwardingHintWireEncoding().size());
-  }
+    if (interestLite.getForwardingHintWireEncoding().buf()) {
+      // Throw any decoding exceptions now before calling set.
+      DelegationSet delegationSet;
+      decodeDelegationSet
+        (delegationSet, interestLite.getForwardingHintWireEncoding().buf(),
+         interestLite.getForwardingHintWireEncoding().size());
+    }
 
-  interest.set(interestLite, *this);
+    interest.set(interestLite, *this);
+    return;
+  }
 }
 
 Tlv0_2WireFormat* Tlv0_2WireFormat::instance_ = 0;
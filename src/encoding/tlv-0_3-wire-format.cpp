@@ -33,20 +33,41 @@
 #include <ndn-cpp/encrypt/encrypted-content.hpp>
 #include <ndn-cpp/lite/encoding/tlv-0_3-wire-format-lite.hpp>
 #include "tlv-encoder.hpp"
+#include "../util/scratch-array.hpp"
 #include <ndn-cpp/encoding/tlv-0_3-wire-format.hpp>
 
 using namespace std;
 
 namespace ndn {
 
+// Most names fit in the ScratchArray without using the heap.
+typedef ScratchArray<struct ndn_NameComponent, 32> NameComponentArray;
+typedef ScratchArray<struct ndn_NameComponent, 16> KeyNameComponentArray;
+typedef ScratchArray<struct ndn_ExcludeEntry, 8> ExcludeEntryArray;
+
 static bool didCanBePrefixWarning_ = false;
 
+/**
+ * Get the number of components in the signature's key locator key name, to
+ * size the KeyNameComponentArray for encoding.
+ * @param signature The Signature.
+ * @return The number of key name components, or 0 if the signature has no key
+ * locator.
+ */
+static size_t
+getKeyNameSize(const Signature* signature)
+{
+  if (KeyLocator::canGetFromSignature(signature))
+    return KeyLocator::getFromSignature(signature).getKeyName().size();
+  else
+    return 0;
+}
+
 Blob
 Tlv0_3WireFormat::encodeName(const Name& name)
 {
-  struct ndn_NameComponent nameComponents[100];
-  NameLite nameLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]));
+  NameComponentArray nameComponents(name.size());
+  NameLite nameLite(nameComponents.get(), nameComponents.size());
   name.get(nameLite);
 
   DynamicUInt8Vector output(256);
@@ -64,17 +85,24 @@ void
 Tlv0_3WireFormat::decodeName
   (Name& name, const uint8_t *input, size_t inputLength)
 {
-  struct ndn_NameComponent nameComponents[100];
-  NameLite nameLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]));
-
-  ndn_Error error;
-  size_t dummyBeginOffset, dummyEndOffset;
-  if ((error = Tlv0_3WireFormatLite::decodeName
-       (nameLite, input, inputLength, &dummyBeginOffset, &dummyEndOffset)))
-    throw runtime_error(ndn_getErrorString(error));
+  NameComponentArray nameComponents;
+  while (true) {
+    NameLite nameLite(nameComponents.get(), nameComponents.size());
+
+    size_t dummyBeginOffset, dummyEndOffset;
+    ndn_Error error = Tlv0_3WireFormatLite::decodeName
+      (nameLite, input, inputLength, &dummyBeginOffset, &dummyEndOffset);
+    if (isScratchArrayFullError(error)) {
+      // This is a long name. Make room and decode again.
+      nameComponents.grow();
+      continue;
+    }
+    if (error)
+      throw runtime_error(ndn_getErrorString(error));
 
-  name.set(nameLite);
+    name.set(nameLite);
+    return;
+  }
 }
 
 Blob
@@ -88,25 +116,26 @@ Tlv0_3WireFormat::encodeInterest
     didCanBePrefixWarning_ = true;
   }
 
-  struct ndn_NameComponent nameComponents[100];
-  struct ndn_ExcludeEntry excludeEntries[100];
-  struct ndn_NameComponent keyNameComponents[100];
+  NameComponentArray nameComponents(interest.getName().size());
+  ExcludeEntryArray excludeEntries(interest.getExclude().size());
+  KeyNameComponentArray keyNameComponents
+    (interest.getKeyLocator().getKeyName().size());
   InterestLite interestLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
-     excludeEntries, sizeof(excludeEntries) / sizeof(excludeEntries[0]),
-     keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+    (nameComponents.get(), nameComponents.size(), excludeEntries.get(),
+     excludeEntries.size(), keyNameComponents.get(), keyNameComponents.size());
   Blob blob1, blob2;
   interest.get(interestLite, *this, blob1, blob2);
 
+  // Encode in one pass from the back instead of computing nested lengths.
   DynamicUInt8Vector output(256);
   ndn_Error error;
   size_t encodingLength;
-  if ((error = Tlv0_3WireFormatLite::encodeInterest
+  if ((error = Tlv0_3WireFormatLite::reverseEncodeInterest
        (interestLite, signedPortionBeginOffset, signedPortionEndOffset,
         DynamicUInt8ArrayLite::downCast(output), &encodingLength)))
     throw runtime_error(ndn_getErrorString(error));
 
-  return output.finish(encodingLength);
+  return output.finishFromBack(encodingLength);
 }
 
 void
@@ -114,69 +143,89 @@ Tlv0_3WireFormat::decodeInterest
   (Interest& interest, const uint8_t *input, size_t inputLength,
    size_t *signedPortionBeginOffset, size_t *signedPortionEndOffset)
 {
-  struct ndn_NameComponent nameComponents[100];
-  struct ndn_ExcludeEntry excludeEntries[100];
-  struct ndn_NameComponent keyNameComponents[100];
-  InterestLite interestLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
-     excludeEntries, sizeof(excludeEntries) / sizeof(excludeEntries[0]),
-     keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+  NameComponentArray nameComponents;
+  ExcludeEntryArray excludeEntries;
+  KeyNameComponentArray keyNameComponents;
+  while (true) {
+    InterestLite interestLite
+      (nameComponents.get(), nameComponents.size(), excludeEntries.get(),
+       excludeEntries.size(), keyNameComponents.get(), keyNameComponents.size());
+
+    ndn_Error error = Tlv0_3WireFormatLite::decodeInterest
+      (interestLite, input, inputLength, signedPortionBeginOffset,
+       signedPortionEndOffset);
+    if (isScratchArrayFullError(error)) {
+      // This is a long name or exclude. Make room and decode again.
+      nameComponents.grow();
+      excludeEntries.grow();
+      keyNameComponents.grow();
+      continue;
+    }
+    if (error)
+      throw runtime_error(ndn_getErrorString(error));
 
-  ndn_Error error;
-  if ((error = Tlv0_3WireFormatLite::decodeInterest
-       (interestLite, input, inputLength, signedPortionBeginOffset,
-        signedPortionEndOffset)))
-    throw runtime_error(ndn_getErrorString(error));
+    if (interestLite.getForwardingHintWireEncoding().buf()) {
+      // Throw any decoding exceptions now before calling set.
+      DelegationSet delegationSet;
+      decodeDelegationSet
+        (delegationSet, interestLite.getForwardingHintWireEncoding().buf(),
+         interestLite.getForwardingHintWireEncoding().size());
+    }
 
-  if (interestLite.getForwardingHintWireEncoding().buf()) {
-    // Throw any decoding exceptions now before calling set.
-    DelegationSet delegationSet;
-    decodeDelegationSet
-      (delegationSet, interestLite.getForwardingHintWireEncoding().buf(),
-       interestLite.getForwardingHintWireEncoding().size());
+    interest.set(interestLite, *this);
+    return;
   }
-
-  interest.set(interestLite, *this);
 }
 
 Blob
 Tlv0_3WireFormat::encodeData(const Data& data, size_t *signedPortionBeginOffset, size_t *signedPortionEndOffset)
 {
-  struct ndn_NameComponent nameComponents[100];
-  struct ndn_NameComponent keyNameComponents[100];
+  NameComponentArray nameComponents(data.getName().size());
+  KeyNameComponentArray keyNameComponents
+    (getKeyNameSize(data.getSignature()));
   DataLite dataLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
-     keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+    (nameComponents.get(), nameComponents.size(), keyNameComponents.get(),
+     keyNameComponents.size());
   data.get(dataLite);
 
+  // Encode in one pass from the back instead of computing nested lengths.
   DynamicUInt8Vector output(1500);
   ndn_Error error;
   size_t encodingLength;
-  if ((error = Tlv0_3WireFormatLite::encodeData
+  if ((error = Tlv0_3WireFormatLite::reverseEncodeData
        (dataLite, signedPortionBeginOffset, signedPortionEndOffset,
         DynamicUInt8ArrayLite::downCast(output), &encodingLength)))
     throw runtime_error(ndn_getErrorString(error));
 
-  return output.finish(encodingLength);
+  return output.finishFromBack(encodingLength);
 }
 
 void
 Tlv0_3WireFormat::decodeData
   (Data& data, const uint8_t *input, size_t inputLength, size_t *signedPortionBeginOffset, size_t *signedPortionEndOffset)
 {
-  struct ndn_NameComponent nameComponents[100];
-  struct ndn_NameComponent keyNameComponents[100];
-  DataLite dataLite
-    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
-     keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
-
-  ndn_Error error;
-  if ((error = Tlv0_3WireFormatLite::decodeData
-       (dataLite, input, inputLength, signedPortionBeginOffset,
-        signedPortionEndOffset)))
-    throw runtime_error(ndn_getErrorString(error));
+  NameComponentArray nameComponents;
+  KeyNameComponentArray keyNameComponents;
+  while (true) {
+    DataLite dataLite
+      (nameComponents.get(), nameComponents.size(), keyNameComponents.get(),
+       keyNameComponents.size());
+
+    ndn_Error error = Tlv0_3WireFormatLite::decodeData
+      (dataLite, input, inputLength, signedPortionBeginOffset,
+       signedPortionEndOffset);
+    if (isScratchArrayFullError(error)) {
+      // This is a long name. Make room and decode again.
+      nameComponents.grow();
+      keyNameComponents.grow();
+      continue;
+    }
+    if (error)
+      throw runtime_error(ndn_getErrorString(error));
 
-  data.set(dataLite);
+    data.set(dataLite);
+    return;
+  }
 }
 
 Blob
@@ -267,9 +316,9 @@ Tlv0_3WireFormat::decodeControlResponse
 Blob
 Tlv0_3WireFormat::encodeSignatureInfo(const Signature& signature)
 {
-  struct ndn_NameComponent keyNameComponents[100];
+  KeyNameComponentArray keyNameComponents(getKeyNameSize(&signature));
   SignatureLite signatureLite
-    (keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+    (keyNameComponents.get(), keyNameComponents.size());
   signature.get(signatureLite);
 
   DynamicUInt8Vector output(256);
@@ -285,9 +334,9 @@ Tlv0_3WireFormat::encodeSignatureInfo(const Signature& signature)
 Blob
 Tlv0_3WireFormat::encodeSignatureValue(const Signature& signature)
 {
-  struct ndn_NameComponent keyNameComponents[100];
+  KeyNameComponentArray keyNameComponents(getKeyNameSize(&signature));
   SignatureLite signatureLite
-    (keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+    (keyNameComponents.get(), keyNameComponents.size());
   signature.get(signatureLite);
 
   DynamicUInt8Vector output(300);
@@ -305,33 +354,40 @@ Tlv0_3WireFormat::decodeSignatureInfoAndValue
   (const uint8_t *signatureInfo, size_t signatureInfoLength,
    const uint8_t *signatureValue, size_t signatureValueLength)
 {
-  struct ndn_NameComponent keyNameComponents[100];
-  SignatureLite signatureLite
-    (keyNameComponents, sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
-
-  ndn_Error error;
-  if ((error = Tlv0_3WireFormatLite::decodeSignatureInfoAndValue
-       (signatureLite, signatureInfo, signatureInfoLength, signatureValue,
-        signatureValueLength)))
-    throw runtime_error(ndn_getErrorString(error));
-
-  ptr_lib::shared_ptr<Signature> result;
-  if (signatureLite.getType() == ndn_SignatureType_Sha256WithRsaSignature)
-    result.reset(new Sha256WithRsaSignature());
-  else if (signatureLite.getType() == ndn_SignatureType_Sha256WithEcdsaSignature)
-    result.reset(new Sha256WithEcdsaSignature());
-  else if (signatureLite.getType() == ndn_SignatureType_HmacWithSha256Signature)
-    result.reset(new HmacWithSha256Signature());
-  else if (signatureLite.getType() == ndn_SignatureType_DigestSha256Signature)
-    result.reset(new DigestSha256Signature());
-  else if (signatureLite.getType() == ndn_SignatureType_Generic)
-    result.reset(new GenericSignature());
-  else
-    // We don't expect this to happen.
-    throw runtime_error("signatureStruct.type has an unrecognized value");
+  KeyNameComponentArray keyNameComponents;
+  while (true) {
+    SignatureLite signatureLite
+      (keyNameComponents.get(), keyNameComponents.size());
+
+    ndn_Error error = Tlv0_3WireFormatLite::decodeSignatureInfoAndValue
+      (signatureLite, signatureInfo, signatureInfoLength, signatureValue,
+       signatureValueLength);
+    if (isScratchArrayFullError(error)) {
+      // This is a long key name. Make room and decode again.
+      keyNameComponents.grow();
+      continue;
+    }
+    if (error)
+      throw runtime_error(ndn_getErrorString(error));
 
-  result->set(signatureLite);
-  return result;
+    ptr_lib::shared_ptr<Signature> result;
+    if (signatureLite.getType() == ndn_SignatureType_Sha256WithRsaSignature)
+      result.reset(new Sha256WithRsaSignature());
+    else if (signatureLite.getType() == ndn_SignatureType_Sha256WithEcdsaSignature)
+      result.reset(new Sha256WithEcdsaSignature());
+    else if (signatureLite.getType() == ndn_SignatureType_HmacWithSha256Signature)
+      result.reset(new HmacWithSha256Signature());
+    else if (signatureLite.getType() == ndn_SignatureType_DigestSha256Signature)
+      result.reset(new DigestSha256Signature());
+    else if (signatureLite.getType() == ndn_SignatureType_Generic)
+      result.reset(new GenericSignature());
+    else
+      // We don't expect this to happen.
+      throw runtime_error("signatureStruct.type has an unrecognized value");
+
+    result->set(signatureLite);
+    return result;
+  }
 }
 
 Blob
@@ -22,9 +22,10 @@
 
 #include <sstream>
 #include <ndn-cpp/util/logging.hpp>
-#include <ndn-cpp/lite/encrypt/algo/aes-algorithm-lite.hpp>
+#include <ndn-cpp/lite/encrypt/algo/aes-context-lite.hpp>
 #include <ndn-cpp/encrypt/encryptor-v2.hpp>
 #include <ndn-cpp/encrypt/decryptor-v2.hpp>
+#include <ndn-cpp/encoding/tlv-wire-format.hpp>
 
 using namespace std;
 using namespace ndn::func_lib;
@@ -73,7 +74,7 @@ DecryptorV2::Impl::shutdown()
 void
 DecryptorV2::Impl::decrypt
   (const ptr_lib::shared_ptr<EncryptedContent>& encryptedContent,
-   const DecryptSuccessCallback& onSuccess,
+   const Name& dataName, const DecryptSuccessCallback& onSuccess,
    const EncryptError::OnError& onError)
 {
   if (encryptedContent->getKeyLocator().getType() != ndn_KeyLocatorType_KEYNAME) {
@@ -103,20 +104,38 @@ DecryptorV2::Impl::decrypt
     contentKey = contentKeys_[ckName];
 
   if (contentKey->isRetrieved)
-    doDecrypt(*encryptedContent, contentKey->bits, onSuccess, onError);
+    doDecrypt(*encryptedContent, dataName, *contentKey, onSuccess, onError);
   else {
     _LOG_TRACE
       ("CK " << ckName <<
        " not yet available, so adding to the pending decrypt queue");
     contentKey->pendingDecrypts.push_back
       (ptr_lib::make_shared<ContentKey::PendingDecrypt>
-       (encryptedContent, onSuccess, onError));
+       (encryptedContent, dataName, onSuccess, onError));
   }
 
   if (isNew)
     fetchCk(ckName, contentKey, onError, EncryptorV2::N_RETRIES);
 }
 
+void
+DecryptorV2::Impl::decrypt
+  (const Data& data, const DecryptSuccessCallback& onSuccess,
+   const EncryptError::OnError& onError)
+{
+  ptr_lib::shared_ptr<EncryptedContent> encryptedContent =
+    ptr_lib::make_shared<EncryptedContent>();
+  try {
+    encryptedContent->wireDecodeV2(data.getContent());
+  } catch (const std::exception& ex) {
+    onError(EncryptError::ErrorCode::InvalidEncryptedFormat,
+      string("Error decoding the EncryptedContent: ") + ex.what());
+    return;
+  }
+
+  decrypt(encryptedContent, data.getName(), onSuccess, onError);
+}
+
 void
 DecryptorV2::Impl::fetchCk
   (const Name& ckName, const ptr_lib::shared_ptr<ContentKey>& contentKey,
@@ -405,7 +424,7 @@ DecryptorV2::Impl::decryptCkAndProcessPendingDecrypts
     ContentKey::PendingDecrypt& pendingDecrypt = *contentKey.pendingDecrypts[i];
     // TODO: If this calls onError, should we quit?
     doDecrypt
-      (*pendingDecrypt.encryptedContent, contentKey.bits,
+      (*pendingDecrypt.encryptedContent, pendingDecrypt.dataName, contentKey,
        pendingDecrypt.onSuccess, pendingDecrypt.onError);
   }
 
@@ -414,8 +433,8 @@ DecryptorV2::Impl::decryptCkAndProcessPendingDecrypts
 
 void
 DecryptorV2::Impl::doDecrypt
-  (const EncryptedContent& content, const Blob& ckBits,
-   const DecryptSuccessCallback& onSuccess,
+  (const EncryptedContent& content, const Name& dataName,
+   ContentKey& contentKey, const DecryptSuccessCallback& onSuccess,
    const EncryptError::OnError& onError)
 {
   if (!content.hasInitialVector()) {
@@ -424,12 +443,48 @@ DecryptorV2::Impl::doDecrypt
     return;
   }
 
+  // NAC v2 uses AES-CBC unless the EncryptedContent has another algorithm.
+  ndn_EncryptAlgorithmType algorithmType = content.getAlgorithmType();
+  if ((int)algorithmType == -1)
+    algorithmType = ndn_EncryptAlgorithmType_AesCbc;
+  if (algorithmType != ndn_EncryptAlgorithmType_AesCbc &&
+      algorithmType != ndn_EncryptAlgorithmType_AesGcm) {
+    onError(EncryptError::ErrorCode::UnsupportedEncryptionScheme,
+      "Unsupported encryption algorithm type in the encrypted content");
+    return;
+  }
+
   ndn_Error error;
+  if (contentKey.context.getAlgorithmType() != algorithmType) {
+    // Expand the CK once and reuse it for other content with this algorithm.
+    if ((error = contentKey.context.setKey(algorithmType, contentKey.bits))) {
+      onError(EncryptError::ErrorCode::DecryptionFailure,
+        "Decryption error in doDecrypt: " + string(ndn_getErrorString(error)));
+      return;
+    }
+  }
+
+  Blob additionalData;
+  if (algorithmType == ndn_EncryptAlgorithmType_AesGcm) {
+    // Encode the header fields without the payload to check them with the tag.
+    EncryptedContent header(content);
+    header.setPayload(Blob());
+    try {
+      Blob headerEncoding = header.wireEncodeV2(*TlvWireFormat::get());
+      additionalData = EncryptorV2::getAesGcmAdditionalData
+        (dataName, headerEncoding.buf(), headerEncoding.size());
+    } catch (const std::exception& ex) {
+      onError(EncryptError::ErrorCode::InvalidEncryptedFormat,
+        string("Error encoding the EncryptedContent header: ") + ex.what());
+      return;
+    }
+  }
+
   ptr_lib::shared_ptr<vector<uint8_t> > plainData
     (new vector<uint8_t>(content.getPayload().size()));
   size_t plainDataLength;
-  if ((error = AesAlgorithmLite::decrypt256Cbc
-       (ckBits, content.getInitialVector(), content.getPayload(),
+  if ((error = contentKey.context.decrypt
+       (content.getInitialVector(), additionalData, content.getPayload(),
         &plainData->front(), plainDataLength))) {
     onError(EncryptError::ErrorCode::DecryptionFailure,
       "Decryption error in doDecrypt: " + string(ndn_getErrorString(error)));
@@ -25,9 +25,12 @@
 #include <ndn-cpp/util/logging.hpp>
 #include <ndn-cpp/lite/util/crypto-lite.hpp>
 #include <ndn-cpp/lite/security/rsa-public-key-lite.hpp>
-#include <ndn-cpp/lite/encrypt/algo/aes-algorithm-lite.hpp>
+#include <ndn-cpp/lite/encrypt/algo/aes-context-lite.hpp>
 #include <ndn-cpp/encrypt/encrypted-content.hpp>
 #include <ndn-cpp/encrypt/encryptor-v2.hpp>
+#include <ndn-cpp/encoding/tlv-wire-format.hpp>
+#include "../encoding/tlv-encoder.hpp"
+#include "../encoding/tlv-decoder.hpp"
 
 using namespace std;
 using namespace ndn::func_lib;
@@ -100,32 +103,131 @@ EncryptorV2::Impl::shutdown()
 ptr_lib::shared_ptr<EncryptedContent>
 EncryptorV2::Impl::encrypt(const uint8_t* plainData, size_t plainDataLength)
 {
-  // Generate the initial vector.
   uint8_t initialVector[AES_IV_SIZE];
-  ndn_Error error;
-  if ((error = CryptoLite::generateRandomBytes
-       (initialVector, sizeof(initialVector))))
-    throw runtime_error(ndn_getErrorString(error));
+  size_t initialVectorLength = generateInitialVector(initialVector);
+
+  ptr_lib::shared_ptr<EncryptedContent> content =
+    ptr_lib::make_shared<EncryptedContent>();
+  content->setAlgorithmType(algorithmType_);
+  content->setInitialVector(Blob(initialVector, initialVectorLength));
+  content->setKeyLocatorName(ckName_);
+
+  Blob additionalData;
+  if (algorithmType_ == ndn_EncryptAlgorithmType_AesGcm) {
+    // The payload is not set yet, so this only encodes the header fields.
+    Blob headerEncoding = content->wireEncodeV2(*TlvWireFormat::get());
+    additionalData = EncryptorV2::getAesGcmAdditionalData
+      (Name(), headerEncoding.buf(), headerEncoding.size());
+  }
 
-  // Add room for the padding.
   ptr_lib::shared_ptr<vector<uint8_t> > encryptedData
-    (new vector<uint8_t>(plainDataLength + ndn_AES_BLOCK_LENGTH));
+    (new vector<uint8_t>(ckContext_.getEncryptedDataLength(plainDataLength)));
   size_t encryptedDataLength;
-  if ((error = AesAlgorithmLite::encrypt256Cbc
-       (ckBits_, sizeof(ckBits_), initialVector, sizeof(initialVector),
-        plainData, plainDataLength, &encryptedData->front(), encryptedDataLength)))
+  ndn_Error error;
+  if ((error = ckContext_.encrypt
+       (initialVector, initialVectorLength, additionalData.buf(),
+        additionalData.size(), plainData, plainDataLength,
+        &encryptedData->front(), encryptedDataLength)))
     throw runtime_error(string("AesAlgorithm: ") + ndn_getErrorString(error));
   encryptedData->resize(encryptedDataLength);
-
-  ptr_lib::shared_ptr<EncryptedContent> content =
-    ptr_lib::make_shared<EncryptedContent>();
-  content->setInitialVector(Blob(initialVector, sizeof(initialVector)));
   content->setPayload(Blob(encryptedData, false));
-  content->setKeyLocatorName(ckName_);
 
   return content;
 }
 
+void
+EncryptorV2::Impl::encrypt
+  (const uint8_t* plainData, size_t plainDataLength, Data& data)
+{
+  uint8_t initialVector[AES_IV_SIZE];
+  size_t initialVectorLength = generateInitialVector(initialVector);
+  struct ndn_Blob initialVectorBlob;
+  ndn_Blob_initialize(&initialVectorBlob, initialVector, initialVectorLength);
+  size_t payloadLength = ckContext_.getEncryptedDataLength(plainDataLength);
+  bool writeAlgorithmType = (algorithmType_ != ndn_EncryptAlgorithmType_AesCbc);
+
+  // This encodes the same EncryptedContent v2 as wireEncodeV2. The payload is
+  // the first field, so reserve space for it and encrypt into it at the end.
+  size_t payloadTlvLength =
+    ndn_TlvEncoder_sizeOfVarNumber(ndn_Tlv_Encrypt_EncryptedPayload) +
+    ndn_TlvEncoder_sizeOfVarNumber(payloadLength) + payloadLength;
+  size_t valueLength = payloadTlvLength +
+    ndn_TlvEncoder_sizeOfBlobTlv
+      (ndn_Tlv_Encrypt_InitialVector, &initialVectorBlob) +
+    ckNameEncoding_.size();
+  if (writeAlgorithmType) {
+    size_t algorithmTypeLength =
+      ndn_TlvEncoder_sizeOfNonNegativeInteger(algorithmType_);
+    valueLength +=
+      ndn_TlvEncoder_sizeOfVarNumber(ndn_Tlv_Encrypt_EncryptionAlgorithm) +
+      ndn_TlvEncoder_sizeOfVarNumber(algorithmTypeLength) + algorithmTypeLength;
+  }
+
+  TlvEncoder encoder
+    (ndn_TlvEncoder_sizeOfVarNumber(ndn_Tlv_Encrypt_EncryptedContent) +
+     ndn_TlvEncoder_sizeOfVarNumber(valueLength) + valueLength);
+  encoder.writeTypeAndLength(ndn_Tlv_Encrypt_EncryptedContent, valueLength);
+  encoder.writeTypeAndLength(ndn_Tlv_Encrypt_EncryptedPayload, payloadLength);
+  size_t payloadOffset = encoder.offset;
+  ndn_Error error;
+  if ((error = ndn_TlvEncoder_seek(&encoder, payloadOffset + payloadLength)))
+    throw runtime_error(ndn_getErrorString(error));
+  encoder.writeBlobTlv(ndn_Tlv_Encrypt_InitialVector, &initialVectorBlob);
+  encoder.writeArray(ckNameEncoding_);
+  if (writeAlgorithmType)
+    encoder.writeNonNegativeIntegerTlv
+      (ndn_Tlv_Encrypt_EncryptionAlgorithm, algorithmType_);
+
+  Blob additionalData;
+  if (algorithmType_ == ndn_EncryptAlgorithmType_AesGcm)
+    additionalData = EncryptorV2::getAesGcmAdditionalData
+      (data.getName(), encoder.output->array, encoder.offset);
+
+  size_t encryptedDataLength;
+  if ((error = ckContext_.encrypt
+       (initialVector, initialVectorLength, additionalData.buf(),
+        additionalData.size(), plainData, plainDataLength,
+        encoder.output->array + payloadOffset, encryptedDataLength)))
+    throw runtime_error(string("AesAlgorithm: ") + ndn_getErrorString(error));
+  if (encryptedDataLength != payloadLength)
+    throw runtime_error("EncryptorV2: Unexpected encrypted payload length");
+
+  data.setContent(encoder.finish());
+}
+
+void
+EncryptorV2::Impl::setAlgorithmType(ndn_EncryptAlgorithmType algorithmType)
+{
+  if (algorithmType != ndn_EncryptAlgorithmType_AesCbc &&
+      algorithmType != ndn_EncryptAlgorithmType_AesGcm)
+    throw runtime_error("EncryptorV2: Unsupported algorithm type");
+
+  algorithmType_ = algorithmType;
+  setCkContext();
+}
+
+void
+EncryptorV2::Impl::setCkContext()
+{
+  ndn_Error error;
+  if ((error = ckContext_.setKey(algorithmType_, ckBits_, sizeof(ckBits_))))
+    throw runtime_error(string("AesAlgorithm: ") + ndn_getErrorString(error));
+}
+
+size_t
+EncryptorV2::Impl::generateInitialVector(uint8_t* initialVector)
+{
+  size_t initialVectorLength =
+    (algorithmType_ == ndn_EncryptAlgorithmType_AesGcm ?
+     ndn_AES_GCM_INITIAL_VECTOR_LENGTH : AES_IV_SIZE);
+  ndn_Error error;
+  if ((error = CryptoLite::generateRandomBytes
+       (initialVector, initialVectorLength)))
+    throw runtime_error(ndn_getErrorString(error));
+
+  return initialVectorLength;
+}
+
 void
 EncryptorV2::Impl::regenerateCk()
 {
@@ -141,6 +243,8 @@ EncryptorV2::Impl::regenerateCk()
   ndn_Error error;
   if ((error = CryptoLite::generateRandomBytes(ckBits_, sizeof(ckBits_))))
     throw runtime_error(ndn_getErrorString(error));
+  setCkContext();
+  ckNameEncoding_ = ckName_.wireEncode(*TlvWireFormat::get());
 
   // One implication: If the CK is updated before the KEK is fetched, then
   // the KDK for the old CK will not be published.
@@ -333,6 +437,29 @@ EncryptorV2::Impl::makeAndPublishCkData(const EncryptError::OnError& onError)
   }
 }
 
+Blob
+EncryptorV2::getAesGcmAdditionalData
+  (const Name& dataName, const uint8_t* encryptedContentEncoding,
+   size_t encryptedContentEncodingLength)
+{
+  // Skip the EncryptedContent type and length and the EncryptedPayload.
+  TlvDecoder decoder(encryptedContentEncoding, encryptedContentEncodingLength);
+  size_t endOffset = decoder.readNestedTlvsStart
+    (ndn_Tlv_Encrypt_EncryptedContent);
+  decoder.readBlobTlv(ndn_Tlv_Encrypt_EncryptedPayload);
+  size_t headerOffset = decoder.offset;
+
+  Blob nameEncoding = dataName.wireEncode(*TlvWireFormat::get());
+  ptr_lib::shared_ptr<vector<uint8_t> > additionalData
+    (new vector<uint8_t>(nameEncoding.buf(),
+                         nameEncoding.buf() + nameEncoding.size()));
+  additionalData->insert
+    (additionalData->end(), encryptedContentEncoding + headerOffset,
+     encryptedContentEncoding + endOffset);
+
+  return Blob(additionalData, false);
+}
+
 EncryptorV2::Values* EncryptorV2::values_ = 0;
 
 }
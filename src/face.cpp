@@ -25,6 +25,7 @@
 #include "node.hpp"
 #include <ndn-cpp/transport/tcp-transport.hpp>
 #include <ndn-cpp/transport/unix-transport.hpp>
+#include <ndn-cpp/util/event-loop.hpp>
 #include <ndn-cpp/face.hpp>
 #if NDN_CPP_HAVE_UNISTD_H
 #include <unistd.h>
@@ -229,6 +230,39 @@ Face::processEvents()
   node_->processEvents();
 }
 
+void
+Face::run()
+{
+  getEventLoop().run();
+}
+
+void
+Face::runFor(Milliseconds durationMilliseconds)
+{
+  if (durationMilliseconds < 0)
+    // EventLoop treats a negative duration as unlimited.
+    durationMilliseconds = 0;
+  getEventLoop().runFor(durationMilliseconds);
+}
+
+void
+Face::stop()
+{
+  if (eventLoop_)
+    eventLoop_->stop();
+}
+
+EventLoop&
+Face::getEventLoop()
+{
+  if (!eventLoop_) {
+    eventLoop_.reset(new EventLoop());
+    eventLoop_->addFace(*this);
+  }
+
+  return *eventLoop_;
+}
+
 bool
 Face::isLocal()
 {
@@ -241,10 +275,18 @@ Face::shutdown()
   node_->shutdown();
 }
 
-void
+uint64_t
 Face::callLater(Milliseconds delayMilliseconds, const Callback& callback)
 {
-  node_->callLater(delayMilliseconds, callback);
+  uint64_t callLaterId = node_->getNextEntryId();
+  node_->callLater(callLaterId, delayMilliseconds, callback);
+  return callLaterId;
+}
+
+void
+Face::cancelCallLater(uint64_t callLaterId)
+{
+  node_->cancelCallLater(callLaterId);
 }
 
 }
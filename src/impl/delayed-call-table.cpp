@@ -29,12 +29,33 @@ namespace ndn {
 
 void
 DelayedCallTable::callLater
-  (Milliseconds delayMilliseconds, const Face::Callback& callback)
+  (uint64_t callLaterId, Milliseconds delayMilliseconds,
+   const Face::Callback& callback)
 {
-  ptr_lib::shared_ptr<Entry> entry(new Entry(delayMilliseconds, callback));
-  // Insert into table_, sorted on getCallTime().
-  table_.insert
-    (lower_bound(table_.begin(), table_.end(), entry, entryCompare_), entry);
+  ptr_lib::shared_ptr<Entry> entry(new Entry
+    (callLaterId, nextSequenceNo_++, delayMilliseconds, callback));
+  heap_.push_back(entry);
+  push_heap(heap_.begin(), heap_.end(), laterThan_);
+  entriesById_[callLaterId] = entry;
+}
+
+void
+DelayedCallTable::cancelCallLater(uint64_t callLaterId)
+{
+  map<uint64_t, ptr_lib::shared_ptr<Entry> >::iterator found =
+    entriesById_.find(callLaterId);
+  if (found == entriesById_.end())
+    // Already called or cancelled.
+    return;
+
+  // Leave the entry in heap_ until it reaches the top or we compact.
+  found->second->setIsCancelled();
+  entriesById_.erase(found);
+  ++nCancelledEntries_;
+
+  if (nCancelledEntries_ > MIN_CANCELLED_ENTRIES_TO_COMPACT &&
+      nCancelledEntries_ * 2 > heap_.size())
+    compact();
 }
 
 void
@@ -42,19 +63,65 @@ DelayedCallTable::callTimedOut()
 {
     // nowOffsetMilliseconds_ is only used for testing.
   ndn_MillisecondsSince1970 now = ndn_getNowMilliseconds() + nowOffsetMilliseconds_;
-  // table_ is sorted on _callTime, so we only need to process the timed-out
-  // entries at the front, then quit.
-  while (table_.size() > 0 && table_.front()->getCallTime() <= now) {
-    ptr_lib::shared_ptr<Entry> entry = table_.front();
-    table_.erase(table_.begin());
+  // heap_ is a min-heap on the call time, so we only need to process the
+  // timed-out entries at the top, then quit.
+  while (heap_.size() > 0 && heap_.front()->getCallTime() <= now) {
+    ptr_lib::shared_ptr<Entry> entry = heap_.front();
+    pop_heap(heap_.begin(), heap_.end(), laterThan_);
+    heap_.pop_back();
+
+    if (entry->getIsCancelled()) {
+      --nCancelledEntries_;
+      continue;
+    }
+
+    entriesById_.erase(entry->getCallLaterId());
     entry->callCallback();
   }
 }
 
+Milliseconds
+DelayedCallTable::getMillisecondsUntilNextCall()
+{
+  popCancelledEntries();
+  if (heap_.size() == 0)
+    return -1;
+
+  ndn_MillisecondsSince1970 now = ndn_getNowMilliseconds() + nowOffsetMilliseconds_;
+  return max(0.0, heap_.front()->getCallTime() - now);
+}
+
+void
+DelayedCallTable::popCancelledEntries()
+{
+  while (heap_.size() > 0 && heap_.front()->getIsCancelled()) {
+    pop_heap(heap_.begin(), heap_.end(), laterThan_);
+    heap_.pop_back();
+    --nCancelledEntries_;
+  }
+}
+
+void
+DelayedCallTable::compact()
+{
+  vector<ptr_lib::shared_ptr<Entry> > remaining;
+  remaining.reserve(heap_.size() - nCancelledEntries_);
+  for (size_t i = 0; i < heap_.size(); ++i) {
+    if (!heap_[i]->getIsCancelled())
+      remaining.push_back(heap_[i]);
+  }
+
+  heap_.swap(remaining);
+  make_heap(heap_.begin(), heap_.end(), laterThan_);
+  nCancelledEntries_ = 0;
+}
+
 DelayedCallTable::Entry::Entry
-  (ndn_Milliseconds delayMilliseconds, const Face::Callback& callback)
-  : callback_(callback),
-    callTime_(ndn_getNowMilliseconds() + delayMilliseconds)
+  (uint64_t callLaterId, uint64_t sequenceNo,
+   ndn_Milliseconds delayMilliseconds, const Face::Callback& callback)
+  : callback_(callback), callLaterId_(callLaterId), sequenceNo_(sequenceNo),
+    callTime_(ndn_getNowMilliseconds() + delayMilliseconds),
+    isCancelled_(false)
 {
 }
 
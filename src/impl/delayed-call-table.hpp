@@ -22,34 +22,75 @@
 #ifndef NDN_DELAYED_CALL_TABLE_HPP
 #define NDN_DELAYED_CALL_TABLE_HPP
 
-#include <deque>
+#include <vector>
+#include <map>
 #include <ndn-cpp/face.hpp>
 
 namespace ndn {
 
+/**
+ * DelayedCallTable holds the callbacks given to callLater in a binary min-heap
+ * ordered by call time, so that adding a call and removing the next timed-out
+ * call are O(log N) and finding the next call time is O(1). A call can be
+ * cancelled by its ID. Cancellation is lazy: the entry is only marked and is
+ * discarded when it reaches the top of the heap, or when the heap is compacted
+ * because most of its entries are cancelled.
+ */
 class DelayedCallTable {
 public:
   DelayedCallTable()
-  : nowOffsetMilliseconds_(0)
+  : nowOffsetMilliseconds_(0), nextSequenceNo_(0), nCancelledEntries_(0)
   {}
 
   /**
    * Call callback() after the given delay. This adds to the delayed call
    * table which is used by callTimedOut().
+   * @param callLaterId The ID which can be used with cancelCallLater. This
+   * should be unique among the calls in the table, for example from
+   * Node::getNextEntryId().
    * @param delayMilliseconds The delay in milliseconds.
    * @param callback This calls callback() after the delay.
    */
   void
-  callLater(Milliseconds delayMilliseconds, const Face::Callback& callback);
+  callLater
+    (uint64_t callLaterId, Milliseconds delayMilliseconds,
+     const Face::Callback& callback);
 
   /**
-   * Call and remove timed-out callback entries. Since callLater does a sorted
-   * insert into the delayed call table, the check for timed-out entries is
-   * quick and does not require searching the entire table.
+   * Cancel the call with the callLaterId so that callTimedOut() will not call
+   * its callback. If there is no call with the callLaterId (for example, if it
+   * was already called), do nothing.
+   * @param callLaterId The ID given to callLater.
+   */
+  void
+  cancelCallLater(uint64_t callLaterId);
+
+  /**
+   * Call and remove timed-out callback entries. Since the table is a heap
+   * ordered by call time, the check for timed-out entries is quick and does not
+   * require searching the entire table. If two calls have the same call time,
+   * they are called in the order that callLater was called.
    */
   void
   callTimedOut();
 
+  /**
+   * Get the number of milliseconds until the next call in the table is due,
+   * so that an event loop can sleep until then instead of polling.
+   * @return The milliseconds until the next call, or 0 if a call is already
+   * due, or -1 if the table has no calls.
+   */
+  Milliseconds
+  getMillisecondsUntilNextCall();
+
+  /**
+   * Get the number of calls in the table which are not yet called or
+   * cancelled.
+   * @return The number of calls.
+   */
+  size_t
+  size() const { return entriesById_.size(); }
+
   /**
    * Set the offset when insert() and refresh() get the current time, which
    * should only be used for testing.
@@ -67,10 +108,22 @@ private:
     /**
      * Create a new DelayedCallTable::Entry and set the call time based on the
      * current time and the delayMilliseconds.
+     * @param callLaterId The ID given to callLater.
+     * @param sequenceNo The sequence number to order entries with the same
+     * call time.
      * @param delayMilliseconds The delay in milliseconds.
      * @param callback This calls callback() after the delay.
      */
-    Entry(ndn_Milliseconds delayMilliseconds, const Face::Callback& callback);
+    Entry
+      (uint64_t callLaterId, uint64_t sequenceNo,
+       ndn_Milliseconds delayMilliseconds, const Face::Callback& callback);
+
+    /**
+     * Get the ID given to callLater.
+     * @return The callLaterId.
+     */
+    uint64_t
+    getCallLaterId() const { return callLaterId_; }
 
     /**
      * Get the time at which the callback should be called.
@@ -87,28 +140,72 @@ private:
     callCallback() const { callback_(); }
 
     /**
-     * Compare shared_ptrs to Entry based only on callTime_.
+     * Mark this entry as cancelled so that the callback is not called.
      */
-    class Compare {
+    void
+    setIsCancelled() { isCancelled_ = true; }
+
+    /**
+     * Check if setIsCancelled() was called.
+     * @return True if this entry is cancelled.
+     */
+    bool
+    getIsCancelled() const { return isCancelled_; }
+
+    /**
+     * Compare shared_ptrs to Entry for a min-heap with std::push_heap, so that
+     * the "greater" entry has the later callTime_, or the later sequenceNo_ if
+     * the call times are the same.
+     */
+    class LaterThan {
     public:
       bool
       operator()
         (const ptr_lib::shared_ptr<const Entry>& x,
          const ptr_lib::shared_ptr<const Entry>& y) const
       {
-        return x->callTime_ < y->callTime_;
+        if (x->callTime_ != y->callTime_)
+          return x->callTime_ > y->callTime_;
+        return x->sequenceNo_ > y->sequenceNo_;
       }
     };
 
   private:
     const Face::Callback callback_;
+    uint64_t callLaterId_;
+    uint64_t sequenceNo_;
     ndn_MillisecondsSince1970 callTime_;
+    bool isCancelled_;
   };
 
-  // Use a deque so we can efficiently remove from the front.
-  std::deque<ptr_lib::shared_ptr<Entry> > table_;
-  Entry::Compare entryCompare_;
+  /**
+   * Pop cancelled entries from the top of heap_.
+   */
+  void
+  popCancelledEntries();
+
+  /**
+   * Remove all cancelled entries from heap_ and restore the heap property.
+   * This is O(N), but is only called when at least half the entries in heap_
+   * are cancelled, so the amortized cost per cancellation is O(1).
+   */
+  void
+  compact();
+
+  /**
+   * If the number of cancelled entries exceeds this, and is more than half of
+   * the entries in heap_, then compact heap_.
+   */
+  static const size_t MIN_CANCELLED_ENTRIES_TO_COMPACT = 64;
+
+  // A min-heap on the call time, maintained with std::push_heap and pop_heap.
+  std::vector<ptr_lib::shared_ptr<Entry> > heap_;
+  // The entries in heap_ which are not cancelled or called, by callLaterId.
+  std::map<uint64_t, ptr_lib::shared_ptr<Entry> > entriesById_;
+  Entry::LaterThan laterThan_;
   ndn_Milliseconds nowOffsetMilliseconds_;
+  uint64_t nextSequenceNo_;
+  size_t nCancelledEntries_;
 };
 
 }
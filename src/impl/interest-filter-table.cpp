@@ -19,7 +19,9 @@
  * A copy of the GNU Lesser General Public License is in the file COPYING.
  */
 
+#include <algorithm>
 #include <ndn-cpp/util/logging.hpp>
+#include "../util/regex/ndn-regex-top-matcher.hpp"
 #include "interest-filter-table.hpp"
 
 INIT_LOGGER("ndn.InterestFilterTable");
@@ -28,33 +30,108 @@ using namespace std;
 
 namespace ndn {
 
+InterestFilterTable::Entry::Entry
+  (uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filter,
+   const OnInterestCallback& onInterest, Face* face)
+: interestFilterId_(interestFilterId), filter_(filter),
+  prefix_(new Name(filter->getPrefix())), onInterest_(onInterest), face_(face)
+{
+#if NDN_CPP_HAVE_REGEX_LIB
+  if (filter->hasRegexFilter())
+    regexMatcher_.reset(new NdnRegexTopMatcher(filter->regexFilterPattern_));
+#endif
+}
+
+bool
+InterestFilterTable::Entry::doesMatchUnderPrefix(const Name& name)
+{
+  if (!filter_->hasRegexFilter())
+    // The caller has already done the prefix match.
+    return true;
+
+#if NDN_CPP_HAVE_REGEX_LIB
+  // Match the regular expression for the remaining components.
+  return regexMatcher_->match(name.getSubName(prefix_->size()));
+#else
+  // We don't expect this since the InterestFilter regexFilter constructors
+  // don't compile. Let doesMatch throw the error.
+  return filter_->doesMatch(name);
+#endif
+}
+
+void
+InterestFilterTable::setInterestFilter
+  (uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filterCopy,
+   const OnInterestCallback& onInterest, Face* face)
+{
+  ptr_lib::shared_ptr<Entry> entry = ptr_lib::make_shared<Entry>
+    (interestFilterId, filterCopy, onInterest, face);
+  trie_.insert(filterCopy->getPrefix())->getValues().push_back(entry);
+  entriesById_[interestFilterId] = entry;
+}
+
 void
 InterestFilterTable::getMatchedFilters
   (const Interest& interest,
     std::vector<ptr_lib::shared_ptr<Entry> > &matchedFilters)
 {
-  for (size_t i = 0; i < table_.size(); ++i) {
-    ptr_lib::shared_ptr<Entry> &entry = table_[i];
-    if (entry->getFilter()->doesMatch(interest.getName()))
-      matchedFilters.push_back(entry);
+  size_t nPreviousFilters = matchedFilters.size();
+
+  // Only a filter whose prefix is a prefix of the Interest name can match, so
+  // only check the entries on the path of the Interest name.
+  const Name& name = interest.getName();
+  NameTrie<ptr_lib::shared_ptr<Entry> >::Node* node = &trie_.getRoot();
+  for (size_t i = 0; ; ++i) {
+    vector<ptr_lib::shared_ptr<Entry> >& values = node->getValues();
+    for (size_t j = 0; j < values.size(); ++j) {
+      if (values[j]->doesMatchUnderPrefix(name))
+        matchedFilters.push_back(values[j]);
+    }
+
+    if (i >= name.size())
+      break;
+    node = node->getChild(name.get(i));
+    if (!node)
+      break;
   }
+
+  // Return the filters in the order they were added, as before.
+  sort(matchedFilters.begin() + nPreviousFilters, matchedFilters.end(),
+       OlderFirst());
 }
 
 void
 InterestFilterTable::unsetInterestFilter(uint64_t interestFilterId)
 {
-  int count = 0;
-  // Go backwards through the list so we can erase entries.
-  // Remove all entries even though interestFilterId should be unique.
-  for (int i = (int)table_.size() - 1; i >= 0; --i) {
-    if (table_[i]->getInterestFilterId() == interestFilterId) {
-      ++count;
-      table_.erase(table_.begin() + i);
+  map<uint64_t, ptr_lib::shared_ptr<Entry> >::iterator found =
+    entriesById_.find(interestFilterId);
+  if (found == entriesById_.end()) {
+    _LOG_DEBUG("unsetInterestFilter: Didn't find interestFilterId " << interestFilterId);
+    return;
+  }
+
+  // Copy the shared_ptr since we erase from entriesById_.
+  ptr_lib::shared_ptr<Entry> entry = found->second;
+  entriesById_.erase(found);
+
+  NameTrie<ptr_lib::shared_ptr<Entry> >::Node* node =
+    trie_.find(entry->getFilter()->getPrefix());
+  if (!node)
+    // We don't expect this to happen.
+    return;
+
+  vector<ptr_lib::shared_ptr<Entry> >& values = node->getValues();
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i].get() == entry.get()) {
+      values.erase(values.begin() + i);
+      break;
     }
   }
 
-  if (count == 0)
-    _LOG_DEBUG("unsetInterestFilter: Didn't find interestFilterId " << interestFilterId);
+  if (values.empty())
+    trie_.prune(node);
 }
 
 }
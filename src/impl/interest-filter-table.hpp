@@ -22,13 +22,20 @@
 #ifndef NDN_INTEREST_FILTER_TABLE_HPP
 #define NDN_INTEREST_FILTER_TABLE_HPP
 
+#include <map>
 #include <ndn-cpp/face.hpp>
+#include "name-trie.hpp"
 
 namespace ndn {
 
+class NdnRegexTopMatcher;
+
 /**
  * An InterestFilterTable is an internal class to hold a list of entries with
- * an interest Filter and its OnInterestCallback.
+ * an interest Filter and its OnInterestCallback. The entries are stored in a
+ * NameTrie by the filter prefix so that finding the filters for an incoming
+ * Interest only checks the entries along the Interest name's path. A regex
+ * filter is only evaluated for an Interest under its prefix.
  */
 class InterestFilterTable {
 public:
@@ -50,11 +57,7 @@ public:
     Entry
       (uint64_t interestFilterId,
        const ptr_lib::shared_ptr<const InterestFilter>& filter,
-       const OnInterestCallback& onInterest, Face* face)
-    : interestFilterId_(interestFilterId), filter_(filter),
-      prefix_(new Name(filter->getPrefix())), onInterest_(onInterest), face_(face)
-    {
-    }
+       const OnInterestCallback& onInterest, Face* face);
 
     /**
      * Return the interestFilterId given to the constructor.
@@ -93,12 +96,26 @@ public:
     Face&
     getFace() { return *face_; }
 
+    /**
+     * Check if the name matches the filter, where the caller has already
+     * checked that the name starts with the filter's prefix (as done by
+     * Name::match). If the filter has a regex filter, this uses the regex
+     * matcher compiled once in the constructor instead of compiling it for
+     * each call to InterestFilter::doesMatch.
+     * @param name The name to check, which starts with the filter's prefix.
+     * @return True if name matches the filter, otherwise false.
+     */
+    bool
+    doesMatchUnderPrefix(const Name& name);
+
   private:
     uint64_t interestFilterId_;  /**< A unique identifier for this entry so it can be deleted */
     ptr_lib::shared_ptr<const InterestFilter> filter_;
     ptr_lib::shared_ptr<const Name> prefix_;
     const OnInterestCallback onInterest_;
     Face* face_;
+    // This is null if the filter doesn't have a regex filter.
+    ptr_lib::shared_ptr<NdnRegexTopMatcher> regexMatcher_;
   };
 
   /**
@@ -113,11 +130,7 @@ public:
   setInterestFilter
     (uint64_t interestFilterId,
      const ptr_lib::shared_ptr<const InterestFilter>& filterCopy,
-     const OnInterestCallback& onInterest, Face* face)
-  {
-    table_.push_back(ptr_lib::make_shared<Entry>
-      (interestFilterId, filterCopy, onInterest, face));
-  }
+     const OnInterestCallback& onInterest, Face* face);
 
   /**
    * Find all entries from the interest filter table where the interest conforms
@@ -143,7 +156,23 @@ public:
   unsetInterestFilter(uint64_t interestFilterId);
 
 private:
-  std::vector<ptr_lib::shared_ptr<Entry> > table_;
+  /**
+   * Compare shared_ptrs to Entry so that the entry with the smaller
+   * interestFilterId (the one added first) comes first.
+   */
+  class OlderFirst {
+  public:
+    bool
+    operator()
+      (const ptr_lib::shared_ptr<Entry>& x,
+       const ptr_lib::shared_ptr<Entry>& y) const
+    {
+      return x->getInterestFilterId() < y->getInterestFilterId();
+    }
+  };
+
+  NameTrie<ptr_lib::shared_ptr<Entry> > trie_;
+  std::map<uint64_t, ptr_lib::shared_ptr<Entry> > entriesById_;
 };
 
 }
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_NAME_TRIE_HPP
+#define NDN_NAME_TRIE_HPP
+
+#include <map>
+#include <ndn-cpp/name.hpp>
+#include "../c/util/ndn_memory.h"
+
+namespace ndn {
+
+/**
+ * A NameTrie is an internal class for a tree of names where each node holds a
+ * list of values of type T which were added with the node's name. A lookup for
+ * a name only visits the nodes along the name's path, so that the cost is
+ * proportional to the number of name components instead of the number of
+ * stored values. The children of a node are keyed by the name component value
+ * without the component type. This is the same as Name::match which also only
+ * compares the component values, so the values along a name's path are a
+ * superset of the values whose name matches it. (The caller should still do a
+ * final check on each value, for example with Interest::matchesData.)
+ */
+template<class T>
+class NameTrie {
+public:
+  class Node {
+  public:
+    /**
+     * Create a new Node. Note: You should not call this directly but call
+     * NameTrie::insert.
+     * @param parent The parent node, or null for the root.
+     * @param key The name component value of this node in the parent's
+     * children.
+     */
+    Node(Node* parent, const Blob& key)
+    : parent_(parent), key_(key)
+    {
+    }
+
+    /**
+     * Get the list of values which were added with this node's name.
+     * @return The list of values, which the caller can modify. If the caller
+     * makes the list empty, it should call NameTrie::prune(node).
+     */
+    std::vector<T>&
+    getValues() { return values_; }
+
+    /**
+     * Get the child node for the name component.
+     * @param component The name component. This only uses the component value.
+     * @return The child node, or null if not found.
+     */
+    Node*
+    getChild(const Name::Component& component) const
+    {
+      typename ChildMap::const_iterator child =
+        children_.find(component.getValue());
+      return child == children_.end() ? 0 : child->second.get();
+    }
+
+    /**
+     * Check if this node has any children.
+     * @return True if this node has at least one child.
+     */
+    bool
+    hasChildren() const { return !children_.empty(); }
+
+  private:
+    friend class NameTrie<T>;
+
+    /**
+     * Compare Blob keys by size, then by the bytes. (We don't need the
+     * canonical order, only a strict weak ordering of the values.)
+     */
+    class KeyCompare {
+    public:
+      bool
+      operator()(const Blob& x, const Blob& y) const
+      {
+        if (x.size() != y.size())
+          return x.size() < y.size();
+        return ndn_memcmp(x.buf(), y.buf(), x.size()) < 0;
+      }
+    };
+
+    typedef std::map<Blob, ptr_lib::shared_ptr<Node>, KeyCompare> ChildMap;
+
+    Node* parent_;
+    Blob key_;
+    ChildMap children_;
+    std::vector<T> values_;
+  };
+
+  NameTrie()
+  : root_(0, Blob())
+  {
+  }
+
+  /**
+   * Get the root node, which is the node for the empty name.
+   * @return The root node.
+   */
+  Node&
+  getRoot() { return root_; }
+
+  /**
+   * Get the node for the name, creating it and the nodes along the name's path
+   * if they don't exist.
+   * @param name The name of the node.
+   * @return The node for the name. This pointer is valid until the node is
+   * removed by prune().
+   */
+  Node*
+  insert(const Name& name)
+  {
+    Node* node = &root_;
+    for (size_t i = 0; i < name.size(); ++i) {
+      const Blob& key = name.get(i).getValue();
+      ptr_lib::shared_ptr<Node>& child = node->children_[key];
+      if (!child)
+        child.reset(new Node(node, key));
+      node = child.get();
+    }
+
+    return node;
+  }
+
+  /**
+   * Find the node for the name.
+   * @param name The name of the node.
+   * @return The node for the name, or null if not found.
+   */
+  Node*
+  find(const Name& name)
+  {
+    Node* node = &root_;
+    for (size_t i = 0; i < name.size() && node; ++i)
+      node = node->getChild(name.get(i));
+
+    return node;
+  }
+
+  /**
+   * Call visitor(node) for the node, then for each node below it depth first,
+   * down to maxDepth levels below the node. The children of a node are not
+   * visited in the canonical order of the name components.
+   * @param node The node to start from.
+   * @param maxDepth The maximum number of levels below the node to visit, or
+   * (size_t)-1 for no limit.
+   * @param visitor The function object where visitor(node) returns true to
+   * continue, or false to stop visiting. The visitor must not insert or prune
+   * nodes.
+   * @return False if the visitor stopped the visit, otherwise true.
+   */
+  template<class Visitor>
+  static bool
+  visit(Node* node, size_t maxDepth, Visitor& visitor)
+  {
+    if (!visitor(node))
+      return false;
+    if (maxDepth == 0)
+      return true;
+
+    for (typename Node::ChildMap::iterator child = node->children_.begin();
+         child != node->children_.end(); ++child) {
+      if (!visit(child->second.get(), maxDepth - 1, visitor))
+        return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Remove the node if it has no values and no children, then do the same for
+   * each parent node. This does not remove the root node. After this returns,
+   * the caller should not use the node pointer.
+   * @param node The node to check.
+   */
+  void
+  prune(Node* node)
+  {
+    while (node->parent_ && node->values_.empty() && node->children_.empty()) {
+      Node* parent = node->parent_;
+      // Copy the key since erase deletes the node.
+      Blob key = node->key_;
+      parent->children_.erase(key);
+      node = parent;
+    }
+  }
+
+private:
+  // Don't allow copying since each node has a pointer to its parent.
+  NameTrie(const NameTrie& other);
+  NameTrie& operator=(const NameTrie& other);
+
+  Node root_;
+};
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_OBJECT_POOL_HPP
+#define NDN_OBJECT_POOL_HPP
+
+#include <vector>
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_BOOST_ATOMIC
+#include <boost/atomic.hpp>
+#endif
+#include <ndn-cpp/common.hpp>
+
+namespace ndn {
+
+/**
+ * An ObjectPool holds shared_ptr objects of type T to reuse for received
+ * packets. An object is free when the pool holds the only reference to it, so
+ * an application can keep a received object as long as it wants and the pool
+ * doesn't need a custom deleter. The caller must overwrite every field of a
+ * reused object, for example with wireDecode. A reused object keeps the memory
+ * it already allocated, such as the Signature of a Data packet.
+ * @note The application must not keep a weak_ptr to a pooled object, since
+ * the pool can't see it.
+ */
+template<class T> class ObjectPool {
+public:
+  /**
+   * Create an ObjectPool which holds up to maxSize objects.
+   * @param maxSize The maximum number of objects which the pool keeps to
+   * reuse. When all of them are in use, get() returns a new object which the
+   * pool doesn't keep.
+   */
+  ObjectPool(size_t maxSize)
+  : maxSize_(maxSize), next_(0)
+  {
+  }
+
+  /**
+   * Get a free object from the pool, or a new object if none is free.
+   * @return The object. If it is reused, it has the values from its last use.
+   */
+  ptr_lib::shared_ptr<T>
+  get()
+  {
+    for (size_t i = 0; i < objects_.size(); ++i) {
+      ptr_lib::shared_ptr<T>& object = objects_[next_];
+      next_ = (next_ + 1) % objects_.size();
+      if (object.use_count() == 1) {
+#if NDN_CPP_HAVE_BOOST_ATOMIC
+        // Another thread may have released the object. Make its last use
+        // happen before we reuse it.
+        boost::atomic_thread_fence(boost::memory_order_acquire);
+#endif
+        return object;
+      }
+    }
+
+    ptr_lib::shared_ptr<T> object = ptr_lib::make_shared<T>();
+    if (objects_.size() < maxSize_)
+      objects_.push_back(object);
+    return object;
+  }
+
+private:
+  std::vector<ptr_lib::shared_ptr<T> > objects_;
+  size_t maxSize_;
+  size_t next_;
+};
+
+}
+
+#endif
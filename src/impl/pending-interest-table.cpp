@@ -50,18 +50,21 @@ PendingInterestTable::add
    const ptr_lib::shared_ptr<const Interest>& interestCopy, const OnData& onData,
    const OnTimeout& onTimeout, const OnNetworkNack& onNetworkNack)
 {
-  vector<uint64_t>::iterator removeRequestIterator =
-    ::find(removeRequests_.begin(), removeRequests_.end(), pendingInterestId);
-  if (removeRequestIterator != removeRequests_.end()) {
+  set<uint64_t>::iterator removeRequest = removeRequests_.find(pendingInterestId);
+  if (removeRequest != removeRequests_.end()) {
     // removePendingInterest was called with the pendingInterestId returned by
     //   expressInterest before we got here, so don't add a PIT entry.
-    removeRequests_.erase(removeRequestIterator);
+    removeRequests_.erase(removeRequest);
     return ptr_lib::shared_ptr<Entry>();
   }
 
   ptr_lib::shared_ptr<Entry> entry(new Entry
     (pendingInterestId, interestCopy, onData, onTimeout, onNetworkNack));
-  table_.push_back(entry);
+  trie_.insert(interestCopy->getName())->getValues().push_back(entry);
+  entriesById_[pendingInterestId] = entry;
+  if (onNetworkNack)
+    nackEntriesByNonce_.insert
+      (make_pair(interestCopy->getNonce().toRawStr(), entry));
   return entry;
 }
 
@@ -69,16 +72,40 @@ void
 PendingInterestTable::extractEntriesForExpressedInterest
   (const Data& data, vector<ptr_lib::shared_ptr<Entry> > &entries)
 {
-  // Go backwards through the list so we can erase entries.
-  for (int i = (int)table_.size() - 1; i >= 0; --i) {
-    ptr_lib::shared_ptr<Entry>& pendingInterest = table_[i];
-    if (pendingInterest->getInterest()->matchesData(data)) {
-      entries.push_back(pendingInterest);
-      // We let the callback from callLater call _processInterestTimeout, but
-      // for efficiency, mark this as removed so that it returns right away.
-      pendingInterest->setIsRemoved();
-      table_.erase(table_.begin() + i);
+  vector<ptr_lib::shared_ptr<Entry> > matchedEntries;
+
+  // Only an Interest whose name is a prefix of the Data name (or is the Data
+  // full name with the implicit digest) can match, so only check the entries
+  // on the path of the Data name.
+  const Name& dataName = data.getName();
+  NameTrie<ptr_lib::shared_ptr<Entry> >::Node* node = &trie_.getRoot();
+  for (size_t i = 0; ; ++i) {
+    addMatchedEntries(node, data, matchedEntries);
+
+    if (i >= dataName.size()) {
+      if (node->hasChildren()) {
+        // There may be an Interest for the Data full name. Only compute the
+        // implicit digest in this case.
+        NameTrie<ptr_lib::shared_ptr<Entry> >::Node* fullNameNode =
+          node->getChild(data.getFullName()->get(-1));
+        if (fullNameNode)
+          addMatchedEntries(fullNameNode, data, matchedEntries);
+      }
+      break;
     }
+
+    node = node->getChild(dataName.get(i));
+    if (!node)
+      break;
+  }
+
+  // Return the most recent entries first, as before.
+  sort(matchedEntries.begin(), matchedEntries.end(), NewerFirst());
+  for (size_t i = 0; i < matchedEntries.size(); ++i) {
+    entries.push_back(matchedEntries[i]);
+    // We let the callback from callLater call _processInterestTimeout, but
+    // for efficiency, mark this as removed so that it returns right away.
+    removeFromTable(matchedEntries[i]);
   }
 }
 
@@ -88,52 +115,49 @@ PendingInterestTable::extractEntriesForNackInterest
 {
   SignedBlob encoding = interest.wireEncode();
 
-  // Go backwards through the list so we can erase entries.
-  for (int i = (int)table_.size() - 1; i >= 0; --i) {
-    ptr_lib::shared_ptr<Entry>& pendingInterest = table_[i];
-    if (!pendingInterest->getOnNetworkNack())
-      continue;
-
+  // Entries with the same encoding have the same nonce, so only check these.
+  vector<ptr_lib::shared_ptr<Entry> > matchedEntries;
+  pair<NonceIndex::iterator, NonceIndex::iterator> range =
+    nackEntriesByNonce_.equal_range(interest.getNonce().toRawStr());
+  for (NonceIndex::iterator i = range.first; i != range.second; ++i) {
     // wireEncode returns the encoding cached when the interest was sent (if
     // it was the default wire encoding).
-    if (pendingInterest->getInterest()->wireEncode().equals(encoding)) {
-      entries.push_back(pendingInterest);
-      // We let the callback from callLater call _processInterestTimeout, but
-      // for efficiency, mark this as removed so that it returns right away.
-      pendingInterest->setIsRemoved();
-      table_.erase(table_.begin() + i);
-    }
+    if (i->second->getInterest()->wireEncode().equals(encoding))
+      matchedEntries.push_back(i->second);
+  }
+
+  // Return the most recent entries first, as before.
+  sort(matchedEntries.begin(), matchedEntries.end(), NewerFirst());
+  for (size_t i = 0; i < matchedEntries.size(); ++i) {
+    entries.push_back(matchedEntries[i]);
+    // We let the callback from callLater call _processInterestTimeout, but
+    // for efficiency, mark this as removed so that it returns right away.
+    removeFromTable(matchedEntries[i]);
   }
 }
 
 void
 PendingInterestTable::removePendingInterest(uint64_t pendingInterestId)
 {
-  int count = 0;
-  // Go backwards through the list so we can erase entries.
-  // Remove all entries even though pendingInterestId should be unique.
-  for (int i = (int)table_.size() - 1; i >= 0; --i) {
-    if (table_[i]->getPendingInterestId() == pendingInterestId) {
-      ++count;
-      // For efficiency, mark this as removed so that processInterestTimeout
-      // doesn't look for it.
-      table_[i]->setIsRemoved();
-      table_.erase(table_.begin() + i);
-    }
+  map<uint64_t, ptr_lib::shared_ptr<Entry> >::iterator found =
+    entriesById_.find(pendingInterestId);
+  if (found != entriesById_.end()) {
+    // For efficiency, mark this as removed so that processInterestTimeout
+    // doesn't look for it. Copy the shared_ptr since this erases from
+    // entriesById_.
+    ptr_lib::shared_ptr<Entry> entry = found->second;
+    removeFromTable(entry);
+    return;
   }
 
-  if (count == 0)
-    _LOG_DEBUG("removePendingInterest: Didn't find pendingInterestId " << pendingInterestId);
-
-  if (count == 0) {
-    // The pendingInterestId was not found. Perhaps this has been called before
-    //   the callback in expressInterest can add to the PIT. Add this
-    //   removal request which will be checked before adding to the PIT.
-    if (::find(removeRequests_.begin(), removeRequests_.end(), pendingInterestId)
-        == removeRequests_.end())
-      // Not already requested, so add the request.
-      removeRequests_.push_back(pendingInterestId);
-  }
+  _LOG_DEBUG("removePendingInterest: Didn't find pendingInterestId " << pendingInterestId);
+
+  // The pendingInterestId was not found. Perhaps this has been called before
+  //   the callback in expressInterest can add to the PIT. Add this
+  //   removal request which will be checked before adding to the PIT.
+  removeRequests_.insert(pendingInterestId);
+  if (removeRequests_.size() > MAX_REMOVE_REQUESTS)
+    removeRequests_.erase(removeRequests_.begin());
 }
 
 bool
@@ -146,16 +170,64 @@ PendingInterestTable::removeEntry
     // Do nothing.
     return false;
 
-  // Search by pointer equality.
-  for (size_t i = 0; i < table_.size(); ++i) {
-    if (table_[i].get() == pendingInterest.get()) {
-      table_[i]->setIsRemoved();
-      table_.erase(table_.begin() + i);
-      return true;
+  map<uint64_t, ptr_lib::shared_ptr<Entry> >::iterator found =
+    entriesById_.find(pendingInterest->getPendingInterestId());
+  if (found == entriesById_.end() || found->second.get() != pendingInterest.get())
+    return false;
+
+  removeFromTable(pendingInterest);
+  return true;
+}
+
+void
+PendingInterestTable::addMatchedEntries
+  (NameTrie<ptr_lib::shared_ptr<Entry> >::Node* node, const Data& data,
+   vector<ptr_lib::shared_ptr<Entry> >& matchedEntries)
+{
+  vector<ptr_lib::shared_ptr<Entry> >& values = node->getValues();
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i]->getInterest()->matchesData(data))
+      matchedEntries.push_back(values[i]);
+  }
+}
+
+void
+PendingInterestTable::removeFromTable(const ptr_lib::shared_ptr<Entry>& entry)
+{
+  entry->setIsRemoved();
+  map<uint64_t, ptr_lib::shared_ptr<Entry> >::iterator found =
+    entriesById_.find(entry->getPendingInterestId());
+  if (found != entriesById_.end() && found->second.get() == entry.get())
+    entriesById_.erase(found);
+
+  if (entry->getOnNetworkNack()) {
+    pair<NonceIndex::iterator, NonceIndex::iterator> range =
+      nackEntriesByNonce_.equal_range(entry->getInterest()->getNonce().toRawStr());
+    for (NonceIndex::iterator i = range.first; i != range.second; ++i) {
+      if (i->second.get() == entry.get()) {
+        nackEntriesByNonce_.erase(i);
+        break;
+      }
+    }
+  }
+
+  NameTrie<ptr_lib::shared_ptr<Entry> >::Node* node =
+    trie_.find(entry->getInterest()->getName());
+  if (!node)
+    // We don't expect this to happen.
+    return;
+
+  // There are usually only a few entries with the same Interest name.
+  vector<ptr_lib::shared_ptr<Entry> >& values = node->getValues();
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (values[i].get() == entry.get()) {
+      values.erase(values.begin() + i);
+      break;
     }
   }
 
-  return false;
+  if (values.empty())
+    trie_.prune(node);
 }
 
 }
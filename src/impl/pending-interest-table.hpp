@@ -22,13 +22,19 @@
 #ifndef NDN_PENDING_INTEREST_TABLE_HPP
 #define NDN_PENDING_INTEREST_TABLE_HPP
 
+#include <map>
+#include <set>
 #include <ndn-cpp/face.hpp>
+#include "name-trie.hpp"
 
 namespace ndn {
 
 /**
  * A PendingInterestTable is an internal class to hold a list of pending
- * interests with their callbacks.
+ * interests with their callbacks. The entries are stored in a NameTrie by the
+ * Interest name so that finding the entries for an incoming Data packet only
+ * checks the entries along the Data name's path. Entries are also indexed by
+ * pendingInterestId for removal and by the Interest nonce for network Nacks.
  */
 class PendingInterestTable {
 public:
@@ -151,7 +157,8 @@ public:
    * entry if the OnNetworkNack callback is an empty OnNetworkNack() so that
    * OnTimeout will be called later.) The interests are the same if their
    * default wire encoding is the same (which has everything including the name,
-   * nonce, link object and selectors).
+   * nonce, link object and selectors). This only compares the encoding of
+   * entries with the same nonce as the given interest.
    * @param interest The Interest to search for (typically from a Nack packet).
    * @param entries Add matching PendingInterestTable::Entry from the pending
    * interest table.  The caller should pass in a reference to an empty vector.
@@ -180,9 +187,60 @@ public:
   bool
   removeEntry(const ptr_lib::shared_ptr<Entry>& pendingInterest);
 
+  /**
+   * Get the number of entries in the pending interest table.
+   * @return The number of entries.
+   */
+  size_t
+  size() const { return entriesById_.size(); }
+
 private:
-  std::vector<ptr_lib::shared_ptr<Entry> > table_;
-  std::vector<uint64_t> removeRequests_;
+  /**
+   * Append the entries in the trie node whose interest matches the data to
+   * matchedEntries.
+   * @param node The trie node.
+   * @param data The Data packet for Interest::matchesData.
+   * @param matchedEntries Append the matching entries to this list.
+   */
+  static void
+  addMatchedEntries
+    (NameTrie<ptr_lib::shared_ptr<Entry> >::Node* node, const Data& data,
+     std::vector<ptr_lib::shared_ptr<Entry> >& matchedEntries);
+
+  /**
+   * Remove the entry from the trie and the entriesById_ and nackEntriesByNonce_
+   * indexes and set its isRemoved flag. The entry must be in the table.
+   * @param entry The entry to remove.
+   */
+  void
+  removeFromTable(const ptr_lib::shared_ptr<Entry>& entry);
+
+  /**
+   * Compare shared_ptrs to Entry so that the entry with the larger
+   * pendingInterestId (the more recently added) comes first.
+   */
+  class NewerFirst {
+  public:
+    bool
+    operator()
+      (const ptr_lib::shared_ptr<Entry>& x,
+       const ptr_lib::shared_ptr<Entry>& y) const
+    {
+      return x->getPendingInterestId() > y->getPendingInterestId();
+    }
+  };
+
+  NameTrie<ptr_lib::shared_ptr<Entry> > trie_;
+  std::map<uint64_t, ptr_lib::shared_ptr<Entry> > entriesById_;
+  // The key is the Interest nonce as a raw string. This only has entries where
+  // the OnNetworkNack callback is not an empty OnNetworkNack().
+  typedef std::multimap<std::string, ptr_lib::shared_ptr<Entry> > NonceIndex;
+  NonceIndex nackEntriesByNonce_;
+  std::set<uint64_t> removeRequests_;
+  // If an application calls removePendingInterest with an ID which is never
+  // added, don't keep the remove request forever. Entry IDs increase, so
+  // remove the oldest requests first.
+  static const size_t MAX_REMOVE_REQUESTS = 10000;
 };
 
 }
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_POSIX_THREADS.
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_POSIX_THREADS
+
+#include <map>
+#include <pthread.h>
+#include <ndn-cpp/in-memory-storage/in-memory-storage-sharded.hpp>
+
+using namespace std;
+
+namespace ndn {
+
+/**
+ * A Shard holds the Data packets for one part of the name hash space, with
+ * the read-write lock which protects them.
+ */
+class InMemoryStorageSharded::Shard {
+public:
+  typedef map<Name, ptr_lib::shared_ptr<Data> > Cache;
+
+  Shard() { pthread_rwlock_init(&lock_, 0); }
+
+  ~Shard() { pthread_rwlock_destroy(&lock_); }
+
+  /**
+   * A ReadLock gets the shard's read lock in the constructor and releases it
+   * in the destructor.
+   */
+  class ReadLock {
+  public:
+    ReadLock(Shard& shard)
+    : shard_(shard)
+    {
+      pthread_rwlock_rdlock(&shard_.lock_);
+    }
+
+    ~ReadLock() { pthread_rwlock_unlock(&shard_.lock_); }
+
+  private:
+    Shard& shard_;
+  };
+
+  /**
+   * A WriteLock gets the shard's write lock in the constructor and releases
+   * it in the destructor.
+   */
+  class WriteLock {
+  public:
+    WriteLock(Shard& shard)
+    : shard_(shard)
+    {
+      pthread_rwlock_wrlock(&shard_.lock_);
+    }
+
+    ~WriteLock() { pthread_rwlock_unlock(&shard_.lock_); }
+
+  private:
+    Shard& shard_;
+  };
+
+  // The key is the full name, including the implicit digest.
+  Cache cache_;
+
+private:
+  pthread_rwlock_t lock_;
+};
+
+InMemoryStorageSharded::InMemoryStorageSharded(size_t nShards)
+{
+  if (nShards == 0)
+    nShards = 1;
+
+  for (size_t i = 0; i < nShards; ++i)
+    shards_.push_back(new Shard());
+}
+
+InMemoryStorageSharded::~InMemoryStorageSharded()
+{
+  for (size_t i = 0; i < shards_.size(); ++i)
+    delete shards_[i];
+}
+
+InMemoryStorageSharded::Shard&
+InMemoryStorageSharded::getShard(const Name& name, size_t nComponents)
+{
+  // Combine the component hashes in the same way as Name::hash().
+  size_t hashCode = 0;
+  for (size_t i = 0; i < nComponents; ++i)
+    hashCode = 37 * hashCode + name.get(i).hash();
+
+  return *shards_[hashCode % shards_.size()];
+}
+
+void
+InMemoryStorageSharded::insert(const Data& data)
+{
+  // Make the copy and cache its encoding and full name before other threads
+  // can find it, so that they only read the shared Data object.
+  ptr_lib::shared_ptr<Data> dataCopy(new Data(data));
+  dataCopy->wireEncode();
+  Name fullName(*dataCopy->getFullName());
+
+  Shard& shard = getShard(fullName, fullName.size() - 1);
+  Shard::WriteLock lock(shard);
+  shard.cache_[fullName] = dataCopy;
+}
+
+ptr_lib::shared_ptr<Data>
+InMemoryStorageSharded::find(const Name& name)
+{
+  // A Data name with the prefix can be in any shard. Find the first in each
+  // shard and return the first of these in the canonical order.
+  ptr_lib::shared_ptr<Data> result;
+  Name resultName;
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    Shard& shard = *shards_[i];
+    Shard::ReadLock lock(shard);
+
+    // The Name keys are in order.
+    Shard::Cache::iterator it = shard.cache_.lower_bound(name);
+    if (it != shard.cache_.end() && name.isPrefixOf(it->first) &&
+        (!result || it->first < resultName)) {
+      result = it->second;
+      resultName = it->first;
+    }
+  }
+
+  return result;
+}
+
+ptr_lib::shared_ptr<Data>
+InMemoryStorageSharded::find(const Interest& interest)
+{
+  if (interest.getCanBePrefix())
+    return find(interest.getName());
+
+  const Name& name = interest.getName();
+  if (name.size() > 0 && name.get(-1).isImplicitSha256Digest()) {
+    // The Interest has the full name.
+    Shard& shard = getShard(name, name.size() - 1);
+    Shard::ReadLock lock(shard);
+
+    Shard::Cache::iterator it = shard.cache_.find(name);
+    return it != shard.cache_.end() ? it->second : ptr_lib::shared_ptr<Data>();
+  }
+
+  // Only a Data packet with the Interest name (plus the implicit digest)
+  // matches, and it is in the shard for the name. Since the implicit digest
+  // component type is less than the other types, the first key with the name
+  // as a prefix is the full name of a Data packet with the name, if there is
+  // one.
+  Shard& shard = getShard(name, name.size());
+  Shard::ReadLock lock(shard);
+
+  Shard::Cache::iterator it = shard.cache_.lower_bound(name);
+  if (it != shard.cache_.end() && it->first.size() == name.size() + 1 &&
+      name.isPrefixOf(it->first))
+    return it->second;
+  else
+    return ptr_lib::shared_ptr<Data>();
+}
+
+void
+InMemoryStorageSharded::remove(const Name& prefix)
+{
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    Shard& shard = *shards_[i];
+    Shard::WriteLock lock(shard);
+
+    // The Name keys are in order.
+    Shard::Cache::iterator it = shard.cache_.lower_bound(prefix);
+    while (it != shard.cache_.end() && prefix.isPrefixOf(it->first))
+      shard.cache_.erase(it++);
+  }
+}
+
+size_t
+InMemoryStorageSharded::size()
+{
+  size_t result = 0;
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    Shard& shard = *shards_[i];
+    Shard::ReadLock lock(shard);
+    result += shard.cache_.size();
+  }
+
+  return result;
+}
+
+}
+
+#endif // NDN_CPP_HAVE_POSIX_THREADS
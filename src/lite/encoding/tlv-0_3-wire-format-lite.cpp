@@ -61,6 +61,17 @@ Tlv0_3WireFormatLite::encodeInterest
      &output, encodingLength);
 }
 
+ndn_Error
+Tlv0_3WireFormatLite::reverseEncodeInterest
+  (const InterestLite& interest, size_t* signedPortionBeginOffset,
+   size_t* signedPortionEndOffset, DynamicUInt8ArrayLite& output,
+   size_t* encodingLength)
+{
+  return ndn_Tlv0_3WireFormat_reverseEncodeInterest
+    (&interest, signedPortionBeginOffset, signedPortionEndOffset,
+     &output, encodingLength);
+}
+
 ndn_Error
 Tlv0_3WireFormatLite::decodeInterest
   (InterestLite& interest, const uint8_t* input, size_t inputLength,
@@ -82,6 +93,17 @@ Tlv0_3WireFormatLite::encodeData
      encodingLength);
 }
 
+ndn_Error
+Tlv0_3WireFormatLite::reverseEncodeData
+  (const DataLite& data, size_t* signedPortionBeginOffset,
+   size_t* signedPortionEndOffset, DynamicUInt8ArrayLite& output,
+   size_t* encodingLength)
+{
+  return ndn_Tlv0_3WireFormat_reverseEncodeData
+    (&data, signedPortionBeginOffset, signedPortionEndOffset, &output,
+     encodingLength);
+}
+
 ndn_Error
 Tlv0_3WireFormatLite::decodeData
   (DataLite& data, const uint8_t* input, size_t inputLength,
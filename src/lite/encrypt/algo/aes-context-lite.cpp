@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "../../../c/encrypt/algo/aes-algorithm.h"
+#include <ndn-cpp/lite/encrypt/algo/aes-context-lite.hpp>
+
+#if NDN_CPP_HAVE_LIBCRYPTO
+
+namespace ndn {
+
+AesContextLite::AesContextLite()
+{
+  ndn_AesContext_initialize(this);
+}
+
+AesContextLite::~AesContextLite()
+{
+  ndn_AesContext_finalize(this);
+}
+
+ndn_Error
+AesContextLite::setKey
+  (ndn_EncryptAlgorithmType algorithmType, const uint8_t* key,
+   size_t keyLength)
+{
+  return ndn_AesContext_setKey(this, algorithmType, key, keyLength);
+}
+
+size_t
+AesContextLite::getEncryptedDataLength(size_t plainDataLength) const
+{
+  return ndn_AesContext_getEncryptedDataLength(this, plainDataLength);
+}
+
+ndn_Error
+AesContextLite::encrypt
+  (const uint8_t* initialVector, size_t initialVectorLength,
+   const uint8_t* additionalData, size_t additionalDataLength,
+   const uint8_t* plainData, size_t plainDataLength, uint8_t* encryptedData,
+   size_t& encryptedDataLength)
+{
+  return ndn_AesContext_encrypt
+    (this, initialVector, initialVectorLength, additionalData,
+     additionalDataLength, plainData, plainDataLength, encryptedData,
+     &encryptedDataLength);
+}
+
+ndn_Error
+AesContextLite::decrypt
+  (const uint8_t* initialVector, size_t initialVectorLength,
+   const uint8_t* additionalData, size_t additionalDataLength,
+   const uint8_t* encryptedData, size_t encryptedDataLength,
+   uint8_t* plainData, size_t& plainDataLength)
+{
+  return ndn_AesContext_decrypt
+    (this, initialVector, initialVectorLength, additionalData,
+     additionalDataLength, encryptedData, encryptedDataLength, plainData,
+     &plainDataLength);
+}
+
+}
+
+#endif // NDN_CPP_HAVE_LIBCRYPTO
@@ -50,6 +50,14 @@ CryptoLite::digestSha256(const uint8_t *data, size_t dataLength, uint8_t *digest
   ndn_digestSha256(data, dataLength, digest);
 }
 
+void
+CryptoLite::digestSha256Multiple
+  (const uint8_t* const* dataList, const size_t* dataLengthList, size_t nData,
+   uint8_t *digests)
+{
+  ndn_digestSha256Multiple(dataList, dataLengthList, nData, digests);
+}
+
 ndn_Error
 CryptoLite::generateRandomBytes(uint8_t *buffer, size_t bufferLength)
 {
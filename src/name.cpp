@@ -27,7 +27,6 @@
 #include <stdlib.h>
 #include <ndn-cpp/name.hpp>
 #include "c/util/ndn_memory.h"
-#include "encoding/tlv-encoder.hpp"
 
 using namespace std;
 
@@ -123,6 +122,9 @@ unescape(const string& str)
   return result.str();
 }
 
+const size_t Name::Component::MAX_INLINE_VALUE_SIZE;
+const uint8_t Name::Component::NO_INLINE_VALUE;
+
 const uint8_t Name::Component::FINAL_SEGMENT_PREFIX[] = { 0xC1, '.', 'M', '.', 'F', 'I', 'N', 'A', 'L', 0x00 };
 size_t Name::Component::FINAL_SEGMENT_PREFIX_LENGTH = sizeof(Name::Component::FINAL_SEGMENT_PREFIX);
 
@@ -175,19 +177,26 @@ Name::Component::fromNumber
         ("fromNumber: other type code must be non-negative");
   }
 
-  TlvEncoder encoder(8);
-  encoder.writeNonNegativeInteger(number);
-  return Name::Component(Blob(encoder.finish()), type, otherTypeCode);
+  // Encode into a local buffer so that the Component stores the value in place.
+  uint8_t buffer[8];
+  NameLite::Component componentLite;
+  ndn_Error error;
+  if ((error = componentLite.setFromNumber
+       (number, buffer, sizeof(buffer), type, otherTypeCode)))
+    throw runtime_error(ndn_getErrorString(error));
+  return Name::Component(componentLite);
 }
 
 Name::Component
 Name::Component::fromNumberWithMarker(uint64_t number, uint8_t marker)
 {
-  TlvEncoder encoder(9);
-  // Add the leading marker.
-  encoder.writeNonNegativeInteger(marker & 0xff);
-  encoder.writeNonNegativeInteger(number);
-  return Name::Component(encoder.finish());
+  uint8_t buffer[9];
+  NameLite::Component componentLite;
+  ndn_Error error;
+  if ((error = componentLite.setFromNumberWithMarker
+       (number, marker, buffer, sizeof(buffer))))
+    throw runtime_error(ndn_getErrorString(error));
+  return Name::Component(componentLite);
 }
 
 Name::Component
@@ -210,12 +219,13 @@ Name::Component::fromNumberWithPrefix(uint64_t number, const uint8_t* prefix, si
 void
 Name::Component::get(NameLite::Component& componentLite) const
 {
+  BlobLite value(getValueBuf(), getValueSize());
   if (type_ == ndn_NameComponentType_IMPLICIT_SHA256_DIGEST)
-    componentLite.setImplicitSha256Digest(value_);
+    componentLite.setImplicitSha256Digest(value);
   if (type_ == ndn_NameComponentType_PARAMETERS_SHA256_DIGEST)
-    componentLite.setParametersSha256Digest(value_);
+    componentLite.setParametersSha256Digest(value);
   else
-    componentLite = NameLite::Component(value_, type_, otherTypeCode_);
+    componentLite = NameLite::Component(value, type_, otherTypeCode_);
 }
 
 void
@@ -223,12 +233,14 @@ Name::Component::toEscapedString(std::ostringstream& result) const
 {
   if (type_ == ndn_NameComponentType_IMPLICIT_SHA256_DIGEST) {
     result << "sha256digest=";
-    value_.toHex(result);
+    if (!isValueNull())
+      toHex(getValueBuf(), getValueSize(), result);
     return;
   }
   if (type_ == ndn_NameComponentType_PARAMETERS_SHA256_DIGEST) {
     result << "params-sha256=";
-    value_.toHex(result);
+    if (!isValueNull())
+      toHex(getValueBuf(), getValueSize(), result);
     return;
   }
 
@@ -238,7 +250,7 @@ Name::Component::toEscapedString(std::ostringstream& result) const
     result << '=';
   }
 
-  Name::toEscapedString(*value_, result);
+  escape(getValueBuf(), getValueSize(), result);
 }
 
 std::string
@@ -271,13 +283,13 @@ Name::Component::compare(const Name::Component& other) const
   if (myTypeCode > otherTypeCode)
     return 1;
 
-  if (value_.size() < other.value_.size())
+  if (getValueSize() < other.getValueSize())
     return -1;
-  if (value_.size() > other.value_.size())
+  if (getValueSize() > other.getValueSize())
     return 1;
 
   // The components are equal length.  Just do a byte compare.
-  return ndn_memcmp(value_.buf(), other.value_.buf(), value_.size());
+  return ndn_memcmp(getValueBuf(), other.getValueBuf(), getValueSize());
 }
 
 Name::Component
@@ -309,16 +321,17 @@ Name::Component::getSuccessor() const
 {
   // Allocate an extra byte in case the result is larger.
   ptr_lib::shared_ptr<vector<uint8_t> > result
-    (new vector<uint8_t>(value_.size() + 1));
+    (new vector<uint8_t>(getValueSize() + 1));
 
+  const uint8_t* value = getValueBuf();
   bool carry = true;
-  for (int i = (int)value_.size() - 1; i >= 0; --i) {
+  for (int i = (int)getValueSize() - 1; i >= 0; --i) {
     if (carry) {
-      (*result)[i] = value_.buf()[i] + 1;
+      (*result)[i] = value[i] + 1;
       carry = ((*result)[i] == 0);
     }
     else
-      (*result)[i] = value_.buf()[i];
+      (*result)[i] = value[i];
   }
 
   if (carry)
@@ -328,11 +341,62 @@ Name::Component::getSuccessor() const
     (*result)[result->size() - 1] = 0;
   else
     // We didn't need the extra byte.
-    result->resize(value_.size());
+    result->resize(getValueSize());
 
   return Component(Blob(result, false), type_, otherTypeCode_);
 }
 
+bool
+Name::Component::valueEquals(const Component& other) const
+{
+  if (isValueNull() || other.isValueNull())
+    return isValueNull() && other.isValueNull();
+
+  return getValueSize() == other.getValueSize() &&
+         ndn_memcmp(getValueBuf(), other.getValueBuf(), getValueSize()) == 0;
+}
+
+const Blob&
+Name::Component::getInlineValueBlob() const
+{
+  typedef ptr_lib::shared_ptr<const vector<uint8_t> > BlobPointer;
+  BlobPointer* valuePointer = static_cast<BlobPointer*>(&value_);
+
+  if (!atomic_load(valuePointer)) {
+    BlobPointer expected;
+    BlobPointer newValue = Blob(inlineValue_, inlineValueSize_);
+    // If another thread already set value_, keep it and discard newValue.
+#if NDN_CPP_HAVE_STD_SHARED_PTR && NDN_CPP_WITH_STD_SHARED_PTR
+    atomic_compare_exchange_strong(valuePointer, &expected, newValue);
+#else
+    // Boost names the same function atomic_compare_exchange.
+    atomic_compare_exchange(valuePointer, &expected, newValue);
+#endif
+  }
+
+  return value_;
+}
+
+void
+Name::Component::setValue(const uint8_t* value, size_t valueLength)
+{
+  if (value && valueLength <= MAX_INLINE_VALUE_SIZE)
+    setInlineValue(value, valueLength);
+  else {
+    inlineValueSize_ = NO_INLINE_VALUE;
+    value_ = Blob(value, valueLength);
+  }
+}
+
+void
+Name::Component::setInlineValue(const uint8_t* value, size_t valueLength)
+{
+  if (valueLength > 0)
+    ndn_memcpy(inlineValue_, value, valueLength);
+  inlineValueSize_ = (uint8_t)valueLength;
+  value_.reset();
+}
+
 void
 Name::Component::setType(ndn_NameComponentType type, int otherTypeCode)
 {
@@ -475,8 +539,26 @@ Name::get(NameLite& nameLite) const
 void
 Name::set(const NameLite& nameLite)
 {
-  clear();
-  for (size_t i = 0; i < nameLite.size(); ++i)
+  // Keep the leading components which already have the same value, for
+  // example when decoding into a reused Name with the same prefix, so that we
+  // don't copy them into new Blobs.
+  size_t nSame = 0;
+  while (nSame < components_.size() && nSame < nameLite.size()) {
+    const Component& component = components_[nSame];
+    const NameLite::Component& componentLite = nameLite.get(nSame);
+    if (component.getType() != componentLite.getType() ||
+        component.getOtherTypeCode() != componentLite.getOtherTypeCode() ||
+        component.getValueSize() != componentLite.getValue().size() ||
+        ndn_memcmp(component.getValueBuf(), componentLite.getValue().buf(),
+                   component.getValueSize()) != 0)
+      break;
+    ++nSame;
+  }
+
+  components_.erase(components_.begin() + nSame, components_.end());
+  ++changeCount_;
+  components_.reserve(nameLite.size());
+  for (size_t i = nSame; i < nameLite.size(); ++i)
     append(Component(nameLite.get(i)));
 }
 
@@ -519,6 +601,8 @@ Name::getSubName(int iStartComponent, size_t nComponents) const
   Name result;
 
   size_t iEnd = min(iStartComponent + nComponents, components_.size());
+  if (iEnd > (size_t)iStartComponent)
+    result.components_.reserve(iEnd - iStartComponent);
   for (size_t i = iStartComponent; i < iEnd; ++i)
     result.components_.push_back(components_[i]);
 
@@ -533,7 +617,9 @@ Name::equals(const Name& name) const
 
   // Check from last to first since the last components are more likely to differ.
   for (int i = components_.size() - 1; i >= 0; --i) {
-    if (*components_[i].getValue() != *name.components_[i].getValue())
+    if (components_[i].getValueSize() != name.components_[i].getValueSize() ||
+        ndn_memcmp(components_[i].getValueBuf(), name.components_[i].getValueBuf(),
+                   components_[i].getValueSize()) != 0)
       return false;
   }
 
@@ -561,7 +647,9 @@ Name::match(const Name& name) const
   // Check if at least one of given components doesn't match. Check from last to
   // first since the last components are more likely to differ.
   for (int i = components_.size() - 1; i >= 0; --i) {
-    if (*components_[i].getValue() != *name.components_[i].getValue())
+    if (components_[i].getValueSize() != name.components_[i].getValueSize() ||
+        ndn_memcmp(components_[i].getValueBuf(), name.components_[i].getValueBuf(),
+                   components_[i].getValueSize()) != 0)
       return false;
   }
 
@@ -596,9 +684,15 @@ Name::fromEscapedString(const char *escapedString)
 
 void
 Name::toEscapedString(const vector<uint8_t>& value, ostringstream& result)
+{
+  escape(value.size() > 0 ? &value[0] : 0, value.size(), result);
+}
+
+void
+Name::escape(const uint8_t* value, size_t valueLength, ostringstream& result)
 {
   bool gotNonDot = false;
-  for (unsigned i = 0; i < value.size(); ++i) {
+  for (size_t i = 0; i < valueLength; ++i) {
     if (value[i] != 0x2e) {
       gotNonDot = true;
       break;
@@ -607,14 +701,14 @@ Name::toEscapedString(const vector<uint8_t>& value, ostringstream& result)
   if (!gotNonDot) {
     // Special case for component of zero or more periods.  Add 3 periods.
     result << "...";
-    for (size_t i = 0; i < value.size(); ++i)
+    for (size_t i = 0; i < valueLength; ++i)
       result << '.';
   }
   else {
     // In case we need to escape, set to upper case hex and save the previous flags.
     ios::fmtflags saveFlags = result.flags(ios::hex | ios::uppercase);
 
-    for (size_t i = 0; i < value.size(); ++i) {
+    for (size_t i = 0; i < valueLength; ++i) {
       uint8_t x = value[i];
       // Check for 0-9, A-Z, a-z, (+), (-), (.), (_)
       if ((x >= 0x30 && x <= 0x39) || (x >= 0x41 && x <= 0x5a) ||
@@ -710,7 +804,7 @@ Name::hash() const
   // this will re-compute the hash each time. This is OK because we don't want
   // to take the space to keep a flag like haveHashCode_ .
   if (hashCode_ == 0) {
-    int hashCode = 0;
+    size_t hashCode = 0;
     for (size_t i = 0; i < components_.size(); ++i)
       hashCode = 37 * hashCode + components_[i].hash();
 
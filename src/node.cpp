@@ -43,7 +43,9 @@ Node::Node(const ptr_lib::shared_ptr<Transport>& transport, const ptr_lib::share
   timeoutPrefix_(Name("/local/timeout")),
   lastEntryId_(0), connectStatus_(ConnectStatus_UNCONNECTED),
   interestLoopbackEnabled_(false), registeredPrefixTable_(interestFilterTable_),
-  nonceTemplate_((const uint8_t*)"\0\0\0\0", 4)
+  nonceTemplate_((const uint8_t*)"\0\0\0\0", 4),
+  interestPool_(RECEIVE_POOL_SIZE), dataPool_(RECEIVE_POOL_SIZE),
+  lpPacketPool_(RECEIVE_POOL_SIZE)
 {
 }
 
@@ -406,6 +408,9 @@ Node::processEvents()
   // If Face::callLater is overridden to use a different mechanism, then
   // processEvents is not needed to check for delayed calls.
   delayedCallTable_.callTimedOut();
+
+  // Send what the callbacks sent if the transport queues it.
+  transport_->flush();
 }
 
 void
@@ -429,7 +434,7 @@ Node::onReceivedElement(const uint8_t *element, size_t elementLength)
     // We have saved the wire encoding, so clear to copy it to lpPacket.
     lpPacketLite.setFragmentWireEncoding(BlobLite());
 
-    lpPacket.reset(new LpPacket());
+    lpPacket = lpPacketPool_.get();
     lpPacket->set(lpPacketLite);
   }
 
@@ -440,18 +445,16 @@ Node::onReceivedElement(const uint8_t *element, size_t elementLength)
   if (element[0] == ndn_Tlv_Interest || element[0] == ndn_Tlv_Data) {
     TlvDecoder decoder(element, elementLength);
     if (decoder.peekType(ndn_Tlv_Interest, elementLength)) {
-      interest.reset(new Interest());
+      interest = interestPool_.get();
       interest->wireDecode(element, elementLength, *TlvWireFormat::get());
-
-      if (lpPacket)
-        interest->setLpPacket(lpPacket);
+      // A reused Interest may have the LpPacket from a previous packet.
+      interest->setLpPacket(lpPacket);
     }
     else if (decoder.peekType(ndn_Tlv_Data, elementLength)) {
-      data.reset(new Data());
+      data = dataPool_.get();
       data->wireDecode(element, elementLength, *TlvWireFormat::get());
-
-      if (lpPacket)
-        data->setLpPacket(lpPacket);
+      // A reused Data may have the LpPacket from a previous packet.
+      data->setLpPacket(lpPacket);
     }
   }
 
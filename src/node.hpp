@@ -37,6 +37,7 @@
 #include "impl/interest-filter-table.hpp"
 #include "impl/pending-interest-table.hpp"
 #include "impl/registered-prefix-table.hpp"
+#include "impl/object-pool.hpp"
 #include "encoding/element-listener.hpp"
 
 struct ndn_Interest;
@@ -327,13 +328,40 @@ public:
   /**
    * Call callback() after the given delay. This adds to delayedCallTable_ which
    * is used by processEvents().
+   * @param callLaterId The getNextEntryId() for the ID which can be used with
+   * cancelCallLater.
    * @param delayMilliseconds The delay in milliseconds.
    * @param callback This calls callback() after the delay.
    */
   void
-  callLater(Milliseconds delayMilliseconds, const Face::Callback& callback)
+  callLater
+    (uint64_t callLaterId, Milliseconds delayMilliseconds,
+     const Face::Callback& callback)
   {
-    delayedCallTable_.callLater(delayMilliseconds, callback);
+    delayedCallTable_.callLater(callLaterId, delayMilliseconds, callback);
+  }
+
+  /**
+   * Cancel the call from callLater with the callLaterId. If there is no such
+   * call (for example, if it was already called), do nothing.
+   * @param callLaterId The ID given to callLater.
+   */
+  void
+  cancelCallLater(uint64_t callLaterId)
+  {
+    delayedCallTable_.cancelCallLater(callLaterId);
+  }
+
+  /**
+   * Get the number of milliseconds until the next call from callLater is due,
+   * so that an event loop can sleep until then instead of polling.
+   * @return The milliseconds until the next call, or 0 if a call is already
+   * due, or -1 if there are no calls.
+   */
+  Milliseconds
+  getMillisecondsUntilNextCall()
+  {
+    return delayedCallTable_.getMillisecondsUntilNextCall();
   }
 
   /**
@@ -540,6 +568,13 @@ private:
   ConnectStatus connectStatus_;
   bool interestLoopbackEnabled_;
   Blob nonceTemplate_;
+  // The number of received Interest, Data and LpPacket objects to keep for reuse.
+  static const size_t RECEIVE_POOL_SIZE = 16;
+  // onReceivedElement reuses the objects for received packets when the
+  // application has released them.
+  ObjectPool<Interest> interestPool_;
+  ObjectPool<Data> dataPool_;
+  ObjectPool<LpPacket> lpPacketPool_;
 #if NDN_CPP_HAVE_BOOST_ATOMIC
   // ThreadsafeFace accesses lastEntryId_ outside of a thread safe dispatch, so
   // use atomic_uint64_t to be thread safe.
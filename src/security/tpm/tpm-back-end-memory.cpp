@@ -41,7 +41,7 @@ TpmBackEndMemory::doHasKey(const Name& keyName) const
 ptr_lib::shared_ptr<TpmKeyHandle>
 TpmBackEndMemory::doGetKeyHandle(const Name& keyName) const
 {
-  map<Name, ptr_lib::shared_ptr<TpmPrivateKey>>::const_iterator it =
+  PrivateKeyMap::const_iterator it =
     keys_.find(keyName);
   if (it == keys_.end())
     return ptr_lib::shared_ptr<TpmKeyHandle>();
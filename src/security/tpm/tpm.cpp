@@ -115,7 +115,7 @@ Tpm::createKey(const Name& identityName, const KeyParams& params)
 void
 Tpm::deleteKey(const Name& keyName)
 {
-  map<Name, ptr_lib::shared_ptr<TpmKeyHandle>>::const_iterator it =
+  KeyHandleMap::const_iterator it =
     keys_.find(keyName);
   if (it != keys_.end())
     keys_.erase(it);
@@ -141,7 +141,7 @@ Tpm::importPrivateKey
 const TpmKeyHandle*
 Tpm::findKey(const Name& keyName) const
 {
-  map<Name, ptr_lib::shared_ptr<TpmKeyHandle>>::const_iterator it =
+  KeyHandleMap::const_iterator it =
     keys_.find(keyName);
 
   if (it != keys_.end())
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include <stdexcept>
+#include <list>
+#include <map>
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+#include <unordered_map>
+#endif
+#if NDN_CPP_HAVE_POSIX_THREADS
+#include <pthread.h>
+#endif
+#include <ndn-cpp/security/security-exception.hpp>
+#include <ndn-cpp/security/certificate/public-key.hpp>
+#include <ndn-cpp/lite/util/crypto-lite.hpp>
+#include <ndn-cpp/lite/security/ec-public-key-lite.hpp>
+#include <ndn-cpp/lite/security/rsa-public-key-lite.hpp>
+#include <ndn-cpp/security/v2/public-key-cache.hpp>
+
+using namespace std;
+
+namespace ndn {
+
+/**
+ * The Impl holds the decoded keys and the lock which protects them. The keys
+ * are only used for verifying, which doesn't change them, so verifySignature
+ * releases the lock before verifying and other threads can use the same key.
+ */
+class PublicKeyCache::Impl {
+public:
+  /**
+   * An Entry holds one decoded key. Only the key for keyType_ is decoded.
+   */
+  class Entry {
+  public:
+    Entry(KeyType keyType)
+    : keyType_(keyType)
+    {
+    }
+
+    KeyType keyType_;
+    RsaPublicKeyLite rsaKey_;
+    EcPublicKeyLite ecKey_;
+    std::list<Name>::iterator lruPosition_;
+  };
+
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+  typedef std::unordered_map<Name, ptr_lib::shared_ptr<Entry>, Name::Hash>
+    EntryMap;
+#else
+  typedef std::map<Name, ptr_lib::shared_ptr<Entry> > EntryMap;
+#endif
+
+  Impl()
+  : nHits_(0), nMisses_(0)
+  {
+#if NDN_CPP_HAVE_POSIX_THREADS
+    pthread_mutex_init(&lock_, 0);
+#endif
+  }
+
+  ~Impl()
+  {
+#if NDN_CPP_HAVE_POSIX_THREADS
+    pthread_mutex_destroy(&lock_);
+#endif
+  }
+
+  /**
+   * A Lock gets the Impl's lock in the constructor and releases it in the
+   * destructor.
+   */
+  class Lock {
+  public:
+    Lock(Impl& impl)
+    : impl_(impl)
+    {
+#if NDN_CPP_HAVE_POSIX_THREADS
+      pthread_mutex_lock(&impl_.lock_);
+#endif
+    }
+
+    ~Lock()
+    {
+#if NDN_CPP_HAVE_POSIX_THREADS
+      pthread_mutex_unlock(&impl_.lock_);
+#endif
+    }
+
+  private:
+    Impl& impl_;
+  };
+
+  EntryMap entries_;
+  // The key of each entry in entries_, with the least recently used first.
+  std::list<Name> lruList_;
+  size_t nHits_;
+  size_t nMisses_;
+#if NDN_CPP_HAVE_POSIX_THREADS
+  pthread_mutex_t lock_;
+#endif
+};
+
+PublicKeyCache::PublicKeyCache(size_t maxEntries)
+: maxEntries_(maxEntries), impl_(new Impl())
+{
+  if (maxEntries_ == 0)
+    throw invalid_argument("PublicKeyCache: maxEntries must be positive");
+}
+
+PublicKeyCache::~PublicKeyCache()
+{
+  delete impl_;
+}
+
+bool
+PublicKeyCache::verifySignature
+  (const uint8_t* buffer, size_t bufferLength, const uint8_t* signature,
+   size_t signatureLength, const Name& keyName, const Blob& publicKeyDer,
+   DigestAlgorithm digestAlgorithm)
+{
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    throw invalid_argument("verifySignature: Invalid digest algorithm");
+  if (publicKeyDer.size() == 0)
+    return false;
+
+  // Find the entry by the key name plus the digest of the DER.
+  uint8_t derDigest[ndn_SHA256_DIGEST_SIZE];
+  CryptoLite::digestSha256(publicKeyDer.buf(), publicKeyDer.size(), derDigest);
+  Name entryKey(keyName);
+  entryKey.appendImplicitSha256Digest(derDigest, sizeof(derDigest));
+
+  ptr_lib::shared_ptr<Impl::Entry> entry;
+  {
+    Impl::Lock lock(*impl_);
+    Impl::EntryMap::iterator found = impl_->entries_.find(entryKey);
+    if (found != impl_->entries_.end()) {
+      ++impl_->nHits_;
+      entry = found->second;
+      // Move the entry to the most recently used position.
+      impl_->lruList_.splice
+        (impl_->lruList_.end(), impl_->lruList_, entry->lruPosition_);
+    }
+    else
+      ++impl_->nMisses_;
+  }
+
+  if (!entry) {
+    // Decode the key outside the lock, then add it.
+    KeyType keyType;
+    try {
+      keyType = PublicKey(publicKeyDer).getKeyType();
+    } catch (const UnrecognizedKeyFormatException&) {
+      return false;
+    }
+
+    entry.reset(new Impl::Entry(keyType));
+#if NDN_CPP_HAVE_LIBCRYPTO
+    if (keyType == KEY_TYPE_RSA) {
+      if (entry->rsaKey_.decode(publicKeyDer.buf(), publicKeyDer.size()) != 0)
+        return false;
+    }
+    else if (keyType == KEY_TYPE_EC) {
+      if (entry->ecKey_.decode(publicKeyDer.buf(), publicKeyDer.size()) != 0)
+        return false;
+    }
+    else
+#endif
+      throw invalid_argument("verifySignature: Invalid key type");
+
+    Impl::Lock lock(*impl_);
+    pair<Impl::EntryMap::iterator, bool> inserted = impl_->entries_.insert
+      (make_pair(entryKey, entry));
+    if (inserted.second) {
+      entry->lruPosition_ = impl_->lruList_.insert
+        (impl_->lruList_.end(), entryKey);
+
+      while (impl_->entries_.size() > maxEntries_) {
+        impl_->entries_.erase(impl_->lruList_.front());
+        impl_->lruList_.pop_front();
+      }
+    }
+    else
+      // Another thread added the same key while this thread decoded it.
+      entry = inserted.first->second;
+  }
+
+#if NDN_CPP_HAVE_LIBCRYPTO
+  if (entry->keyType_ == KEY_TYPE_RSA)
+    return entry->rsaKey_.verifyWithSha256
+      (signature, signatureLength, buffer, bufferLength);
+  else
+    return entry->ecKey_.verifyWithSha256
+      (signature, signatureLength, buffer, bufferLength);
+#else
+  return false;
+#endif
+}
+
+void
+PublicKeyCache::clear()
+{
+  Impl::Lock lock(*impl_);
+  impl_->entries_.clear();
+  impl_->lruList_.clear();
+}
+
+size_t
+PublicKeyCache::size()
+{
+  Impl::Lock lock(*impl_);
+  return impl_->entries_.size();
+}
+
+size_t
+PublicKeyCache::getNHits()
+{
+  Impl::Lock lock(*impl_);
+  return impl_->nHits_;
+}
+
+size_t
+PublicKeyCache::getNMisses()
+{
+  Impl::Lock lock(*impl_);
+  return impl_->nMisses_;
+}
+
+}
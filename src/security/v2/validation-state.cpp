@@ -45,7 +45,8 @@ ValidationState::setOutcome(bool outcome)
 
 ptr_lib::shared_ptr<CertificateV2>
 ValidationState::verifyCertificateChain
-  (const ptr_lib::shared_ptr<CertificateV2>& trustedCertificate)
+  (const ptr_lib::shared_ptr<CertificateV2>& trustedCertificate,
+   PublicKeyCache& publicKeyCache)
 {
   ptr_lib::shared_ptr<CertificateV2> validatedCertificate = trustedCertificate;
   for (size_t i = 0; i < certificateChain_.size(); ++i) {
@@ -53,12 +54,8 @@ ValidationState::verifyCertificateChain
       certificateChain_[i];
 
     if (!VerificationHelpers::verifyDataSignature
-        (*certificateToValidate, *validatedCertificate)) {
-      fail(ValidationError(ValidationError::INVALID_SIGNATURE,
-           "Invalid signature of certificate `" +
-           certificateToValidate->getName().toUri() + "`"));
-      certificateChain_.erase
-        (certificateChain_.begin() + i, certificateChain_.end());
+        (*certificateToValidate, *validatedCertificate, publicKeyCache)) {
+      failCertificateSignature(i);
       return ptr_lib::shared_ptr<CertificateV2>();
     }
     else {
@@ -70,6 +67,16 @@ ValidationState::verifyCertificateChain
   return validatedCertificate;
 }
 
+void
+ValidationState::failCertificateSignature(size_t index)
+{
+  fail(ValidationError(ValidationError::INVALID_SIGNATURE,
+       "Invalid signature of certificate `" +
+       certificateChain_[index]->getName().toUri() + "`"));
+  certificateChain_.erase
+    (certificateChain_.begin() + index, certificateChain_.end());
+}
+
 DataValidationState::DataValidationState
   (const Data& data, const DataValidationSuccessCallback& successCallback,
    const DataValidationFailureCallback& failureCallback)
@@ -85,9 +92,30 @@ DataValidationState::DataValidationState
 
 void
 DataValidationState::verifyOriginalPacket
-  (const CertificateV2& trustedCertificate)
+  (const CertificateV2& trustedCertificate, PublicKeyCache& publicKeyCache)
+{
+  onOriginalPacketVerified(VerificationHelpers::verifyDataSignature
+    (data_, trustedCertificate, publicKeyCache));
+}
+
+bool
+DataValidationState::getOriginalPacketSignature
+  (SignedBlob& encoding, Blob& signature)
 {
-  if (VerificationHelpers::verifyDataSignature(data_, trustedCertificate)) {
+  try {
+    encoding = data_.wireEncode();
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  signature = data_.getSignature()->getSignature();
+  return true;
+}
+
+void
+DataValidationState::onOriginalPacketVerified(bool verified)
+{
+  if (verified) {
     _LOG_TRACE("OK signature for data `" << data_.getName() << "`");
     try {
       successCallback_(data_);
@@ -148,9 +176,38 @@ InterestValidationState::InterestValidationState
 
 void
 InterestValidationState::verifyOriginalPacket
-  (const CertificateV2& trustedCertificate)
+  (const CertificateV2& trustedCertificate, PublicKeyCache& publicKeyCache)
+{
+  onOriginalPacketVerified(VerificationHelpers::verifyInterestSignature
+    (interest_, trustedCertificate, publicKeyCache));
+}
+
+bool
+InterestValidationState::getOriginalPacketSignature
+  (SignedBlob& encoding, Blob& signature)
+{
+  // The last two name components are the SignatureInfo and signature bits.
+  if (interest_.getName().size() < 2)
+    return false;
+
+  try {
+    ptr_lib::shared_ptr<Signature> decodedSignature =
+      WireFormat::getDefaultWireFormat()->decodeSignatureInfoAndValue
+        (interest_.getName().get(-2).getValue(),
+         interest_.getName().get(-1).getValue());
+    encoding = interest_.wireEncode();
+    signature = decodedSignature->getSignature();
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  return true;
+}
+
+void
+InterestValidationState::onOriginalPacketVerified(bool verified)
 {
-  if (VerificationHelpers::verifyInterestSignature(interest_, trustedCertificate)) {
+  if (verified) {
     _LOG_TRACE("OK signature for interest `" << interest_.getName() << "`");
     for (size_t i = 0; i < successCallbacks_.size(); ++i) {
       try {
@@ -61,6 +61,25 @@ Validator::validate
     (data, state, bind(&Validator::continueValidate, this, _1, _2));
 }
 
+void
+Validator::validate
+  (const vector<ptr_lib::shared_ptr<Data> >& dataList,
+   const DataValidationSuccessCallback& successCallback,
+   const DataValidationFailureCallback& failureCallback)
+{
+  if (dataList.size() == 0)
+    return;
+
+  ptr_lib::shared_ptr<vector<ptr_lib::shared_ptr<Data> > > rest
+    (new vector<ptr_lib::shared_ptr<Data> >(dataList.begin() + 1, dataList.end()));
+  validate
+    (*dataList[0],
+     bind(&Validator::onFirstDataValidated, this, _1, rest, successCallback,
+          failureCallback),
+     bind(&Validator::onFirstDataFailed, this, _1, _2, rest, successCallback,
+          failureCallback));
+}
+
 void
 Validator::validate
   (const Interest& interest,
@@ -121,9 +140,16 @@ Validator::requestCertificate
   if (certificate) {
     _LOG_TRACE("Found trusted certificate " << certificate->getName());
 
-    certificate = state->verifyCertificateChain(certificate);
+#if NDN_CPP_HAVE_POSIX_THREADS
+    if (workerPool_) {
+      verifyWithWorkerPool(certificate, state);
+      return;
+    }
+#endif
+
+    certificate = state->verifyCertificateChain(certificate, publicKeyCache_);
     if (certificate)
-      state->verifyOriginalPacket(*certificate);
+      state->verifyOriginalPacket(*certificate, publicKeyCache_);
 
     for (size_t i = 0; i < state->certificateChain_.size(); ++i)
       cacheVerifiedCertificate(*state->certificateChain_[i]);
@@ -136,4 +162,125 @@ Validator::requestCertificate
      bind(&Validator::validateCertificate, this, _1, _2));
 }
 
+#if NDN_CPP_HAVE_POSIX_THREADS
+void
+Validator::verifyWithWorkerPool
+  (const ptr_lib::shared_ptr<CertificateV2>& trustedCertificate,
+   const ptr_lib::shared_ptr<ValidationState>& state)
+{
+  // Copy the values to verify here so that the worker threads don't use the
+  // packets or certificates.
+  ptr_lib::shared_ptr<vector<VerificationWorkerPool::Item> > items
+    (new vector<VerificationWorkerPool::Item>());
+  ptr_lib::shared_ptr<CertificateV2> signingCertificate = trustedCertificate;
+  try {
+    for (size_t i = 0; i < state->certificateChain_.size(); ++i) {
+      const CertificateV2& certificate = *state->certificateChain_[i];
+      SignedBlob encoding;
+      try {
+        encoding = certificate.wireEncode();
+      } catch (const std::exception&) {
+        state->failCertificateSignature(i);
+        return;
+      }
+
+      items->push_back(VerificationWorkerPool::Item
+        (encoding, certificate.getSignature()->getSignature(),
+         signingCertificate->getKeyName(), signingCertificate->getPublicKey()));
+      signingCertificate = state->certificateChain_[i];
+    }
+
+    SignedBlob encoding;
+    Blob signature;
+    if (!state->getOriginalPacketSignature(encoding, signature)) {
+      state->onOriginalPacketVerified(false);
+      return;
+    }
+    items->push_back(VerificationWorkerPool::Item
+      (encoding, signature, signingCertificate->getKeyName(),
+       signingCertificate->getPublicKey()));
+  } catch (const CertificateV2::Error& ex) {
+    // getPublicKey() found an empty certificate content.
+    state->fail(ValidationError
+      (ValidationError::INVALID_SIGNATURE,
+       "Invalid public key in certificate `" +
+       signingCertificate->getName().toUri() + "`: " + ex.what()));
+    return;
+  }
+
+  workerPool_->verify
+    (items, publicKeyCache_,
+     bind(&Validator::onWorkerPoolVerified, this, _1, state));
+}
+
+void
+Validator::onWorkerPoolVerified
+  (const vector<bool>& results, const ptr_lib::shared_ptr<ValidationState>& state)
+{
+  // The results have the certificate chain, then the original packet.
+  bool isChainVerified = true;
+  for (size_t i = 0; i < state->certificateChain_.size(); ++i) {
+    if (!results[i]) {
+      state->failCertificateSignature(i);
+      isChainVerified = false;
+      break;
+    }
+    _LOG_TRACE("OK signature for certificate `" <<
+               state->certificateChain_[i]->getName() << "`");
+  }
+
+  if (isChainVerified)
+    state->onOriginalPacketVerified(results.back());
+
+  for (size_t i = 0; i < state->certificateChain_.size(); ++i)
+    cacheVerifiedCertificate(*state->certificateChain_[i]);
+}
+#endif
+
+void
+Validator::validateRest
+  (const ptr_lib::shared_ptr<vector<ptr_lib::shared_ptr<Data> > >& dataList,
+   const DataValidationSuccessCallback& successCallback,
+   const DataValidationFailureCallback& failureCallback)
+{
+  for (size_t i = 0; i < dataList->size(); ++i)
+    validate(*(*dataList)[i], successCallback, failureCallback);
+}
+
+void
+Validator::onFirstDataValidated
+  (const Data& data,
+   const ptr_lib::shared_ptr<vector<ptr_lib::shared_ptr<Data> > >& dataList,
+   const DataValidationSuccessCallback& successCallback,
+   const DataValidationFailureCallback& failureCallback)
+{
+  try {
+    successCallback(data);
+  } catch (const std::exception& ex) {
+    _LOG_ERROR("Validator::validate: Error in successCallback: " << ex.what());
+  } catch (...) {
+    _LOG_ERROR("Validator::validate: Error in successCallback.");
+  }
+
+  validateRest(dataList, successCallback, failureCallback);
+}
+
+void
+Validator::onFirstDataFailed
+  (const Data& data, const ValidationError& error,
+   const ptr_lib::shared_ptr<vector<ptr_lib::shared_ptr<Data> > >& dataList,
+   const DataValidationSuccessCallback& successCallback,
+   const DataValidationFailureCallback& failureCallback)
+{
+  try {
+    failureCallback(data, error);
+  } catch (const std::exception& ex) {
+    _LOG_ERROR("Validator::validate: Error in failureCallback: " << ex.what());
+  } catch (...) {
+    _LOG_ERROR("Validator::validate: Error in failureCallback.");
+  }
+
+  validateRest(dataList, successCallback, failureCallback);
+}
+
 }
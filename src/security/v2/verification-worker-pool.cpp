@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_POSIX_THREADS.
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_POSIX_THREADS
+
+#include <stdexcept>
+#include <deque>
+#include <pthread.h>
+#include <unistd.h>
+#include <ndn-cpp/util/logging.hpp>
+#include <ndn-cpp/security/v2/verification-worker-pool.hpp>
+
+INIT_LOGGER("ndn.VerificationWorkerPool");
+
+using namespace std;
+
+namespace ndn {
+
+/**
+ * The Impl holds the queue of signatures to verify, the list of finished
+ * calls to verify(), and the lock and condition which protect them.
+ */
+class VerificationWorkerPool::Impl {
+public:
+  /**
+   * A Request holds the items and results of one call to verify().
+   */
+  class Request {
+  public:
+    Request
+      (const ptr_lib::shared_ptr<const vector<Item> >& items,
+       PublicKeyCache& publicKeyCache, const OnVerified& onVerified)
+    : items_(items), publicKeyCache_(publicKeyCache), onVerified_(onVerified),
+      // Use uint8_t since each worker sets a different result, which is not
+      // safe with the packed bits of vector<bool>.
+      results_(items->size(), 0), nRemaining_(items->size())
+    {
+    }
+
+    ptr_lib::shared_ptr<const vector<Item> > items_;
+    PublicKeyCache& publicKeyCache_;
+    OnVerified onVerified_;
+    vector<uint8_t> results_;
+    size_t nRemaining_;
+  };
+
+  /**
+   * A Task is the index of one item in a Request.
+   */
+  typedef pair<ptr_lib::shared_ptr<Request>, size_t> Task;
+
+  Impl()
+  : isStopping_(false)
+  {
+    pthread_mutex_init(&lock_, 0);
+    pthread_cond_init(&taskReady_, 0);
+  }
+
+  ~Impl()
+  {
+    pthread_cond_destroy(&taskReady_);
+    pthread_mutex_destroy(&lock_);
+  }
+
+  /**
+   * Verify tasks until isStopping_ is set.
+   * @param impl The Impl.
+   * @return 0.
+   */
+  static void*
+  runWorker(void* impl);
+
+  /**
+   * Set isStopping_ and join the threads in threads_.
+   */
+  void
+  stop();
+
+  deque<Task> tasks_;
+  vector<ptr_lib::shared_ptr<Request> > finishedRequests_;
+  bool isStopping_;
+  pthread_mutex_t lock_;
+  pthread_cond_t taskReady_;
+  vector<pthread_t> threads_;
+};
+
+void*
+VerificationWorkerPool::Impl::runWorker(void* implPointer)
+{
+  Impl& impl = *(Impl*)implPointer;
+
+  pthread_mutex_lock(&impl.lock_);
+  while (true) {
+    while (impl.tasks_.empty() && !impl.isStopping_)
+      pthread_cond_wait(&impl.taskReady_, &impl.lock_);
+    if (impl.isStopping_)
+      break;
+
+    Task task = impl.tasks_.front();
+    impl.tasks_.pop_front();
+    pthread_mutex_unlock(&impl.lock_);
+
+    // Verify without the lock.
+    Request& request = *task.first;
+    const Item& item = (*request.items_)[task.second];
+    bool verified;
+    try {
+      verified = request.publicKeyCache_.verifySignature
+        (item.encoding_.signedBuf(), item.encoding_.signedSize(),
+         item.signature_.buf(), item.signature_.size(), item.keyName_,
+         item.publicKeyDer_);
+    } catch (const std::exception& ex) {
+      _LOG_TRACE("VerificationWorkerPool: Error verifying: " << ex.what());
+      verified = false;
+    }
+
+    pthread_mutex_lock(&impl.lock_);
+    request.results_[task.second] = (verified ? 1 : 0);
+    --request.nRemaining_;
+    if (request.nRemaining_ == 0)
+      impl.finishedRequests_.push_back(task.first);
+  }
+  pthread_mutex_unlock(&impl.lock_);
+
+  return 0;
+}
+
+void
+VerificationWorkerPool::Impl::stop()
+{
+  pthread_mutex_lock(&lock_);
+  isStopping_ = true;
+  pthread_cond_broadcast(&taskReady_);
+  pthread_mutex_unlock(&lock_);
+
+  for (size_t i = 0; i < threads_.size(); ++i)
+    pthread_join(threads_[i], 0);
+  threads_.clear();
+}
+
+VerificationWorkerPool::VerificationWorkerPool(size_t nThreads)
+: nThreads_(nThreads), impl_(new Impl())
+{
+  if (nThreads_ == 0) {
+    long nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    nThreads_ = (nProcessors > 0 ? (size_t)nProcessors : 1);
+  }
+
+  for (size_t i = 0; i < nThreads_; ++i) {
+    pthread_t thread;
+    if (pthread_create(&thread, 0, &Impl::runWorker, impl_) != 0) {
+      // Stop the threads which started.
+      impl_->stop();
+      delete impl_;
+      throw runtime_error("VerificationWorkerPool: Error creating a thread");
+    }
+    impl_->threads_.push_back(thread);
+  }
+}
+
+VerificationWorkerPool::~VerificationWorkerPool()
+{
+  impl_->stop();
+  delete impl_;
+}
+
+void
+VerificationWorkerPool::verify
+  (const ptr_lib::shared_ptr<const vector<Item> >& items,
+   PublicKeyCache& publicKeyCache, const OnVerified& onVerified)
+{
+  ptr_lib::shared_ptr<Impl::Request> request(new Impl::Request
+    (items, publicKeyCache, onVerified));
+
+  pthread_mutex_lock(&impl_->lock_);
+  if (items->size() == 0)
+    impl_->finishedRequests_.push_back(request);
+  else {
+    for (size_t i = 0; i < items->size(); ++i)
+      impl_->tasks_.push_back(Impl::Task(request, i));
+    pthread_cond_broadcast(&impl_->taskReady_);
+  }
+  pthread_mutex_unlock(&impl_->lock_);
+}
+
+void
+VerificationWorkerPool::processEvents()
+{
+  vector<ptr_lib::shared_ptr<Impl::Request> > finishedRequests;
+  pthread_mutex_lock(&impl_->lock_);
+  finishedRequests.swap(impl_->finishedRequests_);
+  pthread_mutex_unlock(&impl_->lock_);
+
+  // Call the callbacks without the lock so that they can call verify().
+  for (size_t i = 0; i < finishedRequests.size(); ++i) {
+    Impl::Request& request = *finishedRequests[i];
+    vector<bool> results(request.results_.begin(), request.results_.end());
+    try {
+      request.onVerified_(results);
+    } catch (const std::exception& ex) {
+      _LOG_ERROR("VerificationWorkerPool::processEvents: Error in onVerified: " <<
+                 ex.what());
+    } catch (...) {
+      _LOG_ERROR("VerificationWorkerPool::processEvents: Error in onVerified.");
+    }
+  }
+}
+
+}
+
+#endif // NDN_CPP_HAVE_POSIX_THREADS
@@ -113,6 +113,26 @@ VerificationHelpers::verifyDataSignature
   }
 }
 
+bool
+VerificationHelpers::verifyDataSignature
+  (const Data& data, const CertificateV2& certificate,
+   PublicKeyCache& publicKeyCache, DigestAlgorithm digestAlgorithm,
+   WireFormat& wireFormat)
+{
+  SignedBlob encoding;
+  try {
+    encoding = data.wireEncode(wireFormat);
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  return publicKeyCache.verifySignature
+    (encoding.signedBuf(), encoding.signedSize(),
+     data.getSignature()->getSignature().buf(),
+     data.getSignature()->getSignature().size(), certificate.getKeyName(),
+     certificate.getPublicKey(), digestAlgorithm);
+}
+
 bool
 VerificationHelpers::verifyInterestSignature
   (const Interest& interest, const PublicKey& publicKey,
@@ -149,6 +169,30 @@ VerificationHelpers::verifyInterestSignature
   }
 }
 
+bool
+VerificationHelpers::verifyInterestSignature
+  (const Interest& interest, const CertificateV2& certificate,
+   PublicKeyCache& publicKeyCache, DigestAlgorithm digestAlgorithm,
+   WireFormat& wireFormat)
+{
+  ptr_lib::shared_ptr<Signature> signature = extractSignature
+    (interest, wireFormat);
+  if (!signature)
+    return false;
+
+  SignedBlob encoding;
+  try {
+    encoding = interest.wireEncode(wireFormat);
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  return publicKeyCache.verifySignature
+    (encoding.signedBuf(), encoding.signedSize(),
+     signature->getSignature().buf(), signature->getSignature().size(),
+     certificate.getKeyName(), certificate.getPublicKey(), digestAlgorithm);
+}
+
 bool
 VerificationHelpers::verifyDigest
   (const uint8_t* buffer, size_t bufferLength, const uint8_t* digest,
@@ -68,49 +68,93 @@ InvertibleBloomLookupTable::InvertibleBloomLookupTable(size_t expectedNEntries)
   if (remainder != 0)
     nEntries += (N_HASH - remainder);
 
-  hashTable_.resize(nEntries);
+  counts_.resize(nEntries);
+  keySums_.resize(nEntries);
+  keyChecks_.resize(nEntries);
+}
+
+/**
+ * Get the little-endian uint32_t at the given position.
+ */
+static uint32_t
+getUint32(const uint8_t* buffer)
+{
+  return ((uint32_t)buffer[3] << 24) + ((uint32_t)buffer[2] << 16) +
+         ((uint32_t)buffer[1] << 8) + buffer[0];
+}
+
+/**
+ * Put the uint32_t at the given position as little-endian.
+ */
+static void
+putUint32(uint32_t value, uint8_t* buffer)
+{
+  buffer[0] = 0xFF & value;
+  buffer[1] = 0xFF & (value >> 8);
+  buffer[2] = 0xFF & (value >> 16);
+  buffer[3] = 0xFF & (value >> 24);
 }
 
 void
 InvertibleBloomLookupTable::initialize(const Blob& encoding)
 {
-  vector<uint32_t> values = decode(encoding);
+  Blob ibltValues = zlibDecompress(encoding.buf(), encoding.size());
 
-  if (3 * hashTable_.size() != values.size())
+  size_t nEntries = counts_.size();
+  size_t unitSize = (32 * 3) / 8; // hard coding
+  if (unitSize * nEntries != ibltValues.size())
     throw runtime_error("The received Invertible Bloom Filter cannot be decoded");
 
-  for (size_t i = 0; i < hashTable_.size(); i++) {
-    HashTableEntry& entry = hashTable_.at(i);
-    if (values[i * 3] != 0) {
-      entry.count_ = values[i * 3];
-      entry.keySum_ = values[(i * 3) + 1];
-      entry.keyCheck_ = values[(i * 3) + 2];
+  // Decode directly into the hash table without an intermediate array.
+  const uint8_t* buffer = ibltValues.buf();
+  for (size_t i = 0; i < nEntries; i++) {
+    const uint8_t* unit = buffer + i * unitSize;
+    uint32_t count = getUint32(unit);
+    if (count != 0) {
+      counts_[i] = count;
+      keySums_[i] = getUint32(unit + 4);
+      keyChecks_[i] = getUint32(unit + 8);
+    }
+    else {
+      // Clear any value from when this IBLT was used before.
+      counts_[i] = 0;
+      keySums_[i] = 0;
+      keyChecks_[i] = 0;
     }
   }
+
+  encoding_ = Blob();
 }
 
 bool
 InvertibleBloomLookupTable::listEntries
   (set<uint32_t>& positive, set<uint32_t>& negative) const
 {
-  positive.clear();
-  negative.clear();
-
   // Make a deep copy.
   InvertibleBloomLookupTable peeled(*this);
+  return peeled.peel(positive, negative);
+}
+
+bool
+InvertibleBloomLookupTable::peel
+  (set<uint32_t>& positive, set<uint32_t>& negative)
+{
+  positive.clear();
+  negative.clear();
 
   size_t nErased = 0;
   do {
     nErased = 0;
-    for (vector<HashTableEntry>::const_iterator entry = peeled.hashTable_.begin();
-         entry != peeled.hashTable_.end(); ++entry) {
-      if (entry->isPure()) {
-        if (entry->count_ == 1)
-          positive.insert(entry->keySum_);
+    for (size_t i = 0; i < counts_.size(); ++i) {
+      if (isPure(i)) {
+        int32_t count = counts_[i];
+        uint32_t keySum = keySums_[i];
+        if (count == 1)
+          positive.insert(keySum);
         else
-          negative.insert(entry->keySum_);
+          negative.insert(keySum);
 
-        peeled.update(-entry->count_, entry->keySum_);
+        update(-count, keySum);
         ++nErased;
       }
     }
@@ -118,9 +162,8 @@ InvertibleBloomLookupTable::listEntries
 
   // If any buckets for one of the hash functions is not empty, then we didn't
   // peel them all.
-  for (vector<HashTableEntry>::const_iterator entry = peeled.hashTable_.begin();
-       entry != peeled.hashTable_.end(); ++entry) {
-    if (!entry->isEmpty())
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    if (!isEmpty(i))
       return false;
   }
 
@@ -131,110 +174,89 @@ ptr_lib::shared_ptr<InvertibleBloomLookupTable>
 InvertibleBloomLookupTable::difference
   (const InvertibleBloomLookupTable& other) const
 {
-  if (hashTable_.size() != other.hashTable_.size())
-    throw runtime_error("IBLT difference: Both tables must be the same size");
-
   ptr_lib::shared_ptr<InvertibleBloomLookupTable> result =
     ptr_lib::make_shared<InvertibleBloomLookupTable>(*this);
-  for (size_t i = 0; i < hashTable_.size(); i++) {
-    HashTableEntry& e1 = result->hashTable_.at(i);
-    const HashTableEntry& e2 = other.hashTable_.at(i);
-    e1.count_ -= e2.count_;
-    e1.keySum_ ^= e2.keySum_;
-    e1.keyCheck_ ^= e2.keyCheck_;
-  }
+  result->subtract(other);
 
   return result;
 }
 
+void
+InvertibleBloomLookupTable::subtract(const InvertibleBloomLookupTable& other)
+{
+  size_t nEntries = counts_.size();
+  if (nEntries != other.counts_.size())
+    throw runtime_error("IBLT difference: Both tables must be the same size");
+  if (nEntries == 0)
+    return;
+
+  // Use separate loops over plain arrays so that each one can be vectorized.
+  int32_t* counts = &counts_[0];
+  const int32_t* otherCounts = &other.counts_[0];
+  for (size_t i = 0; i < nEntries; ++i)
+    counts[i] -= otherCounts[i];
+
+  uint32_t* keySums = &keySums_[0];
+  const uint32_t* otherKeySums = &other.keySums_[0];
+  for (size_t i = 0; i < nEntries; ++i)
+    keySums[i] ^= otherKeySums[i];
+
+  uint32_t* keyChecks = &keyChecks_[0];
+  const uint32_t* otherKeyChecks = &other.keyChecks_[0];
+  for (size_t i = 0; i < nEntries; ++i)
+    keyChecks[i] ^= otherKeyChecks[i];
+
+  encoding_ = Blob();
+}
+
 Blob
 InvertibleBloomLookupTable::encode() const
 {
-  size_t nEntries = hashTable_.size();
+  if (!encoding_.isNull())
+    return encoding_;
+
+  size_t nEntries = counts_.size();
   size_t unitSize = (32 * 3) / 8; // hard coding
   size_t tableSize = unitSize * nEntries;
 
   vector<uint8_t> table(tableSize);
 
   for (size_t i = 0; i < nEntries; i++) {
-    const HashTableEntry& entry = hashTable_[i];
-
-    // table[i*12],   table[i*12+1], table[i*12+2], table[i*12+3] --> hashTable[i].count_
-
-    table[(i * unitSize)]   = 0xFF & entry.count_;
-    table[(i * unitSize) + 1] = 0xFF & (entry.count_ >> 8);
-    table[(i * unitSize) + 2] = 0xFF & (entry.count_ >> 16);
-    table[(i * unitSize) + 3] = 0xFF & (entry.count_ >> 24);
-
-    // table[i*12+4], table[i*12+5], table[i*12+6], table[i*12+7] --> hashTable[i].keySum_
-
-    table[(i * unitSize) + 4] = 0xFF & entry.keySum_;
-    table[(i * unitSize) + 5] = 0xFF & (entry.keySum_ >> 8);
-    table[(i * unitSize) + 6] = 0xFF & (entry.keySum_ >> 16);
-    table[(i * unitSize) + 7] = 0xFF & (entry.keySum_ >> 24);
-
-    // table[i*12+8], table[i*12+9], table[i*12+10], table[i*12+11] --> hashTable[i].keyCheck_
-
-    table[(i * unitSize) + 8] = 0xFF & entry.keyCheck_;
-    table[(i * unitSize) + 9] = 0xFF & (entry.keyCheck_ >> 8);
-    table[(i * unitSize) + 10] = 0xFF & (entry.keyCheck_ >> 16);
-    table[(i * unitSize) + 11] = 0xFF & (entry.keyCheck_ >> 24);
+    // table[i*12],   table[i*12+1], table[i*12+2], table[i*12+3] --> counts_[i]
+    putUint32(counts_[i], &table[i * unitSize]);
+    // table[i*12+4], table[i*12+5], table[i*12+6], table[i*12+7] --> keySums_[i]
+    putUint32(keySums_[i], &table[(i * unitSize) + 4]);
+    // table[i*12+8], table[i*12+9], table[i*12+10], table[i*12+11] --> keyChecks_[i]
+    putUint32(keyChecks_[i], &table[(i * unitSize) + 8]);
   }
 
-  return zlibCompress(table.data(), table.size());
+  encoding_ = zlibCompress(table.data(), table.size());
+  return encoding_;
 }
 
 bool
 InvertibleBloomLookupTable::equals(const InvertibleBloomLookupTable& other) const
 {
-  const vector<HashTableEntry>& iblt1HashTable = hashTable_;
-  const vector<HashTableEntry>& iblt2HashTable = other.hashTable_;
-  if (iblt1HashTable.size() != iblt2HashTable.size())
-    return false;
-
-  for (size_t i = 0; i < iblt1HashTable.size(); i++) {
-    if (iblt1HashTable[i].count_ != iblt2HashTable[i].count_ ||
-        iblt1HashTable[i].keySum_ != iblt2HashTable[i].keySum_ ||
-        iblt1HashTable[i].keyCheck_ != iblt2HashTable[i].keyCheck_)
-      return false;
-  }
-
-  return true;
+  return counts_ == other.counts_ && keySums_ == other.keySums_ &&
+         keyChecks_ == other.keyChecks_;
 }
 
 void
 InvertibleBloomLookupTable::update(int plusOrMinus, uint32_t key)
 {
-  size_t bucketsPerHash = hashTable_.size() / N_HASH;
+  size_t bucketsPerHash = counts_.size() / N_HASH;
+  uint32_t keyCheck = CryptoLite::murmurHash3(N_HASHCHECK, key);
 
   for (size_t i = 0; i < N_HASH; i++) {
     size_t startEntry = i * bucketsPerHash;
     uint32_t h = CryptoLite::murmurHash3(i, key);
-    HashTableEntry& entry = hashTable_.at(startEntry + (h % bucketsPerHash));
-    entry.count_ += plusOrMinus;
-    entry.keySum_ ^= key;
-    entry.keyCheck_ ^= CryptoLite::murmurHash3(N_HASHCHECK, key);
-  }
-}
-
-vector<uint32_t>
-InvertibleBloomLookupTable::decode(const Blob& encoding)
-{
-  Blob ibltValues = zlibDecompress(encoding.buf(), encoding.size());
-
-  size_t nEntries = ibltValues.size() / 4;
-  vector<uint32_t> values(nEntries, 0);
-
-  const uint8_t* ibltValuesBuf = ibltValues.buf();
-  for (size_t i = 0; i < 4 * nEntries; i += 4) {
-    uint32_t t = (ibltValuesBuf[i + 3] << 24) +
-                 (ibltValuesBuf[i + 2] << 16) +
-                 (ibltValuesBuf[i + 1] << 8)  +
-                 ibltValuesBuf[i];
-    values[i / 4] = t;
+    size_t iEntry = startEntry + (h % bucketsPerHash);
+    counts_[iEntry] += plusOrMinus;
+    keySums_[iEntry] ^= key;
+    keyChecks_[iEntry] ^= keyCheck;
   }
 
-  return values;
+  encoding_ = Blob();
 }
 
 Blob
@@ -317,11 +339,12 @@ InvertibleBloomLookupTable::zlibDecompress(const uint8_t* data, size_t dataLengt
 }
 
 bool
-InvertibleBloomLookupTable::HashTableEntry::isPure() const
+InvertibleBloomLookupTable::isPure(size_t i) const
 {
-  if (count_ == 1 || count_ == -1) {
-    uint32_t check = CryptoLite::murmurHash3(N_HASHCHECK, keySum_);
-    return keyCheck_ == check;
+  int32_t count = counts_[i];
+  if (count == 1 || count == -1) {
+    uint32_t check = CryptoLite::murmurHash3(N_HASHCHECK, keySums_[i]);
+    return keyChecks_[i] == check;
   }
 
   return false;
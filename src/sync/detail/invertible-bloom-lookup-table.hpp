@@ -53,6 +53,7 @@
 #if NDN_CPP_HAVE_LIBZ
 
 #include <set>
+#include <vector>
 #include <ndn-cpp/util/blob.hpp>
 
 namespace ndn {
@@ -89,6 +90,8 @@ public:
    * This is called on a difference of two IBLTs: ownIBLT - receivedIBLT.
    * Entries listed in positive are in ownIBLT but not in receivedIBLT.
    * Entries listed in negative are in receivedIBLT but not in ownIBLT.
+   * This makes a copy of the IBLT to peel. To avoid the copy when the IBLT is
+   * no longer needed, use peel().
    * @param positive Add positive entries to this set. This first clears the set.
    * @param negative Add negative entries to this set. This first clears the set.
    * @return True if decoding is completed successfully.
@@ -96,6 +99,17 @@ public:
   bool
   listEntries(std::set<uint32_t>& positive, std::set<uint32_t>& negative) const;
 
+  /**
+   * List all the entries in the IBLT the same as listEntries, but peel the
+   * entries from this IBLT in place instead of from a copy. After this
+   * returns, this IBLT only has the entries that could not be peeled.
+   * @param positive Add positive entries to this set. This first clears the set.
+   * @param negative Add negative entries to this set. This first clears the set.
+   * @return True if decoding is completed successfully.
+   */
+  bool
+  peel(std::set<uint32_t>& positive, std::set<uint32_t>& negative);
+
   /**
    * Get a new IBLT which is the difference of the other IBLT from this IBLT.
    * @param other The other IBLT.
@@ -104,12 +118,24 @@ public:
   ptr_lib::shared_ptr<InvertibleBloomLookupTable>
   difference(const InvertibleBloomLookupTable& other) const;
 
+  /**
+   * Subtract the other IBLT from this IBLT in place, so that this IBLT
+   * becomes this - other. To compute a difference into a reused IBLT without
+   * allocating, assign the first IBLT to it and call subtract.
+   * @param other The other IBLT.
+   * @throws runtime_error if the other IBLT is not the same size.
+   */
+  void
+  subtract(const InvertibleBloomLookupTable& other);
+
   /**
    * Encode this IBLT to a Blob. This encodes this hash table from a uint32_t
    * array to a uint8_t array. We create a uin8_t array 12 times the size of
    * the uint32_t array. We put the first count in the first 4 cells, keySum in
    * the next 4, and keyCheck in the next 4. We repeat for all the other cells
    * of the hash table. Then we append this uint8_t array to the name.
+   * This caches the encoding until the next change to this IBLT, so that
+   * repeated calls do not compress the table again.
    * @return The encoded Blob.
    */
   Blob
@@ -134,47 +160,36 @@ public:
   static const size_t N_HASHCHECK = 11;
 
 private:
-  class HashTableEntry
-  {
-  public:
-    int32_t count_;
-    uint32_t keySum_;
-    uint32_t keyCheck_;
-
-    bool
-    isPure() const;
+  bool
+  isPure(size_t i) const;
 
-    bool
-    isEmpty() const
-    {
-      return count_ == 0 && keySum_ == 0 && keyCheck_ == 0;
-    }
-  };
+  bool
+  isEmpty(size_t i) const
+  {
+    return counts_[i] == 0 && keySums_[i] == 0 && keyChecks_[i] == 0;
+  }
 
   /**
-   * Update the entries in hashTable_.
+   * Update the entries in the hash table.
    * @param plusOrMinus The amount to update the count.
    * @param key The key for computing the entry.
    */
   void
   update(int plusOrMinus, uint32_t key);
 
-  /**
-   * Decode the IBLT from the Blob. This converts the Blob into a uint8_t array
-   * which is then decoded to a uint32_t array.
-   * @param encoding The encoded IBLT.
-   * @return A uint32_t array representing the hash table of the IBLT.
-   */
-  static std::vector<uint32_t>
-  decode(const Blob& encoding);
-
   static Blob
   zlibCompress(const uint8_t* data, size_t dataLength);
 
   static Blob
   zlibDecompress(const uint8_t* data, size_t dataLength);
 
-  std::vector<HashTableEntry> hashTable_;
+  // The hash table is kept as parallel arrays so that subtract can process
+  // each field in a simple loop which the compiler can vectorize.
+  std::vector<int32_t> counts_;
+  std::vector<uint32_t> keySums_;
+  std::vector<uint32_t> keyChecks_;
+  // The cached result of encode(), or null if the hash table has changed.
+  mutable Blob encoding_;
 
   static const int INSERT = 1;
   static const int ERASE = -1;
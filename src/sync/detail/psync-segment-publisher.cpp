@@ -20,6 +20,7 @@
  * A copy of the GNU Lesser General Public License is in the file COPYING.
  */
 
+#include <ndn-cpp/util/segment-publisher.hpp>
 #include "psync-segment-publisher.hpp"
 
 using namespace std;
@@ -35,53 +36,33 @@ PSyncSegmentPublisher::publish
   if (interestName[-1].isSegment())
     interestSegment = interestName[-1].toSegment();
 
-  const uint8_t* rawBuffer = content.buf();
-  const uint8_t* segmentBegin = rawBuffer;
-  const uint8_t* end = rawBuffer + content.size();
+  // Make all the segments first so that SegmentPublisher can sign them in
+  // parallel.
+  vector<ptr_lib::shared_ptr<Data> > segments;
+  SegmentPublisher publisher
+    (keyChain_, signingInfo, SegmentPublisher::Options()
+     .setSegmentSize(MAX_NDN_PACKET_SIZE / 2)
+     .setFreshnessPeriod(freshnessPeriod));
+  publisher.publish(dataName, content, segments);
 
-  size_t maxPacketSize = MAX_NDN_PACKET_SIZE / 2;
-
-  uint64_t totalSegments = content.size() / maxPacketSize;
-  Name::Component finalBlockId = Name::Component::fromSegment(totalSegments);
-
-  Name segmentPrefix(dataName);
-  segmentPrefix.appendVersion((uint64_t)ndn_getNowMilliseconds());
-
-  uint64_t segmentNo = 0;
-  do {
-    const uint8_t* segmentEnd = segmentBegin + maxPacketSize;
-    if (segmentEnd > end)
-      segmentEnd = end;
-
-    Name segmentName(segmentPrefix);
-    segmentName.appendSegment(segmentNo);
-
-    ptr_lib::shared_ptr<Data> data = ptr_lib::make_shared<Data>(segmentName);
-    data->setContent(Blob(segmentBegin, segmentEnd - segmentBegin));
-    data->getMetaInfo().setFreshnessPeriod(freshnessPeriod);
-    data->getMetaInfo().setFinalBlockId(finalBlockId);
-
-    segmentBegin = segmentEnd;
-
-    keyChain_.sign(*data, signingInfo);
+  for (uint64_t segmentNo = 0; segmentNo < segments.size(); ++segmentNo) {
+    const Data& data = *segments[segmentNo];
 
     // Only send the segment to the Face if it has a pending interest.
     // Otherwise, the segment is unsolicited.
     if (interestSegment == segmentNo)
-      face_.putData(*data);
+      face_.putData(data);
 
 #if 0 // Until InMemoryStorageFifo implements an eviction policy, use InMemoryStorageRetaining.
-    storage_.insert(*data, freshnessPeriod);
+    storage_.insert(data, freshnessPeriod);
 #else
-    storage_.insert(*data);
+    storage_.insert(data);
 #endif
 
     face_.callLater
       (freshnessPeriod,
-       bind(&InMemoryStorageRetaining::remove, &storage_, segmentName));
-
-    ++segmentNo;
-  } while (segmentBegin < end);
+       bind(&InMemoryStorageRetaining::remove, &storage_, data.getName()));
+  }
 }
 
 bool
@@ -43,7 +43,7 @@ PSyncUserPrefixes::addUserNode(const Name& prefix)
 void
 PSyncUserPrefixes::removeUserNode(const Name& prefix)
 {
-  map<Name, int>::iterator entry = prefixes_.find(prefix);
+  PrefixMap::iterator entry = prefixes_.find(prefix);
   if (entry != prefixes_.end())
     prefixes_.erase(entry);
 }
@@ -55,7 +55,7 @@ PSyncUserPrefixes::updateSequenceNo
   oldSequenceNo = 0;
   _LOG_DEBUG("updateSequenceNo: " << prefix << " " << sequenceNo);
 
-  map<Name, int>::iterator entry = prefixes_.find(prefix);
+  PrefixMap::iterator entry = prefixes_.find(prefix);
   if (entry != prefixes_.end())
     oldSequenceNo = entry->second;
   else {
@@ -25,6 +25,9 @@
 
 #include <map>
 #include <ndn-cpp/name.hpp>
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+#include <unordered_map>
+#endif
 
 namespace ndn {
 
@@ -34,6 +37,12 @@ namespace ndn {
  */
 class PSyncUserPrefixes {
 public:
+#if NDN_CPP_HAVE_STD_UNORDERED_MAP
+  typedef std::unordered_map<Name, int, Name::Hash> PrefixMap;
+#else
+  typedef std::map<Name, int> PrefixMap;
+#endif
+
   /**
    * Check if the prefix is in prefixes_.
    *
@@ -54,7 +63,7 @@ public:
   int
   getSequenceNo(const Name& prefix) const
   {
-    std::map<Name, int>::const_iterator entry = prefixes_.find(prefix);
+    PrefixMap::const_iterator entry = prefixes_.find(prefix);
     if (entry == prefixes_.end())
       return -1;
 
@@ -103,7 +112,7 @@ public:
   updateSequenceNo(const Name& prefix, int sequenceNo, int& oldSequenceNo);
 
   // The key is the prefix Name. The value is the sequence number for the prefix.
-  std::map<Name, int> prefixes_;
+  PrefixMap prefixes_;
 };
 
 }
@@ -50,7 +50,8 @@ FullPSync2017::Impl::Impl
   face_(face), keyChain_(keyChain), syncInterestLifetime_(syncInterestLifetime),
   signingInfo_(signingInfo), onNamesUpdate_(onNamesUpdate),
   canAddToSyncData_(canAddToSyncData), canAddReceivedName_(canAddReceivedName),
-  segmentPublisher_(new PSyncSegmentPublisher(face_, keyChain_))
+  segmentPublisher_(new PSyncSegmentPublisher(face_, keyChain_)),
+  differenceIblt_(new InvertibleBloomLookupTable(expectedNEntries))
 {
 }
 
@@ -118,11 +119,14 @@ FullPSync2017::Impl::sendSyncInterest()
   syncInterest->setNonce(Blob((const uint8_t*)"0000", 4));
   syncInterest->refreshNonce();
 
+  // A sync Interest is only answered when there is new data, so don't keep
+  // retransmitting after its lifetime.
   SegmentFetcher::fetch
     (face_, *syncInterest, 0,
      bind(&FullPSync2017::Impl::onSyncData,
           static_pointer_cast<FullPSync2017::Impl>(shared_from_this()), _1, syncInterest),
-     &FullPSync2017::Impl::onError);
+     &FullPSync2017::Impl::onError,
+     SegmentFetcher::Options().setMaxTimeout(syncInterestLifetime_));
 
   _LOG_DEBUG("sendFullSyncInterest, nonce: " << syncInterest->getNonce().toHex() <<
              ", hash: " << syncInterestName.hash());
@@ -163,22 +167,18 @@ FullPSync2017::Impl::onSyncInterest
   _LOG_DEBUG("Full Sync Interest received, nonce: " << interest->getNonce().toHex() <<
              ", hash:" << interestName.hash());
 
-  ptr_lib::shared_ptr<InvertibleBloomLookupTable> iblt
-    (new InvertibleBloomLookupTable(expectedNEntries_));
+  ptr_lib::shared_ptr<InvertibleBloomLookupTable> iblt;
   try {
-    iblt->initialize(ibltName.getValue());
+    iblt = getPeerIblt(ibltName);
   } catch (const std::exception& ex) {
     _LOG_ERROR(ex.what());
     return;
   }
 
-  ptr_lib::shared_ptr<InvertibleBloomLookupTable> difference =
-   iblt_->difference(*iblt);
-
   set<uint32_t> positive;
   set<uint32_t> negative;
 
-  if (!difference->listEntries(positive, negative)) {
+  if (!computeDifference(*iblt).peel(positive, negative)) {
     _LOG_TRACE("Cannot decode differences, positive: " << positive.size() <<
             " negative: " << negative.size() << " threshold: " <<
             threshold_);
@@ -189,7 +189,7 @@ FullPSync2017::Impl::onSyncInterest
     if (positive.size() + negative.size() >= threshold_ ||
         (positive.size() == 0 && negative.size() == 0)) {
       PSyncState state1;
-      for (map<Name, uint32_t>::iterator entry = nameToHash_.begin();
+      for (NameToHash::iterator entry = nameToHash_.begin();
            entry != nameToHash_.end(); ++entry)
         state1.addContent(entry->first);
 
@@ -228,6 +228,43 @@ FullPSync2017::Impl::onSyncInterest
           interest->getName(), entry, interest->getNonce()));
 }
 
+ptr_lib::shared_ptr<InvertibleBloomLookupTable>
+FullPSync2017::Impl::getPeerIblt(const Name::Component& ibltName)
+{
+  uint8_t digest[ndn_SHA256_DIGEST_SIZE];
+  CryptoLite::digestSha256(ibltName.getValue(), digest);
+  string key((const char*)digest, sizeof(digest));
+
+  map<string, ptr_lib::shared_ptr<InvertibleBloomLookupTable> >::iterator
+    found = peerIblts_.find(key);
+  if (found != peerIblts_.end())
+    return found->second;
+
+  ptr_lib::shared_ptr<InvertibleBloomLookupTable> iblt
+    (new InvertibleBloomLookupTable(expectedNEntries_));
+  // This throws an exception if the IBLT can't be decoded, so we don't cache it.
+  iblt->initialize(ibltName.getValue());
+
+  if (peerIbltKeys_.size() >= MAX_PEER_IBLTS) {
+    // Remove the oldest. A pending entry may still hold it in a shared_ptr.
+    peerIblts_.erase(peerIbltKeys_.front());
+    peerIbltKeys_.pop_front();
+  }
+  peerIblts_[key] = iblt;
+  peerIbltKeys_.push_back(key);
+
+  return iblt;
+}
+
+InvertibleBloomLookupTable&
+FullPSync2017::Impl::computeDifference(const InvertibleBloomLookupTable& other)
+{
+  // The assignment copies into the existing arrays without allocating.
+  *differenceIblt_ = *iblt_;
+  differenceIblt_->subtract(other);
+  return *differenceIblt_;
+}
+
 void
 FullPSync2017::Impl::sendSyncData(const Name& name, Blob content)
 {
@@ -278,13 +315,10 @@ FullPSync2017::Impl::satisfyPendingInterests()
   for (map<Name, ptr_lib::shared_ptr<PendingEntryInfoFull> >::iterator it =
          pendingEntries_.begin();
        it != pendingEntries_.end();) {
-    const InvertibleBloomLookupTable& entryIblt = *it->second->iblt_;
-    ptr_lib::shared_ptr<InvertibleBloomLookupTable> difference =
-            iblt_->difference(entryIblt);
     set<uint32_t> positive;
     set<uint32_t> negative;
 
-    if (!difference->listEntries(positive, negative)) {
+    if (!computeDifference(*it->second->iblt_).peel(positive, negative)) {
       _LOG_TRACE("Decode failed for pending interest");
       if (positive.size() + negative.size() >= threshold_ ||
           (positive.size() == 0 && negative.size() == 0)) {
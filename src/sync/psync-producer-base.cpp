@@ -60,7 +60,7 @@ PSyncProducerBase::insertIntoIblt(const Name& name)
 void
 PSyncProducerBase::removeFromIblt(const Name& name)
 {
-  map<Name, uint32_t>::iterator hashEntry = nameToHash_.find(name);
+  NameToHash::iterator hashEntry = nameToHash_.find(name);
   if (hashEntry != nameToHash_.end()) {
     uint32_t hash = hashEntry->second;
     nameToHash_.erase(hashEntry);
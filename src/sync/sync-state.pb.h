@@ -0,0 +1,1084 @@
+// Generated by the protocol buffer compiler.  DO NOT EDIT!
+// source: sync-state.proto
+
+#ifndef GOOGLE_PROTOBUF_INCLUDED_sync_2dstate_2eproto
+#define GOOGLE_PROTOBUF_INCLUDED_sync_2dstate_2eproto
+
+#include <limits>
+#include <string>
+
+#include <google/protobuf/port_def.inc>
+#if PROTOBUF_VERSION < 3021000
+#error This file was generated by a newer version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please update
+#error your headers.
+#endif
+#if 3021012 < PROTOBUF_MIN_PROTOC_VERSION
+#error This file was generated by an older version of protoc which is
+#error incompatible with your Protocol Buffer headers. Please
+#error regenerate this file with a newer version of protoc.
+#endif
+
+#include <google/protobuf/port_undef.inc>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/arenastring.h>
+#include <google/protobuf/generated_message_util.h>
+#include <google/protobuf/metadata_lite.h>
+#include <google/protobuf/generated_message_reflection.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/repeated_field.h>  // IWYU pragma: export
+#include <google/protobuf/extension_set.h>  // IWYU pragma: export
+#include <google/protobuf/generated_enum_reflection.h>
+#include <google/protobuf/unknown_field_set.h>
+// @@protoc_insertion_point(includes)
+#include <google/protobuf/port_def.inc>
+#define PROTOBUF_INTERNAL_EXPORT_sync_2dstate_2eproto
+PROTOBUF_NAMESPACE_OPEN
+namespace internal {
+class AnyMetadata;
+}  // namespace internal
+PROTOBUF_NAMESPACE_CLOSE
+
+// Internal implementation detail -- do not use these members.
+struct TableStruct_sync_2dstate_2eproto {
+  static const uint32_t offsets[];
+};
+extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_sync_2dstate_2eproto;
+namespace Sync {
+class SyncState;
+struct SyncStateDefaultTypeInternal;
+extern SyncStateDefaultTypeInternal _SyncState_default_instance_;
+class SyncStateMsg;
+struct SyncStateMsgDefaultTypeInternal;
+extern SyncStateMsgDefaultTypeInternal _SyncStateMsg_default_instance_;
+class SyncState_SeqNo;
+struct SyncState_SeqNoDefaultTypeInternal;
+extern SyncState_SeqNoDefaultTypeInternal _SyncState_SeqNo_default_instance_;
+}  // namespace Sync
+PROTOBUF_NAMESPACE_OPEN
+template<> ::Sync::SyncState* Arena::CreateMaybeMessage<::Sync::SyncState>(Arena*);
+template<> ::Sync::SyncStateMsg* Arena::CreateMaybeMessage<::Sync::SyncStateMsg>(Arena*);
+template<> ::Sync::SyncState_SeqNo* Arena::CreateMaybeMessage<::Sync::SyncState_SeqNo>(Arena*);
+PROTOBUF_NAMESPACE_CLOSE
+namespace Sync {
+
+enum SyncState_ActionType : int {
+  SyncState_ActionType_UPDATE = 0,
+  SyncState_ActionType_DELETE = 1,
+  SyncState_ActionType_OTHER = 2
+};
+bool SyncState_ActionType_IsValid(int value);
+constexpr SyncState_ActionType SyncState_ActionType_ActionType_MIN = SyncState_ActionType_UPDATE;
+constexpr SyncState_ActionType SyncState_ActionType_ActionType_MAX = SyncState_ActionType_OTHER;
+constexpr int SyncState_ActionType_ActionType_ARRAYSIZE = SyncState_ActionType_ActionType_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SyncState_ActionType_descriptor();
+template<typename T>
+inline const std::string& SyncState_ActionType_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, SyncState_ActionType>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function SyncState_ActionType_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    SyncState_ActionType_descriptor(), enum_t_value);
+}
+inline bool SyncState_ActionType_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, SyncState_ActionType* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<SyncState_ActionType>(
+    SyncState_ActionType_descriptor(), name, value);
+}
+// ===================================================================
+
+class SyncState_SeqNo final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:Sync.SyncState.SeqNo) */ {
+ public:
+  inline SyncState_SeqNo() : SyncState_SeqNo(nullptr) {}
+  ~SyncState_SeqNo() override;
+  explicit PROTOBUF_CONSTEXPR SyncState_SeqNo(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SyncState_SeqNo(const SyncState_SeqNo& from);
+  SyncState_SeqNo(SyncState_SeqNo&& from) noexcept
+    : SyncState_SeqNo() {
+    *this = ::std::move(from);
+  }
+
+  inline SyncState_SeqNo& operator=(const SyncState_SeqNo& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SyncState_SeqNo& operator=(SyncState_SeqNo&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SyncState_SeqNo& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SyncState_SeqNo* internal_default_instance() {
+    return reinterpret_cast<const SyncState_SeqNo*>(
+               &_SyncState_SeqNo_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    0;
+
+  friend void swap(SyncState_SeqNo& a, SyncState_SeqNo& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SyncState_SeqNo* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SyncState_SeqNo* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SyncState_SeqNo* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SyncState_SeqNo>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SyncState_SeqNo& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SyncState_SeqNo& from) {
+    SyncState_SeqNo::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SyncState_SeqNo* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "Sync.SyncState.SeqNo";
+  }
+  protected:
+  explicit SyncState_SeqNo(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kSeqFieldNumber = 1,
+    kSessionFieldNumber = 2,
+  };
+  // required uint64 seq = 1;
+  bool has_seq() const;
+  private:
+  bool _internal_has_seq() const;
+  public:
+  void clear_seq();
+  uint64_t seq() const;
+  void set_seq(uint64_t value);
+  private:
+  uint64_t _internal_seq() const;
+  void _internal_set_seq(uint64_t value);
+  public:
+
+  // required uint64 session = 2;
+  bool has_session() const;
+  private:
+  bool _internal_has_session() const;
+  public:
+  void clear_session();
+  uint64_t session() const;
+  void set_session(uint64_t value);
+  private:
+  uint64_t _internal_session() const;
+  void _internal_set_session(uint64_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:Sync.SyncState.SeqNo)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint64_t seq_;
+    uint64_t session_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_sync_2dstate_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SyncState final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:Sync.SyncState) */ {
+ public:
+  inline SyncState() : SyncState(nullptr) {}
+  ~SyncState() override;
+  explicit PROTOBUF_CONSTEXPR SyncState(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SyncState(const SyncState& from);
+  SyncState(SyncState&& from) noexcept
+    : SyncState() {
+    *this = ::std::move(from);
+  }
+
+  inline SyncState& operator=(const SyncState& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SyncState& operator=(SyncState&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SyncState& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SyncState* internal_default_instance() {
+    return reinterpret_cast<const SyncState*>(
+               &_SyncState_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    1;
+
+  friend void swap(SyncState& a, SyncState& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SyncState* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SyncState* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SyncState* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SyncState>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SyncState& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SyncState& from) {
+    SyncState::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SyncState* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "Sync.SyncState";
+  }
+  protected:
+  explicit SyncState(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  typedef SyncState_SeqNo SeqNo;
+
+  typedef SyncState_ActionType ActionType;
+  static constexpr ActionType UPDATE =
+    SyncState_ActionType_UPDATE;
+  static constexpr ActionType DELETE =
+    SyncState_ActionType_DELETE;
+  static constexpr ActionType OTHER =
+    SyncState_ActionType_OTHER;
+  static inline bool ActionType_IsValid(int value) {
+    return SyncState_ActionType_IsValid(value);
+  }
+  static constexpr ActionType ActionType_MIN =
+    SyncState_ActionType_ActionType_MIN;
+  static constexpr ActionType ActionType_MAX =
+    SyncState_ActionType_ActionType_MAX;
+  static constexpr int ActionType_ARRAYSIZE =
+    SyncState_ActionType_ActionType_ARRAYSIZE;
+  static inline const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor*
+  ActionType_descriptor() {
+    return SyncState_ActionType_descriptor();
+  }
+  template<typename T>
+  static inline const std::string& ActionType_Name(T enum_t_value) {
+    static_assert(::std::is_same<T, ActionType>::value ||
+      ::std::is_integral<T>::value,
+      "Incorrect type passed to function ActionType_Name.");
+    return SyncState_ActionType_Name(enum_t_value);
+  }
+  static inline bool ActionType_Parse(::PROTOBUF_NAMESPACE_ID::ConstStringParam name,
+      ActionType* value) {
+    return SyncState_ActionType_Parse(name, value);
+  }
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNameFieldNumber = 1,
+    kApplicationInfoFieldNumber = 4,
+    kSeqnoFieldNumber = 3,
+    kTypeFieldNumber = 2,
+  };
+  // required string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional bytes application_info = 4;
+  bool has_application_info() const;
+  private:
+  bool _internal_has_application_info() const;
+  public:
+  void clear_application_info();
+  const std::string& application_info() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_application_info(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_application_info();
+  PROTOBUF_NODISCARD std::string* release_application_info();
+  void set_allocated_application_info(std::string* application_info);
+  private:
+  const std::string& _internal_application_info() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_application_info(const std::string& value);
+  std::string* _internal_mutable_application_info();
+  public:
+
+  // optional .Sync.SyncState.SeqNo seqno = 3;
+  bool has_seqno() const;
+  private:
+  bool _internal_has_seqno() const;
+  public:
+  void clear_seqno();
+  const ::Sync::SyncState_SeqNo& seqno() const;
+  PROTOBUF_NODISCARD ::Sync::SyncState_SeqNo* release_seqno();
+  ::Sync::SyncState_SeqNo* mutable_seqno();
+  void set_allocated_seqno(::Sync::SyncState_SeqNo* seqno);
+  private:
+  const ::Sync::SyncState_SeqNo& _internal_seqno() const;
+  ::Sync::SyncState_SeqNo* _internal_mutable_seqno();
+  public:
+  void unsafe_arena_set_allocated_seqno(
+      ::Sync::SyncState_SeqNo* seqno);
+  ::Sync::SyncState_SeqNo* unsafe_arena_release_seqno();
+
+  // required .Sync.SyncState.ActionType type = 2;
+  bool has_type() const;
+  private:
+  bool _internal_has_type() const;
+  public:
+  void clear_type();
+  ::Sync::SyncState_ActionType type() const;
+  void set_type(::Sync::SyncState_ActionType value);
+  private:
+  ::Sync::SyncState_ActionType _internal_type() const;
+  void _internal_set_type(::Sync::SyncState_ActionType value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:Sync.SyncState)
+ private:
+  class _Internal;
+
+  // helper for ByteSizeLong()
+  size_t RequiredFieldsByteSizeFallback() const;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr application_info_;
+    ::Sync::SyncState_SeqNo* seqno_;
+    int type_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_sync_2dstate_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SyncStateMsg final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:Sync.SyncStateMsg) */ {
+ public:
+  inline SyncStateMsg() : SyncStateMsg(nullptr) {}
+  ~SyncStateMsg() override;
+  explicit PROTOBUF_CONSTEXPR SyncStateMsg(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SyncStateMsg(const SyncStateMsg& from);
+  SyncStateMsg(SyncStateMsg&& from) noexcept
+    : SyncStateMsg() {
+    *this = ::std::move(from);
+  }
+
+  inline SyncStateMsg& operator=(const SyncStateMsg& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SyncStateMsg& operator=(SyncStateMsg&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet& unknown_fields() const {
+    return _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance);
+  }
+  inline ::PROTOBUF_NAMESPACE_ID::UnknownFieldSet* mutable_unknown_fields() {
+    return _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SyncStateMsg& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SyncStateMsg* internal_default_instance() {
+    return reinterpret_cast<const SyncStateMsg*>(
+               &_SyncStateMsg_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    2;
+
+  friend void swap(SyncStateMsg& a, SyncStateMsg& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SyncStateMsg* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SyncStateMsg* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SyncStateMsg* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SyncStateMsg>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SyncStateMsg& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SyncStateMsg& from) {
+    SyncStateMsg::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SyncStateMsg* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "Sync.SyncStateMsg";
+  }
+  protected:
+  explicit SyncStateMsg(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kSsFieldNumber = 1,
+  };
+  // repeated .Sync.SyncState ss = 1;
+  int ss_size() const;
+  private:
+  int _internal_ss_size() const;
+  public:
+  void clear_ss();
+  ::Sync::SyncState* mutable_ss(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Sync::SyncState >*
+      mutable_ss();
+  private:
+  const ::Sync::SyncState& _internal_ss(int index) const;
+  ::Sync::SyncState* _internal_add_ss();
+  public:
+  const ::Sync::SyncState& ss(int index) const;
+  ::Sync::SyncState* add_ss();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Sync::SyncState >&
+      ss() const;
+
+  // @@protoc_insertion_point(class_scope:Sync.SyncStateMsg)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Sync::SyncState > ss_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_sync_2dstate_2eproto;
+};
+// ===================================================================
+
+
+// ===================================================================
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wstrict-aliasing"
+#endif  // __GNUC__
+// SyncState_SeqNo
+
+// required uint64 seq = 1;
+inline bool SyncState_SeqNo::_internal_has_seq() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool SyncState_SeqNo::has_seq() const {
+  return _internal_has_seq();
+}
+inline void SyncState_SeqNo::clear_seq() {
+  _impl_.seq_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint64_t SyncState_SeqNo::_internal_seq() const {
+  return _impl_.seq_;
+}
+inline uint64_t SyncState_SeqNo::seq() const {
+  // @@protoc_insertion_point(field_get:Sync.SyncState.SeqNo.seq)
+  return _internal_seq();
+}
+inline void SyncState_SeqNo::_internal_set_seq(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.seq_ = value;
+}
+inline void SyncState_SeqNo::set_seq(uint64_t value) {
+  _internal_set_seq(value);
+  // @@protoc_insertion_point(field_set:Sync.SyncState.SeqNo.seq)
+}
+
+// required uint64 session = 2;
+inline bool SyncState_SeqNo::_internal_has_session() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool SyncState_SeqNo::has_session() const {
+  return _internal_has_session();
+}
+inline void SyncState_SeqNo::clear_session() {
+  _impl_.session_ = uint64_t{0u};
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline uint64_t SyncState_SeqNo::_internal_session() const {
+  return _impl_.session_;
+}
+inline uint64_t SyncState_SeqNo::session() const {
+  // @@protoc_insertion_point(field_get:Sync.SyncState.SeqNo.session)
+  return _internal_session();
+}
+inline void SyncState_SeqNo::_internal_set_session(uint64_t value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.session_ = value;
+}
+inline void SyncState_SeqNo::set_session(uint64_t value) {
+  _internal_set_session(value);
+  // @@protoc_insertion_point(field_set:Sync.SyncState.SeqNo.session)
+}
+
+// -------------------------------------------------------------------
+
+// SyncState
+
+// required string name = 1;
+inline bool SyncState::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool SyncState::has_name() const {
+  return _internal_has_name();
+}
+inline void SyncState::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& SyncState::name() const {
+  // @@protoc_insertion_point(field_get:Sync.SyncState.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void SyncState::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:Sync.SyncState.name)
+}
+inline std::string* SyncState::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:Sync.SyncState.name)
+  return _s;
+}
+inline const std::string& SyncState::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void SyncState::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* SyncState::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* SyncState::release_name() {
+  // @@protoc_insertion_point(field_release:Sync.SyncState.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void SyncState::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:Sync.SyncState.name)
+}
+
+// required .Sync.SyncState.ActionType type = 2;
+inline bool SyncState::_internal_has_type() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  return value;
+}
+inline bool SyncState::has_type() const {
+  return _internal_has_type();
+}
+inline void SyncState::clear_type() {
+  _impl_.type_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000008u;
+}
+inline ::Sync::SyncState_ActionType SyncState::_internal_type() const {
+  return static_cast< ::Sync::SyncState_ActionType >(_impl_.type_);
+}
+inline ::Sync::SyncState_ActionType SyncState::type() const {
+  // @@protoc_insertion_point(field_get:Sync.SyncState.type)
+  return _internal_type();
+}
+inline void SyncState::_internal_set_type(::Sync::SyncState_ActionType value) {
+  assert(::Sync::SyncState_ActionType_IsValid(value));
+  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_.type_ = value;
+}
+inline void SyncState::set_type(::Sync::SyncState_ActionType value) {
+  _internal_set_type(value);
+  // @@protoc_insertion_point(field_set:Sync.SyncState.type)
+}
+
+// optional .Sync.SyncState.SeqNo seqno = 3;
+inline bool SyncState::_internal_has_seqno() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.seqno_ != nullptr);
+  return value;
+}
+inline bool SyncState::has_seqno() const {
+  return _internal_has_seqno();
+}
+inline void SyncState::clear_seqno() {
+  if (_impl_.seqno_ != nullptr) _impl_.seqno_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline const ::Sync::SyncState_SeqNo& SyncState::_internal_seqno() const {
+  const ::Sync::SyncState_SeqNo* p = _impl_.seqno_;
+  return p != nullptr ? *p : reinterpret_cast<const ::Sync::SyncState_SeqNo&>(
+      ::Sync::_SyncState_SeqNo_default_instance_);
+}
+inline const ::Sync::SyncState_SeqNo& SyncState::seqno() const {
+  // @@protoc_insertion_point(field_get:Sync.SyncState.seqno)
+  return _internal_seqno();
+}
+inline void SyncState::unsafe_arena_set_allocated_seqno(
+    ::Sync::SyncState_SeqNo* seqno) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.seqno_);
+  }
+  _impl_.seqno_ = seqno;
+  if (seqno) {
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:Sync.SyncState.seqno)
+}
+inline ::Sync::SyncState_SeqNo* SyncState::release_seqno() {
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  ::Sync::SyncState_SeqNo* temp = _impl_.seqno_;
+  _impl_.seqno_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::Sync::SyncState_SeqNo* SyncState::unsafe_arena_release_seqno() {
+  // @@protoc_insertion_point(field_release:Sync.SyncState.seqno)
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  ::Sync::SyncState_SeqNo* temp = _impl_.seqno_;
+  _impl_.seqno_ = nullptr;
+  return temp;
+}
+inline ::Sync::SyncState_SeqNo* SyncState::_internal_mutable_seqno() {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  if (_impl_.seqno_ == nullptr) {
+    auto* p = CreateMaybeMessage<::Sync::SyncState_SeqNo>(GetArenaForAllocation());
+    _impl_.seqno_ = p;
+  }
+  return _impl_.seqno_;
+}
+inline ::Sync::SyncState_SeqNo* SyncState::mutable_seqno() {
+  ::Sync::SyncState_SeqNo* _msg = _internal_mutable_seqno();
+  // @@protoc_insertion_point(field_mutable:Sync.SyncState.seqno)
+  return _msg;
+}
+inline void SyncState::set_allocated_seqno(::Sync::SyncState_SeqNo* seqno) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.seqno_;
+  }
+  if (seqno) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(seqno);
+    if (message_arena != submessage_arena) {
+      seqno = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, seqno, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  _impl_.seqno_ = seqno;
+  // @@protoc_insertion_point(field_set_allocated:Sync.SyncState.seqno)
+}
+
+// optional bytes application_info = 4;
+inline bool SyncState::_internal_has_application_info() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool SyncState::has_application_info() const {
+  return _internal_has_application_info();
+}
+inline void SyncState::clear_application_info() {
+  _impl_.application_info_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& SyncState::application_info() const {
+  // @@protoc_insertion_point(field_get:Sync.SyncState.application_info)
+  return _internal_application_info();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void SyncState::set_application_info(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.application_info_.SetBytes(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:Sync.SyncState.application_info)
+}
+inline std::string* SyncState::mutable_application_info() {
+  std::string* _s = _internal_mutable_application_info();
+  // @@protoc_insertion_point(field_mutable:Sync.SyncState.application_info)
+  return _s;
+}
+inline const std::string& SyncState::_internal_application_info() const {
+  return _impl_.application_info_.Get();
+}
+inline void SyncState::_internal_set_application_info(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.application_info_.Set(value, GetArenaForAllocation());
+}
+inline std::string* SyncState::_internal_mutable_application_info() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.application_info_.Mutable(GetArenaForAllocation());
+}
+inline std::string* SyncState::release_application_info() {
+  // @@protoc_insertion_point(field_release:Sync.SyncState.application_info)
+  if (!_internal_has_application_info()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.application_info_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.application_info_.IsDefault()) {
+    _impl_.application_info_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void SyncState::set_allocated_application_info(std::string* application_info) {
+  if (application_info != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.application_info_.SetAllocated(application_info, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.application_info_.IsDefault()) {
+    _impl_.application_info_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:Sync.SyncState.application_info)
+}
+
+// -------------------------------------------------------------------
+
+// SyncStateMsg
+
+// repeated .Sync.SyncState ss = 1;
+inline int SyncStateMsg::_internal_ss_size() const {
+  return _impl_.ss_.size();
+}
+inline int SyncStateMsg::ss_size() const {
+  return _internal_ss_size();
+}
+inline void SyncStateMsg::clear_ss() {
+  _impl_.ss_.Clear();
+}
+inline ::Sync::SyncState* SyncStateMsg::mutable_ss(int index) {
+  // @@protoc_insertion_point(field_mutable:Sync.SyncStateMsg.ss)
+  return _impl_.ss_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Sync::SyncState >*
+SyncStateMsg::mutable_ss() {
+  // @@protoc_insertion_point(field_mutable_list:Sync.SyncStateMsg.ss)
+  return &_impl_.ss_;
+}
+inline const ::Sync::SyncState& SyncStateMsg::_internal_ss(int index) const {
+  return _impl_.ss_.Get(index);
+}
+inline const ::Sync::SyncState& SyncStateMsg::ss(int index) const {
+  // @@protoc_insertion_point(field_get:Sync.SyncStateMsg.ss)
+  return _internal_ss(index);
+}
+inline ::Sync::SyncState* SyncStateMsg::_internal_add_ss() {
+  return _impl_.ss_.Add();
+}
+inline ::Sync::SyncState* SyncStateMsg::add_ss() {
+  ::Sync::SyncState* _add = _internal_add_ss();
+  // @@protoc_insertion_point(field_add:Sync.SyncStateMsg.ss)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::Sync::SyncState >&
+SyncStateMsg::ss() const {
+  // @@protoc_insertion_point(field_list:Sync.SyncStateMsg.ss)
+  return _impl_.ss_;
+}
+
+#ifdef __GNUC__
+  #pragma GCC diagnostic pop
+#endif  // __GNUC__
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+
+// @@protoc_insertion_point(namespace_scope)
+
+}  // namespace Sync
+
+PROTOBUF_NAMESPACE_OPEN
+
+template <> struct is_proto_enum< ::Sync::SyncState_ActionType> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::Sync::SyncState_ActionType>() {
+  return ::Sync::SyncState_ActionType_descriptor();
+}
+
+PROTOBUF_NAMESPACE_CLOSE
+
+// @@protoc_insertion_point(global_scope)
+
+#include <google/protobuf/port_undef.inc>
+#endif  // GOOGLE_PROTOBUF_INCLUDED_GOOGLE_PROTOBUF_INCLUDED_sync_2dstate_2eproto
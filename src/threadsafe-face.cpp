@@ -244,35 +244,71 @@ ThreadsafeFace::shutdown()
   ioService_.dispatch(boost::bind(&Node::shutdown, node_));
 }
 
-/**
- * After the delay, async_wait calls this to call the original caller's callback.
- * @param errorCode The error code from async_wait.
- * @param callback The original caller's callback.
- * @param timer This is not used, but passed in the function object to keep
- * the timer object alive until this is called.
- */
-static void
-waitHandler
-  (const boost::system::error_code& errorCode, const Face::Callback& callback,
-   ptr_lib::shared_ptr<boost::asio::deadline_timer> timer)
+uint64_t
+ThreadsafeFace::callLater
+  (Milliseconds delayMilliseconds, const Callback& callback)
 {
-  if (errorCode != boost::system::errc::success)
-    // Don't expect this to happen.
-    return;
+  // Node.lastEntryId_ uses atomic_uint64_t, so this call is thread safe.
+  uint64_t callLaterId = node_->getNextEntryId();
 
-  callback();
+  ioService_.dispatch
+    (boost::bind
+     (&ThreadsafeFace::callLaterHelper, this, callLaterId, delayMilliseconds,
+      callback));
+
+  return callLaterId;
 }
 
 void
-ThreadsafeFace::callLater
-  (Milliseconds delayMilliseconds, const Callback& callback)
+ThreadsafeFace::cancelCallLater(uint64_t callLaterId)
+{
+  ioService_.dispatch
+    (boost::bind(&ThreadsafeFace::cancelCallLaterHelper, this, callLaterId));
+}
+
+void
+ThreadsafeFace::callLaterHelper
+  (uint64_t callLaterId, Milliseconds delayMilliseconds,
+   const Callback& callback)
 {
   ptr_lib::shared_ptr<boost::asio::deadline_timer> timer
     (new boost::asio::deadline_timer
      (ioService_, boost::posix_time::milliseconds((uint64_t)delayMilliseconds)));
 
-  // Pass the timer to waitHandler to keep it alive.
-  timer->async_wait(boost::bind(&waitHandler, _1, callback, timer));
+  // timers_ keeps the timer alive until it expires or is cancelled.
+  timers_[callLaterId] = timer;
+  timer->async_wait(boost::bind
+    (&ThreadsafeFace::onTimerExpired, this, _1, callLaterId, callback));
+}
+
+void
+ThreadsafeFace::cancelCallLaterHelper(uint64_t callLaterId)
+{
+  map<uint64_t, ptr_lib::shared_ptr<boost::asio::deadline_timer> >::iterator
+    found = timers_.find(callLaterId);
+  if (found == timers_.end())
+    // Already called or cancelled.
+    return;
+
+  found->second->cancel();
+  timers_.erase(found);
+}
+
+void
+ThreadsafeFace::onTimerExpired
+  (const boost::system::error_code& errorCode, uint64_t callLaterId,
+   const Callback& callback)
+{
+  if (errorCode != boost::system::errc::success)
+    // The timer was cancelled, or this ThreadsafeFace was destroyed.
+    return;
+
+  // If the timer expired before it could be cancelled, then the call was
+  // already removed from timers_.
+  if (timers_.erase(callLaterId) == 0)
+    return;
+
+  callback();
 }
 
 }
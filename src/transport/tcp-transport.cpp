@@ -114,6 +114,12 @@ TcpTransport::getIsConnected()
   return isConnected_;
 }
 
+int
+TcpTransport::getSocketDescriptor()
+{
+  return transport_->base.socketDescriptor;
+}
+
 void
 TcpTransport::close()
 {
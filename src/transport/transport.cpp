@@ -68,6 +68,14 @@ Transport::getIsConnected()
   throw logic_error("unimplemented");
 }
 
+int
+Transport::getSocketDescriptor() { return -1; }
+
+void
+Transport::flush()
+{
+}
+
 void
 Transport::close()
 {
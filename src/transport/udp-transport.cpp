@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include "../c/transport/udp-transport.h"
 #include "../c/encoding/element-reader.h"
+#include "../c/util/ndn_memory.h"
 #include "../encoding/element-listener.hpp"
 #include "../util/dynamic-uint8-vector.hpp"
 #include <ndn-cpp/transport/udp-transport.hpp>
@@ -39,11 +40,23 @@ UdpTransport::ConnectionInfo::~ConnectionInfo()
 {
 }
 
-UdpTransport::UdpTransport()
+UdpTransport::UdpTransport(bool useBatchedIo)
   : isConnected_(false), transport_(new struct ndn_UdpTransport),
-    elementBuffer_(new DynamicUInt8Vector(1000))
+    elementBuffer_(new DynamicUInt8Vector(1000)), useBatchedIo_(useBatchedIo),
+    nQueuedDatagrams_(0)
 {
   ndn_UdpTransport_initialize(transport_.get(), elementBuffer_.get());
+
+  if (useBatchedIo_) {
+    receiveBuffer_.resize(MAX_BATCHED_DATAGRAMS * MAX_NDN_PACKET_SIZE);
+    receiveDatagramLengths_.resize(MAX_BATCHED_DATAGRAMS);
+    sendBuffer_.resize(MAX_BATCHED_DATAGRAMS * MAX_NDN_PACKET_SIZE);
+    sendDatagramLengths_.resize(MAX_BATCHED_DATAGRAMS);
+    for (size_t i = 0; i < MAX_BATCHED_DATAGRAMS; ++i) {
+      receiveDatagrams_.push_back(&receiveBuffer_[i * MAX_NDN_PACKET_SIZE]);
+      sendDatagrams_.push_back(&sendBuffer_[i * MAX_NDN_PACKET_SIZE]);
+    }
+  }
 }
 
 bool
@@ -77,6 +90,19 @@ UdpTransport::connect
 void
 UdpTransport::send(const uint8_t *data, size_t dataLength)
 {
+  if (useBatchedIo_ && dataLength <= MAX_NDN_PACKET_SIZE) {
+    if (nQueuedDatagrams_ >= MAX_BATCHED_DATAGRAMS)
+      flush();
+
+    ndn_memcpy(sendDatagrams_[nQueuedDatagrams_], data, dataLength);
+    sendDatagramLengths_[nQueuedDatagrams_] = dataLength;
+    ++nQueuedDatagrams_;
+    return;
+  }
+
+  // Send the queued datagrams first to keep the order.
+  flush();
+
   ndn_Error error;
   if ((error = ndn_UdpTransport_send(transport_.get(), data, dataLength)))
     throw runtime_error(ndn_getErrorString(error));
@@ -85,22 +111,58 @@ UdpTransport::send(const uint8_t *data, size_t dataLength)
 void
 UdpTransport::processEvents()
 {
-  uint8_t buffer[MAX_NDN_PACKET_SIZE];
   ndn_Error error;
+  if (useBatchedIo_) {
+    if ((error = ndn_UdpTransport_processDatagrams
+         (transport_.get(), &receiveDatagrams_[0], MAX_NDN_PACKET_SIZE,
+          MAX_BATCHED_DATAGRAMS, &receiveDatagramLengths_[0])))
+      throw runtime_error(ndn_getErrorString(error));
+    return;
+  }
+
+  uint8_t buffer[MAX_NDN_PACKET_SIZE];
   if ((error = ndn_UdpTransport_processEvents
        (transport_.get(), buffer, sizeof(buffer))))
     throw runtime_error(ndn_getErrorString(error));
 }
 
+void
+UdpTransport::flush()
+{
+  if (nQueuedDatagrams_ == 0)
+    return;
+
+  // Clear the queue first in case of an error.
+  size_t nDatagrams = nQueuedDatagrams_;
+  nQueuedDatagrams_ = 0;
+  ndn_Error error;
+  if ((error = ndn_UdpTransport_sendDatagrams
+       (transport_.get(), &sendDatagrams_[0], &sendDatagramLengths_[0],
+        nDatagrams)))
+    throw runtime_error(ndn_getErrorString(error));
+}
+
 bool
 UdpTransport::getIsConnected()
 {
   return isConnected_;
 }
 
+int
+UdpTransport::getSocketDescriptor()
+{
+  return transport_->base.socketDescriptor;
+}
+
 void
 UdpTransport::close()
 {
+  // Ignore an error sending the queued datagrams since we are closing.
+  try {
+    flush();
+  } catch (const std::exception& ex) {
+  }
+
   ndn_Error error;
   if ((error = ndn_UdpTransport_close(transport_.get())))
     throw runtime_error(ndn_getErrorString(error));
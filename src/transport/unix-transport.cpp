@@ -98,6 +98,12 @@ UnixTransport::getIsConnected()
   return isConnected_;
 }
 
+int
+UnixTransport::getSocketDescriptor()
+{
+  return transport_->base.socketDescriptor;
+}
+
 void
 UnixTransport::close()
 {
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include <algorithm>
+#include "congestion-window.hpp"
+
+using namespace std;
+
+namespace ndn {
+
+CongestionWindow::CongestionWindow(const SegmentFetcher::Options& options)
+: useConstantCwnd_(options.getUseConstantCwnd()),
+  initCwnd_(max(1.0, options.getInitCwnd())), aiStep_(options.getAiStep()),
+  mdCoef_(options.getMdCoef()), resetCwndToInit_(options.getResetCwndToInit()),
+  cwnd_(initCwnd_), ssthresh_(options.getInitSsthresh()), nInFlight_(0),
+  lastSendSequence_(0), recoveryPoint_(0),
+  rttEstimator_(options.getInitialRto(), options.getMinRto(), options.getMaxRto()),
+  isScheduling_(false)
+{
+}
+
+void
+CongestionWindow::addFetcher(const ptr_lib::shared_ptr<SegmentFetcher>& fetcher)
+{
+  fetchers_.push_back(fetcher);
+}
+
+void
+CongestionWindow::removeFetcher(const SegmentFetcher* fetcher)
+{
+  for (size_t i = 0; i < fetchers_.size(); ++i) {
+    if (fetchers_[i].get() == fetcher) {
+      fetchers_.erase(fetchers_.begin() + i);
+      return;
+    }
+  }
+}
+
+void
+CongestionWindow::schedule()
+{
+  if (isScheduling_)
+    return;
+
+  isScheduling_ = true;
+  while (nInFlight_ < max(1, (int)cwnd_)) {
+    // Weighted fairness: Pick the fetcher which would have the smallest
+    // share of the window relative to its priority. Ties go to the earliest
+    // added fetcher.
+    ptr_lib::shared_ptr<SegmentFetcher> selected;
+    double selectedShare = 0;
+    for (size_t i = 0; i < fetchers_.size(); ++i) {
+      SegmentFetcher& fetcher = *fetchers_[i];
+      if (!fetcher.hasInterestToSend())
+        continue;
+
+      double share = (fetcher.nInterestsInFlight_ + 1) / fetcher.priority_;
+      if (!selected || share < selectedShare) {
+        selected = fetchers_[i];
+        selectedShare = share;
+      }
+    }
+
+    if (!selected)
+      break;
+    // This may finish the fetcher and remove it, but selected keeps it
+    // allocated.
+    selected->sendNextInterest();
+  }
+  isScheduling_ = false;
+}
+
+void
+CongestionWindow::increase()
+{
+  if (useConstantCwnd_)
+    return;
+
+  if (cwnd_ < ssthresh_)
+    // Slow start.
+    cwnd_ += aiStep_;
+  else
+    // Congestion avoidance.
+    cwnd_ += aiStep_ / cwnd_;
+}
+
+void
+CongestionWindow::onCongestionSignal(uint64_t sendSequence)
+{
+  // Conservative window adaptation: Only decrease once for the losses in
+  // the window of Interests which were outstanding at the last decrease.
+  if (useConstantCwnd_ || sendSequence <= recoveryPoint_)
+    return;
+
+  recoveryPoint_ = lastSendSequence_;
+  ssthresh_ = max(2.0, cwnd_ * mdCoef_);
+  cwnd_ = (resetCwndToInit_ ? initCwnd_ : ssthresh_);
+}
+
+}
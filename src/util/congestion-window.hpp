@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_CONGESTION_WINDOW_HPP
+#define NDN_CONGESTION_WINDOW_HPP
+
+#include <vector>
+#include <ndn-cpp/util/segment-fetcher.hpp>
+#include "rtt-estimator.hpp"
+
+namespace ndn {
+
+/**
+ * A CongestionWindow holds the AIMD congestion window and the RTT estimator
+ * which are shared by one or more SegmentFetcher objects, and schedules which
+ * fetcher sends the next Interest when the window has room. A SegmentFetcher
+ * from SegmentFetcher::fetch has its own CongestionWindow, and the fetchers
+ * from a FetchScheduler share one. The window is decreased at most once per
+ * round trip, which is tracked with a sequence number for each Interest sent
+ * through the window.
+ */
+class CongestionWindow {
+public:
+  /**
+   * Create a CongestionWindow with the window and RTO settings from the
+   * options.
+   * @param options The Options for the window and retransmission timer.
+   */
+  CongestionWindow(const SegmentFetcher::Options& options);
+
+  /**
+   * Add the fetcher to the fetchers which share the window. This keeps a
+   * pointer to the fetcher until removeFetcher.
+   * @param fetcher The SegmentFetcher.
+   */
+  void
+  addFetcher(const ptr_lib::shared_ptr<SegmentFetcher>& fetcher);
+
+  /**
+   * Remove the fetcher from the fetchers which share the window.
+   * @param fetcher The SegmentFetcher given to addFetcher.
+   */
+  void
+  removeFetcher(const SegmentFetcher* fetcher);
+
+  /**
+   * While the window has room, pick the fetcher with an Interest to send
+   * which has the fewest Interests in flight relative to its priority, and
+   * have it send an Interest. If this is called again while an Interest is
+   * sent (for example, if the Face answers immediately), just return and let
+   * the outer call fill the window.
+   */
+  void
+  schedule();
+
+  /**
+   * Count an Interest sent through the window.
+   * @return The sequence number of the Interest, to give to
+   * onCongestionSignal.
+   */
+  uint64_t
+  onInterestSent()
+  {
+    ++nInFlight_;
+    return ++lastSendSequence_;
+  }
+
+  /**
+   * Count an Interest which is no longer in flight because it was answered,
+   * timed out or was cancelled.
+   */
+  void
+  onInterestDone() { --nInFlight_; }
+
+  /**
+   * Increase the window for a received Data packet, using slow start below
+   * the threshold and additive increase above it.
+   */
+  void
+  increase();
+
+  /**
+   * Decrease the window for a timeout, CongestionMark or Congestion Nack,
+   * unless the window was already decreased after the Interest was sent.
+   * @param sendSequence The sequence number from onInterestSent for the
+   * Interest which got the congestion signal.
+   */
+  void
+  onCongestionSignal(uint64_t sendSequence);
+
+  double
+  getCwnd() const { return cwnd_; }
+
+  /**
+   * Get the number of fetchers which share the window.
+   * @return The number of fetchers.
+   */
+  size_t
+  getNFetchers() const { return fetchers_.size(); }
+
+  RttEstimator&
+  getRttEstimator() { return rttEstimator_; }
+
+private:
+  bool useConstantCwnd_;
+  double initCwnd_;
+  double aiStep_;
+  double mdCoef_;
+  bool resetCwndToInit_;
+  double cwnd_;
+  double ssthresh_;
+  int nInFlight_;
+  uint64_t lastSendSequence_;
+  // The lastSendSequence_ at the last decrease.
+  uint64_t recoveryPoint_;
+  RttEstimator rttEstimator_;
+  std::vector<ptr_lib::shared_ptr<SegmentFetcher> > fetchers_;
+  bool isScheduling_;
+};
+
+}
+
+#endif
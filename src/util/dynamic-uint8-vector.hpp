@@ -141,6 +141,23 @@ public:
     return result;
   }
 
+  /**
+   * Move the final size bytes of the allocated vector to the front (where they
+   * were written by a reverse encoder), resize the vector to the given size,
+   * transfer the bytes to a Blob and return the Blob. Further calls to get()
+   * will return a null pointer.
+   * @param size The number of bytes at the back of the allocated vector.
+   * @return A new Blob with the bytes from the vector.
+   */
+  Blob
+  finishFromBack(size_t size)
+  {
+    vector_->erase(vector_->begin(), vector_->end() - size);
+    Blob result(vector_, false);
+    vector_.reset();
+    return result;
+  }
+
   uint8_t&
   operator [] (size_t i) { return (*vector_)[i]; }
 
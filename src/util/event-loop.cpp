@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include <math.h>
+#include <errno.h>
+#include <algorithm>
+#include <stdexcept>
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif NDN_CPP_HAVE_UNISTD_H
+#include <poll.h>
+#endif
+#include "../c/util/time.h"
+#include "../node.hpp"
+#include <ndn-cpp/util/event-loop.hpp>
+
+using namespace std;
+
+namespace ndn {
+
+EventLoop::EventLoop()
+: epollDescriptor_(-1), isStopped_(false)
+{
+#if NDN_CPP_HAVE_SYS_EPOLL_H
+  if ((epollDescriptor_ = epoll_create(MAX_EVENTS)) < 0)
+    throw runtime_error("EventLoop: Error in epoll_create");
+#endif
+}
+
+EventLoop::~EventLoop()
+{
+#if NDN_CPP_HAVE_SYS_EPOLL_H
+  close(epollDescriptor_);
+#endif
+}
+
+void
+EventLoop::addFace(Face& face)
+{
+  if (find(faces_.begin(), faces_.end(), &face) != faces_.end())
+    return;
+
+  faces_.push_back(&face);
+  // updateSocketDescriptors() will add the socket when it is connected.
+  socketDescriptors_[&face] = -1;
+}
+
+void
+EventLoop::removeFace(Face& face)
+{
+  vector<Face*>::iterator found = find(faces_.begin(), faces_.end(), &face);
+  if (found == faces_.end())
+    return;
+
+  faces_.erase(found);
+#if NDN_CPP_HAVE_SYS_EPOLL_H
+  int socketDescriptor = socketDescriptors_[&face];
+  if (socketDescriptor >= 0)
+    // Ignore the error if the socket is already closed.
+    epoll_ctl(epollDescriptor_, EPOLL_CTL_DEL, socketDescriptor, 0);
+#endif
+  socketDescriptors_.erase(&face);
+}
+
+void
+EventLoop::runFor(Milliseconds durationMilliseconds)
+{
+  ndn_MillisecondsSince1970 endTime = ndn_getNowMilliseconds() +
+    durationMilliseconds;
+  isStopped_ = false;
+
+  while (true) {
+    // Copy faces_ in case a callback adds or removes a face.
+    vector<Face*> faces(faces_);
+    for (size_t i = 0; i < faces.size() && !isStopped_; ++i)
+      faces[i]->processEvents();
+    if (isStopped_)
+      break;
+
+    Milliseconds timeoutMilliseconds = getMillisecondsUntilNextCall();
+    size_t nConnectedFaces = updateSocketDescriptors();
+    if (durationMilliseconds >= 0) {
+      Milliseconds remainingMilliseconds = endTime - ndn_getNowMilliseconds();
+      if (remainingMilliseconds <= 0)
+        break;
+      if (timeoutMilliseconds < 0 || timeoutMilliseconds > remainingMilliseconds)
+        timeoutMilliseconds = remainingMilliseconds;
+    }
+    else if (timeoutMilliseconds < 0 && nConnectedFaces == 0)
+      // There is nothing which could call a callback.
+      break;
+
+    waitForEvents(timeoutMilliseconds);
+  }
+}
+
+Milliseconds
+EventLoop::getMillisecondsUntilNextCall()
+{
+  Milliseconds result = -1;
+  for (size_t i = 0; i < faces_.size(); ++i) {
+    Milliseconds faceResult = faces_[i]->node_->getMillisecondsUntilNextCall();
+    if (faceResult >= 0 && (result < 0 || faceResult < result))
+      result = faceResult;
+  }
+
+  return result;
+}
+
+size_t
+EventLoop::updateSocketDescriptors()
+{
+  size_t nConnectedFaces = 0;
+  for (size_t i = 0; i < faces_.size(); ++i) {
+    int socketDescriptor =
+      faces_[i]->node_->getTransport()->getSocketDescriptor();
+    if (socketDescriptor >= 0)
+      ++nConnectedFaces;
+
+    int& oldSocketDescriptor = socketDescriptors_[faces_[i]];
+    if (socketDescriptor == oldSocketDescriptor)
+      continue;
+
+#if NDN_CPP_HAVE_SYS_EPOLL_H
+    // Node does not reconnect a transport after it is closed, so a face's
+    // socket descriptor only changes from -1 when connected, or to -1 when
+    // closed.
+    if (oldSocketDescriptor >= 0)
+      // Ignore the error since closing the socket already removed it.
+      epoll_ctl(epollDescriptor_, EPOLL_CTL_DEL, oldSocketDescriptor, 0);
+    if (socketDescriptor >= 0) {
+      struct epoll_event event;
+      event.events = EPOLLIN;
+      event.data.fd = socketDescriptor;
+      if (epoll_ctl
+          (epollDescriptor_, EPOLL_CTL_ADD, socketDescriptor, &event) < 0)
+        throw runtime_error("EventLoop: Error in epoll_ctl");
+    }
+#endif
+    oldSocketDescriptor = socketDescriptor;
+  }
+
+  return nConnectedFaces;
+}
+
+void
+EventLoop::waitForEvents(Milliseconds timeoutMilliseconds)
+{
+  // Round up so that we don't wake up before the next call is due.
+  int timeout = timeoutMilliseconds < 0 ? -1 : (int)ceil(timeoutMilliseconds);
+
+#if NDN_CPP_HAVE_SYS_EPOLL_H
+  // We only need to wake up. runFor calls processEvents for all faces.
+  struct epoll_event events[MAX_EVENTS];
+  if (epoll_wait(epollDescriptor_, events, MAX_EVENTS, timeout) < 0 &&
+      errno != EINTR)
+    throw runtime_error("EventLoop: Error in epoll_wait");
+#elif NDN_CPP_HAVE_UNISTD_H
+  vector<struct pollfd> pollInfo;
+  for (map<Face*, int>::iterator i = socketDescriptors_.begin();
+       i != socketDescriptors_.end(); ++i) {
+    if (i->second >= 0) {
+      struct pollfd info;
+      info.fd = i->second;
+      info.events = POLLIN;
+      info.revents = 0;
+      pollInfo.push_back(info);
+    }
+  }
+
+  if (poll(pollInfo.size() > 0 ? &pollInfo[0] : 0, pollInfo.size(),
+           timeout) < 0 && errno != EINTR)
+    throw runtime_error("EventLoop: Error in poll");
+#else
+  // We can't wait on the sockets, so return and let runFor poll.
+#endif
+}
+
+}
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "congestion-window.hpp"
+#include <ndn-cpp/util/fetch-scheduler.hpp>
+
+using namespace std;
+
+namespace ndn {
+
+FetchScheduler::FetchScheduler
+  (Face& face, const SegmentFetcher::Options& options)
+: face_(face), options_(options),
+  window_(ptr_lib::make_shared<CongestionWindow>(options))
+{
+}
+
+void
+FetchScheduler::fetch
+  (const Interest& baseInterest, KeyChain* validatorKeyChain,
+   const SegmentFetcher::OnComplete& onComplete,
+   const SegmentFetcher::OnError& onError, double priority)
+{
+  // The window keeps the fetcher allocated until it finishes.
+  ptr_lib::shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher
+    (face_, validatorKeyChain, SegmentFetcher::DontVerifySegment, onComplete,
+     onError, options_, baseInterest, window_, priority));
+  fetcher->start();
+}
+
+void
+FetchScheduler::fetchStream
+  (const Interest& baseInterest, KeyChain* validatorKeyChain,
+   const SegmentFetcher::OnSegment& onSegment,
+   const SegmentFetcher::OnStreamComplete& onComplete,
+   const SegmentFetcher::OnError& onError, double priority)
+{
+  ptr_lib::shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher
+    (face_, validatorKeyChain, SegmentFetcher::DontVerifySegment,
+     SegmentFetcher::OnComplete(), onError, options_, baseInterest, window_,
+     priority));
+  fetcher->onSegment_ = onSegment;
+  fetcher->onStreamComplete_ = onComplete;
+  fetcher->start();
+}
+
+size_t
+FetchScheduler::getNObjectsInProgress() const
+{
+  return window_->getNFetchers();
+}
+
+double
+FetchScheduler::getCwnd() const
+{
+  return window_->getCwnd();
+}
+
+}
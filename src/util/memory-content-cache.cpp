@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include "../c/util/time.h"
+#include "../impl/name-trie.hpp"
 #include <ndn-cpp/util/logging.hpp>
 #include <ndn-cpp/util/memory-content-cache.hpp>
 
@@ -31,10 +32,150 @@ INIT_LOGGER("ndn.MemoryContentCache");
 
 namespace ndn {
 
+/**
+ * An Entry holds the Content for a Data packet in the cache, with its
+ * freshness and its position in entriesByUse_ and removalTimes_.
+ */
+class MemoryContentCache::Impl::Entry {
+public:
+  /**
+   * Create a new Entry to hold data's name and wire encoding. If the
+   * FreshnessPeriod is not negative, set the cache removal time to now plus the
+   * maximum of the FreshnessPeriod and the minimumCacheLifetime.
+   * @param data The Data packet whose name and wire encoding are copied.
+   * @param nowMilliseconds The current time in milliseconds from
+   * ndn_getNowMilliseconds.
+   * @param minimumCacheLifetime The minimum cache lifetime in milliseconds.
+   */
+  Entry
+    (const Data& data, MillisecondsSince1970 nowMilliseconds,
+     Milliseconds minimumCacheLifetime)
+  : content_(ptr_lib::make_shared<const Content>(data)),
+    hasRemovalTime_(data.getMetaInfo().getFreshnessPeriod() >= 0.0),
+    cacheRemovalTimeMilliseconds_(0), freshnessExpiryTimeMilliseconds_(0)
+  {
+    if (hasRemovalTime_) {
+      cacheRemovalTimeMilliseconds_ = nowMilliseconds +
+        max(data.getMetaInfo().getFreshnessPeriod(), minimumCacheLifetime);
+      freshnessExpiryTimeMilliseconds_ = nowMilliseconds +
+        data.getMetaInfo().getFreshnessPeriod();
+    }
+  }
+
+  const ptr_lib::shared_ptr<const Content>&
+  getContent() const { return content_; }
+
+  /**
+   * Check if the content is still fresh according to its freshness period
+   * (independent of when to remove from the cache). Content without a
+   * FreshnessPeriod is always fresh.
+   * @param nowMilliseconds The current time in milliseconds from
+   * ndn_getNowMilliseconds.
+   * @return True if the content is still fresh, otherwise false.
+   */
+  bool
+  isFresh(MillisecondsSince1970 nowMilliseconds) const
+  {
+    return !hasRemovalTime_ || freshnessExpiryTimeMilliseconds_ > nowMilliseconds;
+  }
+
+private:
+  friend class MemoryContentCache::Impl;
+
+  ptr_lib::shared_ptr<const Content> content_;
+  bool hasRemovalTime_;
+  MillisecondsSince1970 cacheRemovalTimeMilliseconds_; /**< The time when the content
+    becomes stale and should be removed from the cache in milliseconds
+    according to ndn_getNowMilliseconds */
+  MillisecondsSince1970 freshnessExpiryTimeMilliseconds_; /**< The time when
+    the freshness period of the content expires (independent of when to
+    remove from the cache) in milliseconds according to ndn_getNowMilliseconds */
+  EntryList::iterator usePosition_;
+  // This is only valid if hasRemovalTime_.
+  RemovalTimeMap::iterator removalTimePosition_;
+};
+
+/**
+ * A MatchVisitor is called by NameTrie::visit for each node under the
+ * Interest name to select the matching entry, using the ChildSelector in the
+ * same way as the search through all the content did before.
+ */
+class MemoryContentCache::Impl::MatchVisitor {
+public:
+  MatchVisitor
+    (const Interest& interest, MillisecondsSince1970 nowMilliseconds,
+     const Name::Component& emptyComponent)
+  : interest_(interest), nowMilliseconds_(nowMilliseconds),
+    emptyComponent_(emptyComponent), selectedComponent_(0), selectedEntry_(0)
+  {
+  }
+
+  bool
+  operator()(ContentTrie::Node* node)
+  {
+    std::vector<ptr_lib::shared_ptr<Entry> >& entries = node->getValues();
+    for (size_t i = 0; i < entries.size(); ++i) {
+      Entry* entry = entries[i].get();
+      const Name& name = entry->getContent()->getName();
+      if (!interest_.matchesName(name) ||
+          (interest_.getMustBeFresh() && !entry->isFresh(nowMilliseconds_)))
+        continue;
+
+      if (interest_.getChildSelector() < 0) {
+        // No child selector, so select the first match and stop.
+        selectedEntry_ = entry;
+        return false;
+      }
+
+      const Name::Component* component;
+      if (name.size() > interest_.getName().size())
+        component = &name.get(interest_.getName().size());
+      else
+        component = &emptyComponent_;
+
+      bool gotBetterMatch = false;
+      if (!selectedEntry_)
+        // Save the first match.
+        gotBetterMatch = true;
+      else {
+        if (interest_.getChildSelector() == 0) {
+          // Leftmost child.
+          if (*component < *selectedComponent_)
+            gotBetterMatch = true;
+        }
+        else {
+          // Rightmost child.
+          if (*component > *selectedComponent_)
+            gotBetterMatch = true;
+        }
+      }
+
+      if (gotBetterMatch) {
+        selectedComponent_ = component;
+        selectedEntry_ = entry;
+      }
+    }
+
+    return true;
+  }
+
+  Entry*
+  getSelectedEntry() { return selectedEntry_; }
+
+private:
+  const Interest& interest_;
+  MillisecondsSince1970 nowMilliseconds_;
+  const Name::Component& emptyComponent_;
+  const Name::Component* selectedComponent_;
+  Entry* selectedEntry_;
+};
+
 MemoryContentCache::Impl::Impl
   (Face* face, Milliseconds cleanupIntervalMilliseconds)
 : face_(face), cleanupIntervalMilliseconds_(cleanupIntervalMilliseconds),
   nextCleanupTime_(ndn_getNowMilliseconds() + cleanupIntervalMilliseconds),
+  contentTrie_(new ContentTrie()), nEntries_(0), nBytes_(0), maxEntries_(0),
+  maxBytes_(0), nHits_(0), nMisses_(0), nEvictions_(0),
   isDoingCleanup_(false), minimumCacheLifetime_(0)
 {
 }
@@ -108,19 +249,47 @@ MemoryContentCache::Impl::add(const Data& data)
   MillisecondsSince1970 nowMilliseconds = ndn_getNowMilliseconds();
   doCleanup(nowMilliseconds);
 
-  if (data.getMetaInfo().getFreshnessPeriod() >= 0.0) {
-    // The content will go stale, so use staleTimeCache_.
-    ptr_lib::shared_ptr<const StaleTimeContent> content
-      (new StaleTimeContent(data, nowMilliseconds, minimumCacheLifetime_));
-    // Insert into staleTimeCache_, sorted on content->cacheRemovalTimeMilliseconds_.
-    staleTimeCache_.insert
-      (std::lower_bound(staleTimeCache_.begin(), staleTimeCache_.end(), content, contentCompare_),
-       content);
+  ptr_lib::shared_ptr<ContentList> contentList;
+
+  // Replace content with the same name, and report the replaced content to
+  // OnContentRemoved.
+  ContentTrie::Node* node = contentTrie_->find(data.getName());
+  if (node) {
+    std::vector<ptr_lib::shared_ptr<Entry> >& entries = node->getValues();
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (entries[i]->getContent()->getName().equals(data.getName())) {
+        ptr_lib::shared_ptr<const Content> content =
+          removeEntry(entries[i].get());
+        if (onContentRemoved_) {
+          contentList.reset(new ContentList());
+          contentList->push_back(content);
+        }
+        break;
+      }
+    }
+  }
+
+  ptr_lib::shared_ptr<Entry> entry
+    (new Entry(data, nowMilliseconds, minimumCacheLifetime_));
+  size_t encodingSize = entry->getContent()->getDataEncoding().size();
+  if (maxBytes_ == 0 || encodingSize <= maxBytes_) {
+    contentTrie_->insert(data.getName())->getValues().push_back(entry);
+    entry->usePosition_ = entriesByUse_.insert(entriesByUse_.begin(), entry.get());
+    if (entry->hasRemovalTime_)
+      entry->removalTimePosition_ = removalTimes_.insert
+        (RemovalTimeMap::value_type
+         (entry->cacheRemovalTimeMilliseconds_, entry.get()));
+    ++nEntries_;
+    nBytes_ += encodingSize;
+
+    evictToLimits(contentList);
   }
   else
-    // The data does not go stale, so use noStaleTimeCache_.
-    noStaleTimeCache_.push_back
-      (ptr_lib::make_shared<const Content>(data));
+    _LOG_DEBUG("MemoryContentCache: The Data packet is larger than maxBytes. Not caching " <<
+               data.getName());
+
+  if (contentList)
+    callOnContentRemoved(contentList);
 
   // Remove timed-out interests and check if the data packet matches any pending
   // interest.
@@ -210,69 +379,18 @@ MemoryContentCache::Impl::onInterest
   MillisecondsSince1970 nowMilliseconds = ndn_getNowMilliseconds();
   doCleanup(nowMilliseconds);
 
-  const Name::Component* selectedComponent = 0;
-  Blob selectedEncoding;
-  // We need to iterate over both arrays.
-  size_t totalSize = staleTimeCache_.size() + noStaleTimeCache_.size();
-  for (size_t i = 0; i < totalSize; ++i) {
-    const Content* content;
-    bool isFresh = true;
-    if (i < staleTimeCache_.size()) {
-      const StaleTimeContent *staleTimeContent = staleTimeCache_[i].get();
-      content = staleTimeContent;
-      isFresh = staleTimeContent->isFresh(nowMilliseconds);
-    }
-    else
-      // We have iterated over the first array. Get from the second.
-      content = noStaleTimeCache_[i - staleTimeCache_.size()].get();
-
-    if (interest->matchesName(content->getName()) &&
-        !(interest->getMustBeFresh() && !isFresh)) {
-      if (interest->getChildSelector() < 0) {
-        // No child selector, so send the first match that we have found.
-        _LOG_TRACE("MemoryContentCache:         Reply Data " << content->getName());
-        face.send(*content->getDataEncoding());
-        return;
-      }
-      else {
-        // Update selectedEncoding based on the child selector.
-        const Name::Component* component;
-        if (content->getName().size() > interest->getName().size())
-          component = &content->getName().get(interest->getName().size());
-        else
-          component = &emptyComponent_;
-
-        bool gotBetterMatch = false;
-        if (!selectedEncoding)
-          // Save the first match.
-          gotBetterMatch = true;
-        else {
-          if (interest->getChildSelector() == 0) {
-            // Leftmost child.
-            if (*component < *selectedComponent)
-              gotBetterMatch = true;
-          }
-          else {
-            // Rightmost child.
-            if (*component > *selectedComponent)
-              gotBetterMatch = true;
-          }
-        }
-
-        if (gotBetterMatch) {
-          selectedComponent = component;
-          selectedEncoding = content->getDataEncoding();
-        }
-      }
-    }
-  }
-
-  if (selectedEncoding) {
-    // We found the leftmost or rightmost child.
-    _LOG_TRACE("MemoryContentCache: Reply Data to Interest " << interest->toUri());
-    face.send(*selectedEncoding);
+  Entry* entry = findEntry(*interest, nowMilliseconds);
+  if (entry) {
+    ++nHits_;
+    // Move the entry to the front as the most recently used.
+    entriesByUse_.splice
+      (entriesByUse_.begin(), entriesByUse_, entry->usePosition_);
+    _LOG_TRACE("MemoryContentCache: Reply Data " << entry->getContent()->getName() <<
+               " to Interest " << interest->toUri());
+    face.send(*entry->getContent()->getDataEncoding());
   }
   else {
+    ++nMisses_;
     _LOG_TRACE("MemoryContentCache: onDataNotFound for " << interest->toUri());
     // Call the onDataNotFound callback (if defined).
     map<string, OnInterestCallback>::iterator onDataNotFound =
@@ -302,49 +420,133 @@ MemoryContentCache::Impl::doCleanup(MillisecondsSince1970 nowMilliseconds)
 
   ptr_lib::shared_ptr<ContentList> contentList;
   if (nowMilliseconds >= nextCleanupTime_) {
-    // staleTimeCache_ is sorted on cacheRemovalTimeMilliseconds_, so we only need to
-    // erase the stale entries at the front, then quit.
-    while (staleTimeCache_.size() > 0 &&
-           staleTimeCache_.front()->isPastRemovalTime(nowMilliseconds)) {
+    // removalTimes_ is sorted on the cache removal time, so we only need to
+    // remove the stale entries at the front, then quit.
+    while (!removalTimes_.empty() &&
+           removalTimes_.begin()->first <= nowMilliseconds) {
+      ptr_lib::shared_ptr<const Content> content =
+        removeEntry(removalTimes_.begin()->second);
       if (onContentRemoved_) {
         // Add to the list of removed content for the OnContentRemoved callback.
         // We make a separate list instead of calling the callback each time
-        // because the callback might call add again to modify the staleTimeCache_.
+        // because the callback might call add again to modify the cache.
         if (!contentList)
           contentList.reset(new ContentList());
 
-        contentList->push_back(staleTimeCache_.front());
+        contentList->push_back(content);
       }
-
-      staleTimeCache_.erase(staleTimeCache_.begin());
     }
 
     nextCleanupTime_ = nowMilliseconds + cleanupIntervalMilliseconds_;
   }
 
-  if (onContentRemoved_ && contentList) {
-    try {
-      onContentRemoved_(contentList);
-    } catch (const std::exception& ex) {
-      _LOG_ERROR("MemoryContentCache::doCleanup(): Error in onContentRemoved: " << ex.what());
-    } catch (...) {
-      _LOG_ERROR("MemoryContentCache::doCleanup(): Error in onContentRemoved.");
+  if (contentList)
+    callOnContentRemoved(contentList);
+
+  isDoingCleanup_ = false;
+}
+
+MemoryContentCache::Impl::Entry*
+MemoryContentCache::Impl::findEntry
+  (const Interest& interest, MillisecondsSince1970 nowMilliseconds)
+{
+  // Each entry whose name matches the Interest is under the Interest name.
+  ContentTrie::Node* node = contentTrie_->find(interest.getName());
+  if (!node)
+    return 0;
+
+  // Only visit the levels below the node allowed by MaxSuffixComponents, where
+  // the implicit digest is one of the components.
+  size_t maxDepth = (size_t)-1;
+  if (interest.getMaxSuffixComponents() >= 0)
+    maxDepth = interest.getMaxSuffixComponents() > 0 ?
+      (size_t)(interest.getMaxSuffixComponents() - 1) : 0;
+
+  MatchVisitor visitor(interest, nowMilliseconds, emptyComponent_);
+  ContentTrie::visit(node, maxDepth, visitor);
+  return visitor.getSelectedEntry();
+}
+
+ptr_lib::shared_ptr<const MemoryContentCache::Content>
+MemoryContentCache::Impl::removeEntry(Entry* entry)
+{
+  ptr_lib::shared_ptr<const Content> content = entry->getContent();
+
+  entriesByUse_.erase(entry->usePosition_);
+  if (entry->hasRemovalTime_)
+    removalTimes_.erase(entry->removalTimePosition_);
+  --nEntries_;
+  nBytes_ -= content->getDataEncoding().size();
+
+  ContentTrie::Node* node = contentTrie_->find(content->getName());
+  std::vector<ptr_lib::shared_ptr<Entry> >& entries = node->getValues();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (entries[i].get() == entry) {
+      // This deletes the entry.
+      entries.erase(entries.begin() + i);
+      break;
     }
   }
+  contentTrie_->prune(node);
 
-  isDoingCleanup_ = false;
+  return content;
 }
 
-MemoryContentCache::Impl::StaleTimeContent::StaleTimeContent
-  (const Data& data, MillisecondsSince1970 nowMilliseconds,
-   Milliseconds minimumCacheLifetime)
-// wireEncode returns the cached encoding if available.
-: Content(data)
+void
+MemoryContentCache::Impl::evictToLimits
+  (ptr_lib::shared_ptr<ContentList>& contentList)
 {
-  cacheRemovalTimeMilliseconds_ = nowMilliseconds +
-    max(data.getMetaInfo().getFreshnessPeriod(), minimumCacheLifetime);
-  freshnessExpiryTimeMilliseconds_ = nowMilliseconds +
-    data.getMetaInfo().getFreshnessPeriod();
+  while (!entriesByUse_.empty() &&
+         ((maxEntries_ > 0 && nEntries_ > maxEntries_) ||
+          (maxBytes_ > 0 && nBytes_ > maxBytes_))) {
+    // The least recently used entry is at the back.
+    ptr_lib::shared_ptr<const Content> content =
+      removeEntry(entriesByUse_.back());
+    ++nEvictions_;
+    _LOG_TRACE("MemoryContentCache: Evict Data " << content->getName());
+
+    if (onContentRemoved_) {
+      if (!contentList)
+        contentList.reset(new ContentList());
+
+      contentList->push_back(content);
+    }
+  }
+}
+
+void
+MemoryContentCache::Impl::setMaxEntries(size_t maxEntries)
+{
+  maxEntries_ = maxEntries;
+
+  ptr_lib::shared_ptr<ContentList> contentList;
+  evictToLimits(contentList);
+  if (contentList)
+    callOnContentRemoved(contentList);
+}
+
+void
+MemoryContentCache::Impl::setMaxBytes(size_t maxBytes)
+{
+  maxBytes_ = maxBytes;
+
+  ptr_lib::shared_ptr<ContentList> contentList;
+  evictToLimits(contentList);
+  if (contentList)
+    callOnContentRemoved(contentList);
+}
+
+void
+MemoryContentCache::Impl::callOnContentRemoved
+  (const ptr_lib::shared_ptr<ContentList>& contentList)
+{
+  try {
+    onContentRemoved_(contentList);
+  } catch (const std::exception& ex) {
+    _LOG_ERROR("MemoryContentCache: Error in onContentRemoved: " << ex.what());
+  } catch (...) {
+    _LOG_ERROR("MemoryContentCache: Error in onContentRemoved.");
+  }
 }
 
 MemoryContentCache::PendingInterest::PendingInterest
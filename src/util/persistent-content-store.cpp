@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+// Only compile if ndn-cpp-config.h defines NDN_CPP_HAVE_MMAP.
+#include <ndn-cpp/ndn-cpp-config.h>
+#if NDN_CPP_HAVE_MMAP
+
+#include <stdexcept>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "../c/encoding/tlv/tlv-decoder.h"
+#include <ndn-cpp/lite/util/crypto-lite.hpp>
+#include <ndn-cpp/util/persistent-content-store.hpp>
+
+using namespace std;
+using namespace ndn::func_lib;
+
+namespace ndn {
+
+// An index entry has the 8-byte offset and 4-byte length of the Data encoding,
+// both big endian, followed by the Name TLV.
+static const size_t INDEX_ENTRY_HEADER_LENGTH = 12;
+
+// The smallest length of the memory mapping of the Data file. Mapping past the
+// end of the file is allowed, so the file can grow up to this size without
+// remapping.
+static const size_t MIN_MAPPING_LENGTH = 1024 * 1024;
+
+/**
+ * Write all of the bytes to the file at the offset.
+ * @throws runtime_error If the file can't be written.
+ */
+static void
+writeAll(int file, const uint8_t* buffer, size_t length, uint64_t offset)
+{
+  while (length > 0) {
+    ssize_t nBytes = ::pwrite(file, buffer, length, (off_t)offset);
+    if (nBytes < 0)
+      throw runtime_error("PersistentContentStore: Error writing the file");
+
+    buffer += nBytes;
+    length -= nBytes;
+    offset += nBytes;
+  }
+}
+
+/**
+ * Open the file, creating it if it doesn't exist, and get its size.
+ * @throws runtime_error If the file can't be opened.
+ */
+static int
+openFile(const string& filePath, uint64_t& fileSize)
+{
+  int file = ::open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+  if (file < 0)
+    throw runtime_error
+      ("PersistentContentStore: Cannot open the file " + filePath);
+
+  struct stat fileStat;
+  if (::fstat(file, &fileStat) != 0) {
+    ::close(file);
+    throw runtime_error
+      ("PersistentContentStore: Cannot get the size of the file " + filePath);
+  }
+
+  fileSize = (uint64_t)fileStat.st_size;
+  return file;
+}
+
+PersistentContentStore::PersistentContentStore(const string& filePath)
+: dataFilePath_(filePath), indexFilePath_(filePath + ".index"),
+  dataFile_(-1), indexFile_(-1), dataFileSize_(0), indexFileSize_(0),
+  mapping_(0), mappingLength_(0)
+{
+  try {
+    dataFile_ = openFile(dataFilePath_, dataFileSize_);
+    indexFile_ = openFile(indexFilePath_, indexFileSize_);
+    mapDataFile();
+    readIndex();
+  } catch (...) {
+    // The destructor is not called if the constructor throws.
+    close();
+    throw;
+  }
+}
+
+PersistentContentStore::~PersistentContentStore()
+{
+  close();
+}
+
+void
+PersistentContentStore::add(const Data& data)
+{
+  // wireEncode returns the cached encoding if available.
+  Blob encoding = data.wireEncode();
+  Blob nameEncoding = data.getName().wireEncode();
+  Record record(dataFileSize_, encoding.size());
+
+  // Write the Data before the index entry, so that the index never refers to
+  // an incomplete Data packet.
+  writeAll(dataFile_, encoding.buf(), encoding.size(), dataFileSize_);
+  dataFileSize_ += encoding.size();
+  writeIndexEntry(BlobLite(nameEncoding.buf(), nameEncoding.size()), record);
+
+  records_[data.getName()] = record;
+  mapDataFile();
+}
+
+BlobLite
+PersistentContentStore::find(const Interest& interest) const
+{
+  const Name& name = interest.getName();
+
+  if (name.size() > 0 && name.get(-1).isImplicitSha256Digest()) {
+    // The Interest has the full name, so check the digest of the Data packet.
+    RecordMap::const_iterator it = records_.find(name.getPrefix(-1));
+    if (it == records_.end())
+      return BlobLite();
+
+    BlobLite encoding = getEncoding(it->second);
+    uint8_t digest[ndn_SHA256_DIGEST_SIZE];
+    CryptoLite::digestSha256(encoding, digest);
+    const Blob& interestDigest = name.get(-1).getValue();
+    if (interestDigest.size() == sizeof(digest) &&
+        ::memcmp(interestDigest.buf(), digest, sizeof(digest)) == 0)
+      return encoding;
+    else
+      return BlobLite();
+  }
+
+  if (!interest.getCanBePrefix()) {
+    RecordMap::const_iterator it = records_.find(name);
+    return it != records_.end() ? getEncoding(it->second) : BlobLite();
+  }
+
+  // The Name keys are in order, so the Data names with the prefix follow
+  // lower_bound.
+  for (RecordMap::const_iterator it = records_.lower_bound(name);
+       it != records_.end() && name.isPrefixOf(it->first); ++it) {
+    if (interest.matchesName(it->first))
+      return getEncoding(it->second);
+  }
+
+  return BlobLite();
+}
+
+uint64_t
+PersistentContentStore::setInterestFilter
+  (Face& face, const Name& prefix, const OnInterestCallback& onDataNotFound)
+{
+  return face.setInterestFilter
+    (prefix, bind(&PersistentContentStore::onInterest, this, _1, _2, _3, _4, _5,
+                  onDataNotFound));
+}
+
+void
+PersistentContentStore::readIndex()
+{
+  vector<uint8_t> index((size_t)indexFileSize_);
+  size_t nRead = 0;
+  while (nRead < index.size()) {
+    ssize_t nBytes = ::pread
+      (indexFile_, &index[nRead], index.size() - nRead, (off_t)nRead);
+    if (nBytes <= 0)
+      throw runtime_error
+        ("PersistentContentStore: Error reading the file " + indexFilePath_);
+    nRead += nBytes;
+  }
+
+  // Each index entry follows the previous one in the Data file. Stop at the
+  // first entry which is incomplete or doesn't fit in the Data file.
+  size_t position = 0;
+  uint64_t nextOffset = 0;
+  while (position + INDEX_ENTRY_HEADER_LENGTH <= index.size()) {
+    const uint8_t* entry = &index[position];
+    uint64_t offset = 0;
+    for (size_t i = 0; i < 8; ++i)
+      offset = (offset << 8) | entry[i];
+    size_t length = 0;
+    for (size_t i = 8; i < INDEX_ENTRY_HEADER_LENGTH; ++i)
+      length = (length << 8) | entry[i];
+    if (offset != nextOffset || offset + length > dataFileSize_)
+      break;
+
+    const uint8_t* nameEncoding = entry + INDEX_ENTRY_HEADER_LENGTH;
+    struct ndn_TlvDecoder decoder;
+    ndn_TlvDecoder_initialize
+      (&decoder, nameEncoding,
+       index.size() - position - INDEX_ENTRY_HEADER_LENGTH);
+    size_t nameLength;
+    if (ndn_TlvDecoder_readTypeAndLength(&decoder, ndn_Tlv_Name, &nameLength))
+      break;
+    size_t nameEncodingLength = decoder.offset + nameLength;
+
+    Name name;
+    try {
+      name.wireDecode(nameEncoding, nameEncodingLength);
+    } catch (const std::exception&) {
+      break;
+    }
+
+    records_[name] = Record(offset, length);
+    position += INDEX_ENTRY_HEADER_LENGTH + nameEncodingLength;
+    nextOffset = offset + length;
+  }
+
+  if (position < indexFileSize_) {
+    if (::ftruncate(indexFile_, (off_t)position) != 0)
+      throw runtime_error
+        ("PersistentContentStore: Error truncating the file " + indexFilePath_);
+    indexFileSize_ = position;
+  }
+
+  // Index the complete Data packets after the last indexed one.
+  while (nextOffset < dataFileSize_) {
+    struct ndn_TlvDecoder decoder;
+    ndn_TlvDecoder_initialize
+      (&decoder, mapping_ + nextOffset, (size_t)(dataFileSize_ - nextOffset));
+    size_t length;
+    if (ndn_TlvDecoder_readTypeAndLength(&decoder, ndn_Tlv_Data, &length))
+      break;
+    size_t dataLength = decoder.offset + length;
+
+    size_t nameOffset = decoder.offset;
+    size_t nameLength;
+    if (ndn_TlvDecoder_readTypeAndLength(&decoder, ndn_Tlv_Name, &nameLength) ||
+        decoder.offset + nameLength > dataLength)
+      break;
+    BlobLite nameEncoding
+      (mapping_ + nextOffset + nameOffset,
+       decoder.offset - nameOffset + nameLength);
+
+    Name name;
+    try {
+      name.wireDecode(nameEncoding.buf(), nameEncoding.size());
+    } catch (const std::exception&) {
+      break;
+    }
+
+    Record record(nextOffset, dataLength);
+    writeIndexEntry(nameEncoding, record);
+    records_[name] = record;
+    nextOffset += dataLength;
+  }
+
+  if (nextOffset < dataFileSize_) {
+    // Remove the incomplete Data packet so that add() appends after the last
+    // complete one.
+    if (::ftruncate(dataFile_, (off_t)nextOffset) != 0)
+      throw runtime_error
+        ("PersistentContentStore: Error truncating the file " + dataFilePath_);
+    dataFileSize_ = nextOffset;
+  }
+}
+
+void
+PersistentContentStore::writeIndexEntry
+  (const BlobLite& nameEncoding, const Record& record)
+{
+  vector<uint8_t> entry(INDEX_ENTRY_HEADER_LENGTH + nameEncoding.size());
+  for (size_t i = 0; i < 8; ++i)
+    entry[i] = (uint8_t)(record.offset_ >> (8 * (7 - i)));
+  for (size_t i = 8; i < INDEX_ENTRY_HEADER_LENGTH; ++i)
+    entry[i] = (uint8_t)(record.length_ >> (8 * (11 - i)));
+  ::memcpy
+    (&entry[INDEX_ENTRY_HEADER_LENGTH], nameEncoding.buf(), nameEncoding.size());
+
+  writeAll(indexFile_, &entry[0], entry.size(), indexFileSize_);
+  indexFileSize_ += entry.size();
+}
+
+void
+PersistentContentStore::mapDataFile()
+{
+  // The mapping can extend past the end of the file. Its pages become valid
+  // as the file grows.
+  if (mapping_ && dataFileSize_ <= mappingLength_)
+    return;
+
+  size_t newLength = mappingLength_ > 0 ? 2 * mappingLength_ : MIN_MAPPING_LENGTH;
+  while (newLength < dataFileSize_)
+    newLength *= 2;
+
+  if (mapping_) {
+    ::munmap((void*)mapping_, mappingLength_);
+    mapping_ = 0;
+    mappingLength_ = 0;
+  }
+
+  void* mapping = ::mmap(0, newLength, PROT_READ, MAP_SHARED, dataFile_, 0);
+  if (mapping == MAP_FAILED)
+    throw runtime_error
+      ("PersistentContentStore: Cannot map the file " + dataFilePath_);
+
+  mapping_ = (const uint8_t*)mapping;
+  mappingLength_ = newLength;
+}
+
+void
+PersistentContentStore::close()
+{
+  if (mapping_) {
+    ::munmap((void*)mapping_, mappingLength_);
+    mapping_ = 0;
+  }
+  if (dataFile_ >= 0) {
+    ::close(dataFile_);
+    dataFile_ = -1;
+  }
+  if (indexFile_ >= 0) {
+    ::close(indexFile_);
+    indexFile_ = -1;
+  }
+}
+
+void
+PersistentContentStore::onInterest
+  (const ptr_lib::shared_ptr<const Name>& prefix,
+   const ptr_lib::shared_ptr<const Interest>& interest, Face& face,
+   uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filter,
+   const OnInterestCallback& onDataNotFound)
+{
+  BlobLite encoding = find(*interest);
+  if (!encoding.isNull())
+    // Send directly from the memory mapping.
+    face.send(encoding.buf(), encoding.size());
+  else if (onDataNotFound)
+    onDataNotFound(prefix, interest, face, interestFilterId, filter);
+}
+
+}
+
+#endif // NDN_CPP_HAVE_MMAP
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "rtt-estimator.hpp"
+
+using namespace std;
+
+namespace ndn {
+
+const double RttEstimator::ALPHA = 1.0 / 8;
+const double RttEstimator::BETA = 1.0 / 4;
+const int RttEstimator::K = 4;
+
+void
+RttEstimator::addMeasurement(Milliseconds rtt, double nExpectedSamples)
+{
+  if (sRtt_ < 0) {
+    // The first measurement.
+    sRtt_ = rtt;
+    rttVar_ = rtt / 2;
+  }
+  else {
+    if (nExpectedSamples < 1)
+      nExpectedSamples = 1;
+    double alpha = ALPHA / nExpectedSamples;
+    double beta = BETA / nExpectedSamples;
+    rttVar_ = (1 - beta) * rttVar_ + beta * fabs(sRtt_ - rtt);
+    sRtt_ = (1 - alpha) * sRtt_ + alpha * rtt;
+  }
+
+  rto_ = max(minRto_, min(maxRto_, sRtt_ + K * rttVar_));
+}
+
+void
+RttEstimator::backoffRto()
+{
+  rto_ = min(maxRto_, rto_ * 2);
+}
+
+}
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_RTT_ESTIMATOR_HPP
+#define NDN_RTT_ESTIMATOR_HPP
+
+#include <ndn-cpp/common.hpp>
+
+namespace ndn {
+
+/**
+ * An RttEstimator keeps a smoothed round-trip time and computes the
+ * retransmission timeout (RTO) as described in RFC 6298. The retransmission
+ * timer is backed off exponentially on each timeout until the next
+ * measurement.
+ */
+class RttEstimator {
+public:
+  /**
+   * Create an RttEstimator with no measurements, where getRto() returns
+   * initialRto.
+   * @param initialRto The RTO in milliseconds before the first measurement.
+   * @param minRto The lower bound for the RTO in milliseconds.
+   * @param maxRto The upper bound for the RTO in milliseconds, including after
+   * backoffRto().
+   */
+  RttEstimator(Milliseconds initialRto, Milliseconds minRto, Milliseconds maxRto)
+  : sRtt_(-1), rttVar_(-1), rto_(initialRto), minRto_(minRto), maxRto_(maxRto)
+  {
+  }
+
+  /**
+   * Update the smoothed RTT and the RTO with a new measurement. Following
+   * Karn's algorithm, the caller should only give measurements for Interests
+   * which were not retransmitted.
+   * @param rtt The measured round-trip time in milliseconds.
+   * @param nExpectedSamples (optional) The number of measurements expected in
+   * one RTT, such as the congestion window size. The gains are divided by
+   * this so that a large window does not make the estimate jump. If omitted,
+   * use 1.
+   */
+  void
+  addMeasurement(Milliseconds rtt, double nExpectedSamples = 1);
+
+  /**
+   * Double the RTO, up to the maximum, after a retransmission timeout.
+   */
+  void
+  backoffRto();
+
+  /**
+   * Get the current retransmission timeout.
+   * @return The RTO in milliseconds.
+   */
+  Milliseconds
+  getRto() const { return rto_; }
+
+  /**
+   * Get the smoothed RTT.
+   * @return The smoothed RTT in milliseconds, or -1 if there are no
+   * measurements yet.
+   */
+  Milliseconds
+  getSmoothedRtt() const { return sRtt_; }
+
+private:
+  // The gains and multiplier from RFC 6298 section 2.
+  static const double ALPHA;
+  static const double BETA;
+  static const int K;
+
+  Milliseconds sRtt_;
+  Milliseconds rttVar_;
+  Milliseconds rto_;
+  Milliseconds minRto_;
+  Milliseconds maxRto_;
+};
+
+}
+
+#endif
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#ifndef NDN_SCRATCH_ARRAY_HPP
+#define NDN_SCRATCH_ARRAY_HPP
+
+#include <vector>
+#include <ndn-cpp/common.hpp>
+#include <ndn-cpp/c/errors.h>
+
+namespace ndn {
+
+/**
+ * A ScratchArray holds a temporary array of elements such as the name
+ * components which a NameLite points to while encoding or decoding. The first
+ * N elements are held in the object itself, which is normally on the stack, and
+ * a larger array is allocated on the heap. So there is no fixed limit on the
+ * number of elements, and the common case does not allocate.
+ */
+template<class T, size_t N>
+class ScratchArray {
+public:
+  /**
+   * Create a ScratchArray with room for at least nElements.
+   * @param nElements The needed number of elements. If this is at most N, use
+   * the array in this object.
+   */
+  ScratchArray(size_t nElements = 0)
+  {
+    resize(nElements);
+  }
+
+  /**
+   * Make sure this has room for at least nElements. This does not preserve
+   * the previous elements.
+   * @param nElements The needed number of elements.
+   */
+  void
+  resize(size_t nElements)
+  {
+    if (nElements <= N) {
+      array_ = fixedArray_;
+      size_ = N;
+    }
+    else {
+      heapArray_.resize(nElements);
+      array_ = &heapArray_[0];
+      size_ = nElements;
+    }
+  }
+
+  /**
+   * Double the number of elements, for example to decode again after the
+   * decoder ran out of room.
+   */
+  void
+  grow() { resize(size_ * 2); }
+
+  /**
+   * Get a pointer to the array.
+   * @return The array pointer. This is invalidated by resize or grow.
+   */
+  T*
+  get() { return array_; }
+
+  /**
+   * Get the number of elements in the array returned by get().
+   * @return The number of elements, which is at least N.
+   */
+  size_t
+  size() const { return size_; }
+
+private:
+  // Don't allow copying since array_ may point into this object.
+  ScratchArray(const ScratchArray& other);
+  ScratchArray& operator=(const ScratchArray& other);
+
+  T fixedArray_[N];
+  std::vector<T> heapArray_;
+  T* array_;
+  size_t size_;
+};
+
+/**
+ * Check if the error from a Lite decoder is because a NameLite or ExcludeLite
+ * ran out of room, so that the caller can grow its ScratchArray objects and
+ * decode again.
+ * @param error The error code from the decoder.
+ * @return True if the caller should grow the arrays and decode again.
+ */
+static __inline bool
+isScratchArrayFullError(ndn_Error error)
+{
+  return error ==
+      NDN_ERROR_attempt_to_add_a_component_past_the_maximum_number_of_components_allowed_in_the_name ||
+    error == NDN_ERROR_cannot_add_an_entry_past_the_maximum_number_of_entries_allowed_in_the_exclude;
+}
+
+}
+
+#endif
@@ -21,8 +21,15 @@
  */
 
 #include <stdexcept>
+#include <algorithm>
+#include <sstream>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
 #include "../c/util/ndn_memory.h"
+#include "../c/util/time.h"
 #include <ndn-cpp/util/logging.hpp>
+#include "congestion-window.hpp"
 #include <ndn-cpp/util/segment-fetcher.hpp>
 
 using namespace std;
@@ -41,68 +48,380 @@ SegmentFetcher::DontVerifySegment(const ptr_lib::shared_ptr<Data>& data)
 void
 SegmentFetcher::fetch
   (Face& face, const Interest &baseInterest, const VerifySegment& verifySegment,
-   const OnComplete& onComplete, const OnError& onError)
+   const OnComplete& onComplete, const OnError& onError, const Options& options)
 {
   // Make a shared_ptr because we make callbacks with bind using
   //   shared_from_this() so the object remains allocated.
   ptr_lib::shared_ptr<SegmentFetcher> segmentFetcher
-    (new SegmentFetcher(face, 0, verifySegment, onComplete, onError));
-  segmentFetcher->fetchFirstSegment(baseInterest);
+    (new SegmentFetcher
+     (face, 0, verifySegment, onComplete, onError, options, baseInterest));
+  segmentFetcher->start();
 }
 
 void
 SegmentFetcher::fetch
   (Face& face, const Interest &baseInterest, KeyChain* validatorKeyChain,
-   const OnComplete& onComplete, const OnError& onError)
+   const OnComplete& onComplete, const OnError& onError, const Options& options)
 {
   // Make a shared_ptr because we make callbacks with bind using
   //   shared_from_this() so the object remains allocated.
   ptr_lib::shared_ptr<SegmentFetcher> segmentFetcher
     (new SegmentFetcher
      (face, validatorKeyChain, SegmentFetcher::DontVerifySegment, onComplete,
-      onError));
-  segmentFetcher->fetchFirstSegment(baseInterest);
+      onError, options, baseInterest));
+  segmentFetcher->start();
+}
+
+void
+SegmentFetcher::fetchStream
+  (Face& face, const Interest &baseInterest, KeyChain* validatorKeyChain,
+   const OnSegment& onSegment, const OnStreamComplete& onComplete,
+   const OnError& onError, const Options& options)
+{
+  ptr_lib::shared_ptr<SegmentFetcher> segmentFetcher
+    (new SegmentFetcher
+     (face, validatorKeyChain, SegmentFetcher::DontVerifySegment, OnComplete(),
+      onError, options, baseInterest));
+  segmentFetcher->onSegment_ = onSegment;
+  segmentFetcher->onStreamComplete_ = onComplete;
+  segmentFetcher->start();
+}
+
+void
+SegmentFetcher::fetchToFile
+  (Face& face, const Interest &baseInterest, KeyChain* validatorKeyChain,
+   int fd, uint64_t fileOffset, const OnStreamComplete& onComplete,
+   const OnError& onError, const Options& options)
+{
+  ptr_lib::shared_ptr<SegmentFetcher> segmentFetcher
+    (new SegmentFetcher
+     (face, validatorKeyChain, SegmentFetcher::DontVerifySegment, OnComplete(),
+      onError, options, baseInterest));
+  segmentFetcher->fd_ = fd;
+  segmentFetcher->fileOffset_ = fileOffset;
+  segmentFetcher->onStreamComplete_ = onComplete;
+  segmentFetcher->start();
+}
+
+SegmentFetcher::SegmentFetcher
+  (Face& face, KeyChain* validatorKeyChain, const VerifySegment& verifySegment,
+   const OnComplete& onComplete, const OnError& onError,
+   const Options& options, const Interest& baseInterest,
+   const ptr_lib::shared_ptr<CongestionWindow>& window, double priority)
+: face_(face), validatorKeyChain_(validatorKeyChain), verifySegment_(verifySegment),
+  onComplete_(onComplete), fd_(-1), fileOffset_(0), onError_(onError),
+  options_(options),
+  baseInterest_(baseInterest),
+  window_(window ? window : ptr_lib::make_shared<CongestionWindow>(options)),
+  priority_(priority > 0 ? priority : 1.0),
+  isStopped_(false), nInterestsInFlight_(0), nextSegmentNumber_(0),
+  finalSegmentNumber_(-1), needDiscoveryInterest_(true),
+  isDiscoveryPending_(false), isVersionDiscovered_(false),
+  discoverySendTime_(0), isDiscoveryRetransmitted_(false),
+  discoveryInterestId_(0), timeLastSegmentReceived_(0), rtoCheckCallId_(0),
+  nextSegmentToDeliver_(0), nBytesDelivered_(0), startTime_(0),
+  lastProgressTime_(0)
+{
+}
+
+void
+SegmentFetcher::start()
+{
+  timeLastSegmentReceived_ = ndn_getNowMilliseconds();
+  startTime_ = timeLastSegmentReceived_;
+  lastProgressTime_ = timeLastSegmentReceived_;
+
+  window_->addFetcher(shared_from_this());
+  window_->schedule();
+}
+
+bool
+SegmentFetcher::hasInterestToSend()
+{
+  if (isStopped_)
+    return false;
+  if (needDiscoveryInterest_)
+    return true;
+  if (!isVersionDiscovered_)
+    return false;
+
+  // Drop a segment which was cancelled after the FinalBlockId was known.
+  while (!retransmitQueue_.empty()) {
+    map<uint64_t, PendingSegment>::iterator entry =
+      pendingSegments_.find(retransmitQueue_.front());
+    if (entry != pendingSegments_.end() &&
+        entry->second.state == IN_RETRANSMIT_QUEUE)
+      return true;
+    retransmitQueue_.pop_front();
+  }
+
+  while ((finalSegmentNumber_ < 0 ||
+          nextSegmentNumber_ <= (uint64_t)finalSegmentNumber_) &&
+         // Don't request past the end of the bounded reorder buffer.
+         nextSegmentNumber_ <
+           nextSegmentToDeliver_ + options_.getMaxReorderSegments()) {
+    // Skip the segment from the discovery Interest if we already have it.
+    if (nextSegmentNumber_ >= nextSegmentToDeliver_ &&
+        receivedSegments_.find(nextSegmentNumber_) == receivedSegments_.end())
+      return true;
+    ++nextSegmentNumber_;
+  }
+
+  return false;
+}
+
+void
+SegmentFetcher::sendNextInterest()
+{
+  if (!hasInterestToSend())
+    return;
+
+  if (needDiscoveryInterest_)
+    sendDiscoveryInterest();
+  else if (!retransmitQueue_.empty()) {
+    uint64_t segment = retransmitQueue_.front();
+    retransmitQueue_.pop_front();
+    sendSegmentInterest(segment, true);
+  }
+  else {
+    // Increment first in case the Face answers inside expressInterest.
+    uint64_t segment = nextSegmentNumber_++;
+    sendSegmentInterest(segment, false);
+  }
 }
 
 void
-SegmentFetcher::fetchFirstSegment(const Interest& baseInterest)
+SegmentFetcher::sendDiscoveryInterest()
 {
-  Interest interest(baseInterest);
+  Interest interest(baseInterest_);
   interest.setChildSelector(1);
   interest.setMustBeFresh(true);
+  if (isDiscoveryRetransmitted_)
+    interest.refreshNonce();
 
-  face_.expressInterest
+  needDiscoveryInterest_ = false;
+  isDiscoveryPending_ = true;
+  onInterestSent();
+  discoverySendTime_ = ndn_getNowMilliseconds();
+  uint64_t pendingInterestId = face_.expressInterest
     (interest,
-     bind(&SegmentFetcher::onSegmentReceived, shared_from_this(), _1, _2),
-     bind(&SegmentFetcher::onTimeout, shared_from_this(), _1));
+     bind(&SegmentFetcher::onDiscoveryData, shared_from_this(), _1, _2),
+     bind(&SegmentFetcher::onDiscoveryTimeout, shared_from_this(), _1),
+     bind(&SegmentFetcher::onNetworkNack, shared_from_this(), _1, _2, -1));
+  // The Face may already have answered the Interest.
+  if (isDiscoveryPending_)
+    discoveryInterestId_ = pendingInterestId;
 }
 
 void
-SegmentFetcher::fetchNextSegment
-  (const Interest& originalInterest, const Name& dataName, uint64_t segment)
+SegmentFetcher::retryDiscoveryInterest()
+{
+  if (isStopped_)
+    return;
+
+  needDiscoveryInterest_ = true;
+  window_->schedule();
+}
+
+uint64_t
+SegmentFetcher::onInterestSent()
+{
+  ++nInterestsInFlight_;
+  return window_->onInterestSent();
+}
+
+void
+SegmentFetcher::onInterestDone()
+{
+  --nInterestsInFlight_;
+  window_->onInterestDone();
+}
+
+void
+SegmentFetcher::onDiscoveryData
+  (const ptr_lib::shared_ptr<const Interest>& interest,
+   const ptr_lib::shared_ptr<Data>& data)
+{
+  if (isStopped_)
+    return;
+
+  if (!isDiscoveryPending_)
+    return;
+  isDiscoveryPending_ = false;
+  discoveryInterestId_ = 0;
+  onInterestDone();
+  MillisecondsSince1970 now = ndn_getNowMilliseconds();
+  if (!isDiscoveryRetransmitted_)
+    window_->getRttEstimator().addMeasurement(now - discoverySendTime_);
+  timeLastSegmentReceived_ = now;
+
+  verify(data, true);
+}
+
+void
+SegmentFetcher::onDiscoveryTimeout
+  (const ptr_lib::shared_ptr<const Interest>& interest)
+{
+  if (isStopped_)
+    return;
+
+  if (!isDiscoveryPending_)
+    return;
+  isDiscoveryPending_ = false;
+  discoveryInterestId_ = 0;
+  onInterestDone();
+  if (checkMaxTimeout(interest->getName()))
+    return;
+
+  window_->getRttEstimator().backoffRto();
+  isDiscoveryRetransmitted_ = true;
+  retryDiscoveryInterest();
+}
+
+void
+SegmentFetcher::sendSegmentInterest(uint64_t segment, bool isRetransmission)
 {
   // Start with the original Interest to preserve any special selectors.
-  Interest interest(originalInterest);
+  Interest interest(baseInterest_);
   // Changing a field clears the nonce so that the library will generate a new one.
   interest.setChildSelector(0);
   interest.setMustBeFresh(false);
-  interest.setName(dataName.getPrefix(-1).appendSegment(segment));
+  interest.setName(Name(versionedDataName_).appendSegment(segment));
 
-  face_.expressInterest
+  uint64_t sendSequence = onInterestSent();
+  PendingSegment& pendingSegment = pendingSegments_[segment];
+  pendingSegment.state = (isRetransmission ? RETRANSMITTED : FIRST_INTEREST);
+  pendingSegment.sendTime = ndn_getNowMilliseconds();
+  pendingSegment.rto = window_->getRttEstimator().getRto();
+  pendingSegment.pendingInterestId = 0;
+  pendingSegment.sendSequence = sendSequence;
+
+  uint64_t pendingInterestId = face_.expressInterest
     (interest,
-     bind(&SegmentFetcher::onSegmentReceived, shared_from_this(), _1, _2),
-     bind(&SegmentFetcher::onTimeout, shared_from_this(), _1));
+     bind(&SegmentFetcher::onSegmentData, shared_from_this(), _1, _2, segment),
+     bind(&SegmentFetcher::onSegmentTimeout, shared_from_this(), _1, segment),
+     bind(&SegmentFetcher::onNetworkNack, shared_from_this(), _1, _2,
+          (int64_t)segment));
+
+  // The Face may already have answered the Interest, so find the entry again.
+  map<uint64_t, PendingSegment>::iterator entry = pendingSegments_.find(segment);
+  if (entry != pendingSegments_.end() && entry->second.sendSequence == sendSequence)
+    entry->second.pendingInterestId = pendingInterestId;
 }
 
 void
-SegmentFetcher::onSegmentReceived
-  (const ptr_lib::shared_ptr<const Interest>& originalInterest,
-   const ptr_lib::shared_ptr<Data>& data)
+SegmentFetcher::onSegmentData
+  (const ptr_lib::shared_ptr<const Interest>& interest,
+   const ptr_lib::shared_ptr<Data>& data, uint64_t segment)
+{
+  if (isStopped_)
+    return;
+
+  map<uint64_t, PendingSegment>::iterator entry = pendingSegments_.find(segment);
+  if (entry == pendingSegments_.end())
+    // We already cancelled this segment.
+    return;
+
+  MillisecondsSince1970 now = ndn_getNowMilliseconds();
+  if (entry->second.state == FIRST_INTEREST)
+    // Karn's algorithm: Don't measure the RTT of a retransmitted Interest.
+    window_->getRttEstimator().addMeasurement
+      (now - entry->second.sendTime, window_->getCwnd());
+  uint64_t sendSequence = entry->second.sendSequence;
+  if (entry->second.state != IN_RETRANSMIT_QUEUE)
+    onInterestDone();
+  pendingSegments_.erase(entry);
+
+  timeLastSegmentReceived_ = now;
+
+  if (data->getCongestionMark() > 0 && !options_.getIgnoreCongestionMarks())
+    window_->onCongestionSignal(sendSequence);
+  else
+    window_->increase();
+
+  verify(data, false);
+}
+
+void
+SegmentFetcher::onSegmentTimeout
+  (const ptr_lib::shared_ptr<const Interest>& interest, uint64_t segment)
+{
+  if (isStopped_)
+    return;
+
+  map<uint64_t, PendingSegment>::iterator entry = pendingSegments_.find(segment);
+  if (entry == pendingSegments_.end() ||
+      entry->second.state == IN_RETRANSMIT_QUEUE)
+    return;
+
+  // The Interest lifetime expired before the RTO check noticed.
+  uint64_t sendSequence = entry->second.sendSequence;
+  enqueueForRetransmission(entry);
+  window_->getRttEstimator().backoffRto();
+  window_->onCongestionSignal(sendSequence);
+  if (checkMaxTimeout(interest->getName()))
+    return;
+
+  window_->schedule();
+}
+
+void
+SegmentFetcher::onNetworkNack
+  (const ptr_lib::shared_ptr<const Interest>& interest,
+   const ptr_lib::shared_ptr<NetworkNack>& networkNack, int64_t segment)
+{
+  if (isStopped_)
+    return;
+
+  ndn_NetworkNackReason reason = networkNack->getReason();
+  if (reason != ndn_NetworkNackReason_CONGESTION &&
+      reason != ndn_NetworkNackReason_DUPLICATE) {
+    ostringstream message;
+    message << "Received a network Nack with reason " << reason <<
+      " for interest " << interest->getName().toUri();
+    reportError(NACK_ERROR, message.str());
+    return;
+  }
+
+  if (segment < 0) {
+    // The discovery Interest. Retry after the RTO.
+    if (!isDiscoveryPending_)
+      return;
+    isDiscoveryPending_ = false;
+    discoveryInterestId_ = 0;
+    onInterestDone();
+    if (checkMaxTimeout(interest->getName()))
+      return;
+    isDiscoveryRetransmitted_ = true;
+    face_.callLater
+      (window_->getRttEstimator().getRto(),
+       bind(&SegmentFetcher::retryDiscoveryInterest, shared_from_this()));
+    // Let other fetchers use the freed room in the window.
+    window_->schedule();
+    return;
+  }
+
+  map<uint64_t, PendingSegment>::iterator entry =
+    pendingSegments_.find((uint64_t)segment);
+  if (entry == pendingSegments_.end() ||
+      entry->second.state == IN_RETRANSMIT_QUEUE)
+    return;
+
+  // The Face has removed the pending Interest, so retransmit the segment.
+  uint64_t sendSequence = entry->second.sendSequence;
+  enqueueForRetransmission(entry);
+  if (reason == ndn_NetworkNackReason_CONGESTION)
+    window_->onCongestionSignal(sendSequence);
+  window_->schedule();
+}
+
+void
+SegmentFetcher::verify(const ptr_lib::shared_ptr<Data>& data, bool isDiscovery)
 {
   if (validatorKeyChain_)
     validatorKeyChain_->verifyData
       (data,
-       bind(&SegmentFetcher::onVerified, shared_from_this(), _1, originalInterest),
+       bind(&SegmentFetcher::onVerified, shared_from_this(), _1, isDiscovery),
        // Cast to disambiguate from the deprecated OnVerifyFailed.
        (const OnDataValidationFailed)bind
          (&SegmentFetcher::onValidationFailed, shared_from_this(), _1, _2));
@@ -112,137 +431,340 @@ SegmentFetcher::onSegmentReceived
       return;
     }
 
-    onVerified(data, originalInterest);
+    onVerified(data, isDiscovery);
   }
 }
 
 void
 SegmentFetcher::onVerified
-  (const ptr_lib::shared_ptr<Data>& data,
-   const ptr_lib::shared_ptr<const Interest>& originalInterest)
+  (const ptr_lib::shared_ptr<Data>& data, bool isDiscovery)
 {
+  if (isStopped_)
+    return;
+
   if (!endsWithSegmentNumber(data->getName())) {
     // We don't expect a name without a segment number.  Treat it as a bad packet.
-    try {
-      onError_
-        (DATA_HAS_NO_SEGMENT,
-         string("Got an unexpected packet without a segment number: ") +
-           data->getName().toUri());
-    } catch (const std::exception& ex) {
-      _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError: " << ex.what());
-    } catch (...) {
-      _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError.");
-    }
+    reportError
+      (DATA_HAS_NO_SEGMENT,
+       string("Got an unexpected packet without a segment number: ") +
+         data->getName().toUri());
+    return;
   }
-  else {
-    uint64_t currentSegment;
+
+  uint64_t currentSegment;
+  try {
+    currentSegment = data->getName().get(-1).toSegment();
+  }
+  catch (runtime_error& ex) {
+    reportError
+      (DATA_HAS_NO_SEGMENT,
+       string("Error decoding the name segment number ") +
+       data->getName().get(-1).toEscapedString() + ": " + ex.what());
+    return;
+  }
+
+  if (isDiscovery) {
+    versionedDataName_ = data->getName().getPrefix(-1);
+    isVersionDiscovered_ = true;
+    rtoCheckCallId_ = face_.callLater
+      (options_.getRtoCheckInterval(),
+       bind(&SegmentFetcher::checkRto, shared_from_this()));
+  }
+
+  if (data->getMetaInfo().getFinalBlockId().getValue().size() > 0 &&
+      finalSegmentNumber_ < 0) {
     try {
-      currentSegment = data->getName().get(-1).toSegment();
+      finalSegmentNumber_ = data->getMetaInfo().getFinalBlockId().toSegment();
     }
     catch (runtime_error& ex) {
-      try {
-        onError_
-          (DATA_HAS_NO_SEGMENT,
-           string("Error decoding the name segment number ") +
-           data->getName().get(-1).toEscapedString() + ": " + ex.what());
-      } catch (const std::exception& ex) {
-        _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError: " << ex.what());
-      } catch (...) {
-        _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError.");
-      }
+      reportError
+        (DATA_HAS_NO_SEGMENT,
+         string("Error decoding the FinalBlockId segment number ") +
+         data->getMetaInfo().getFinalBlockId().toEscapedString() + ": " +
+         ex.what());
       return;
     }
 
-    uint64_t expectedSegmentNumber = contentParts_.size();
-    if (currentSegment != expectedSegmentNumber)
-      // Try again to get the expected segment.  This also includes the case
-      //   where the first segment is not segment 0.
-      fetchNextSegment(*originalInterest, data->getName(), expectedSegmentNumber);
-    else {
-      // Save the content and check if we are finished.
-      contentParts_.push_back(data->getContent());
-
-      if (data->getMetaInfo().getFinalBlockId().getValue().size() > 0) {
-        uint64_t finalSegmentNumber;
-        try {
-          finalSegmentNumber = data->getMetaInfo().getFinalBlockId().toSegment();
-        }
-        catch (runtime_error& ex) {
-          try {
-            onError_
-              (DATA_HAS_NO_SEGMENT,
-               string("Error decoding the FinalBlockId segment number ") +
-               data->getMetaInfo().getFinalBlockId().toEscapedString() + ": " +
-               ex.what());
-          } catch (const std::exception& ex) {
-            _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError: " << ex.what());
-          } catch (...) {
-            _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError.");
-          }
-          return;
-        }
-
-        if (currentSegment == finalSegmentNumber) {
-          // We are finished.
-
-          // Get the total size and concatenate to get the content.
-          int totalSize = 0;
-          for (size_t i = 0; i < contentParts_.size(); ++i)
-            totalSize += contentParts_[i].size();
-          ptr_lib::shared_ptr<vector<uint8_t> > content
-            (new std::vector<uint8_t>(totalSize));
-          size_t offset = 0;
-          for (size_t i = 0; i < contentParts_.size(); ++i) {
-            const Blob& part = contentParts_[i];
-            ndn_memcpy(&(*content)[offset], part.buf(), part.size());
-            offset += part.size();
-          }
-
-          try {
-            onComplete_(Blob(content, false));
-          } catch (const std::exception& ex) {
-            _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onComplete: " << ex.what());
-          } catch (...) {
-            _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onComplete.");
-          }
-          return;
-        }
-      }
+    cancelSegmentsAfterFinal();
+  }
 
-      // Fetch the next segment.
-      fetchNextSegment
-        (*originalInterest, data->getName(), expectedSegmentNumber + 1);
-    }
+  if ((finalSegmentNumber_ < 0 ||
+       currentSegment <= (uint64_t)finalSegmentNumber_) &&
+      currentSegment >= nextSegmentToDeliver_) {
+    // Save the content in the reorder buffer. The discovered segment is kept
+    // if it is not segment 0 and hasInterestToSend skips it.
+    receivedSegments_[currentSegment] = data->getContent();
+    deliverSegments();
+    if (isStopped_)
+      return;
   }
+
+  if (finalSegmentNumber_ >= 0 &&
+      nextSegmentToDeliver_ > (uint64_t)finalSegmentNumber_) {
+    // We are finished.
+    finish();
+    return;
+  }
+
+  window_->schedule();
 }
 
 void
 SegmentFetcher::onValidationFailed
   (const ptr_lib::shared_ptr<Data>& data, const string& reason)
 {
+  reportError
+    (SEGMENT_VERIFICATION_FAILED,
+     "Segment verification failed for " + data->getName().toUri() +
+     " . Reason: " + reason);
+}
+
+void
+SegmentFetcher::checkRto()
+{
+  if (isStopped_)
+    return;
+
+  MillisecondsSince1970 now = ndn_getNowMilliseconds();
+  const Name* timedOutName = 0;
+  Name firstTimedOutName;
+  uint64_t maxSendSequence = 0;
+  for (map<uint64_t, PendingSegment>::iterator entry = pendingSegments_.begin();
+       entry != pendingSegments_.end(); ++entry) {
+    if (entry->second.state == IN_RETRANSMIT_QUEUE ||
+        now - entry->second.sendTime < entry->second.rto)
+      continue;
+
+    if (!timedOutName) {
+      firstTimedOutName = Name(versionedDataName_).appendSegment(entry->first);
+      timedOutName = &firstTimedOutName;
+    }
+    maxSendSequence = max(maxSendSequence, entry->second.sendSequence);
+    face_.removePendingInterest(entry->second.pendingInterestId);
+    enqueueForRetransmission(entry);
+  }
+
+  if (timedOutName) {
+    window_->getRttEstimator().backoffRto();
+    // Decrease the window once for the losses, unless it was already
+    // decreased after the last of them was sent.
+    window_->onCongestionSignal(maxSendSequence);
+    if (checkMaxTimeout(*timedOutName))
+      return;
+
+    window_->schedule();
+  }
+
+  if (!isStopped_)
+    rtoCheckCallId_ = face_.callLater
+      (options_.getRtoCheckInterval(),
+       bind(&SegmentFetcher::checkRto, shared_from_this()));
+}
+
+void
+SegmentFetcher::enqueueForRetransmission
+  (map<uint64_t, PendingSegment>::iterator entry)
+{
+  entry->second.state = IN_RETRANSMIT_QUEUE;
+  onInterestDone();
+  retransmitQueue_.push_back(entry->first);
+}
+
+bool
+SegmentFetcher::checkMaxTimeout(const Name& name)
+{
+  if (ndn_getNowMilliseconds() - timeLastSegmentReceived_ <
+      options_.getMaxTimeout())
+    return false;
+
+  reportError(INTEREST_TIMEOUT, string("Time out for interest ") + name.toUri());
+  return true;
+}
+
+void
+SegmentFetcher::cancelSegmentsAfterFinal()
+{
+  map<uint64_t, PendingSegment>::iterator entry =
+    pendingSegments_.upper_bound((uint64_t)finalSegmentNumber_);
+  while (entry != pendingSegments_.end()) {
+    if (entry->second.state != IN_RETRANSMIT_QUEUE) {
+      face_.removePendingInterest(entry->second.pendingInterestId);
+      onInterestDone();
+    }
+    // hasInterestToSend drops the entry if it is in retransmitQueue_.
+    pendingSegments_.erase(entry++);
+  }
+
+  receivedSegments_.erase
+    (receivedSegments_.upper_bound((uint64_t)finalSegmentNumber_),
+     receivedSegments_.end());
+}
+
+void
+SegmentFetcher::deliverSegments()
+{
+  while (!receivedSegments_.empty() &&
+         receivedSegments_.begin()->first == nextSegmentToDeliver_) {
+    map<uint64_t, Blob>::iterator front = receivedSegments_.begin();
+    Blob content = front->second;
+    receivedSegments_.erase(front);
+
+    if (!deliverSegment(nextSegmentToDeliver_, content))
+      return;
+    ++nextSegmentToDeliver_;
+    nBytesDelivered_ += content.size();
+  }
+
+  if (options_.getOnProgress() &&
+      ndn_getNowMilliseconds() - lastProgressTime_ >=
+        options_.getProgressInterval())
+    reportProgress();
+}
+
+bool
+SegmentFetcher::deliverSegment(uint64_t segment, const Blob& content)
+{
+  if (fd_ >= 0) {
+    // Write the whole content, retrying a partial write.
+    size_t nWritten = 0;
+    while (nWritten < content.size()) {
+      ssize_t result = pwrite
+        (fd_, content.buf() + nWritten, content.size() - nWritten,
+         (off_t)(fileOffset_ + nBytesDelivered_ + nWritten));
+      if (result < 0) {
+        if (errno == EINTR)
+          continue;
+
+        ostringstream message;
+        message << "Error writing segment " << segment << " to the file: " <<
+          strerror(errno);
+        reportError(IO_ERROR, message.str());
+        return false;
+      }
+      nWritten += result;
+    }
+  }
+  else if (onSegment_) {
+    try {
+      onSegment_(segment, content);
+    } catch (const std::exception& ex) {
+      _LOG_ERROR("SegmentFetcher::deliverSegment: Error in onSegment: " << ex.what());
+    } catch (...) {
+      _LOG_ERROR("SegmentFetcher::deliverSegment: Error in onSegment.");
+    }
+  }
+  else
+    contentParts_.push_back(content);
+
+  return !isStopped_;
+}
+
+void
+SegmentFetcher::reportProgress()
+{
+  MillisecondsSince1970 now = ndn_getNowMilliseconds();
+  lastProgressTime_ = now;
+  double bytesPerSecond = (now > startTime_ ?
+    nBytesDelivered_ / ((now - startTime_) / 1000.0) : 0);
+  int64_t nSegments = (finalSegmentNumber_ >= 0 ? finalSegmentNumber_ + 1 : -1);
+
   try {
-    onError_
-      (SEGMENT_VERIFICATION_FAILED,
-       "Segment verification failed for " + data->getName().toUri() +
-       " . Reason: " + reason);
+    options_.getOnProgress()
+      (nextSegmentToDeliver_, nSegments, nBytesDelivered_, bytesPerSecond);
   } catch (const std::exception& ex) {
-    _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError: " << ex.what());
+    _LOG_ERROR("SegmentFetcher::reportProgress: Error in onProgress: " << ex.what());
   } catch (...) {
-    _LOG_ERROR("SegmentFetcher::onSegmentReceived: Error in onError.");
+    _LOG_ERROR("SegmentFetcher::reportProgress: Error in onProgress.");
   }
 }
 
 void
-SegmentFetcher::onTimeout(const ptr_lib::shared_ptr<const Interest>& interest)
+SegmentFetcher::finish()
 {
+  // stop removes this from window_, so keep this allocated.
+  ptr_lib::shared_ptr<SegmentFetcher> self = shared_from_this();
+  stop();
+  if (options_.getOnProgress())
+    reportProgress();
+
+  if (onStreamComplete_) {
+    try {
+      onStreamComplete_(nBytesDelivered_);
+    } catch (const std::exception& ex) {
+      _LOG_ERROR("SegmentFetcher::finish: Error in onComplete: " << ex.what());
+    } catch (...) {
+      _LOG_ERROR("SegmentFetcher::finish: Error in onComplete.");
+    }
+    return;
+  }
+
+  // Concatenate the delivered segments to get the content.
+  ptr_lib::shared_ptr<vector<uint8_t> > content
+    (new std::vector<uint8_t>(nBytesDelivered_));
+  size_t offset = 0;
+  for (size_t i = 0; i < contentParts_.size(); ++i) {
+    const Blob& part = contentParts_[i];
+    if (part.size() > 0)
+      ndn_memcpy(&(*content)[offset], part.buf(), part.size());
+    offset += part.size();
+  }
+  contentParts_.clear();
+
+  try {
+    onComplete_(Blob(content, false));
+  } catch (const std::exception& ex) {
+    _LOG_ERROR("SegmentFetcher::finish: Error in onComplete: " << ex.what());
+  } catch (...) {
+    _LOG_ERROR("SegmentFetcher::finish: Error in onComplete.");
+  }
+}
+
+void
+SegmentFetcher::stop()
+{
+  if (isStopped_)
+    return;
+  isStopped_ = true;
+
+  for (map<uint64_t, PendingSegment>::iterator entry = pendingSegments_.begin();
+       entry != pendingSegments_.end(); ++entry) {
+    if (entry->second.state != IN_RETRANSMIT_QUEUE) {
+      face_.removePendingInterest(entry->second.pendingInterestId);
+      onInterestDone();
+    }
+  }
+  pendingSegments_.clear();
+  retransmitQueue_.clear();
+
+  if (isDiscoveryPending_) {
+    face_.removePendingInterest(discoveryInterestId_);
+    isDiscoveryPending_ = false;
+    discoveryInterestId_ = 0;
+    onInterestDone();
+  }
+  if (rtoCheckCallId_ != 0) {
+    face_.cancelCallLater(rtoCheckCallId_);
+    rtoCheckCallId_ = 0;
+  }
+
+  // Let the other fetchers which share the window use the freed room.
+  window_->removeFetcher(this);
+  window_->schedule();
+}
+
+void
+SegmentFetcher::reportError(ErrorCode errorCode, const string& message)
+{
+  // stop removes this from window_, so keep this allocated.
+  ptr_lib::shared_ptr<SegmentFetcher> self = shared_from_this();
+  stop();
+
   try {
-    onError_
-      (INTEREST_TIMEOUT,
-       string("Time out for interest ") + interest->getName().toUri());
+    onError_(errorCode, message);
   } catch (const std::exception& ex) {
-    _LOG_ERROR("SegmentFetcher::onTimeout: Error in onError: " << ex.what());
+    _LOG_ERROR("SegmentFetcher::reportError: Error in onError: " << ex.what());
   } catch (...) {
-    _LOG_ERROR("SegmentFetcher::onTimeout: Error in onError.");
+    _LOG_ERROR("SegmentFetcher::reportError: Error in onError.");
   }
 }
 
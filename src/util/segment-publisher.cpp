@@ -0,0 +1,344 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include <ndn-cpp/ndn-cpp-config.h>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <unistd.h>
+#if NDN_CPP_HAVE_POSIX_THREADS
+#include <pthread.h>
+#endif
+#include "../c/util/crypto.h"
+#include "../c/util/time.h"
+#include <ndn-cpp/digest-sha256-signature.hpp>
+#include <ndn-cpp/util/segment-publisher.hpp>
+
+using namespace std;
+
+namespace ndn {
+
+#if NDN_CPP_HAVE_POSIX_THREADS
+/**
+ * A SigningJob holds the signed portions of the segments for the worker
+ * threads, which take the next index under the lock and sign it with the TPM
+ * key. Each worker writes a different entry of signatures_.
+ */
+class SigningJob {
+public:
+  SigningJob
+    (Tpm& tpm, const Name& keyName, DigestAlgorithm digestAlgorithm,
+     const vector<SignedBlob>& encodings)
+  : tpm_(tpm), keyName_(keyName), digestAlgorithm_(digestAlgorithm),
+    encodings_(encodings), signatures_(encodings.size()), nextIndex_(0)
+  {
+    pthread_mutex_init(&lock_, 0);
+  }
+
+  ~SigningJob()
+  {
+    pthread_mutex_destroy(&lock_);
+  }
+
+  /**
+   * Sign encodings until none are left.
+   * @param job The SigningJob.
+   * @return 0.
+   */
+  static void*
+  runWorker(void* job);
+
+  Tpm& tpm_;
+  Name keyName_;
+  DigestAlgorithm digestAlgorithm_;
+  const vector<SignedBlob>& encodings_;
+  vector<Blob> signatures_;
+  size_t nextIndex_;
+  // The first error message, or empty for no error.
+  string error_;
+  pthread_mutex_t lock_;
+};
+
+void*
+SigningJob::runWorker(void* jobPointer)
+{
+  SigningJob& job = *(SigningJob*)jobPointer;
+
+  while (true) {
+    pthread_mutex_lock(&job.lock_);
+    size_t i = job.nextIndex_++;
+    bool isDone = (i >= job.encodings_.size() || !job.error_.empty());
+    pthread_mutex_unlock(&job.lock_);
+    if (isDone)
+      break;
+
+    // Sign without the lock. This is only safe because the Tpm already has
+    // the key handle from signing the first segment and keyName_ already has
+    // its cached hash for the Tpm key lookup, so this only reads shared state.
+    string error;
+    try {
+      job.signatures_[i] = job.tpm_.sign
+        (job.encodings_[i].signedBuf(), job.encodings_[i].signedSize(),
+         job.keyName_, job.digestAlgorithm_);
+      if (job.signatures_[i].isNull())
+        error = "The key " + job.keyName_.toUri() + " is not in the TPM";
+    } catch (const std::exception& ex) {
+      error = ex.what();
+    }
+
+    if (!error.empty()) {
+      pthread_mutex_lock(&job.lock_);
+      if (job.error_.empty())
+        job.error_ = error;
+      pthread_mutex_unlock(&job.lock_);
+    }
+  }
+
+  return 0;
+}
+#endif
+
+SegmentPublisher::SegmentPublisher
+  (KeyChain& keyChain, const SigningInfo& signingInfo, const Options& options)
+: keyChain_(keyChain), signingInfo_(signingInfo), options_(options),
+  nSegmentsPublished_(0), segmentsPerSecond_(0)
+{
+#if !NDN_CPP_HAVE_POSIX_THREADS
+  if (options_.getNThreads() > 1)
+    throw runtime_error
+      ("SegmentPublisher: Signing with multiple threads needs POSIX threads, which this library is not built with");
+#endif
+}
+
+Name
+SegmentPublisher::publish
+  (const Name& prefix, const uint8_t* content, size_t contentLength,
+   uint64_t version, vector<ptr_lib::shared_ptr<Data> >& segments)
+{
+  MillisecondsSince1970 startTime = ndn_getNowMilliseconds();
+
+  Name versionedName(prefix);
+  versionedName.appendVersion(version);
+
+  size_t segmentSize = max((size_t)1, options_.getSegmentSize());
+  // Empty content still has one segment.
+  uint64_t nSegments = (contentLength == 0 ?
+    1 : (contentLength + segmentSize - 1) / segmentSize);
+  Name::Component finalBlockId = Name::Component::fromSegment(nSegments - 1);
+
+  size_t begin = segments.size();
+  segments.reserve(begin + nSegments);
+  for (uint64_t segment = 0; segment < nSegments; ++segment) {
+    size_t offset = segment * segmentSize;
+    size_t size = min(segmentSize, contentLength - offset);
+
+    ptr_lib::shared_ptr<Data> data(new Data
+      (Name(versionedName).appendSegment(segment)));
+    data->setContent(Blob(content + offset, size));
+    if (options_.getFreshnessPeriod() >= 0)
+      data->getMetaInfo().setFreshnessPeriod(options_.getFreshnessPeriod());
+    data->getMetaInfo().setFinalBlockId(finalBlockId);
+    segments.push_back(data);
+  }
+
+  if (options_.getSigningMode() == SIGN_MANIFEST)
+    signWithManifest(segments, begin, versionedName);
+  else {
+    manifest_.reset();
+    signSegments(segments, begin);
+  }
+
+  nSegmentsPublished_ = nSegments;
+  double seconds = (ndn_getNowMilliseconds() - startTime) / 1000.0;
+  segmentsPerSecond_ = (seconds > 0 ? nSegments / seconds : 0);
+  return versionedName;
+}
+
+Name
+SegmentPublisher::publish
+  (const Name& prefix, const Blob& content,
+   vector<ptr_lib::shared_ptr<Data> >& segments)
+{
+  return publish
+    (prefix, content.buf(), content.size(), (uint64_t)ndn_getNowMilliseconds(),
+     segments);
+}
+
+Name
+SegmentPublisher::publish
+  (const Name& prefix, const Blob& content, MemoryContentCache& contentCache)
+{
+  vector<ptr_lib::shared_ptr<Data> > segments;
+  Name versionedName = publish(prefix, content, segments);
+
+  for (size_t i = 0; i < segments.size(); ++i)
+    contentCache.add(*segments[i]);
+
+  return versionedName;
+}
+
+Name
+SegmentPublisher::publishFile
+  (const Name& prefix, const string& filePath,
+   vector<ptr_lib::shared_ptr<Data> >& segments)
+{
+  ifstream file(filePath.c_str(), ios::in | ios::binary);
+  if (!file.good())
+    throw runtime_error("SegmentPublisher: Cannot open the file " + filePath);
+
+  file.seekg(0, ios::end);
+  streamoff fileSize = file.tellg();
+  file.seekg(0, ios::beg);
+  if (fileSize < 0)
+    throw runtime_error("SegmentPublisher: Cannot get the size of " + filePath);
+
+  ptr_lib::shared_ptr<vector<uint8_t> > content
+    (new vector<uint8_t>((size_t)fileSize));
+  if (fileSize > 0 && !file.read((char*)&(*content)[0], fileSize))
+    throw runtime_error("SegmentPublisher: Error reading the file " + filePath);
+
+  return publish(prefix, Blob(content, false), segments);
+}
+
+bool
+SegmentPublisher::verifyWithManifest
+  (const ptr_lib::shared_ptr<Data>& manifest,
+   const ptr_lib::shared_ptr<Data>& segment)
+{
+  const Name& name = segment->getName();
+  if (name.size() < 1 || !name.get(-1).isSegment() ||
+      manifest->getName().size() < 1 ||
+      !manifest->getName().getPrefix(-1).equals(name.getPrefix(-1)))
+    return false;
+
+  uint64_t segmentNumber = name.get(-1).toSegment();
+  const Blob& digests = manifest->getContent();
+  if (segmentNumber >= digests.size() / ndn_SHA256_DIGEST_SIZE)
+    return false;
+
+  Blob digest = segment->getFullName()->get(-1).getValue();
+  return digest.size() == ndn_SHA256_DIGEST_SIZE &&
+    equal(digest.buf(), digest.buf() + ndn_SHA256_DIGEST_SIZE,
+          digests.buf() + segmentNumber * ndn_SHA256_DIGEST_SIZE);
+}
+
+void
+SegmentPublisher::signSegments
+  (vector<ptr_lib::shared_ptr<Data> >& segments, size_t begin)
+{
+  if (begin >= segments.size())
+    return;
+
+  // Sign the first segment on this thread. This checks the SigningInfo and
+  // loads the key into the TPM.
+  keyChain_.sign(*segments[begin], signingInfo_);
+
+#if NDN_CPP_HAVE_POSIX_THREADS
+  size_t nThreads = options_.getNThreads();
+  if (nThreads == 0) {
+    long nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    nThreads = (nProcessors > 0 ? (size_t)nProcessors : 1);
+  }
+  const Signature* signature = segments[begin]->getSignature();
+  size_t nRemaining = segments.size() - begin - 1;
+  nThreads = min(nThreads, nRemaining);
+
+  if (nThreads > 1 && !keyChain_.getIsSecurityV1() &&
+      !dynamic_cast<const DigestSha256Signature*>(signature) &&
+      KeyLocator::canGetFromSignature(signature) &&
+      KeyLocator::getFromSignature(signature).getType() ==
+        ndn_KeyLocatorType_KEYNAME) {
+    // Encode the remaining segments with the same SignatureInfo to get the
+    // signed portions.
+    vector<SignedBlob> encodings;
+    encodings.reserve(nRemaining);
+    for (size_t i = begin + 1; i < segments.size(); ++i) {
+      segments[i]->setSignature(*signature);
+      encodings.push_back(segments[i]->wireEncode());
+    }
+
+    SigningJob job
+      (keyChain_.getTpm(), KeyLocator::getFromSignature(signature).getKeyName(),
+       signingInfo_.getDigestAlgorithm(), encodings);
+    // Name::hash() caches the hash code, so compute it here before the
+    // workers look up the key in the Tpm at the same time.
+    job.keyName_.hash();
+    vector<pthread_t> threads;
+    for (size_t i = 0; i < nThreads; ++i) {
+      pthread_t thread;
+      if (pthread_create(&thread, 0, &SigningJob::runWorker, &job) != 0)
+        // Use the threads which started, or sign on this thread below.
+        break;
+      threads.push_back(thread);
+    }
+    if (threads.size() == 0)
+      SigningJob::runWorker(&job);
+    for (size_t i = 0; i < threads.size(); ++i)
+      pthread_join(threads[i], 0);
+
+    if (!job.error_.empty())
+      throw KeyChain::Error("SegmentPublisher: Error signing: " + job.error_);
+
+    // Set the signature bits and encode again to include them.
+    for (size_t i = 0; i < nRemaining; ++i) {
+      Data& data = *segments[begin + 1 + i];
+      data.getSignature()->setSignature(job.signatures_[i]);
+      data.wireEncode();
+    }
+    return;
+  }
+#endif
+
+  for (size_t i = begin + 1; i < segments.size(); ++i)
+    keyChain_.sign(*segments[i], signingInfo_);
+}
+
+void
+SegmentPublisher::signWithManifest
+  (vector<ptr_lib::shared_ptr<Data> >& segments, size_t begin,
+   const Name& versionedName)
+{
+  SigningInfo digestSigningInfo(SigningInfo::SIGNER_TYPE_SHA256);
+  size_t nSegments = segments.size() - begin;
+  vector<const uint8_t*> encodings(nSegments);
+  vector<size_t> encodingLengths(nSegments);
+  for (size_t i = 0; i < nSegments; ++i) {
+    Data& data = *segments[begin + i];
+    keyChain_.sign(data, digestSigningInfo);
+    // The implicit digest is the digest of the full encoding.
+    SignedBlob encoding = data.wireEncode();
+    encodings[i] = encoding.buf();
+    encodingLengths[i] = encoding.size();
+  }
+
+  ptr_lib::shared_ptr<vector<uint8_t> > digests
+    (new vector<uint8_t>(nSegments * ndn_SHA256_DIGEST_SIZE));
+  ndn_digestSha256Multiple
+    (&encodings[0], &encodingLengths[0], nSegments, &(*digests)[0]);
+
+  manifest_.reset(new Data(Name(versionedName).append("_manifest")));
+  manifest_->setContent(Blob(digests, false));
+  if (options_.getFreshnessPeriod() >= 0)
+    manifest_->getMetaInfo().setFreshnessPeriod(options_.getFreshnessPeriod());
+  keyChain_.sign(*manifest_, signingInfo_);
+}
+
+}
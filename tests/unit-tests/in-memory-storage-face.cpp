@@ -64,10 +64,18 @@ InMemoryStorageFace::putData(const Data& data, WireFormat& wireFormat)
   sentData_.push_back(ptr_lib::make_shared<Data>(data));
 }
 
-void
+uint64_t
 InMemoryStorageFace::callLater(Milliseconds delayMilliseconds, const Face::Callback& callback)
 {
-  delayedCallTable_.callLater(delayMilliseconds, callback);
+  uint64_t callLaterId = ++lastCallLaterId_;
+  delayedCallTable_.callLater(callLaterId, delayMilliseconds, callback);
+  return callLaterId;
+}
+
+void
+InMemoryStorageFace::cancelCallLater(uint64_t callLaterId)
+{
+  delayedCallTable_.cancelCallLater(callLaterId);
 }
 
 void
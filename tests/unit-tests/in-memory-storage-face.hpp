@@ -37,7 +37,7 @@ class InMemoryStorageFace : public ndn::Face
 {
 public:
   InMemoryStorageFace(ndn::InMemoryStorageRetaining* storage)
-  : Face("localhost"), storage_(storage)
+  : Face("localhost"), storage_(storage), lastCallLaterId_(0)
   {
   }
 
@@ -60,10 +60,13 @@ public:
     (const ndn::Data& data,
      ndn::WireFormat& wireFormat = *ndn::WireFormat::getDefaultWireFormat());
 
-  virtual void
+  virtual uint64_t
   callLater
     (ndn::Milliseconds delayMilliseconds, const ndn::Face::Callback& callback);
 
+  virtual void
+  cancelCallLater(uint64_t callLaterId);
+
   virtual void
   processEvents();
 
@@ -84,6 +87,7 @@ public:
 private:
   ndn::InterestFilterTable interestFilterTable_;
   ndn::InMemoryStorageRetaining* storage_;
+  uint64_t lastCallLaterId_;
 };
 
 #endif
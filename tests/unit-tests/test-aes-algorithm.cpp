@@ -21,7 +21,9 @@
  */
 
 #include "gtest/gtest.h"
+#include <cstring>
 #include <ndn-cpp/encrypt/algo/aes-algorithm.hpp>
+#include <ndn-cpp/lite/encrypt/algo/aes-context-lite.hpp>
 
 using namespace std;
 using namespace ndn;
@@ -121,6 +123,140 @@ TEST_F(TestAesAlgorithm, KeyGeneration)
   ASSERT_TRUE(receivedBlob.equals(plainBlob));
 }
 
+TEST_F(TestAesAlgorithm, AesContext)
+{
+  // Check that a reused context gives the same CBC result as the one-shot
+  // encrypt.
+  AesContextLite cbcContext;
+  ASSERT_EQ(NDN_ERROR_success, cbcContext.setKey
+    (ndn_EncryptAlgorithmType_AesCbc, KEY, sizeof(KEY)));
+  ASSERT_EQ(sizeof(CIPHERTEXT_CBC_IV),
+            cbcContext.getEncryptedDataLength(sizeof(PLAINTEXT)));
+  for (int i = 0; i < 2; ++i) {
+    uint8_t encryptedData[sizeof(CIPHERTEXT_CBC_IV)];
+    size_t encryptedDataLength;
+    ASSERT_EQ(NDN_ERROR_success, cbcContext.encrypt
+      (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), 0, 0, PLAINTEXT,
+       sizeof(PLAINTEXT), encryptedData, encryptedDataLength));
+    ASSERT_TRUE(Blob(encryptedData, encryptedDataLength).equals
+      (Blob(CIPHERTEXT_CBC_IV, sizeof(CIPHERTEXT_CBC_IV))));
+
+    uint8_t plainData[sizeof(CIPHERTEXT_CBC_IV)];
+    size_t plainDataLength;
+    ASSERT_EQ(NDN_ERROR_success, cbcContext.decrypt
+      (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), 0, 0, encryptedData,
+       encryptedDataLength, plainData, plainDataLength));
+    ASSERT_TRUE(Blob(plainData, plainDataLength).equals
+      (Blob(PLAINTEXT, sizeof(PLAINTEXT))));
+  }
+}
+
+TEST_F(TestAesAlgorithm, AesContextGcm)
+{
+  // Test case 14 from the GCM specification, with a 256-bit zero key, a zero
+  // initial vector and one zero block.
+  uint8_t key[32] = { 0 };
+  uint8_t initialVector[12] = { 0 };
+  uint8_t plainData[16] = { 0 };
+  AesContextLite context;
+  ASSERT_EQ(NDN_ERROR_success, context.setKey
+    (ndn_EncryptAlgorithmType_AesGcm, key, sizeof(key)));
+
+  uint8_t encryptedData[sizeof(plainData) + ndn_AES_GCM_TAG_LENGTH];
+  size_t encryptedDataLength;
+  ASSERT_EQ(NDN_ERROR_success, context.encrypt
+    (initialVector, sizeof(initialVector), 0, 0, plainData, sizeof(plainData),
+     encryptedData, encryptedDataLength));
+  ASSERT_EQ(sizeof(encryptedData), encryptedDataLength);
+  // The encrypted data is the cipher text followed by the tag.
+  ASSERT_EQ
+    (string("cea7403d4d606b6e074ec5d3baf39d18") +
+       "d0d1c8a799996bf0265b98b5d48ab919",
+     Blob(encryptedData, encryptedDataLength).toHex());
+
+  uint8_t decryptedData[sizeof(encryptedData)];
+  size_t decryptedDataLength;
+  ASSERT_EQ(NDN_ERROR_success, context.decrypt
+    (initialVector, sizeof(initialVector), 0, 0, encryptedData,
+     encryptedDataLength, decryptedData, decryptedDataLength));
+  ASSERT_TRUE(Blob(decryptedData, decryptedDataLength).equals
+    (Blob(plainData, sizeof(plainData))));
+
+  // Changing the cipher text or the tag should fail authentication.
+  encryptedData[0] ^= 1;
+  ASSERT_EQ(NDN_ERROR_Error_in_decrypt_operation, context.decrypt
+    (initialVector, sizeof(initialVector), 0, 0, encryptedData,
+     encryptedDataLength, decryptedData, decryptedDataLength));
+  encryptedData[0] ^= 1;
+  encryptedData[encryptedDataLength - 1] ^= 1;
+  ASSERT_EQ(NDN_ERROR_Error_in_decrypt_operation, context.decrypt
+    (initialVector, sizeof(initialVector), 0, 0, encryptedData,
+     encryptedDataLength, decryptedData, decryptedDataLength));
+
+  // The tag covers the additional data, so decrypt must have the same.
+  const uint8_t additionalData[] = { 1, 2, 3 };
+  ASSERT_EQ(NDN_ERROR_success, context.encrypt
+    (initialVector, sizeof(initialVector), additionalData,
+     sizeof(additionalData), plainData, sizeof(plainData), encryptedData,
+     encryptedDataLength));
+  ASSERT_EQ(NDN_ERROR_success, context.decrypt
+    (initialVector, sizeof(initialVector), additionalData,
+     sizeof(additionalData), encryptedData, encryptedDataLength,
+     decryptedData, decryptedDataLength));
+  ASSERT_TRUE(Blob(decryptedData, decryptedDataLength).equals
+    (Blob(plainData, sizeof(plainData))));
+  ASSERT_EQ(NDN_ERROR_Error_in_decrypt_operation, context.decrypt
+    (initialVector, sizeof(initialVector), 0, 0, encryptedData,
+     encryptedDataLength, decryptedData, decryptedDataLength));
+  ASSERT_EQ(NDN_ERROR_Error_in_decrypt_operation, context.decrypt
+    (initialVector, sizeof(initialVector), additionalData,
+     sizeof(additionalData) - 1, encryptedData, encryptedDataLength,
+     decryptedData, decryptedDataLength));
+
+  // GCM needs a 12-byte initial vector.
+  ASSERT_EQ(NDN_ERROR_Incorrect_initial_vector_size, context.encrypt
+    (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), 0, 0, plainData, sizeof(plainData),
+     encryptedData, encryptedDataLength));
+}
+
+TEST_F(TestAesAlgorithm, AesContextCtr)
+{
+  AesContextLite context;
+  ASSERT_EQ(NDN_ERROR_success, context.setKey
+    (ndn_EncryptAlgorithmType_AesCtr, KEY, sizeof(KEY)));
+  ASSERT_EQ(sizeof(PLAINTEXT) + 1,
+            context.getEncryptedDataLength(sizeof(PLAINTEXT) + 1));
+
+  // Encrypt in place. CTR mode has no padding.
+  uint8_t data[sizeof(PLAINTEXT) + 1];
+  memcpy(data, PLAINTEXT, sizeof(PLAINTEXT));
+  data[sizeof(PLAINTEXT)] = '!';
+  Blob plainBlob(data, sizeof(data));
+  size_t length;
+  ASSERT_EQ(NDN_ERROR_success, context.encrypt
+    (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), 0, 0, data, sizeof(data), data,
+     length));
+  ASSERT_EQ(sizeof(data), length);
+  ASSERT_FALSE(Blob(data, length).equals(plainBlob));
+
+  ASSERT_EQ(NDN_ERROR_success, context.decrypt
+    (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), 0, 0, data, sizeof(data), data,
+     length));
+  ASSERT_TRUE(Blob(data, length).equals(plainBlob));
+
+  // Only GCM accepts additional data.
+  ASSERT_EQ(NDN_ERROR_Error_in_encrypt_operation, context.encrypt
+    (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), PLAINTEXT, 1, data, sizeof(data),
+     data, length));
+
+  // A context without a key is an error.
+  AesContextLite noKey;
+  ASSERT_FALSE(noKey.hasKey());
+  ASSERT_EQ(NDN_ERROR_Error_in_encrypt_operation, noKey.encrypt
+    (INITIAL_VECTOR, sizeof(INITIAL_VECTOR), 0, 0, data, sizeof(data), data,
+     length));
+}
+
 int
 main(int argc, char **argv)
 {
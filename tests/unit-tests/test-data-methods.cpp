@@ -29,9 +29,12 @@
 #include <ndn-cpp/security/key-chain.hpp>
 #include <ndn-cpp/sha256-with-rsa-signature.hpp>
 #include <ndn-cpp/generic-signature.hpp>
+#include <ndn-cpp/digest-sha256-signature.hpp>
+#include <ndn-cpp/hmac-with-sha256-signature.hpp>
 #include <ndn-cpp/lite/util/crypto-lite.hpp>
 #include <ndn-cpp/lite/lp/lp-packet-lite.hpp>
 #include <ndn-cpp/encoding/tlv-wire-format.hpp>
+#include <ndn-cpp/encoding/tlv-0_2-wire-format.hpp>
 #include <ndn-cpp/lite/encoding/tlv-0_2-wire-format-lite.hpp>
 #include "../../src/lp/lp-packet.hpp"
 
@@ -642,6 +645,158 @@ TEST_F(TestDataMethods, FullName)
   ASSERT_FALSE(data.getFullName()->get(-1).equals(saveFullName.get(-1)));
 }
 
+TEST_F(TestDataMethods, DigestSha256Multiple)
+{
+  // Use buffers which are smaller and larger than the sha-256 block size.
+  vector<Blob> buffers;
+  buffers.push_back(Blob(codedData, sizeof(codedData)));
+  buffers.push_back(Blob());
+  buffers.push_back(Blob(vector<uint8_t>(63, 1)));
+  buffers.push_back(Blob(vector<uint8_t>(1000, 2)));
+
+  vector<const uint8_t*> dataList;
+  vector<size_t> dataLengthList;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    dataList.push_back(buffers[i].buf());
+    dataLengthList.push_back(buffers[i].size());
+  }
+  vector<uint8_t> digests(buffers.size() * ndn_SHA256_DIGEST_SIZE);
+  CryptoLite::digestSha256Multiple
+    (&dataList[0], &dataLengthList[0], buffers.size(), &digests[0]);
+
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    uint8_t digest[ndn_SHA256_DIGEST_SIZE];
+    CryptoLite::digestSha256(buffers[i].buf(), buffers[i].size(), digest);
+    ASSERT_TRUE(Blob(digest, sizeof(digest)).equals
+      (Blob(&digests[i * ndn_SHA256_DIGEST_SIZE], ndn_SHA256_DIGEST_SIZE)));
+  }
+}
+
+TEST_F(TestDataMethods, HmacWithSha256)
+{
+  // Test cases 2 and 6 from RFC 4231, where test case 6 has a key which is
+  // larger than the block size.
+  string data1 = "what do ya want for nothing?";
+  uint8_t digest[ndn_SHA256_DIGEST_SIZE];
+  CryptoLite::computeHmacWithSha256
+    ((const uint8_t*)"Jefe", 4, (const uint8_t*)data1.c_str(), data1.size(),
+     digest);
+  ASSERT_EQ
+    ("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+     Blob(digest, sizeof(digest)).toHex());
+
+  vector<uint8_t> key2(131, 0xaa);
+  string data2 = "Test Using Larger Than Block-Size Key - Hash Key First";
+  CryptoLite::computeHmacWithSha256
+    (&key2[0], key2.size(), (const uint8_t*)data2.c_str(), data2.size(),
+     digest);
+  ASSERT_EQ
+    ("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+     Blob(digest, sizeof(digest)).toHex());
+
+  // Check signing and verifying a Data packet.
+  Blob key(vector<uint8_t>(32, 7));
+  HmacWithSha256Signature signature;
+  signature.getKeyLocator().setType(ndn_KeyLocatorType_KEYNAME);
+  signature.getKeyLocator().setKeyName(Name("/key"));
+  freshData->setSignature(signature);
+  KeyChain::signWithHmacWithSha256(*freshData, key);
+  ASSERT_TRUE(KeyChain::verifyDataWithHmacWithSha256(*freshData, key));
+  ASSERT_FALSE(KeyChain::verifyDataWithHmacWithSha256
+    (*freshData, Blob(vector<uint8_t>(32, 8))));
+}
+
+
+/**
+ * Check that the single-pass reverse encoder in Tlv0_3WireFormat produces the
+ * same encoding and signed portion as the two-pass encoder in
+ * Tlv0_2WireFormat.
+ */
+static void
+checkReverseEncoding(const Data& data)
+{
+  SignedBlob encoding = data.wireEncode(*Tlv0_3WireFormat::get());
+  SignedBlob expectedEncoding = data.wireEncode(*Tlv0_2WireFormat::get());
+
+  ASSERT_TRUE(expectedEncoding.equals(encoding));
+  ASSERT_EQ(expectedEncoding.getSignedPortionBeginOffset(),
+            encoding.getSignedPortionBeginOffset());
+  ASSERT_EQ(expectedEncoding.getSignedPortionEndOffset(),
+            encoding.getSignedPortionEndOffset());
+}
+
+TEST_F(TestDataMethods, ReverseEncode)
+{
+  Data data;
+  data.wireDecode(codedData, sizeof(codedData));
+  // Set the content again to clear the cached encoding so we encode again.
+  data.setContent(data.getContent());
+  checkReverseEncoding(data);
+
+  // Default fields and an empty name.
+  checkReverseEncoding(Data());
+
+  // A key locator digest and a validity period.
+  Sha256WithRsaSignature signature;
+  signature.getKeyLocator().setType(ndn_KeyLocatorType_KEY_LOCATOR_DIGEST);
+  signature.getKeyLocator().setKeyData(Blob(codedData, 32));
+  signature.getValidityPeriod().setPeriod(1438995600000.0, 1754528400000.0);
+  signature.setSignature(Blob(codedData, 256));
+  freshData->setSignature(signature);
+  freshData->getMetaInfo().setType(ndn_ContentType_KEY);
+  checkReverseEncoding(*freshData);
+
+  credentials.signDataWithSha256(*freshData);
+  checkReverseEncoding(*freshData);
+
+  // A long name, large content and a multi-byte final block ID.
+  Name name;
+  for (int i = 0; i < 150; ++i)
+    name.appendSegment(i * 1000);
+  freshData->setName(name);
+  freshData->setContent(Blob(DEFAULT_RSA_PRIVATE_KEY_DER,
+                             sizeof(DEFAULT_RSA_PRIVATE_KEY_DER)));
+  freshData->getMetaInfo().setFinalBlockId(Name::Component::fromSegment(70000));
+  credentials.signData(*freshData);
+  checkReverseEncoding(*freshData);
+
+  ptr_lib::shared_ptr<GenericSignature> genericSignature(new GenericSignature());
+  genericSignature->setSignatureInfoEncoding
+    (Blob(experimentalSignatureInfo, sizeof(experimentalSignatureInfo)), -1);
+  genericSignature->setSignature(Blob(codedData, 4));
+  freshData->setSignature(*genericSignature);
+  checkReverseEncoding(*freshData);
+}
+
+TEST_F(TestDataMethods, DecodeReused)
+{
+  // Imitate onReceivedElement which decodes into a Data object from its pool.
+  Data data;
+  data.wireDecode(codedData, sizeof(codedData));
+  Name codedFullName(*data.getFullName());
+  const Signature* codedSignature = data.getSignature();
+
+  // Decode a packet with a different name and the same signature type.
+  freshData->setName(Name("/ndn/other/name"));
+  credentials.signData(*freshData);
+  Blob freshEncoding = freshData->wireEncode();
+  data.wireDecode(freshEncoding);
+  ASSERT_EQ(Name("/ndn/other/name"), data.getName());
+  ASSERT_TRUE(freshEncoding.equals(data.wireEncode()));
+  ASSERT_EQ(*freshData->getFullName(), *data.getFullName());
+  ASSERT_FALSE(codedFullName.equals(*data.getFullName()));
+  ASSERT_EQ(codedSignature, data.getSignature()) <<
+    "Expected to reuse the Signature object";
+  // The Data must encode the same after we clear its cached encoding.
+  data.setContent(data.getContent());
+  ASSERT_TRUE(freshEncoding.equals(data.wireEncode()));
+
+  // Decode a packet with a different signature type.
+  credentials.signDataWithSha256(*freshData);
+  data.wireDecode(freshData->wireEncode());
+  ASSERT_TRUE(dynamic_cast<const DigestSha256Signature*>(data.getSignature()));
+  ASSERT_TRUE(freshData->wireEncode().equals(data.wireEncode()));
+}
 
 TEST_F(TestDataMethods, CongestionMark)
 {
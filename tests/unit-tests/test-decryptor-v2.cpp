@@ -24,6 +24,7 @@
 #include <cstdio>
 #include <ndn-cpp/security/validator-null.hpp>
 #include <ndn-cpp/encrypt/decryptor-v2.hpp>
+#include <ndn-cpp/encrypt/encryptor-v2.hpp>
 #include "identity-management-fixture.hpp"
 #include "in-memory-storage-face.hpp"
 #include "encrypt-static-data.hpp"
@@ -158,6 +159,127 @@ TEST_F(TestDecryptorV2, DecryptInvalid)
   ASSERT_EQ(1, callbacks.nFailures_);
 }
 
+static void
+onEncryptorError(EncryptError::ErrorCode errorCode, const string& message)
+{
+  FAIL() << "onError: " << message;
+}
+
+TEST_F(TestDecryptorV2, DecryptAesGcm)
+{
+  DecryptorFixture fixture(Name("/first/user"));
+
+  // The EncryptorV2 fetches the KEK from the same static data.
+  EncryptorV2 encryptor
+    (Name("/access/policy/identity/NAC/dataset"), Name("/some/ck/prefix"),
+     SigningInfo(SigningInfo::SIGNER_TYPE_SHA256), onEncryptorError,
+     &fixture.validator_, &fixture.keyChain_, &fixture.face_);
+  encryptor.setAlgorithmType(ndn_EncryptAlgorithmType_AesGcm);
+
+  // Encrypt directly into the Data content.
+  string text = "Data to encrypt with AES-GCM";
+  Blob plainText((const uint8_t*)text.c_str(), text.size());
+  Data data(Name("/some/data"));
+  encryptor.encrypt(plainText, data);
+
+  ptr_lib::shared_ptr<EncryptedContent> encryptedContent =
+    ptr_lib::make_shared<EncryptedContent>();
+  encryptedContent->wireDecodeV2(data.getContent());
+  ASSERT_EQ(ndn_EncryptAlgorithmType_AesGcm,
+            encryptedContent->getAlgorithmType());
+  ASSERT_EQ(ndn_AES_GCM_INITIAL_VECTOR_LENGTH,
+            encryptedContent->getInitialVector().size());
+  ASSERT_EQ(plainText.size() + ndn_AES_GCM_TAG_LENGTH,
+            encryptedContent->getPayload().size());
+  // The direct encoding should be the same as from wireEncodeV2.
+  ASSERT_TRUE(encryptedContent->wireEncodeV2().equals(data.getContent()));
+
+  // Put the CK Data from the EncryptorV2 where the DecryptorV2 can fetch it.
+  ptr_lib::shared_ptr<Interest> ckInterest =
+    ptr_lib::make_shared<Interest>(encryptedContent->getKeyLocatorName());
+  ckInterest->setCanBePrefix(true).setMustBeFresh(true);
+  fixture.face_.sentData_.clear();
+  fixture.face_.receive(ckInterest);
+  ASSERT_EQ(1, fixture.face_.sentData_.size());
+  fixture.storage_.insert(*fixture.face_.sentData_[0]);
+
+  class Callbacks {
+  public:
+    Callbacks(const Blob& expectedPlainText)
+    : nSuccesses_(0), nFailures_(0), expectedPlainText_(expectedPlainText)
+    {}
+
+    void
+    onSuccess(const Blob& plainData)
+    {
+      ++nSuccesses_;
+      ASSERT_TRUE(plainData.equals(expectedPlainText_));
+    }
+
+    void
+    onError(EncryptError::ErrorCode errorCode, const string& message)
+    {
+      ++nFailures_;
+    }
+
+    int nSuccesses_;
+    int nFailures_;
+    Blob expectedPlainText_;
+  };
+
+  Callbacks callbacks(plainText);
+  fixture.decryptor_->decrypt
+    (data,
+     bind(&Callbacks::onSuccess, &callbacks, _1),
+     bind(&Callbacks::onError, &callbacks, _1, _2));
+  ASSERT_EQ(1, callbacks.nSuccesses_);
+  ASSERT_EQ(0, callbacks.nFailures_);
+
+  // The tag covers the Data name, so the same content under another name or
+  // without a name should fail authentication.
+  Data movedData(Name("/other/data"));
+  movedData.setContent(data.getContent());
+  fixture.decryptor_->decrypt
+    (movedData,
+     bind(&Callbacks::onSuccess, &callbacks, _1),
+     bind(&Callbacks::onError, &callbacks, _1, _2));
+  ASSERT_EQ(1, callbacks.nSuccesses_);
+  ASSERT_EQ(1, callbacks.nFailures_);
+  fixture.decryptor_->decrypt
+    (encryptedContent,
+     bind(&Callbacks::onSuccess, &callbacks, _1),
+     bind(&Callbacks::onError, &callbacks, _1, _2));
+  ASSERT_EQ(1, callbacks.nSuccesses_);
+  ASSERT_EQ(2, callbacks.nFailures_);
+
+  // Content encrypted without a Data packet decrypts without a name.
+  ptr_lib::shared_ptr<EncryptedContent> namelessContent =
+    encryptor.encrypt(plainText);
+  fixture.decryptor_->decrypt
+    (namelessContent,
+     bind(&Callbacks::onSuccess, &callbacks, _1),
+     bind(&Callbacks::onError, &callbacks, _1, _2));
+  ASSERT_EQ(2, callbacks.nSuccesses_);
+  ASSERT_EQ(2, callbacks.nFailures_);
+
+  // A changed payload should fail authentication.
+  vector<uint8_t> payload
+    (encryptedContent->getPayload().buf(),
+     encryptedContent->getPayload().buf() +
+       encryptedContent->getPayload().size());
+  payload[0] ^= 1;
+  encryptedContent->setPayload(Blob(payload));
+  data.setContent(encryptedContent->wireEncodeV2());
+  fixture.decryptor_->decrypt
+    (data,
+     bind(&Callbacks::onSuccess, &callbacks, _1),
+     bind(&Callbacks::onError, &callbacks, _1, _2));
+  ASSERT_EQ(2, callbacks.nSuccesses_);
+  ASSERT_EQ(3, callbacks.nFailures_);
+
+  encryptor.shutdown();
+}
+
 int
 main(int argc, char **argv)
 {
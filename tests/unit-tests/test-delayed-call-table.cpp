@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include "../../src/impl/delayed-call-table.hpp"
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+class TestDelayedCallTable : public ::testing::Test {
+public:
+  void
+  onCall(int n) { calls_.push_back(n); }
+
+  void
+  callLater(uint64_t callLaterId, Milliseconds delayMilliseconds, int n)
+  {
+    delayedCallTable_.callLater
+      (callLaterId, delayMilliseconds,
+       bind(&TestDelayedCallTable::onCall, this, n));
+  }
+
+  DelayedCallTable delayedCallTable_;
+  vector<int> calls_;
+};
+
+TEST_F(TestDelayedCallTable, CallOrder)
+{
+  callLater(1, 3000, 3);
+  callLater(2, 1000, 1);
+  callLater(3, 2000, 2);
+  // The same call time as ID 3, so it should be called after it.
+  callLater(4, 2000, 4);
+
+  delayedCallTable_.callTimedOut();
+  ASSERT_EQ(0, calls_.size());
+
+  delayedCallTable_.setNowOffsetMilliseconds_(2500);
+  delayedCallTable_.callTimedOut();
+  ASSERT_EQ(3, calls_.size());
+  ASSERT_EQ(1, calls_[0]);
+  ASSERT_EQ(2, calls_[1]);
+  ASSERT_EQ(4, calls_[2]);
+  ASSERT_EQ(1, delayedCallTable_.size());
+
+  delayedCallTable_.setNowOffsetMilliseconds_(3500);
+  delayedCallTable_.callTimedOut();
+  ASSERT_EQ(4, calls_.size());
+  ASSERT_EQ(3, calls_[3]);
+  ASSERT_EQ(0, delayedCallTable_.size());
+}
+
+TEST_F(TestDelayedCallTable, Cancel)
+{
+  callLater(1, 1000, 1);
+  callLater(2, 2000, 2);
+  delayedCallTable_.cancelCallLater(1);
+  // Cancelling an unknown ID does nothing.
+  delayedCallTable_.cancelCallLater(99);
+  ASSERT_EQ(1, delayedCallTable_.size());
+
+  delayedCallTable_.setNowOffsetMilliseconds_(3000);
+  delayedCallTable_.callTimedOut();
+  ASSERT_EQ(1, calls_.size());
+  ASSERT_EQ(2, calls_[0]);
+
+  // Cancel most of many calls so that the table is compacted.
+  for (uint64_t id = 100; id < 1100; ++id)
+    callLater(id, 1000, (int)id);
+  for (uint64_t id = 100; id < 1100; ++id) {
+    if (id % 10 != 0)
+      delayedCallTable_.cancelCallLater(id);
+  }
+  ASSERT_EQ(100, delayedCallTable_.size());
+
+  calls_.clear();
+  delayedCallTable_.setNowOffsetMilliseconds_(5000);
+  delayedCallTable_.callTimedOut();
+  ASSERT_EQ(100, calls_.size());
+  for (size_t i = 0; i < calls_.size(); ++i)
+    ASSERT_EQ(100 + 10 * (int)i, calls_[i]);
+}
+
+TEST_F(TestDelayedCallTable, MillisecondsUntilNextCall)
+{
+  ASSERT_EQ(-1, delayedCallTable_.getMillisecondsUntilNextCall());
+
+  callLater(1, 1000, 1);
+  callLater(2, 5000, 2);
+  Milliseconds untilNextCall = delayedCallTable_.getMillisecondsUntilNextCall();
+  ASSERT_TRUE(untilNextCall > 900 && untilNextCall <= 1000);
+
+  // A cancelled call is not the next call.
+  delayedCallTable_.cancelCallLater(1);
+  untilNextCall = delayedCallTable_.getMillisecondsUntilNextCall();
+  ASSERT_TRUE(untilNextCall > 4900 && untilNextCall <= 5000);
+
+  delayedCallTable_.setNowOffsetMilliseconds_(6000);
+  ASSERT_EQ(0, delayedCallTable_.getMillisecondsUntilNextCall());
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
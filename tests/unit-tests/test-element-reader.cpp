@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <ndn-cpp/data.hpp>
+#include "../../src/c/encoding/element-reader.h"
+#include "../../src/encoding/element-listener.hpp"
+#include "../../src/util/dynamic-uint8-vector.hpp"
+
+using namespace std;
+using namespace ndn;
+
+class ElementCollector : public ElementListener {
+public:
+  virtual void
+  onReceivedElement(const uint8_t *element, size_t elementLength)
+  {
+    elements_.push_back(Blob(element, elementLength));
+  }
+
+  vector<Blob> elements_;
+};
+
+class TestElementReader : public ::testing::Test {
+public:
+  TestElementReader()
+  : buffer_(100)
+  {
+    ndn_ElementReader_initialize(&elementReader_, &collector_, &buffer_);
+  }
+
+  /**
+   * Make the encoding of a Data packet with the given content size.
+   */
+  static Blob
+  makeEncoding(size_t contentSize)
+  {
+    Data data(Name("/test/element-reader"));
+    data.setContent(Blob(vector<uint8_t>(contentSize, 0x5a)));
+    return data.wireEncode();
+  }
+
+  ElementCollector collector_;
+  DynamicUInt8Vector buffer_;
+  struct ndn_ElementReader elementReader_;
+};
+
+TEST_F(TestElementReader, Chunks)
+{
+  Blob encoding = makeEncoding(8000);
+
+  // Send an extra element after the first one to check the following bytes.
+  vector<uint8_t> input(encoding.buf(), encoding.buf() + encoding.size());
+  input.insert(input.end(), encoding.buf(), encoding.buf() + encoding.size());
+
+  for (size_t offset = 0; offset < input.size(); offset += 1000) {
+    size_t chunkLength = min((size_t)1000, input.size() - offset);
+    ASSERT_EQ(NDN_ERROR_success, ndn_ElementReader_onReceivedData
+      (&elementReader_, &input[offset], chunkLength));
+  }
+
+  ASSERT_EQ(2, collector_.elements_.size());
+  ASSERT_TRUE(collector_.elements_[0].equals(encoding));
+  ASSERT_TRUE(collector_.elements_[1].equals(encoding));
+}
+
+TEST_F(TestElementReader, ReceiveIntoBuffer)
+{
+  Blob encoding = makeEncoding(8000);
+  uint8_t *gap;
+  size_t gapLength;
+
+  // Before the type and length are read, there is no gap.
+  ndn_ElementReader_getReceiveBuffer(&elementReader_, &gap, &gapLength);
+  ASSERT_EQ(0, gapLength);
+  ASSERT_EQ(NDN_ERROR_success, ndn_ElementReader_onReceivedData
+    (&elementReader_, encoding.buf(), 2));
+  ndn_ElementReader_getReceiveBuffer(&elementReader_, &gap, &gapLength);
+  ASSERT_EQ(0, gapLength);
+
+  ASSERT_EQ(NDN_ERROR_success, ndn_ElementReader_onReceivedData
+    (&elementReader_, encoding.buf() + 2, 998));
+  // Now the reader knows the element length and has reserved the space.
+  ndn_ElementReader_getReceiveBuffer(&elementReader_, &gap, &gapLength);
+  ASSERT_EQ(encoding.size() - 1000, gapLength);
+
+  // Receive part of the rest into the gap.
+  ndn_memcpy(gap, encoding.buf() + 1000, 3000);
+  ASSERT_EQ(NDN_ERROR_success, ndn_ElementReader_onReceivedIntoBuffer
+    (&elementReader_, 3000));
+  ASSERT_EQ(0, collector_.elements_.size());
+
+  ndn_ElementReader_getReceiveBuffer(&elementReader_, &gap, &gapLength);
+  ASSERT_EQ(encoding.size() - 4000, gapLength);
+  ASSERT_EQ
+    (NDN_ERROR_ElementReader_received_more_bytes_than_the_receive_buffer_length,
+     ndn_ElementReader_onReceivedIntoBuffer(&elementReader_, gapLength + 1));
+
+  ndn_memcpy(gap, encoding.buf() + 4000, gapLength);
+  ASSERT_EQ(NDN_ERROR_success, ndn_ElementReader_onReceivedIntoBuffer
+    (&elementReader_, gapLength));
+  ASSERT_EQ(1, collector_.elements_.size());
+  ASSERT_TRUE(collector_.elements_[0].equals(encoding));
+
+  // The reader is ready for a new element.
+  ndn_ElementReader_getReceiveBuffer(&elementReader_, &gap, &gapLength);
+  ASSERT_EQ(0, gapLength);
+  ASSERT_EQ(NDN_ERROR_success, ndn_ElementReader_onReceivedData
+    (&elementReader_, encoding.buf(), encoding.size()));
+  ASSERT_EQ(2, collector_.elements_.size());
+}
+
+TEST_F(TestElementReader, MaxPacketSize)
+{
+  Blob encoding = makeEncoding(MAX_NDN_PACKET_SIZE + 1);
+
+  // The reader rejects the element as soon as it reads the length.
+  ASSERT_EQ
+    (NDN_ERROR_ElementReader_The_incoming_packet_exceeds_the_maximum_limit_getMaxNdnPacketSize,
+     ndn_ElementReader_onReceivedData(&elementReader_, encoding.buf(), 100));
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <ndn-cpp/transport/udp-transport.hpp>
+#include <ndn-cpp/util/event-loop.hpp>
+#include "../../src/c/util/time.h"
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+/**
+ * A LocalForwarder binds a UDP socket on the loopback interface so that a
+ * Face with a UdpTransport can send it Interests and receive Data.
+ */
+class LocalForwarder {
+public:
+  LocalForwarder()
+  {
+    socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    bind(socket_, (struct sockaddr *)&address, sizeof(address));
+    socklen_t addressLength = sizeof(address);
+    getsockname(socket_, (struct sockaddr *)&address, &addressLength);
+    port_ = ntohs(address.sin_port);
+  }
+
+  ~LocalForwarder() { close(socket_); }
+
+  ptr_lib::shared_ptr<Face>
+  makeFace(bool useBatchedIo = false)
+  {
+    return ptr_lib::make_shared<Face>
+      (ptr_lib::make_shared<UdpTransport>(useBatchedIo),
+       ptr_lib::make_shared<UdpTransport::ConnectionInfo>("127.0.0.1", port_));
+  }
+
+  /**
+   * Receive the Interest which a face sent, and send the Data back to it.
+   */
+  void
+  replyWithData(const Data& data)
+  {
+    uint8_t buffer[8800];
+    struct sockaddr_in fromAddress;
+    socklen_t fromAddressLength = sizeof(fromAddress);
+    recvfrom(socket_, buffer, sizeof(buffer), 0,
+             (struct sockaddr *)&fromAddress, &fromAddressLength);
+
+    Blob encoding = data.wireEncode();
+    sendto(socket_, encoding.buf(), encoding.size(), 0,
+           (struct sockaddr *)&fromAddress, fromAddressLength);
+  }
+
+  int socket_;
+  unsigned short port_;
+};
+
+class TestEventLoop : public ::testing::Test {
+public:
+  TestEventLoop()
+  : nData_(0), nTimeouts_(0)
+  {}
+
+  void
+  onData
+    (const ptr_lib::shared_ptr<const Interest>& interest,
+     const ptr_lib::shared_ptr<Data>& data, Face* face)
+  {
+    ++nData_;
+    if (face)
+      face->stop();
+  }
+
+  void
+  onTimeout(const ptr_lib::shared_ptr<const Interest>& interest, Face* face)
+  {
+    ++nTimeouts_;
+    if (face)
+      face->stop();
+  }
+
+  void
+  expressInterest
+    (Face& face, const Name& name, Milliseconds lifetime, Face* stopFace)
+  {
+    Interest interest(name);
+    interest.setMustBeFresh(false).setInterestLifetimeMilliseconds(lifetime);
+    face.expressInterest
+      (interest, bind(&TestEventLoop::onData, this, _1, _2, stopFace),
+       bind(&TestEventLoop::onTimeout, this, _1, stopFace));
+  }
+
+  LocalForwarder forwarder_;
+  int nData_;
+  int nTimeouts_;
+};
+
+TEST_F(TestEventLoop, RunUntilTimeout)
+{
+  ptr_lib::shared_ptr<Face> face = forwarder_.makeFace();
+  expressInterest(*face, Name("/test/timeout"), 200, face.get());
+
+  MillisecondsSince1970 start = ndn_getNowMilliseconds();
+  face->run();
+  MillisecondsSince1970 elapsed = ndn_getNowMilliseconds() - start;
+
+  ASSERT_EQ(1, nTimeouts_);
+  // run() should sleep until the Interest timeout, and not much longer.
+  ASSERT_TRUE(elapsed >= 190 && elapsed < 1000);
+}
+
+TEST_F(TestEventLoop, RunUntilData)
+{
+  ptr_lib::shared_ptr<Face> face = forwarder_.makeFace();
+  Name name("/test/data");
+  expressInterest(*face, name, 4000, face.get());
+  forwarder_.replyWithData(Data(name));
+
+  MillisecondsSince1970 start = ndn_getNowMilliseconds();
+  face->run();
+  MillisecondsSince1970 elapsed = ndn_getNowMilliseconds() - start;
+
+  ASSERT_EQ(1, nData_);
+  ASSERT_EQ(0, nTimeouts_);
+  // run() should wake up for the Data before the Interest timeout.
+  ASSERT_TRUE(elapsed < 1000);
+}
+
+TEST_F(TestEventLoop, RunFor)
+{
+  ptr_lib::shared_ptr<Face> face = forwarder_.makeFace();
+  // The Interest doesn't time out before runFor returns.
+  expressInterest(*face, Name("/test/timeout"), 4000, 0);
+
+  MillisecondsSince1970 start = ndn_getNowMilliseconds();
+  face->runFor(200);
+  MillisecondsSince1970 elapsed = ndn_getNowMilliseconds() - start;
+
+  ASSERT_EQ(0, nTimeouts_);
+  ASSERT_TRUE(elapsed >= 190 && elapsed < 1000);
+}
+
+TEST_F(TestEventLoop, MultipleFaces)
+{
+  ptr_lib::shared_ptr<Face> face1 = forwarder_.makeFace();
+  ptr_lib::shared_ptr<Face> face2 = forwarder_.makeFace();
+  EventLoop eventLoop;
+  eventLoop.addFace(*face1);
+  eventLoop.addFace(*face2);
+
+  Name name("/test/data");
+  expressInterest(*face1, name, 4000, 0);
+  forwarder_.replyWithData(Data(name));
+  expressInterest(*face2, Name("/test/timeout"), 200, 0);
+
+  // Run until after the Interest for face2 times out.
+  eventLoop.runFor(500);
+  ASSERT_EQ(1, nData_);
+  ASSERT_EQ(1, nTimeouts_);
+}
+
+TEST_F(TestEventLoop, BatchedUdpTransport)
+{
+  ptr_lib::shared_ptr<Face> face = forwarder_.makeFace(true);
+  Name name1("/test/data1");
+  Name name2("/test/data2");
+  expressInterest(*face, name1, 4000, 0);
+  expressInterest(*face, name2, 4000, 0);
+
+  // The batched transport queues the Interests until processEvents.
+  face->processEvents();
+  forwarder_.replyWithData(Data(name1));
+  forwarder_.replyWithData(Data(name2));
+
+  face->runFor(200);
+  ASSERT_EQ(2, nData_);
+  ASSERT_EQ(0, nTimeouts_);
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <pthread.h>
+#include <ndn-cpp/in-memory-storage/in-memory-storage-sharded.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static Interest
+makeInterest(const Name& name, bool canBePrefix)
+{
+  Interest interest(name);
+  interest.setCanBePrefix(canBePrefix);
+  return interest;
+}
+
+class TestInMemoryStorageSharded : public ::testing::Test {
+public:
+  TestInMemoryStorageSharded()
+  : storage_(8)
+  {
+  }
+
+  InMemoryStorageSharded storage_;
+};
+
+TEST_F(TestInMemoryStorageSharded, Find)
+{
+  storage_.insert(Data(Name("/a/c")));
+  storage_.insert(Data(Name("/a/b/1")));
+  storage_.insert(Data(Name("/a/b")));
+  storage_.insert(Data(Name("/x")));
+  ASSERT_EQ(4, storage_.size());
+  // Inserting the same packet replaces it.
+  storage_.insert(Data(Name("/x")));
+  ASSERT_EQ(4, storage_.size());
+
+  // The first Data packet with the prefix in the canonical order.
+  ASSERT_EQ(Name("/a/b"), storage_.find(Name("/a"))->getName());
+  ASSERT_EQ(Name("/a/b"), storage_.find(makeInterest(Name("/a"), true))->getName());
+  ASSERT_TRUE(!storage_.find(Name("/y")));
+
+  // Without CanBePrefix, only the exact name matches.
+  ASSERT_EQ(Name("/a/b"), storage_.find(makeInterest(Name("/a/b"), false))->getName());
+  ASSERT_TRUE(!storage_.find(makeInterest(Name("/a"), false)));
+
+  // Find by the full name.
+  Name fullName = *Data(Name("/a/c")).getFullName();
+  ASSERT_EQ(Name("/a/c"), storage_.find(makeInterest(fullName, false))->getName());
+  Name otherFullName = *Data(Name("/a/b/1")).getFullName();
+  ASSERT_TRUE(!storage_.find
+    (makeInterest(Name("/a/c").append(otherFullName.get(-1)), false)));
+}
+
+TEST_F(TestInMemoryStorageSharded, Remove)
+{
+  storage_.insert(Data(Name("/a/b")));
+  storage_.insert(Data(Name("/a/c")));
+  storage_.insert(Data(Name("/x")));
+
+  storage_.remove(Name("/a"));
+  ASSERT_EQ(1, storage_.size());
+  ASSERT_TRUE(!storage_.find(Name("/a")));
+  ASSERT_FALSE(!storage_.find(Name("/x")));
+}
+
+/**
+ * A ThreadParameters holds the storage and the thread number for
+ * insertAndFind.
+ */
+struct ThreadParameters {
+  InMemoryStorageSharded* storage;
+  int threadNumber;
+  int nFound;
+};
+
+static const int N_PACKETS_PER_THREAD = 500;
+
+static void*
+insertAndFind(void* arg)
+{
+  ThreadParameters* parameters = (ThreadParameters*)arg;
+  parameters->nFound = 0;
+  for (int i = 0; i < N_PACKETS_PER_THREAD; ++i) {
+    Name name("/thread");
+    name.appendSequenceNumber(parameters->threadNumber).appendSegment(i);
+    parameters->storage->insert(Data(name));
+
+    ptr_lib::shared_ptr<Data> data =
+      parameters->storage->find(makeInterest(name, false));
+    if (data && data->getName().equals(name))
+      ++parameters->nFound;
+  }
+
+  return 0;
+}
+
+TEST_F(TestInMemoryStorageSharded, MultipleThreads)
+{
+  const int nThreads = 4;
+  pthread_t threads[nThreads];
+  ThreadParameters parameters[nThreads];
+  for (int i = 0; i < nThreads; ++i) {
+    parameters[i].storage = &storage_;
+    parameters[i].threadNumber = i;
+    ASSERT_EQ(0, pthread_create(&threads[i], 0, insertAndFind, &parameters[i]));
+  }
+
+  for (int i = 0; i < nThreads; ++i) {
+    pthread_join(threads[i], 0);
+    ASSERT_EQ(N_PACKETS_PER_THREAD, parameters[i].nFound);
+  }
+
+  ASSERT_EQ(nThreads * N_PACKETS_PER_THREAD, storage_.size());
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <ndn-cpp/interest.hpp>
+#include "../../src/impl/interest-filter-table.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static void
+onInterest
+  (const ptr_lib::shared_ptr<const Name>& prefix,
+   const ptr_lib::shared_ptr<const Interest>& interest, Face& face,
+   uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filter)
+{
+}
+
+class TestInterestFilterTable : public ::testing::Test {
+public:
+  void
+  setInterestFilter(uint64_t interestFilterId, const InterestFilter& filter)
+  {
+    interestFilterTable_.setInterestFilter
+      (interestFilterId, ptr_lib::make_shared<InterestFilter>(filter),
+       onInterest, 0);
+  }
+
+  vector<uint64_t>
+  getMatchedIds(const Name& name)
+  {
+    vector<ptr_lib::shared_ptr<InterestFilterTable::Entry> > matchedFilters;
+    interestFilterTable_.getMatchedFilters(Interest(name), matchedFilters);
+
+    vector<uint64_t> result;
+    for (size_t i = 0; i < matchedFilters.size(); ++i)
+      result.push_back(matchedFilters[i]->getInterestFilterId());
+    return result;
+  }
+
+  InterestFilterTable interestFilterTable_;
+};
+
+TEST_F(TestInterestFilterTable, MatchPrefix)
+{
+  setInterestFilter(1, InterestFilter("/a/b"));
+  setInterestFilter(2, InterestFilter("/a"));
+  setInterestFilter(3, InterestFilter("/a/c"));
+  setInterestFilter(4, InterestFilter("/"));
+
+  // The matched filters are in the order they were added.
+  vector<uint64_t> ids = getMatchedIds(Name("/a/b/c"));
+  ASSERT_EQ(3, ids.size());
+  ASSERT_EQ(1, ids[0]);
+  ASSERT_EQ(2, ids[1]);
+  ASSERT_EQ(4, ids[2]);
+
+  ids = getMatchedIds(Name("/x"));
+  ASSERT_EQ(1, ids.size());
+  ASSERT_EQ(4, ids[0]);
+
+  interestFilterTable_.unsetInterestFilter(1);
+  ids = getMatchedIds(Name("/a/b/c"));
+  ASSERT_EQ(2, ids.size());
+  ASSERT_EQ(2, ids[0]);
+  ASSERT_EQ(4, ids[1]);
+}
+
+TEST_F(TestInterestFilterTable, MatchRegex)
+{
+  setInterestFilter(1, InterestFilter("/hello", "<world><>+"));
+
+  ASSERT_EQ(1, getMatchedIds(Name("/hello/world/!")).size());
+  ASSERT_EQ(1, getMatchedIds(Name("/hello/world/x/y/z")).size());
+  ASSERT_EQ(0, getMatchedIds(Name("/hello/world")).size());
+  ASSERT_EQ(0, getMatchedIds(Name("/hello/other/x")).size());
+  ASSERT_EQ(0, getMatchedIds(Name("/world/x")).size());
+  // Check again with the compiled matcher after the previous matches.
+  ASSERT_EQ(1, getMatchedIds(Name("/hello/world/!")).size());
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -30,7 +30,10 @@
 #include <ndn-cpp/digest-sha256-signature.hpp>
 #include <ndn-cpp/sha256-with-rsa-signature.hpp>
 #include <ndn-cpp/encoding/tlv-0_2-wire-format.hpp>
+#include <ndn-cpp/encoding/tlv-wire-format.hpp>
+#include <ndn-cpp/lite/encoding/tlv-0_3-wire-format-lite.hpp>
 #include <ndn-cpp/interest.hpp>
+#include "../../src/util/dynamic-uint8-vector.hpp"
 
 using namespace std;
 using namespace ndn;
@@ -574,6 +577,102 @@ TEST_F(TestInterestMethods, AppendParametersDigest)
     "params-sha256=a16cc669b4c9ef6801e1569488513f9523ffb28a39e53aa6e11add8d00a413fc");
 }
 
+TEST_F(TestInterestMethods, LongNameAndExclude)
+{
+  // There is no fixed limit on the number of name components or exclude
+  // entries to encode or decode.
+  Name name;
+  for (int i = 0; i < 150; ++i)
+    name.appendSegment(i);
+  Interest interest(name);
+  interest.setCanBePrefix(true);
+  for (int i = 0; i < 150; ++i)
+    interest.getExclude().appendComponent(Name::Component::fromSegment(i));
+
+  Interest decodedInterest;
+  decodedInterest.wireDecode(interest.wireEncode(*Tlv0_2WireFormat::get()),
+                             *Tlv0_2WireFormat::get());
+  ASSERT_TRUE(decodedInterest.getName().equals(name));
+  ASSERT_EQ(150, decodedInterest.getExclude().size());
+  ASSERT_EQ(interest.getExclude().toUri(), decodedInterest.getExclude().toUri());
+}
+
+/**
+ * Check that the single-pass reverse encoder produces the same encoding and
+ * signed portion as the two-pass encoder for NDN-TLV format v0.3. Use a small
+ * initial output buffer so that the reverse encoder must grow it.
+ */
+static void
+checkReverseEncoding(const Interest& interest)
+{
+  struct ndn_NameComponent nameComponents[200];
+  struct ndn_ExcludeEntry excludeEntries[10];
+  struct ndn_NameComponent keyNameComponents[10];
+  InterestLite interestLite
+    (nameComponents, sizeof(nameComponents) / sizeof(nameComponents[0]),
+     excludeEntries, sizeof(excludeEntries) / sizeof(excludeEntries[0]),
+     keyNameComponents,
+     sizeof(keyNameComponents) / sizeof(keyNameComponents[0]));
+  Blob blob1, blob2;
+  interest.get(interestLite, *TlvWireFormat::get(), blob1, blob2);
+
+  DynamicUInt8Vector expectedOutput(16);
+  size_t expectedBeginOffset, expectedEndOffset, expectedLength;
+  ASSERT_EQ(NDN_ERROR_success, Tlv0_3WireFormatLite::encodeInterest
+    (interestLite, &expectedBeginOffset, &expectedEndOffset,
+     DynamicUInt8ArrayLite::downCast(expectedOutput), &expectedLength));
+
+  DynamicUInt8Vector output(16);
+  size_t beginOffset, endOffset, length;
+  ASSERT_EQ(NDN_ERROR_success, Tlv0_3WireFormatLite::reverseEncodeInterest
+    (interestLite, &beginOffset, &endOffset,
+     DynamicUInt8ArrayLite::downCast(output), &length));
+
+  ASSERT_TRUE(expectedOutput.finish(expectedLength).equals
+              (output.finishFromBack(length)));
+  ASSERT_EQ(expectedBeginOffset, beginOffset);
+  ASSERT_EQ(expectedEndOffset, endOffset);
+}
+
+TEST_F(TestInterestMethods, ReverseEncode)
+{
+  // Use a fixed nonce so that both encoders don't make a random nonce. Changing
+  // the Interest removes the nonce, so set it before each check.
+  Blob nonce((const uint8_t*)"\x01\x02\x03\x04", 4);
+  Interest interest(Name("/ndn/abc"));
+  interest.setCanBePrefix(false);
+  interest.setNonce(nonce);
+  checkReverseEncoding(interest);
+
+  interest.setCanBePrefix(true);
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetimeMilliseconds(30000);
+  DelegationSet forwardingHint;
+  forwardingHint.add(1, Name("/A"));
+  forwardingHint.add(2, Name("/B/C"));
+  interest.setForwardingHint(forwardingHint);
+  interest.setNonce(nonce);
+  checkReverseEncoding(interest);
+
+  // A long name and ApplicationParameters longer than 252 bytes.
+  Name name;
+  for (int i = 0; i < 150; ++i)
+    name.appendSegment(i * 1000);
+  interest.setName(name);
+  vector<uint8_t> parameters(300, 7);
+  interest.setApplicationParameters(Blob(parameters));
+  interest.setNonce(nonce);
+  checkReverseEncoding(interest);
+
+  // Interest::wireEncode uses the reverse encoder. Check that it decodes.
+  Interest decodedInterest;
+  decodedInterest.wireDecode(interest.wireEncode());
+  ASSERT_TRUE(decodedInterest.getName().equals(interest.getName()));
+  ASSERT_TRUE(decodedInterest.getNonce().equals(interest.getNonce()));
+  ASSERT_EQ(300, decodedInterest.getApplicationParameters().size());
+  ASSERT_EQ(2, decodedInterest.getForwardingHint().size());
+}
+
 int
 main(int argc, char **argv)
 {
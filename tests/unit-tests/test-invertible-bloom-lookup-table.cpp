@@ -212,6 +212,97 @@ TEST_F(TestInvertibleBloomLookupTable, DifferenceBwOversizedIblts)
   ASSERT_TRUE(!receivedIblt.listEntries(positive, negative));
 }
 
+TEST_F(TestInvertibleBloomLookupTable, EncodeCache)
+{
+  size_t size = 10;
+
+  InvertibleBloomLookupTable iblt(size);
+  string prefix = Name("/test/memphis").appendNumber(1).toUri();
+  uint32_t hash1 = CryptoLite::murmurHash3(11, prefix.data(), prefix.size());
+  iblt.insert(hash1);
+
+  // Without a change, encode returns the cached encoding.
+  Blob encoding1 = iblt.encode();
+  ASSERT_EQ(encoding1.buf(), iblt.encode().buf());
+
+  prefix = Name("/test/memphis").appendNumber(2).toUri();
+  uint32_t hash2 = CryptoLite::murmurHash3(11, prefix.data(), prefix.size());
+  iblt.insert(hash2);
+  Blob encoding2 = iblt.encode();
+  ASSERT_FALSE(encoding1.equals(encoding2));
+
+  // The encoding after erase must match a fresh encoding of the same entries.
+  iblt.erase(hash2);
+  ASSERT_TRUE(iblt.encode().equals(encoding1));
+
+  InvertibleBloomLookupTable fresh(size);
+  fresh.insert(hash1);
+  ASSERT_TRUE(fresh.encode().equals(iblt.encode()));
+}
+
+TEST_F(TestInvertibleBloomLookupTable, SubtractAndPeel)
+{
+  size_t size = 10;
+
+  InvertibleBloomLookupTable ownIblt(size);
+  InvertibleBloomLookupTable receivedIblt(size);
+
+  string prefix = Name("/test/memphis").appendNumber(3).toUri();
+  uint32_t hash1 = CryptoLite::murmurHash3(11, prefix.data(), prefix.size());
+  ownIblt.insert(hash1);
+
+  string prefix2 = Name("/test/memphis").appendNumber(4).toUri();
+  uint32_t hash2 = CryptoLite::murmurHash3(11, prefix2.data(), prefix2.size());
+  receivedIblt.insert(hash2);
+
+  // Reuse a table which already has other entries and a cached encoding.
+  InvertibleBloomLookupTable scratch(size);
+  scratch.insert(hash2);
+  scratch.encode();
+
+  scratch = ownIblt;
+  scratch.subtract(receivedIblt);
+  ASSERT_TRUE(scratch.equals(*ownIblt.difference(receivedIblt)));
+  ASSERT_TRUE(scratch.encode().equals(ownIblt.difference(receivedIblt)->encode()));
+
+  set<uint32_t> positive;
+  set<uint32_t> negative;
+  ASSERT_TRUE(scratch.peel(positive, negative));
+  ASSERT_EQ(1, positive.size());
+  ASSERT_EQ(hash1, *positive.begin());
+  ASSERT_EQ(1, negative.size());
+  ASSERT_EQ(hash2, *negative.begin());
+
+  // All entries are peeled.
+  ASSERT_TRUE(scratch.equals(InvertibleBloomLookupTable(size)));
+
+  InvertibleBloomLookupTable differentSize(20);
+  ASSERT_THROW(scratch.subtract(differentSize), runtime_error);
+}
+
+TEST_F(TestInvertibleBloomLookupTable, InitializeReused)
+{
+  size_t size = 10;
+
+  InvertibleBloomLookupTable iblt1(size);
+  string prefix = Name("/test/memphis").appendNumber(1).toUri();
+  uint32_t hash1 = CryptoLite::murmurHash3(11, prefix.data(), prefix.size());
+  iblt1.insert(hash1);
+
+  InvertibleBloomLookupTable iblt2(size);
+  prefix = Name("/test/memphis").appendNumber(2).toUri();
+  uint32_t hash2 = CryptoLite::murmurHash3(11, prefix.data(), prefix.size());
+  iblt2.insert(hash2);
+
+  // Initializing a table which was used before must replace all its entries.
+  InvertibleBloomLookupTable received(size);
+  received.initialize(iblt1.encode());
+  ASSERT_TRUE(received.equals(iblt1));
+  received.initialize(iblt2.encode());
+  ASSERT_TRUE(received.equals(iblt2));
+  ASSERT_TRUE(received.encode().equals(iblt2.encode()));
+}
+
 int
 main(int argc, char **argv)
 {
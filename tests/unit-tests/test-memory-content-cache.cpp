@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <ndn-cpp/util/memory-content-cache.hpp>
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+/**
+ * CacheTestFace extends Face to remember the OnInterestCallback from
+ * setInterestFilter so that the test can deliver an Interest to it, and to
+ * remember each packet sent by the MemoryContentCache.
+ */
+class CacheTestFace : public Face {
+public:
+  CacheTestFace()
+  : Face("localhost")
+  {
+  }
+
+  virtual uint64_t
+  setInterestFilter(const Name& prefix, const OnInterestCallback& onInterest)
+  {
+    prefix_ = ptr_lib::make_shared<Name>(prefix);
+    onInterest_ = onInterest;
+    return 1;
+  }
+
+  virtual void
+  send(const uint8_t *encoding, size_t encodingLength)
+  {
+    ptr_lib::shared_ptr<Data> data(new Data());
+    data->wireDecode(encoding, encodingLength);
+    sentData_.push_back(data);
+  }
+
+  /**
+   * Call the OnInterestCallback with the interest.
+   * @param interest The Interest.
+   * @return The Data sent in reply, or null if none.
+   */
+  ptr_lib::shared_ptr<Data>
+  receive(const Interest& interest)
+  {
+    sentData_.clear();
+    onInterest_
+      (prefix_, ptr_lib::make_shared<Interest>(interest), *this, 1,
+       ptr_lib::shared_ptr<InterestFilter>());
+    return sentData_.size() > 0 ? sentData_[0] : ptr_lib::shared_ptr<Data>();
+  }
+
+  ptr_lib::shared_ptr<Name> prefix_;
+  OnInterestCallback onInterest_;
+  vector<ptr_lib::shared_ptr<Data> > sentData_;
+};
+
+static Data
+makeData(const Name& name, Milliseconds freshnessPeriod = -1)
+{
+  Data data(name);
+  data.setContent(Blob((const uint8_t*)"content", 7));
+  data.getMetaInfo().setFreshnessPeriod(freshnessPeriod);
+  return data;
+}
+
+static Interest
+makeInterest(const Name& name, bool canBePrefix)
+{
+  Interest interest(name);
+  interest.setCanBePrefix(canBePrefix);
+  return interest;
+}
+
+static void
+onContentRemoved
+  (const ptr_lib::shared_ptr<MemoryContentCache::ContentList>& contentList,
+   vector<Name>* removedNames)
+{
+  for (size_t i = 0; i < contentList->size(); ++i)
+    removedNames->push_back((*contentList)[i]->getName());
+}
+
+class TestMemoryContentCache : public ::testing::Test {
+public:
+  TestMemoryContentCache()
+  : cache_(&face_, 0.0)
+  {
+    cache_.setInterestFilter(Name("/"));
+  }
+
+  CacheTestFace face_;
+  MemoryContentCache cache_;
+};
+
+TEST_F(TestMemoryContentCache, ExactAndPrefix)
+{
+  cache_.add(makeData(Name("/a/b")));
+  cache_.add(makeData(Name("/a/b/1")));
+  cache_.add(makeData(Name("/a/c/2")));
+  ASSERT_EQ(3, cache_.getNEntries());
+
+  ptr_lib::shared_ptr<Data> data = face_.receive(makeInterest(Name("/a/b"), false));
+  ASSERT_TRUE(!!data);
+  ASSERT_EQ(Name("/a/b"), data->getName());
+
+  // Without CanBePrefix, a longer name doesn't match.
+  ASSERT_TRUE(!face_.receive(makeInterest(Name("/a/c"), false)));
+  data = face_.receive(makeInterest(Name("/a/c"), true));
+  ASSERT_TRUE(!!data);
+  ASSERT_EQ(Name("/a/c/2"), data->getName());
+
+  ASSERT_TRUE(!face_.receive(makeInterest(Name("/x"), true)));
+  ASSERT_EQ(2, cache_.getNHits());
+  ASSERT_EQ(2, cache_.getNMisses());
+
+  // Adding the same name replaces the content.
+  Data newData = makeData(Name("/a/b"));
+  newData.setContent(Blob((const uint8_t*)"new", 3));
+  cache_.add(newData);
+  ASSERT_EQ(3, cache_.getNEntries());
+  data = face_.receive(makeInterest(Name("/a/b"), false));
+  ASSERT_TRUE(newData.getContent().equals(data->getContent()));
+}
+
+TEST_F(TestMemoryContentCache, ChildSelector)
+{
+  cache_.add(makeData(Name("/a/2")));
+  cache_.add(makeData(Name("/a/1/x")));
+  cache_.add(makeData(Name("/a/3")));
+
+  Interest interest = makeInterest(Name("/a"), true);
+  interest.setChildSelector(0);
+  ASSERT_EQ(Name("/a/1/x"), face_.receive(interest)->getName());
+  interest.setChildSelector(1);
+  ASSERT_EQ(Name("/a/3"), face_.receive(interest)->getName());
+
+  // MaxSuffixComponents 2 only allows one more component plus the digest.
+  interest.setChildSelector(0);
+  interest.setMaxSuffixComponents(2);
+  ASSERT_EQ(Name("/a/2"), face_.receive(interest)->getName());
+}
+
+TEST_F(TestMemoryContentCache, MustBeFresh)
+{
+  cache_.add(makeData(Name("/a/stale"), 0));
+  cache_.setMinimumCacheLifetime(100000);
+  cache_.add(makeData(Name("/b/stale"), 0));
+  ASSERT_EQ(1, cache_.getNEntries());
+
+  Interest interest = makeInterest(Name("/b"), true);
+  ASSERT_TRUE(!!face_.receive(interest));
+  interest.setMustBeFresh(true);
+  ASSERT_TRUE(!face_.receive(interest));
+}
+
+TEST_F(TestMemoryContentCache, EvictLeastRecentlyUsed)
+{
+  vector<Name> removedNames;
+  cache_.setOnContentRemoved(bind(&onContentRemoved, _1, &removedNames));
+  cache_.setMaxEntries(3);
+
+  cache_.add(makeData(Name("/a/1")));
+  cache_.add(makeData(Name("/a/2")));
+  cache_.add(makeData(Name("/a/3")));
+  // Use /a/1 so that /a/2 is the least recently used.
+  ASSERT_TRUE(!!face_.receive(makeInterest(Name("/a/1"), false)));
+
+  cache_.add(makeData(Name("/a/4")));
+  ASSERT_EQ(3, cache_.getNEntries());
+  ASSERT_EQ(1, cache_.getNEvictions());
+  ASSERT_EQ(1, removedNames.size());
+  ASSERT_EQ(Name("/a/2"), removedNames[0]);
+  ASSERT_TRUE(!face_.receive(makeInterest(Name("/a/2"), false)));
+
+  // Limit the bytes to two packets.
+  size_t dataSize = makeData(Name("/a/1")).wireEncode().size();
+  cache_.setMaxBytes(2 * dataSize);
+  ASSERT_EQ(2, cache_.getNEntries());
+  ASSERT_EQ(2 * dataSize, cache_.getNBytes());
+  ASSERT_EQ(Name("/a/3"), removedNames[1]);
+
+  // Content larger than the limit is not added.
+  Data bigData(Name("/a/big"));
+  bigData.setContent(Blob(vector<uint8_t>(3 * dataSize)));
+  cache_.add(bigData);
+  ASSERT_EQ(2, cache_.getNEntries());
+  ASSERT_TRUE(!face_.receive(makeInterest(Name("/a/big"), false)));
+}
+
+TEST_F(TestMemoryContentCache, ReplaceNotifiesRemoved)
+{
+  vector<Name> removedNames;
+  cache_.setOnContentRemoved(bind(&onContentRemoved, _1, &removedNames));
+
+  cache_.add(makeData(Name("/a/1")));
+  ASSERT_EQ(0, removedNames.size());
+
+  Data newData = makeData(Name("/a/1"));
+  newData.setContent(Blob((const uint8_t*)"new", 3));
+  cache_.add(newData);
+  ASSERT_EQ(1, cache_.getNEntries());
+  ASSERT_EQ(1, removedNames.size());
+  ASSERT_EQ(Name("/a/1"), removedNames[0]);
+
+  ptr_lib::shared_ptr<Data> data =
+    face_.receive(makeInterest(Name("/a/1"), false));
+  ASSERT_TRUE(!!data);
+  ASSERT_TRUE(data->getContent().equals(Blob((const uint8_t*)"new", 3)));
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,6 +23,7 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <pthread.h>
 #include <ndn-cpp/name.hpp>
 #include <ndn-cpp/encoding/tlv-wire-format.hpp>
 
@@ -84,6 +85,35 @@ TEST_F(TestNameComponentMethods, Compare)
   ASSERT_TRUE(c80.compare(c7f) > 0) << "%80 should be greater than %7f";
 }
 
+TEST_F(TestNameComponentMethods, InlineValue)
+{
+  // Check values up to and past the size which is stored in place.
+  for (size_t size = 0; size <= Name::Component::MAX_INLINE_VALUE_SIZE + 1;
+       ++size) {
+    vector<uint8_t> value(size, 0x41);
+    Name::Component fromPointer(size > 0 ? &value[0] : (const uint8_t*)"", size);
+    Name::Component fromBlob((Blob(value)));
+
+    ASSERT_TRUE(fromPointer.equals(fromBlob));
+    ASSERT_EQ(0, fromPointer.compare(fromBlob));
+    ASSERT_EQ(fromBlob.hash(), fromPointer.hash());
+    ASSERT_EQ(fromBlob.toEscapedString(), fromPointer.toEscapedString());
+    ASSERT_TRUE(Blob(value).equals(fromPointer.getValue()));
+
+    // A copy has the same value, whether or not getValue() made the Blob.
+    Name::Component copy(fromPointer);
+    ASSERT_TRUE(copy.equals(fromBlob));
+    ASSERT_TRUE(Blob(value).equals(copy.getValue()));
+  }
+
+  ASSERT_TRUE(Name::Component().getValue().isNull());
+  ASSERT_FALSE(Name::Component().equals(Name::Component("")));
+  ASSERT_TRUE(Name::Component("").getValue().size() == 0);
+
+  ASSERT_EQ(1234, Name::Component::fromNumber(1234).toNumber());
+  ASSERT_EQ(12, Name::Component::fromSegment(12).toSegment());
+}
+
 class TestNameMethods : public ::testing::Test {
 public:
   TestNameMethods()
@@ -252,6 +282,28 @@ TEST_F(TestNameMethods, Match)
   ASSERT_TRUE(Name().match(name)) << "Empty name should always match another";
 }
 
+TEST_F(TestNameMethods, Hash)
+{
+  Name name("/edu/cmu/andrew/user");
+  Name copy(name.toUri());
+  ASSERT_EQ(copy.hash(), name.hash()) << "Equal names should have equal hashes";
+
+  // Appending to a name with a cached hash code updates it.
+  name.appendSequenceNumber(3498478);
+  Name expected("/edu/cmu/andrew/user");
+  expected.appendSequenceNumber(3498478);
+  ASSERT_EQ(expected.hash(), name.hash());
+  ASSERT_NE(copy.hash(), name.hash());
+
+  // Other changes invalidate the cached hash code.
+  name.clear();
+  name.append("edu").append("cmu").append("andrew").append("user");
+  ASSERT_EQ(copy.hash(), name.hash());
+
+  Name::Hash hasher;
+  ASSERT_EQ(name.hash(), hasher(name));
+}
+
 TEST_F(TestNameMethods, GetSuccessor)
 {
   ASSERT_EQ(Name("ndn:/%00%01/%01%03"), Name("ndn:/%00%01/%01%02").getSuccessor());
@@ -433,6 +485,79 @@ TEST_F(TestNameMethods, TypedNameComponent)
   ASSERT_EQ(otherTypeCode, decodedName.get(1).getOtherTypeCode());
 }
 
+TEST_F(TestNameMethods, LongName)
+{
+  // There is no fixed limit on the number of components to encode or decode.
+  Name name;
+  for (int i = 0; i < 300; ++i)
+    name.appendSegment(i);
+
+  Name decodedName;
+  decodedName.wireDecode(name.wireEncode());
+  ASSERT_EQ(300, decodedName.size());
+  ASSERT_TRUE(decodedName.equals(name));
+}
+
+static const int N_GET_VALUE_NAMES = 2000;
+
+class GetValueParameters {
+public:
+  const vector<Name>* names;
+  // The buffer of each component value Blob, in order.
+  vector<const uint8_t*> buffers;
+  bool valuesOk;
+};
+
+static void*
+getValues(void* arg)
+{
+  GetValueParameters* parameters = (GetValueParameters*)arg;
+  const vector<Name>& names = *parameters->names;
+  parameters->valuesOk = true;
+  for (size_t i = 0; i < names.size(); ++i) {
+    for (size_t j = 0; j < names[i].size(); ++j) {
+      const Blob& value = names[i][j].getValue();
+      if (!value.equals(Name::Component::fromSegment(j).getValue()))
+        parameters->valuesOk = false;
+      parameters->buffers.push_back(value.buf());
+    }
+  }
+
+  return 0;
+}
+
+TEST_F(TestNameMethods, GetValueMultipleThreads)
+{
+  // Each thread calls getValue() on the same const components stored in place
+  // and must get the same Blob.
+  vector<Name> names(N_GET_VALUE_NAMES);
+  for (size_t i = 0; i < names.size(); ++i) {
+    for (int j = 0; j < 4; ++j)
+      names[i].appendSegment(j);
+  }
+
+  const int nThreads = 4;
+  pthread_t threads[nThreads];
+  GetValueParameters parameters[nThreads];
+  for (int i = 0; i < nThreads; ++i) {
+    parameters[i].names = &names;
+    ASSERT_EQ(0, pthread_create(&threads[i], 0, getValues, &parameters[i]));
+  }
+
+  for (int i = 0; i < nThreads; ++i) {
+    pthread_join(threads[i], 0);
+    ASSERT_TRUE(parameters[i].valuesOk);
+  }
+
+  for (int i = 1; i < nThreads; ++i)
+    ASSERT_TRUE(parameters[i].buffers == parameters[0].buffers);
+
+  // A copy of a component doesn't share the Blob made for the original.
+  Name::Component copy(names[0][0]);
+  ASSERT_TRUE(copy.getValue().equals(names[0][0].getValue()));
+  ASSERT_TRUE(copy.getValue().buf() != names[0][0].getValue().buf());
+}
+
 int
 main(int argc, char **argv)
 {
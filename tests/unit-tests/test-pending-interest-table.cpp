@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <ndn-cpp/data.hpp>
+#include "../../src/impl/pending-interest-table.hpp"
+
+using namespace std;
+using namespace ndn;
+
+static void
+onData(const ptr_lib::shared_ptr<const Interest>& interest,
+       const ptr_lib::shared_ptr<Data>& data)
+{
+}
+
+static ptr_lib::shared_ptr<const Interest>
+makeInterest(const Name& name, bool canBePrefix)
+{
+  ptr_lib::shared_ptr<Interest> interest(new Interest(name));
+  interest->setCanBePrefix(canBePrefix);
+  return interest;
+}
+
+class TestPendingInterestTable : public ::testing::Test {
+public:
+  ptr_lib::shared_ptr<PendingInterestTable::Entry>
+  add(uint64_t pendingInterestId, const Name& name, bool canBePrefix)
+  {
+    return pendingInterestTable_.add
+      (pendingInterestId, makeInterest(name, canBePrefix), onData, OnTimeout(),
+       OnNetworkNack());
+  }
+
+  PendingInterestTable pendingInterestTable_;
+};
+
+TEST_F(TestPendingInterestTable, ExtractForData)
+{
+  add(1, Name("/a"), true);
+  add(2, Name("/a/b"), true);
+  add(3, Name("/a/b"), false);
+  add(4, Name("/a/b/c"), true);
+  add(5, Name("/x"), true);
+  add(6, Name("/a"), false);
+  ASSERT_EQ(6, pendingInterestTable_.size());
+
+  vector<ptr_lib::shared_ptr<PendingInterestTable::Entry> > entries;
+  pendingInterestTable_.extractEntriesForExpressedInterest
+    (Data(Name("/a/b")), entries);
+
+  // The most recent entries should be first.
+  ASSERT_EQ(3, entries.size());
+  ASSERT_EQ(3, entries[0]->getPendingInterestId());
+  ASSERT_EQ(2, entries[1]->getPendingInterestId());
+  ASSERT_EQ(1, entries[2]->getPendingInterestId());
+  for (size_t i = 0; i < entries.size(); ++i)
+    ASSERT_TRUE(entries[i]->getIsRemoved());
+  ASSERT_EQ(3, pendingInterestTable_.size());
+
+  // The entries are removed, so they don't match again.
+  entries.clear();
+  pendingInterestTable_.extractEntriesForExpressedInterest
+    (Data(Name("/a/b")), entries);
+  ASSERT_EQ(0, entries.size());
+
+  entries.clear();
+  pendingInterestTable_.extractEntriesForExpressedInterest
+    (Data(Name("/a/b/c/d")), entries);
+  ASSERT_EQ(1, entries.size());
+  ASSERT_EQ(4, entries[0]->getPendingInterestId());
+}
+
+TEST_F(TestPendingInterestTable, ExtractForDataFullName)
+{
+  Data data(Name("/a/b"));
+  add(1, *data.getFullName(), false);
+  add(2, Name(*data.getFullName()).append("c"), true);
+
+  vector<ptr_lib::shared_ptr<PendingInterestTable::Entry> > entries;
+  pendingInterestTable_.extractEntriesForExpressedInterest(data, entries);
+  ASSERT_EQ(1, entries.size());
+  ASSERT_EQ(1, entries[0]->getPendingInterestId());
+  ASSERT_EQ(1, pendingInterestTable_.size());
+}
+
+TEST_F(TestPendingInterestTable, Remove)
+{
+  ptr_lib::shared_ptr<PendingInterestTable::Entry> entry1 =
+    add(1, Name("/a/b"), true);
+  ptr_lib::shared_ptr<PendingInterestTable::Entry> entry2 =
+    add(2, Name("/a/b"), true);
+
+  pendingInterestTable_.removePendingInterest(1);
+  ASSERT_TRUE(entry1->getIsRemoved());
+  ASSERT_FALSE(pendingInterestTable_.removeEntry(entry1));
+  ASSERT_EQ(1, pendingInterestTable_.size());
+
+  ASSERT_TRUE(pendingInterestTable_.removeEntry(entry2));
+  ASSERT_EQ(0, pendingInterestTable_.size());
+
+  vector<ptr_lib::shared_ptr<PendingInterestTable::Entry> > entries;
+  pendingInterestTable_.extractEntriesForExpressedInterest
+    (Data(Name("/a/b")), entries);
+  ASSERT_EQ(0, entries.size());
+
+  // Removing before adding should prevent the add.
+  pendingInterestTable_.removePendingInterest(3);
+  ASSERT_TRUE(!add(3, Name("/a/b"), true));
+  ASSERT_FALSE(!add(4, Name("/a/b"), true));
+}
+
+static void
+onNetworkNack(const ptr_lib::shared_ptr<const Interest>& interest,
+              const ptr_lib::shared_ptr<NetworkNack>& networkNack)
+{
+}
+
+TEST_F(TestPendingInterestTable, ExtractForNack)
+{
+  ptr_lib::shared_ptr<Interest> interest1(new Interest(Name("/a/b")));
+  interest1->setNonce(Blob((const uint8_t*)"\x01\x02\x03\x04", 4));
+  ptr_lib::shared_ptr<Interest> interest2(new Interest(*interest1));
+  interest2->setNonce(Blob((const uint8_t*)"\x05\x06\x07\x08", 4));
+
+  pendingInterestTable_.add
+    (1, interest1, onData, OnTimeout(), onNetworkNack);
+  pendingInterestTable_.add
+    (2, interest2, onData, OnTimeout(), onNetworkNack);
+  // Without an OnNetworkNack, the entry is not returned for a Nack.
+  pendingInterestTable_.add
+    (3, ptr_lib::make_shared<Interest>(*interest1), onData, OnTimeout(),
+     OnNetworkNack());
+
+  vector<ptr_lib::shared_ptr<PendingInterestTable::Entry> > entries;
+  pendingInterestTable_.extractEntriesForNackInterest(*interest1, entries);
+  ASSERT_EQ(1, entries.size());
+  ASSERT_EQ(1, entries[0]->getPendingInterestId());
+  ASSERT_EQ(2, pendingInterestTable_.size());
+
+  // The same nonce with a different name doesn't match.
+  Interest otherName(*interest2);
+  otherName.setName(Name("/a/c"));
+  entries.clear();
+  pendingInterestTable_.extractEntriesForNackInterest(otherName, entries);
+  ASSERT_EQ(0, entries.size());
+
+  entries.clear();
+  pendingInterestTable_.extractEntriesForNackInterest(*interest2, entries);
+  ASSERT_EQ(1, entries.size());
+  ASSERT_EQ(2, entries[0]->getPendingInterestId());
+  ASSERT_EQ(1, pendingInterestTable_.size());
+}
+
+TEST_F(TestPendingInterestTable, ManyRemoveRequests)
+{
+  // Remove requests for IDs which are never added should not accumulate.
+  for (uint64_t id = 1; id <= 20000; ++id)
+    pendingInterestTable_.removePendingInterest(id);
+
+  // The oldest remove requests were dropped.
+  ASSERT_FALSE(!add(1, Name("/a/b"), true));
+  ASSERT_TRUE(!add(20000, Name("/a/b"), true));
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,269 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include <fstream>
+#include <stdexcept>
+#include <stdio.h>
+#include "gtest/gtest.h"
+#include <ndn-cpp/util/persistent-content-store.hpp>
+
+using namespace std;
+using namespace ndn;
+
+static bool
+fileExists(const string& filePath)
+{
+  ifstream stream(filePath.c_str());
+  bool result = (bool)stream;
+  stream.close();
+  return result;
+}
+
+static string
+getPolicyConfigDirectory()
+{
+  string policyConfigDirectory = "policy_config";
+  // Check if expected files are in this directory.
+  if (!fileExists(policyConfigDirectory + "/regex_ruleset.conf")) {
+    // Maybe we are running "make check" from the ndn-cpp root.  There may be
+    //   a way to tell "make check" to run from tests/unit-tests, but for
+    //   now just set policyConfigDirectory explicitly.
+    policyConfigDirectory = "tests/unit-tests/policy_config";
+
+    if(!fileExists(policyConfigDirectory + "/regex_ruleset.conf"))
+      throw runtime_error("Cannot find the directory for policy-config");
+  }
+
+  return policyConfigDirectory;
+}
+
+/**
+ * StoreTestFace extends Face to remember the OnInterestCallback from
+ * setInterestFilter so that the test can deliver an Interest to it, and to
+ * remember each packet sent by the PersistentContentStore.
+ */
+class StoreTestFace : public Face {
+public:
+  StoreTestFace()
+  : Face("localhost")
+  {
+  }
+
+  virtual uint64_t
+  setInterestFilter(const Name& prefix, const OnInterestCallback& onInterest)
+  {
+    prefix_ = ptr_lib::make_shared<Name>(prefix);
+    onInterest_ = onInterest;
+    return 1;
+  }
+
+  virtual void
+  send(const uint8_t *encoding, size_t encodingLength)
+  {
+    sentEncodings_.push_back(Blob(encoding, encodingLength));
+  }
+
+  ptr_lib::shared_ptr<Name> prefix_;
+  OnInterestCallback onInterest_;
+  vector<Blob> sentEncodings_;
+};
+
+static Data
+makeData(const Name& name, const string& content = "content")
+{
+  Data data(name);
+  data.setContent(Blob((const uint8_t*)content.c_str(), content.size()));
+  return data;
+}
+
+static Interest
+makeInterest(const Name& name, bool canBePrefix)
+{
+  Interest interest(name);
+  interest.setCanBePrefix(canBePrefix);
+  return interest;
+}
+
+static Name
+findName(const PersistentContentStore& store, const Interest& interest)
+{
+  BlobLite encoding = store.find(interest);
+  if (encoding.isNull())
+    return Name("/not-found");
+
+  Data data;
+  data.wireDecode(encoding.buf(), encoding.size());
+  return data.getName();
+}
+
+static void
+onDataNotFound
+  (const ptr_lib::shared_ptr<const Name>& prefix,
+   const ptr_lib::shared_ptr<const Interest>& interest, Face& face,
+   uint64_t interestFilterId,
+   const ptr_lib::shared_ptr<const InterestFilter>& filter,
+   int* nNotFound)
+{
+  ++(*nNotFound);
+}
+
+class TestPersistentContentStore : public ::testing::Test {
+public:
+  TestPersistentContentStore()
+  {
+    dataFilePath_ = getPolicyConfigDirectory() + "/test-content-store.dat";
+    indexFilePath_ = dataFilePath_ + ".index";
+    remove(dataFilePath_.c_str());
+    remove(indexFilePath_.c_str());
+  }
+
+  virtual void
+  TearDown()
+  {
+    remove(dataFilePath_.c_str());
+    remove(indexFilePath_.c_str());
+  }
+
+  string dataFilePath_;
+  string indexFilePath_;
+};
+
+TEST_F(TestPersistentContentStore, AddAndFind)
+{
+  PersistentContentStore store(dataFilePath_);
+  store.add(makeData(Name("/a/c")));
+  store.add(makeData(Name("/a/b/1")));
+  store.add(makeData(Name("/a/b")));
+  ASSERT_EQ(3, store.size());
+
+  ASSERT_EQ(Name("/a/b"), findName(store, makeInterest(Name("/a/b"), false)));
+  ASSERT_EQ(Name("/a/b"), findName(store, makeInterest(Name("/a"), true)));
+  ASSERT_EQ(Name("/not-found"), findName(store, makeInterest(Name("/a"), false)));
+  ASSERT_EQ(Name("/not-found"), findName(store, makeInterest(Name("/x"), true)));
+
+  // Find by the full name.
+  Name fullName = *makeData(Name("/a/c")).getFullName();
+  ASSERT_EQ(Name("/a/c"), findName(store, makeInterest(fullName, false)));
+  Name otherFullName = *makeData(Name("/a/c"), "other").getFullName();
+  ASSERT_EQ(Name("/not-found"), findName(store, makeInterest(otherFullName, false)));
+
+  // Adding the same name replaces it in the index.
+  Data newData = makeData(Name("/a/b"), "new");
+  store.add(newData);
+  ASSERT_EQ(3, store.size());
+  ASSERT_TRUE(newData.wireEncode().equals
+    (Blob(store.find(makeInterest(Name("/a/b"), false)))));
+}
+
+TEST_F(TestPersistentContentStore, SetInterestFilter)
+{
+  PersistentContentStore store(dataFilePath_);
+  Data data = makeData(Name("/a/b"));
+  store.add(data);
+
+  StoreTestFace face;
+  int nNotFound = 0;
+  store.setInterestFilter
+    (face, Name("/a"), func_lib::bind(&onDataNotFound, func_lib::_1,
+     func_lib::_2, func_lib::_3, func_lib::_4, func_lib::_5, &nNotFound));
+
+  face.onInterest_
+    (face.prefix_, ptr_lib::make_shared<Interest>
+     (makeInterest(Name("/a/b"), false)), face, 1,
+     ptr_lib::shared_ptr<InterestFilter>());
+  ASSERT_EQ(1, face.sentEncodings_.size());
+  ASSERT_TRUE(data.wireEncode().equals(face.sentEncodings_[0]));
+
+  face.onInterest_
+    (face.prefix_, ptr_lib::make_shared<Interest>
+     (makeInterest(Name("/a/x"), false)), face, 1,
+     ptr_lib::shared_ptr<InterestFilter>());
+  ASSERT_EQ(1, face.sentEncodings_.size());
+  ASSERT_EQ(1, nNotFound);
+}
+
+TEST_F(TestPersistentContentStore, Reopen)
+{
+  Blob encoding;
+  uint64_t nBytes;
+  {
+    PersistentContentStore store(dataFilePath_);
+    // Add enough to remap the Data file.
+    for (int i = 0; i < 2000; ++i) {
+      Data data(Name("/a").appendSegment(i));
+      data.setContent(Blob(vector<uint8_t>(1000, (uint8_t)i)));
+      store.add(data);
+      if (i == 1)
+        encoding = data.wireEncode();
+    }
+    nBytes = store.getNBytes();
+  }
+
+  PersistentContentStore store(dataFilePath_);
+  ASSERT_EQ(2000, store.size());
+  ASSERT_EQ(nBytes, store.getNBytes());
+  ASSERT_TRUE(encoding.equals(Blob(store.find
+    (makeInterest(Name("/a").appendSegment(1), false)))));
+}
+
+TEST_F(TestPersistentContentStore, Recover)
+{
+  Blob lastEncoding;
+  {
+    PersistentContentStore store(dataFilePath_);
+    store.add(makeData(Name("/a/1")));
+    store.add(makeData(Name("/a/2")));
+    lastEncoding = makeData(Name("/a/3")).wireEncode();
+  }
+
+  // Simulate a process which stopped while writing the Data file.
+  {
+    ofstream dataFile(dataFilePath_.c_str(), ios::binary | ios::app);
+    dataFile.write((const char*)lastEncoding.buf(), lastEncoding.size() / 2);
+  }
+  uint64_t nBytes;
+  {
+    PersistentContentStore store(dataFilePath_);
+    ASSERT_EQ(2, store.size());
+    nBytes = store.getNBytes();
+    ASSERT_EQ(2 * lastEncoding.size(), nBytes);
+
+    store.add(makeData(Name("/a/3")));
+  }
+
+  // Remove the index. The constructor rebuilds it from the Data file.
+  remove(indexFilePath_.c_str());
+  {
+    PersistentContentStore store(dataFilePath_);
+    ASSERT_EQ(3, store.size());
+    ASSERT_EQ(Name("/a/3"), findName(store, makeInterest(Name("/a/3"), false)));
+  }
+
+  PersistentContentStore store(dataFilePath_);
+  ASSERT_EQ(3, store.size());
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
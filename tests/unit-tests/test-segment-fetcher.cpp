@@ -0,0 +1,603 @@
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <ndn-cpp/util/fetch-scheduler.hpp>
+#include <ndn-cpp/lite/lp/lp-packet-lite.hpp>
+#include <ndn-cpp/lite/encoding/tlv-0_2-wire-format-lite.hpp>
+#include "../../src/lp/lp-packet.hpp"
+#include "../../src/impl/delayed-call-table.hpp"
+
+using namespace std;
+using namespace ndn;
+using namespace ndn::func_lib;
+
+static const uint8_t CONGESTION_MARK_LP_PACKET[] = {
+  0x64, 0x05, // LpPacket
+    0xfd, 0x03, 0x40, 0x01, 0x01 // CongestionMark = 1
+};
+
+/**
+ * LoopbackFace extends Face to answer Interests for the segments of one or
+ * more objects. Interests are queued by expressInterest and answered by
+ * processEvents, so that each call to processEvents is one round trip and the
+ * number of queued Interests is the number in flight. A test can make the
+ * Face drop or Nack an Interest for a segment once, or add a CongestionMark
+ * to every Data packet.
+ */
+class LoopbackFace : public Face
+{
+public:
+  LoopbackFace(const Name& prefix, int nSegments)
+  : Face("localhost"), maxInFlight_(0), markAllData_(false),
+    lastPendingInterestId_(0), lastCallLaterId_(0)
+  {
+    addObject(prefix, nSegments);
+    expectedContent_ = objects_[0].expectedContent;
+  }
+
+  /**
+   * Add another object to answer Interests for.
+   * @return The expected content of the object.
+   */
+  const vector<uint8_t>&
+  addObject(const Name& prefix, int nSegments)
+  {
+    objects_.push_back(Object());
+    Object& object = objects_.back();
+    object.prefix = prefix;
+    Name versionedName(prefix);
+    versionedName.appendVersion(1);
+    for (int i = 0; i < nSegments; ++i) {
+      ptr_lib::shared_ptr<Data> data(new Data(Name(versionedName).appendSegment(i)));
+      uint8_t content[] = { (uint8_t)i, (uint8_t)(i + 1), (uint8_t)(i + 2) };
+      data->setContent(content, sizeof(content));
+      data->getMetaInfo().setFinalBlockId(Name::Component::fromSegment(nSegments - 1));
+      object.segments.push_back(data);
+
+      object.expectedContent.insert
+        (object.expectedContent.end(), content, content + sizeof(content));
+    }
+
+    return object.expectedContent;
+  }
+
+  virtual uint64_t
+  expressInterest
+    (const Interest& interest, const OnData& onData,
+     const OnTimeout& onTimeout, const OnNetworkNack& onNetworkNack,
+     WireFormat& wireFormat = *WireFormat::getDefaultWireFormat())
+  {
+    uint64_t pendingInterestId = ++lastPendingInterestId_;
+    PendingInterest& entry = pendingInterests_[pendingInterestId];
+    entry.interest.reset(new Interest(interest));
+    entry.onData = onData;
+    entry.onTimeout = onTimeout;
+    entry.onNetworkNack = onNetworkNack;
+    sentInterests_.push_back(entry.interest);
+    return pendingInterestId;
+  }
+
+  virtual void
+  removePendingInterest(uint64_t pendingInterestId)
+  {
+    pendingInterests_.erase(pendingInterestId);
+  }
+
+  virtual uint64_t
+  callLater(Milliseconds delayMilliseconds, const Face::Callback& callback)
+  {
+    uint64_t callLaterId = ++lastCallLaterId_;
+    delayedCallTable_.callLater(callLaterId, delayMilliseconds, callback);
+    return callLaterId;
+  }
+
+  virtual void
+  cancelCallLater(uint64_t callLaterId)
+  {
+    delayedCallTable_.cancelCallLater(callLaterId);
+  }
+
+  virtual void
+  processEvents()
+  {
+    delayedCallTable_.callTimedOut();
+
+    // Only answer the Interests which are pending now.
+    vector<uint64_t> pendingInterestIds;
+    for (map<uint64_t, PendingInterest>::iterator entry = pendingInterests_.begin();
+         entry != pendingInterests_.end(); ++entry)
+      pendingInterestIds.push_back(entry->first);
+    if (pendingInterestIds.size() > maxInFlight_)
+      maxInFlight_ = pendingInterestIds.size();
+
+    for (size_t i = 0; i < pendingInterestIds.size(); ++i) {
+      map<uint64_t, PendingInterest>::iterator entry =
+        pendingInterests_.find(pendingInterestIds[i]);
+      if (entry == pendingInterests_.end())
+        // The SegmentFetcher removed it.
+        continue;
+      PendingInterest pendingInterest = entry->second;
+      pendingInterests_.erase(entry);
+
+      const Name& name = pendingInterest.interest->getName();
+      // The discovery Interest gets segment 0.
+      uint64_t segment = name.get(-1).isSegment() ? name.get(-1).toSegment() : 0;
+      const vector<ptr_lib::shared_ptr<Data> >* segments = 0;
+      for (size_t j = 0; j < objects_.size(); ++j) {
+        if (objects_[j].prefix.match(name)) {
+          segments = &objects_[j].segments;
+          break;
+        }
+      }
+
+      if (dropSegments_.erase(segment) > 0)
+        pendingInterest.onTimeout(pendingInterest.interest);
+      else if (nackSegments_.find(segment) != nackSegments_.end()) {
+        ptr_lib::shared_ptr<NetworkNack> networkNack(new NetworkNack());
+        networkNack->setReason(nackSegments_[segment]);
+        nackSegments_.erase(segment);
+        pendingInterest.onNetworkNack(pendingInterest.interest, networkNack);
+      }
+      else if (segments && segment < segments->size()) {
+        ptr_lib::shared_ptr<Data> data(new Data(*(*segments)[segment]));
+        if (markAllData_)
+          data->setLpPacket(makeCongestionMarkLpPacket());
+        pendingInterest.onData(pendingInterest.interest, data);
+      }
+    }
+  }
+
+  static ptr_lib::shared_ptr<LpPacket>
+  makeCongestionMarkLpPacket()
+  {
+    struct ndn_LpPacketHeaderField headerFields[5];
+    LpPacketLite lpPacketLite
+      (headerFields, sizeof(headerFields) / sizeof(headerFields[0]));
+    ndn_Error error;
+    if ((error = Tlv0_2WireFormatLite::decodeLpPacket
+         (lpPacketLite, CONGESTION_MARK_LP_PACKET,
+          sizeof(CONGESTION_MARK_LP_PACKET))))
+      throw runtime_error(ndn_getErrorString(error));
+
+    ptr_lib::shared_ptr<LpPacket> lpPacket(new LpPacket());
+    lpPacket->set(lpPacketLite);
+    return lpPacket;
+  }
+
+  int
+  countInterests(uint64_t segment)
+  {
+    int count = 0;
+    for (size_t i = 0; i < sentInterests_.size(); ++i) {
+      const Name& name = sentInterests_[i]->getName();
+      if (name.get(-1).isSegment() && name.get(-1).toSegment() == segment)
+        ++count;
+    }
+    return count;
+  }
+
+  int
+  countInterests(const Name& prefix)
+  {
+    int count = 0;
+    for (size_t i = 0; i < sentInterests_.size(); ++i) {
+      if (prefix.match(sentInterests_[i]->getName()))
+        ++count;
+    }
+    return count;
+  }
+
+  vector<ptr_lib::shared_ptr<Interest> > sentInterests_;
+  vector<uint8_t> expectedContent_;
+  size_t maxInFlight_;
+  bool markAllData_;
+  set<uint64_t> dropSegments_;
+  map<uint64_t, ndn_NetworkNackReason> nackSegments_;
+
+private:
+  class PendingInterest {
+  public:
+    ptr_lib::shared_ptr<Interest> interest;
+    OnData onData;
+    OnTimeout onTimeout;
+    OnNetworkNack onNetworkNack;
+  };
+
+  class Object {
+  public:
+    Name prefix;
+    vector<ptr_lib::shared_ptr<Data> > segments;
+    vector<uint8_t> expectedContent;
+  };
+
+  vector<Object> objects_;
+  map<uint64_t, PendingInterest> pendingInterests_;
+  DelayedCallTable delayedCallTable_;
+  uint64_t lastPendingInterestId_;
+  uint64_t lastCallLaterId_;
+};
+
+class TestSegmentFetcher : public ::testing::Test {
+public:
+  TestSegmentFetcher()
+  : prefix_("/test/segments"), isComplete_(false), errorCode_(0), nBytes_(0),
+    lastProgressSegments_(0), lastProgressTotal_(0)
+  {
+  }
+
+  void
+  onComplete(const Blob& content)
+  {
+    isComplete_ = true;
+    content_ = content;
+  }
+
+  void
+  onError(SegmentFetcher::ErrorCode errorCode, const string& message)
+  {
+    errorCode_ = errorCode;
+  }
+
+  void
+  onSegment(uint64_t segmentNumber, const Blob& content)
+  {
+    segmentNumbers_.push_back(segmentNumber);
+    streamContent_.insert(streamContent_.end(), content.buf(), content.buf() + content.size());
+  }
+
+  void
+  onStreamComplete(uint64_t nBytes)
+  {
+    isComplete_ = true;
+    nBytes_ = nBytes;
+  }
+
+  void
+  onProgress
+    (uint64_t nSegmentsDelivered, int64_t nSegments, uint64_t nBytesDelivered,
+     double bytesPerSecond)
+  {
+    lastProgressSegments_ = nSegmentsDelivered;
+    lastProgressTotal_ = nSegments;
+  }
+
+  static bool
+  rejectSegment(const ptr_lib::shared_ptr<Data>& data) { return false; }
+
+  void
+  fetch(LoopbackFace& face, const SegmentFetcher::Options& options)
+  {
+    Interest interest(prefix_);
+    interest.setInterestLifetimeMilliseconds(1000);
+    SegmentFetcher::fetch
+      (face, interest, SegmentFetcher::DontVerifySegment,
+       bind(&TestSegmentFetcher::onComplete, this, _1),
+       bind(&TestSegmentFetcher::onError, this, _1, _2), options);
+
+    for (int i = 0; i < 1000 && !isComplete_ && errorCode_ == 0; ++i)
+      face.processEvents();
+  }
+
+  Name prefix_;
+  bool isComplete_;
+  Blob content_;
+  int errorCode_;
+  vector<uint64_t> segmentNumbers_;
+  vector<uint8_t> streamContent_;
+  uint64_t nBytes_;
+  uint64_t lastProgressSegments_;
+  int64_t lastProgressTotal_;
+};
+
+TEST_F(TestSegmentFetcher, Pipelined)
+{
+  LoopbackFace face(prefix_, 40);
+  fetch(face, SegmentFetcher::Options());
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_TRUE(content_.equals(Blob(face.expectedContent_)));
+  // The discovery Interest gets segment 0, then each segment is fetched once.
+  ASSERT_EQ(40, face.sentInterests_.size());
+  ASSERT_TRUE(face.maxInFlight_ > 8) << "Expected slow start to grow the window";
+}
+
+TEST_F(TestSegmentFetcher, ConstantWindow)
+{
+  LoopbackFace face(prefix_, 40);
+  fetch(face, SegmentFetcher::Options().setUseConstantCwnd(true).setInitCwnd(4));
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_TRUE(content_.equals(Blob(face.expectedContent_)));
+  ASSERT_EQ(4, face.maxInFlight_);
+}
+
+TEST_F(TestSegmentFetcher, RetransmitAfterTimeout)
+{
+  LoopbackFace face(prefix_, 20);
+  face.dropSegments_.insert(5);
+  face.dropSegments_.insert(12);
+  fetch(face, SegmentFetcher::Options());
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_TRUE(content_.equals(Blob(face.expectedContent_)));
+  ASSERT_EQ(2, face.countInterests(5));
+  ASSERT_EQ(2, face.countInterests(12));
+  ASSERT_EQ(1, face.countInterests(6));
+}
+
+TEST_F(TestSegmentFetcher, MaxTimeout)
+{
+  LoopbackFace face(prefix_, 20);
+  face.dropSegments_.insert(5);
+  // A maximum timeout of 0 fails on the first timeout.
+  fetch(face, SegmentFetcher::Options().setMaxTimeout(0));
+
+  ASSERT_FALSE(isComplete_);
+  ASSERT_EQ(SegmentFetcher::INTEREST_TIMEOUT, errorCode_);
+}
+
+TEST_F(TestSegmentFetcher, CongestionMark)
+{
+  LoopbackFace face(prefix_, 40);
+  face.markAllData_ = true;
+  fetch(face, SegmentFetcher::Options());
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_TRUE(content_.equals(Blob(face.expectedContent_)));
+  ASSERT_TRUE(face.maxInFlight_ <= 3) <<
+    "Expected congestion marks to keep the window small";
+
+  LoopbackFace face2(prefix_, 40);
+  face2.markAllData_ = true;
+  isComplete_ = false;
+  fetch(face2, SegmentFetcher::Options().setIgnoreCongestionMarks(true));
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_TRUE(face2.maxInFlight_ > 8);
+}
+
+TEST_F(TestSegmentFetcher, NetworkNack)
+{
+  LoopbackFace face(prefix_, 20);
+  face.nackSegments_[3] = ndn_NetworkNackReason_DUPLICATE;
+  face.nackSegments_[7] = ndn_NetworkNackReason_CONGESTION;
+  fetch(face, SegmentFetcher::Options());
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_TRUE(content_.equals(Blob(face.expectedContent_)));
+  ASSERT_EQ(2, face.countInterests(3));
+  ASSERT_EQ(2, face.countInterests(7));
+
+  LoopbackFace face2(prefix_, 20);
+  face2.nackSegments_[3] = ndn_NetworkNackReason_NO_ROUTE;
+  isComplete_ = false;
+  fetch(face2, SegmentFetcher::Options());
+
+  ASSERT_FALSE(isComplete_);
+  ASSERT_EQ(SegmentFetcher::NACK_ERROR, errorCode_);
+}
+
+TEST_F(TestSegmentFetcher, VerificationFailed)
+{
+  LoopbackFace face(prefix_, 20);
+  Interest interest(prefix_);
+  SegmentFetcher::fetch
+    (face, interest, &TestSegmentFetcher::rejectSegment,
+     bind(&TestSegmentFetcher::onComplete, this, _1),
+     bind(&TestSegmentFetcher::onError, this, _1, _2));
+  for (int i = 0; i < 1000 && !isComplete_ && errorCode_ == 0; ++i)
+    face.processEvents();
+
+  ASSERT_FALSE(isComplete_);
+  ASSERT_EQ(SegmentFetcher::SEGMENT_VERIFICATION_FAILED, errorCode_);
+}
+
+TEST_F(TestSegmentFetcher, Stream)
+{
+  LoopbackFace face(prefix_, 30);
+  face.dropSegments_.insert(3);
+  Interest interest(prefix_);
+  SegmentFetcher::fetchStream
+    (face, interest, 0, bind(&TestSegmentFetcher::onSegment, this, _1, _2),
+     bind(&TestSegmentFetcher::onStreamComplete, this, _1),
+     bind(&TestSegmentFetcher::onError, this, _1, _2),
+     SegmentFetcher::Options().setMaxReorderSegments(4).setOnProgress
+       (bind(&TestSegmentFetcher::onProgress, this, _1, _2, _3, _4)));
+  for (int i = 0; i < 1000 && !isComplete_ && errorCode_ == 0; ++i)
+    face.processEvents();
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_EQ(30, segmentNumbers_.size());
+  for (size_t i = 0; i < segmentNumbers_.size(); ++i)
+    ASSERT_EQ(i, segmentNumbers_[i]) << "Expected segments in order";
+  ASSERT_TRUE(streamContent_ == face.expectedContent_);
+  ASSERT_EQ(face.expectedContent_.size(), nBytes_);
+  ASSERT_TRUE(face.maxInFlight_ <= 4) <<
+    "Expected the reorder buffer to limit the Interests in flight";
+  ASSERT_EQ(30, lastProgressSegments_);
+  ASSERT_EQ(30, lastProgressTotal_);
+}
+
+TEST_F(TestSegmentFetcher, ToFile)
+{
+  char filePath[] = "/tmp/test-segment-fetcher-XXXXXX";
+  int fd = mkstemp(filePath);
+  ASSERT_TRUE(fd >= 0);
+
+  LoopbackFace face(prefix_, 30);
+  face.dropSegments_.insert(0);
+  face.dropSegments_.insert(17);
+  const uint64_t fileOffset = 10;
+  Interest interest(prefix_);
+  SegmentFetcher::fetchToFile
+    (face, interest, 0, fd, fileOffset,
+     bind(&TestSegmentFetcher::onStreamComplete, this, _1),
+     bind(&TestSegmentFetcher::onError, this, _1, _2));
+  for (int i = 0; i < 1000 && !isComplete_ && errorCode_ == 0; ++i)
+    face.processEvents();
+
+  ASSERT_TRUE(isComplete_);
+  ASSERT_EQ(face.expectedContent_.size(), nBytes_);
+  vector<uint8_t> fileContent(fileOffset + nBytes_ + 1);
+  ssize_t nRead = pread(fd, &fileContent[0], fileContent.size(), 0);
+  close(fd);
+  remove(filePath);
+  ASSERT_EQ(fileOffset + nBytes_, nRead);
+  ASSERT_TRUE(equal
+    (face.expectedContent_.begin(), face.expectedContent_.end(),
+     fileContent.begin() + fileOffset));
+}
+
+/**
+ * FetchSchedulerObject records the result of one object fetched by a
+ * FetchScheduler, and how many Interests the other object had sent when this
+ * one completed.
+ */
+class FetchSchedulerObject {
+public:
+  FetchSchedulerObject
+    (LoopbackFace& face, const Name& prefix, const Name& otherPrefix)
+  : face_(face), prefix_(prefix), otherPrefix_(otherPrefix), isComplete_(false),
+    errorCode_(0), nOtherInterestsAtComplete_(0)
+  {
+  }
+
+  void
+  onComplete(const Blob& content)
+  {
+    isComplete_ = true;
+    content_ = content;
+    nOtherInterestsAtComplete_ = face_.countInterests(otherPrefix_);
+  }
+
+  void
+  onError(SegmentFetcher::ErrorCode errorCode, const string& message)
+  {
+    errorCode_ = errorCode;
+  }
+
+  void
+  fetch(FetchScheduler& scheduler, double priority)
+  {
+    scheduler.fetch
+      (Interest(prefix_), 0, bind(&FetchSchedulerObject::onComplete, this, _1),
+       bind(&FetchSchedulerObject::onError, this, _1, _2), priority);
+  }
+
+  LoopbackFace& face_;
+  Name prefix_;
+  Name otherPrefix_;
+  bool isComplete_;
+  Blob content_;
+  int errorCode_;
+  int nOtherInterestsAtComplete_;
+};
+
+TEST_F(TestSegmentFetcher, SchedulerFairShare)
+{
+  Name prefixA("/test/a");
+  Name prefixB("/test/b");
+  LoopbackFace face(prefixA, 200);
+  const vector<uint8_t>& expectedB = face.addObject(prefixB, 200);
+  FetchScheduler scheduler
+    (face, SegmentFetcher::Options().setUseConstantCwnd(true).setInitCwnd(8));
+  FetchSchedulerObject a(face, prefixA, prefixB);
+  FetchSchedulerObject b(face, prefixB, prefixA);
+  a.fetch(scheduler, 1);
+  b.fetch(scheduler, 1);
+  ASSERT_EQ(2, scheduler.getNObjectsInProgress());
+  for (int i = 0; i < 1000 && scheduler.getNObjectsInProgress() > 0; ++i)
+    face.processEvents();
+
+  ASSERT_TRUE(a.isComplete_);
+  ASSERT_TRUE(b.isComplete_);
+  ASSERT_TRUE(a.content_.equals(Blob(face.expectedContent_)));
+  ASSERT_TRUE(b.content_.equals(Blob(expectedB)));
+  ASSERT_EQ(8, face.maxInFlight_) << "Expected the objects to share one window";
+  // With the same priority, the first object to complete finishes about one
+  // round trip before the other.
+  FetchSchedulerObject& first =
+    (a.nOtherInterestsAtComplete_ < b.nOtherInterestsAtComplete_ ? a : b);
+  ASSERT_TRUE(first.nOtherInterestsAtComplete_ >= 190);
+}
+
+TEST_F(TestSegmentFetcher, SchedulerPriority)
+{
+  Name prefixA("/test/a");
+  Name prefixB("/test/b");
+  LoopbackFace face(prefixA, 300);
+  face.addObject(prefixB, 300);
+  FetchScheduler scheduler
+    (face, SegmentFetcher::Options().setUseConstantCwnd(true).setInitCwnd(8));
+  FetchSchedulerObject a(face, prefixA, prefixB);
+  FetchSchedulerObject b(face, prefixB, prefixA);
+  a.fetch(scheduler, 3);
+  b.fetch(scheduler, 1);
+  for (int i = 0; i < 1000 && scheduler.getNObjectsInProgress() > 0; ++i)
+    face.processEvents();
+
+  ASSERT_TRUE(a.isComplete_);
+  ASSERT_TRUE(b.isComplete_);
+  // Object A has 3/4 of the window, so B has a third of its Interests sent
+  // when A completes.
+  ASSERT_TRUE(a.nOtherInterestsAtComplete_ >= 80 &&
+              a.nOtherInterestsAtComplete_ <= 120) <<
+    "Interests sent for B: " << a.nOtherInterestsAtComplete_;
+}
+
+TEST_F(TestSegmentFetcher, SchedulerStream)
+{
+  Name prefixA("/test/a");
+  LoopbackFace face(prefixA, 100);
+  face.addObject(prefix_, 100);
+  // Drop segment 20 of the object which asks for it first.
+  face.dropSegments_.insert(20);
+  FetchScheduler scheduler(face);
+  FetchSchedulerObject a(face, prefixA, prefix_);
+  a.fetch(scheduler, 1);
+  scheduler.fetchStream
+    (Interest(prefix_), 0, bind(&TestSegmentFetcher::onSegment, this, _1, _2),
+     bind(&TestSegmentFetcher::onStreamComplete, this, _1),
+     bind(&TestSegmentFetcher::onError, this, _1, _2));
+  ASSERT_EQ(2, scheduler.getNObjectsInProgress());
+  for (int i = 0; i < 1000 && scheduler.getNObjectsInProgress() > 0; ++i)
+    face.processEvents();
+
+  ASSERT_TRUE(a.isComplete_);
+  ASSERT_TRUE(a.content_.equals(Blob(face.expectedContent_)));
+  ASSERT_TRUE(isComplete_);
+  ASSERT_EQ(100, segmentNumbers_.size());
+  ASSERT_TRUE(streamContent_ == face.expectedContent_) <<
+    "Expected the same content as object A";
+  ASSERT_TRUE(face.maxInFlight_ > 8) << "Expected slow start to grow the window";
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
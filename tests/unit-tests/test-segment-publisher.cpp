@@ -0,0 +1,168 @@
+/**
+ * Copyright (C) 2020 Regents of the University of California.
+ * @author: Jeff Thompson <jefft0@remap.ucla.edu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version, with the additional exemption that
+ * compiling, linking, and/or using OpenSSL is allowed.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ * A copy of the GNU Lesser General Public License is in the file COPYING.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <ndn-cpp/security/verification-helpers.hpp>
+#include <ndn-cpp/util/segment-publisher.hpp>
+
+using namespace std;
+using namespace ndn;
+
+class TestSegmentPublisher : public ::testing::Test {
+public:
+  TestSegmentPublisher()
+  : keyChain_("pib-memory:", "tpm-memory:"), prefix_("/test/publisher")
+  {
+    identity_ = keyChain_.createIdentityV2(Name("/test/identity"), EcKeyParams());
+    certificate_ = identity_->getDefaultKey()->getDefaultCertificate();
+
+    for (size_t i = 0; i < 20500; ++i)
+      content_.push_back((uint8_t)(i * 7));
+  }
+
+  /**
+   * Check that the segments are named and sized for segmentSize, and that
+   * their content concatenates to content_.
+   */
+  void
+  checkSegments
+    (const Name& versionedName, const vector<ptr_lib::shared_ptr<Data> >& segments,
+     size_t segmentSize)
+  {
+    size_t nSegments = (content_.size() + segmentSize - 1) / segmentSize;
+    ASSERT_EQ(nSegments, segments.size());
+
+    vector<uint8_t> content;
+    for (size_t i = 0; i < segments.size(); ++i) {
+      const Data& data = *segments[i];
+      ASSERT_TRUE(data.getName().equals(Name(versionedName).appendSegment(i)));
+      ASSERT_EQ(nSegments - 1, data.getMetaInfo().getFinalBlockId().toSegment());
+      content.insert
+        (content.end(), data.getContent().buf(),
+         data.getContent().buf() + data.getContent().size());
+    }
+    ASSERT_TRUE(content == content_);
+  }
+
+  KeyChain keyChain_;
+  ptr_lib::shared_ptr<PibIdentity> identity_;
+  ptr_lib::shared_ptr<CertificateV2> certificate_;
+  Name prefix_;
+  vector<uint8_t> content_;
+};
+
+TEST_F(TestSegmentPublisher, SignEachSegment)
+{
+  for (size_t nThreads = 1; nThreads <= 4; nThreads += 3) {
+    SegmentPublisher publisher
+      (keyChain_, SigningInfo(identity_),
+       SegmentPublisher::Options().setSegmentSize(1000).setNThreads(nThreads)
+       .setFreshnessPeriod(5000));
+    vector<ptr_lib::shared_ptr<Data> > segments;
+    Name versionedName = publisher.publish
+      (prefix_, &content_[0], content_.size(), 7, segments);
+
+    ASSERT_TRUE(versionedName.equals(Name(prefix_).appendVersion(7)));
+    checkSegments(versionedName, segments, 1000);
+    ASSERT_EQ(segments.size(), publisher.getNSegmentsPublished());
+    ASSERT_TRUE(publisher.getSegmentsPerSecond() > 0);
+    ASSERT_TRUE(!publisher.getManifest());
+    for (size_t i = 0; i < segments.size(); ++i) {
+      ASSERT_EQ(5000, segments[i]->getMetaInfo().getFreshnessPeriod());
+      ASSERT_TRUE(VerificationHelpers::verifyDataSignature
+        (*segments[i], *certificate_)) <<
+        "Segment " << i << " with " << nThreads << " threads";
+    }
+  }
+}
+
+TEST_F(TestSegmentPublisher, SignManifest)
+{
+  SegmentPublisher publisher
+    (keyChain_, SigningInfo(identity_),
+     SegmentPublisher::Options().setSegmentSize(1000)
+     .setSigningMode(SegmentPublisher::SIGN_MANIFEST));
+  vector<ptr_lib::shared_ptr<Data> > segments;
+  Name versionedName = publisher.publish(prefix_, Blob(content_), segments);
+
+  checkSegments(versionedName, segments, 1000);
+  ptr_lib::shared_ptr<Data> manifest = publisher.getManifest();
+  ASSERT_TRUE(manifest.get() != 0);
+  ASSERT_TRUE(manifest->getName().equals(Name(versionedName).append("_manifest")));
+  ASSERT_TRUE(VerificationHelpers::verifyDataSignature(*manifest, *certificate_));
+  for (size_t i = 0; i < segments.size(); ++i) {
+    ASSERT_TRUE(VerificationHelpers::verifyDataDigest
+      (*segments[i], DIGEST_ALGORITHM_SHA256));
+    ASSERT_TRUE(SegmentPublisher::verifyWithManifest(manifest, segments[i]));
+  }
+
+  // A changed segment doesn't match.
+  ptr_lib::shared_ptr<Data> changed(new Data(*segments[3]));
+  changed->setContent(Blob(vector<uint8_t>(10, 0)));
+  keyChain_.sign(*changed, SigningInfo(SigningInfo::SIGNER_TYPE_SHA256));
+  ASSERT_FALSE(SegmentPublisher::verifyWithManifest(manifest, changed));
+  // A segment of another version doesn't match.
+  ptr_lib::shared_ptr<Data> otherVersion(new Data
+    (Name(prefix_).appendVersion(1).appendSegment(0)));
+  ASSERT_FALSE(SegmentPublisher::verifyWithManifest(manifest, otherVersion));
+}
+
+TEST_F(TestSegmentPublisher, EmptyContent)
+{
+  SegmentPublisher publisher(keyChain_, SigningInfo(identity_));
+  vector<ptr_lib::shared_ptr<Data> > segments;
+  Name versionedName = publisher.publish(prefix_, Blob(), segments);
+
+  ASSERT_EQ(1, segments.size());
+  ASSERT_EQ(0, segments[0]->getContent().size());
+  ASSERT_EQ(0, segments[0]->getMetaInfo().getFinalBlockId().toSegment());
+  ASSERT_TRUE(VerificationHelpers::verifyDataSignature(*segments[0], *certificate_));
+}
+
+TEST_F(TestSegmentPublisher, PublishFile)
+{
+  char filePath[] = "/tmp/test-segment-publisher-XXXXXX";
+  int fd = mkstemp(filePath);
+  ASSERT_TRUE(fd >= 0);
+  ASSERT_EQ(content_.size(), write(fd, &content_[0], content_.size()));
+  close(fd);
+
+  SegmentPublisher publisher
+    (keyChain_, SigningInfo(identity_),
+     SegmentPublisher::Options().setSegmentSize(3000));
+  vector<ptr_lib::shared_ptr<Data> > segments;
+  Name versionedName = publisher.publishFile(prefix_, filePath, segments);
+  remove(filePath);
+
+  checkSegments(versionedName, segments, 3000);
+  ASSERT_THROW
+    (publisher.publishFile(prefix_, "/tmp/no-such-dir/no-such-file", segments),
+     runtime_error);
+}
+
+int
+main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
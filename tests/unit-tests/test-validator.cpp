@@ -22,6 +22,7 @@
 
 #include "gtest/gtest.h"
 #include "validator-fixture.hpp"
+#include <unistd.h>
 #include <ndn-cpp/security/v2/validation-policy-simple-hierarchy.hpp>
 
 using namespace std;
@@ -314,6 +315,93 @@ TEST_F(TestValidator, ResetVerifiedCertificates)
     (data, "Should fail, as there is no trusted cache or anchors");
 }
 
+TEST_F(TestValidator, PublicKeyCaching)
+{
+  PublicKeyCache& publicKeyCache = fixture_.validator_.getPublicKeyCache();
+
+  Data data(Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data"));
+  fixture_.keyChain_.sign(data, SigningInfo(fixture_.subIdentity_));
+  validateExpectSuccess
+    (data, "Should get accepted, as signed by the policy-compliant certificate");
+  // The keys of the anchor and the fetched certificate are decoded.
+  ASSERT_EQ(0, publicKeyCache.getNHits());
+  ASSERT_EQ(2, publicKeyCache.getNMisses());
+  ASSERT_EQ(2, publicKeyCache.size());
+
+  Data data2(Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data2"));
+  fixture_.keyChain_.sign(data2, SigningInfo(fixture_.subIdentity_));
+  validateExpectSuccess
+    (data2, "Should get accepted, based on the cached trusted certificate");
+  ASSERT_EQ(1, publicKeyCache.getNHits());
+  ASSERT_EQ(2, publicKeyCache.getNMisses());
+
+  // A cached key must still reject a bad signature.
+  Data badData(data2);
+  badData.setContent(Blob((const uint8_t*)"bad", 3));
+  validateExpectFailure(badData, "Should fail, as the content was changed");
+  ASSERT_EQ(2, publicKeyCache.getNHits());
+
+  publicKeyCache.clear();
+  ASSERT_EQ(0, publicKeyCache.size());
+  validateExpectSuccess
+    (data, "Should get accepted after decoding the key again");
+  ASSERT_EQ(3, publicKeyCache.getNMisses());
+}
+
+#if NDN_CPP_HAVE_POSIX_THREADS
+static void
+countData(const Data& data, int* count)
+{
+  ++(*count);
+}
+
+static void
+countDataFailure(const Data& data, const ValidationError& error, int* count)
+{
+  ++(*count);
+}
+
+TEST_F(TestValidator, VerificationWorkerPool)
+{
+  ptr_lib::shared_ptr<VerificationWorkerPool> workerPool
+    (new VerificationWorkerPool(2));
+  fixture_.validator_.setVerificationWorkerPool(workerPool);
+
+  // Make segments signed by the same certificate, and one with a bad signature.
+  const int nGoodData = 5;
+  vector<ptr_lib::shared_ptr<Data> > dataList;
+  for (int i = 0; i < nGoodData; ++i) {
+    ptr_lib::shared_ptr<Data> data(new Data
+      (Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data").appendSegment(i)));
+    fixture_.keyChain_.sign(*data, SigningInfo(fixture_.subIdentity_));
+    dataList.push_back(data);
+  }
+  ptr_lib::shared_ptr<Data> badData(new Data(*dataList[0]));
+  badData->setContent(Blob((const uint8_t*)"bad", 3));
+  dataList.push_back(badData);
+
+  int nSucceeded = 0;
+  int nFailed = 0;
+  fixture_.validator_.validate
+    (dataList, bind(&countData, _1, &nSucceeded),
+     bind(&countDataFailure, _1, _2, &nFailed));
+
+  // The callbacks come from the worker pool's processEvents.
+  ASSERT_EQ(0, nSucceeded + nFailed);
+  MillisecondsSince1970 timeout = ndn_getNowMilliseconds() + 10000;
+  while (nSucceeded + nFailed < (int)dataList.size() &&
+         ndn_getNowMilliseconds() < timeout) {
+    workerPool->processEvents();
+    usleep(1000);
+  }
+
+  ASSERT_EQ(nGoodData, nSucceeded);
+  ASSERT_EQ(1, nFailed);
+  // The certificate is only fetched for the first segment.
+  ASSERT_EQ(1, fixture_.face_.sentInterests_.size());
+}
+#endif
+
 TEST_F(TestValidator, UntrustedCertificateCaching)
 {
   Data data(Name("/Security/V2/ValidatorFixture/Sub1/Sub2/Data"));